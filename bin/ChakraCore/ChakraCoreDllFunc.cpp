@@ -11,6 +11,8 @@
 #include "Language/DynamicProfileStorage.h"
 #endif
 #include "JsrtContext.h"
+#include "RegexFlags.h"
+#include "RegexProgramCache.h"
 #include "TestHooks.h"
 #ifdef VTUNE_PROFILING
 #include "Base/VTuneChakraProfile.h"
@@ -108,6 +110,12 @@ static void DetachProcess()
 
     ThreadContextTLSEntry::CleanupProcess();
 
+    // All runtimes are gone; drop the regexes they compiled into the shared cache
+    UnifiedRegex::ProgramCache::Clear();
+
+    // All page allocators are gone; give the pooled segments back to the OS
+    PageSegmentPool::Instance.Flush();
+
 #if PROFILE_DICTIONARY
     DictionaryStats::OutputStats();
 #endif
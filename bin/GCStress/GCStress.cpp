@@ -68,6 +68,13 @@ WeightedTable<Operation> operationTable;
 // Not used currently, but keep for now
 bool verbose = false;
 
+// Instead of running the stress loop, time full collections of the initial heap at each degree of mark parallelism
+bool markBenchmarkMode = false;
+static const unsigned int markBenchmarkCollectCount = 10;
+
+// Instead of running the stress loop, check the platform services the Recycler depends on
+bool selfTestMode = false;
+
 
 RecyclerTestObject * CreateNewObject()
 {
@@ -236,6 +243,46 @@ void BuildOperationTable()
     operationTable.AddWeightedEntry(&SwapObjects, 5);
 }
 
+void MarkBenchmark()
+{
+#if ENABLE_CONCURRENT_GC
+    // All the objects reachable from our roots get marked by every collection
+    size_t liveBytes = RecyclerTestObject::GetWalkTotalByteCount();
+    uint maxParallelism = recyclerInstance->GetMaxParallelism();
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    wprintf(_u("-------------------------------------------\n"));
+    wprintf(_u("Mark benchmark: %llu live bytes, %u collections per thread count\n"), (unsigned long long) liveBytes, markBenchmarkCollectCount);
+    // Each collection is timed as a whole, including the work around the mark, so the rate is a collection rate
+    wprintf(_u("Threads   Collect (ms)   Live bytes/collect ms\n"));
+
+    for (uint threadCount = 1; threadCount <= maxParallelism; threadCount++)
+    {
+        recyclerInstance->SetMaxParallelism(threadCount);
+
+        // Warm up, so that the parallel threads exist and the heap is in a steady state
+        recyclerInstance->CollectNow<CollectNowForceInThread>();
+
+        LARGE_INTEGER start, end;
+        QueryPerformanceCounter(&start);
+        for (unsigned int i = 0; i < markBenchmarkCollectCount; i++)
+        {
+            recyclerInstance->CollectNow<CollectNowForceInThread>();
+        }
+        QueryPerformanceCounter(&end);
+
+        double elapsedMs = (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)frequency.QuadPart / markBenchmarkCollectCount;
+        wprintf(_u("%7u   %12.3f   %21.0f\n"), threadCount, elapsedMs, elapsedMs > 0 ? (double)liveBytes / elapsedMs : 0.0);
+    }
+
+    recyclerInstance->SetMaxParallelism(maxParallelism);
+#else
+    wprintf(_u("Mark benchmark requires concurrent GC support\n"));
+#endif
+}
+
 void SimpleRecyclerTest()
 {
     // Initialize the probability tables for object creation and heap operations.
@@ -315,6 +362,18 @@ void SimpleRecyclerTest()
         // Do an initial walk
         WalkHeap();
 
+        if (markBenchmarkMode)
+        {
+            MarkBenchmark();
+            return;
+        }
+
+        if (selfTestMode)
+        {
+            ConcurrentCollectSelfTest();
+            return;
+        }
+
         // Loop, continually doing heap operations, and periodically doing a full heap walk
         while (true)
         {
@@ -359,8 +418,10 @@ bool GetDeviceFamilyInfo(
 void usage(const WCHAR* self)
 {
     wprintf(
-        _u("usage: %s [-?|-v] [-js <jscript options from here on>]\n")
-        _u("  -v\n\tverbose logging\n"),
+        _u("usage: %s [-?|-v|-markbench|-selftest] [-js <jscript options from here on>]\n")
+        _u("  -v\n\tverbose logging\n")
+        _u("  -markbench\n\treport collection time and live bytes collected per ms for each parallel mark thread count\n")
+        _u("  -selftest\n\tcheck the platform services used by the recycler, then run a short concurrent collection test\n"),
         self);
 }
 
@@ -381,6 +442,14 @@ int __cdecl wmain(int argc, __in_ecount(argc) WCHAR* argv[])
             {
                 verbose = true;
             }
+            else if (wcscmp(argv[i], _u("-markbench")) == 0)
+            {
+                markBenchmarkMode = true;
+            }
+            else if (wcscmp(argv[i], _u("-selftest")) == 0)
+            {
+                selfTestMode = true;
+            }
             else if (wcscmp(argv[i], _u("-js")) == 0 || wcscmp(argv[i], _u("-JS")) == 0)
             {
                 jscriptOptions = i;
@@ -409,6 +478,11 @@ int __cdecl wmain(int argc, __in_ecount(argc) WCHAR* argv[])
     }
 
     // Run the actual test
+    if (selfTestMode)
+    {
+        SelfTest();
+    }
+
     SimpleRecyclerTest();
 
     return 0;
@@ -75,6 +75,11 @@ public:
         wprintf(_u("Max Depth:      %12llu\n"), (unsigned long long) maxWalkDepth);
     }
 
+    static size_t GetWalkTotalByteCount()
+    {
+        return walkScannedByteCount + walkBarrierByteCount + walkTrackedByteCount + walkLeafByteCount;
+    }
+
     // Virtual methods
     virtual bool TryGetRandomLocation(Location * location)
     {
@@ -0,0 +1,459 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "stdafx.h"
+
+// Checks for the platform services the Recycler and the background job processor rely on.
+// These run instead of the stress loop when -selftest is passed.
+
+//////////////////// Begin thread tests ////////////////////
+
+static const unsigned int threadStartCount = 8;
+static volatile LONG threadStartRunCount = 0;
+
+static unsigned int ThreadStartExitCode(unsigned int index)
+{
+    return 0x100 + index;
+}
+
+static unsigned int __stdcall ThreadStartProc(void * arg)
+{
+    InterlockedIncrement(&threadStartRunCount);
+    return ThreadStartExitCode(*(unsigned int *)arg);
+}
+
+// Start threads suspended the way the job processor and the concurrent GC do, then resume and join them
+static void ThreadStartTest()
+{
+    HANDLE threads[threadStartCount];
+    unsigned int threadIds[threadStartCount];
+    unsigned int args[threadStartCount];
+
+    threadStartRunCount = 0;
+    for (unsigned int i = 0; i < threadStartCount; i++)
+    {
+        args[i] = i;
+        threadIds[i] = 0;
+        threads[i] = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &ThreadStartProc, &args[i], CREATE_SUSPENDED, &threadIds[i]));
+        VerifyCondition(threads[i] != nullptr);
+        VerifyCondition(threadIds[i] != 0);
+    }
+
+    // None of the threads may run before they are resumed
+    Sleep(10);
+    VerifyCondition(threadStartRunCount == 0);
+
+    for (unsigned int i = 0; i < threadStartCount; i++)
+    {
+        VerifyCondition(ResumeThread(threads[i]) != (DWORD)-1);
+    }
+
+    VerifyCondition(WaitForMultipleObjects(threadStartCount, threads, TRUE, INFINITE) == WAIT_OBJECT_0);
+    VerifyCondition(threadStartRunCount == threadStartCount);
+
+    for (unsigned int i = 0; i < threadStartCount; i++)
+    {
+        DWORD exitCode = 0;
+        VerifyCondition(GetExitCodeThread(threads[i], &exitCode));
+        VerifyCondition(exitCode == ThreadStartExitCode(i));
+        VerifyCondition(CloseHandle(threads[i]));
+    }
+
+    wprintf(_u("Thread start test passed\n"));
+}
+
+//////////////////// End thread tests ////////////////////
+
+//////////////////// Begin write watch tests ////////////////////
+
+static const size_t writeWatchPageCount = 16;
+static const unsigned int writeWatchThreadCount = 4;
+
+static char * WriteWatchPage(char * base, size_t page)
+{
+    return base + page * AutoSystemInfo::PageSize;
+}
+
+// Check that the pages reported written in the region are exactly the expected ones, in address order
+static void CheckWrittenPages(char * base, DWORD flags, const size_t * expected, size_t expectedCount)
+{
+    PVOID addresses[writeWatchPageCount];
+    ULONG_PTR count = writeWatchPageCount;
+    ULONG granularity = 0;
+
+    VerifyCondition(GetWriteWatch(flags, base, writeWatchPageCount * AutoSystemInfo::PageSize, addresses, &count, &granularity) == 0);
+    VerifyCondition(granularity == AutoSystemInfo::PageSize);
+    VerifyCondition(count == expectedCount);
+    for (ULONG_PTR i = 0; i < count; i++)
+    {
+        VerifyCondition(addresses[i] == WriteWatchPage(base, expected[i]));
+    }
+}
+
+struct WriteWatchThreadArgs
+{
+    char * base;
+    unsigned int index;
+};
+
+static unsigned int __stdcall WriteWatchThreadProc(void * arg)
+{
+    WriteWatchThreadArgs * args = (WriteWatchThreadArgs *)arg;
+
+    // Every thread writes its own page and page 0, so that the first write to page 0 races between threads
+    for (unsigned int i = 0; i < 1000; i++)
+    {
+        WriteWatchPage(args->base, 0)[args->index] = (char)i;
+        WriteWatchPage(args->base, 1 + args->index)[i] = (char)i;
+    }
+    return 0;
+}
+
+// The recycler finds the pages written during a concurrent mark through GetWriteWatch/ResetWriteWatch
+static void WriteWatchTest()
+{
+    const size_t regionSize = writeWatchPageCount * AutoSystemInfo::PageSize;
+    char * base = (char *)VirtualAlloc(nullptr, regionSize, MEM_RESERVE | MEM_WRITE_WATCH, PAGE_READWRITE);
+    VerifyCondition(base != nullptr);
+    VerifyCondition(VirtualAlloc(base, regionSize, MEM_COMMIT, PAGE_READWRITE) == base);
+
+    // Nothing is reported right after a reset, and reading doesn't count as a write
+    VerifyCondition(ResetWriteWatch(base, regionSize) == 0);
+    VerifyCondition(WriteWatchPage(base, 3)[0] == 0);
+    CheckWrittenPages(base, 0, nullptr, 0);
+
+    // Each written page is reported once, however often it is written
+    const size_t written[] = { 1, 5, 15 };
+    WriteWatchPage(base, 1)[0] = 1;
+    WriteWatchPage(base, 5)[10] = 1;
+    WriteWatchPage(base, 5)[20] = 1;
+    WriteWatchPage(base, 15)[AutoSystemInfo::PageSize - 1] = 1;
+    CheckWrittenPages(base, 0, written, _countof(written));
+
+    // Without the reset flag the pages stay written; with it they are reported one last time
+    CheckWrittenPages(base, WRITE_WATCH_FLAG_RESET, written, _countof(written));
+    CheckWrittenPages(base, 0, nullptr, 0);
+
+    // Writes after a reset are seen again
+    const size_t rewritten[] = { 5 };
+    WriteWatchPage(base, 5)[30] = 1;
+    CheckWrittenPages(base, WRITE_WATCH_FLAG_RESET, rewritten, _countof(rewritten));
+
+    // Pages that don't fit in the caller's buffer are left for the next call
+    PVOID addresses[2];
+    ULONG_PTR count = _countof(addresses);
+    ULONG granularity = 0;
+    WriteWatchPage(base, 2)[0] = 1;
+    WriteWatchPage(base, 4)[0] = 1;
+    WriteWatchPage(base, 6)[0] = 1;
+    VerifyCondition(GetWriteWatch(WRITE_WATCH_FLAG_RESET, base, regionSize, addresses, &count, &granularity) == 0);
+    VerifyCondition(count == 2);
+    VerifyCondition(addresses[0] == WriteWatchPage(base, 2) && addresses[1] == WriteWatchPage(base, 4));
+    const size_t remaining[] = { 6 };
+    CheckWrittenPages(base, WRITE_WATCH_FLAG_RESET, remaining, _countof(remaining));
+
+    // A page committed again is still watched
+    const size_t recommitted[] = { 7 };
+    VerifyCondition(VirtualFree(WriteWatchPage(base, 7), AutoSystemInfo::PageSize, MEM_DECOMMIT));
+    VerifyCondition(VirtualAlloc(WriteWatchPage(base, 7), AutoSystemInfo::PageSize, MEM_COMMIT, PAGE_READWRITE) == WriteWatchPage(base, 7));
+    WriteWatchPage(base, 7)[0] = 1;
+    CheckWrittenPages(base, WRITE_WATCH_FLAG_RESET, recommitted, _countof(recommitted));
+
+    // First writes from several threads at once, including to the same page
+    HANDLE threads[writeWatchThreadCount];
+    WriteWatchThreadArgs args[writeWatchThreadCount];
+    for (unsigned int i = 0; i < writeWatchThreadCount; i++)
+    {
+        args[i].base = base;
+        args[i].index = i;
+        threads[i] = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &WriteWatchThreadProc, &args[i], 0, nullptr));
+        VerifyCondition(threads[i] != nullptr);
+    }
+    VerifyCondition(WaitForMultipleObjects(writeWatchThreadCount, threads, TRUE, INFINITE) == WAIT_OBJECT_0);
+    for (unsigned int i = 0; i < writeWatchThreadCount; i++)
+    {
+        VerifyCondition(CloseHandle(threads[i]));
+    }
+    const size_t threadWritten[] = { 0, 1, 2, 3, 4 };
+    CheckWrittenPages(base, WRITE_WATCH_FLAG_RESET, threadWritten, _countof(threadWritten));
+
+    VerifyCondition(VirtualFree(base, 0, MEM_RELEASE));
+
+    wprintf(_u("Write watch test passed\n"));
+}
+
+#ifdef __LINUX__
+static size_t CountMappings()
+{
+    FILE * maps = fopen("/proc/self/maps", "r");
+    VerifyCondition(maps != nullptr);
+
+    size_t count = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), maps) != nullptr)
+    {
+        if (strchr(line, '\n') != nullptr)
+        {
+            count++;
+        }
+    }
+    fclose(maps);
+    return count;
+}
+
+// Enough pages that protecting every other one would need more mappings than vm.max_map_count allows
+static const size_t writeWatchLargePageCount = 64 * 1024;
+static const size_t writeWatchMaxAddedMappings = 33 * 1024;
+
+// Write protection splits mappings, so a large heap written sparsely must not run the process out of them.
+// Every written page must still be reported, though pages past the mapping budget may be reported unwritten.
+static void WriteWatchMappingTest()
+{
+    const size_t regionSize = writeWatchLargePageCount * AutoSystemInfo::PageSize;
+    char * base = (char *)VirtualAlloc(nullptr, regionSize, MEM_RESERVE | MEM_WRITE_WATCH, PAGE_READWRITE);
+    VerifyCondition(base != nullptr);
+    VerifyCondition(VirtualAlloc(base, regionSize, MEM_COMMIT, PAGE_READWRITE) == base);
+    VerifyCondition(ResetWriteWatch(base, regionSize) == 0);
+
+    const size_t mappingsBefore = CountMappings();
+    for (size_t page = 1; page < writeWatchLargePageCount; page += 2)
+    {
+        WriteWatchPage(base, page)[0] = 1;
+    }
+    VerifyCondition(CountMappings() <= mappingsBefore + writeWatchMaxAddedMappings);
+
+    PVOID * addresses = new PVOID[writeWatchLargePageCount];
+    ULONG_PTR count = writeWatchLargePageCount;
+    ULONG granularity = 0;
+    VerifyCondition(GetWriteWatch(WRITE_WATCH_FLAG_RESET, base, regionSize, addresses, &count, &granularity) == 0);
+    VerifyCondition(count >= writeWatchLargePageCount / 2);
+    size_t reported = 0;
+    for (size_t page = 1; page < writeWatchLargePageCount; page += 2)
+    {
+        while (reported < count && addresses[reported] < WriteWatchPage(base, page))
+        {
+            reported++;
+        }
+        VerifyCondition(reported < count && addresses[reported] == WriteWatchPage(base, page));
+    }
+
+    // Once reset, the region is protected as a whole again and writes are seen page by page
+    VerifyCondition(CountMappings() <= mappingsBefore + 2);
+    const size_t rewritten[] = { 3 };
+    WriteWatchPage(base, 3)[0] = 1;
+    count = writeWatchLargePageCount;
+    VerifyCondition(GetWriteWatch(WRITE_WATCH_FLAG_RESET, base, regionSize, addresses, &count, &granularity) == 0);
+    VerifyCondition(count == _countof(rewritten) && addresses[0] == WriteWatchPage(base, rewritten[0]));
+
+    delete[] addresses;
+    VerifyCondition(VirtualFree(base, 0, MEM_RELEASE));
+
+    wprintf(_u("Write watch mapping test passed\n"));
+}
+#endif
+
+//////////////////// End write watch tests ////////////////////
+
+//////////////////// Begin segment pool tests ////////////////////
+
+static const size_t segmentPoolPageCount = 16;
+
+static char * AllocPoolSegment(size_t pageCount, char fill)
+{
+    char * segment = (char *)VirtualAlloc(nullptr, pageCount * AutoSystemInfo::PageSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    VerifyCondition(segment != nullptr);
+    memset(segment, fill, pageCount * AutoSystemInfo::PageSize);
+    return segment;
+}
+
+static bool IsFilledWith(char * segment, size_t pageCount, char fill)
+{
+    for (size_t i = 0; i < pageCount * AutoSystemInfo::PageSize; i++)
+    {
+        if (segment[i] != fill)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Segments move between page allocators through the process-wide pool: the pool refuses segments once it is
+// full, hands segments back only for the same size and flags, moves the charge for the pages to the taker's
+// policy manager, and zeroes pages that go to another allocator than the one that released them.
+static void SegmentPoolTest()
+{
+    PageSegmentPool& pool = PageSegmentPool::Instance;
+    const size_t byteCount = segmentPoolPageCount * AutoSystemInfo::PageSize;
+    const Js::Number savedPoolPageCount = Js::Configuration::Global.flags.PageSegmentPoolPageCount;
+    Js::Configuration::Global.flags.PageSegmentPoolPageCount = (Js::Number)(2 * segmentPoolPageCount);
+    pool.Flush();
+
+    // Stand-ins for two page allocators in two runtimes; the pool only compares them
+    int ownerA, ownerB;
+    AllocationPolicyManager policyManagerA(true), policyManagerB(true);
+
+    // Add, charged to the releasing allocator's policy manager
+    char * segment = AllocPoolSegment(segmentPoolPageCount, 'a');
+    VerifyCondition(policyManagerA.RequestAlloc(byteCount));
+    VerifyCondition(pool.Add(segment, segmentPoolPageCount, MEM_COMMIT, &ownerA, &policyManagerA));
+    VerifyCondition(pool.GetPageCount() == segmentPoolPageCount);
+
+    // Pool full
+    char * tooMany = AllocPoolSegment(segmentPoolPageCount + 1, 'c');
+    VerifyCondition(!pool.Add(tooMany, segmentPoolPageCount + 1, MEM_COMMIT, &ownerB, &policyManagerB));
+    VerifyCondition(pool.GetPageCount() == segmentPoolPageCount);
+    VerifyCondition(VirtualFree(tooMany, 0, MEM_RELEASE));
+
+    // No segment of another size or with other flags
+    VerifyCondition(pool.Take(segmentPoolPageCount + 1, MEM_COMMIT, &ownerA, &policyManagerA, false) == nullptr);
+    VerifyCondition(pool.Take(segmentPoolPageCount, 0, &ownerA, &policyManagerA, false) == nullptr);
+
+    // Taken back by the allocator that released it: still charged once, and only the pool entry is cleared
+    VerifyCondition(pool.Take(segmentPoolPageCount, MEM_COMMIT, &ownerA, &policyManagerA, false) == segment);
+    VerifyCondition(pool.GetPageCount() == 0);
+    VerifyCondition(policyManagerA.GetUsage() == byteCount);
+    VerifyCondition(IsFilledWith(segment + AutoSystemInfo::PageSize, segmentPoolPageCount - 1, 'a'));
+
+    // Taken by an allocator that is over its limit: stays in the pool, charged to the releasing allocator
+    VerifyCondition(pool.Add(segment, segmentPoolPageCount, MEM_COMMIT, &ownerA, &policyManagerA));
+    policyManagerB.SetLimit(byteCount - 1);
+    VerifyCondition(pool.Take(segmentPoolPageCount, MEM_COMMIT, &ownerB, &policyManagerB, false) == nullptr);
+    VerifyCondition(pool.GetPageCount() == segmentPoolPageCount);
+    VerifyCondition(policyManagerA.GetUsage() == byteCount);
+    VerifyCondition(policyManagerB.GetUsage() == 0);
+
+    // Taken by another allocator: the charge moves over, and none of the previous contents do
+    policyManagerB.SetLimit((size_t)-1);
+    VerifyCondition(pool.Take(segmentPoolPageCount, MEM_COMMIT, &ownerB, &policyManagerB, false) == segment);
+    VerifyCondition(policyManagerA.GetUsage() == 0);
+    VerifyCondition(policyManagerB.GetUsage() == byteCount);
+    VerifyCondition(IsFilledWith(segment, segmentPoolPageCount, 0));
+
+    // A runtime going away leaves its pooled segments to the others, uncharged and zeroed for whoever takes them
+    memset(segment, 'b', byteCount);
+    VerifyCondition(pool.Add(segment, segmentPoolPageCount, MEM_COMMIT, &ownerB, &policyManagerB));
+    pool.DetachPolicyManager(&policyManagerB);
+    VerifyCondition(policyManagerB.GetUsage() == 0);
+    VerifyCondition(pool.Take(segmentPoolPageCount, MEM_COMMIT, &ownerA, &policyManagerA, false) == segment);
+    VerifyCondition(policyManagerA.GetUsage() == byteCount);
+    VerifyCondition(IsFilledWith(segment, segmentPoolPageCount, 0));
+
+    policyManagerA.ReportFree(byteCount);
+    VerifyCondition(VirtualFree(segment, 0, MEM_RELEASE));
+    Js::Configuration::Global.flags.PageSegmentPoolPageCount = savedPoolPageCount;
+
+    wprintf(_u("Segment pool test passed\n"));
+}
+
+//////////////////// End segment pool tests ////////////////////
+
+//////////////////// Begin write barrier tests ////////////////////
+
+static bool IsCardDirty(char * address)
+{
+    return RecyclerWriteBarrierManager::GetWriteBarrier(address) != 0;
+}
+
+// Barrier pages are tracked through the card table instead of write watch. A partial collect clears the
+// cards when it starts and again as it rescans each dirty page, so a page must become dirty again on the
+// next write after its card is reset, and resetting one card must leave its neighbors alone.
+static void WriteBarrierCardTest()
+{
+#if defined(RECYCLER_WRITE_BARRIER) && defined(RECYCLER_WRITE_BARRIER_ALLOC_SEPARATE_PAGE)
+    // Large enough to span several pages, all in the same barrier segment
+    RecyclerTestObject * object = BarrierObject<1024, 1024>::New();
+    char * firstPage = (char *)((uintptr_t)object & ~((uintptr_t)AutoSystemInfo::PageSize - 1));
+    char * secondPage = firstPage + AutoSystemInfo::PageSize;
+
+    RecyclerWriteBarrierManager::ResetWriteBarrier(firstPage, 2);
+    VerifyCondition(!IsCardDirty(firstPage));
+    VerifyCondition(!IsCardDirty(secondPage));
+
+    RecyclerWriteBarrierManager::WriteBarrier(firstPage);
+    RecyclerWriteBarrierManager::WriteBarrier(secondPage);
+    VerifyCondition(IsCardDirty(firstPage));
+    VerifyCondition(IsCardDirty(secondPage));
+
+    // Single page reset, as done by Rescan
+    RecyclerWriteBarrierManager::ResetWriteBarrier(firstPage, 1);
+    VerifyCondition(!IsCardDirty(firstPage));
+    VerifyCondition(IsCardDirty(secondPage));
+
+    // A write after the reset dirties the card again
+    RecyclerWriteBarrierManager::WriteBarrier(firstPage + AutoSystemInfo::PageSize - sizeof(void *));
+    VerifyCondition(IsCardDirty(firstPage));
+
+    // Multi-page reset, as done when entering partial collect mode
+    RecyclerWriteBarrierManager::ResetWriteBarrier(firstPage, 2);
+    VerifyCondition(!IsCardDirty(firstPage));
+    VerifyCondition(!IsCardDirty(secondPage));
+
+    RecyclerWriteBarrierManager::WriteBarrier(secondPage);
+    VerifyCondition(!IsCardDirty(firstPage));
+    VerifyCondition(IsCardDirty(secondPage));
+
+    wprintf(_u("Write barrier card test passed\n"));
+#else
+    wprintf(_u("Write barrier card test requires separate barrier pages\n"));
+#endif
+}
+
+//////////////////// End write barrier tests ////////////////////
+
+//////////////////// Begin concurrent GC tests ////////////////////
+
+static const unsigned int concurrentCollectCount = 20;
+static const unsigned int operationsPerConcurrentCollect = 20000;
+
+// Mutate the heap while background marks are in flight, so that the objects reachable only through
+// pointers written during the mark must be found through write watch or the card table. Runs on the
+// heap built by SimpleRecyclerTest; a missed write frees a reachable object and fails the heap walk.
+void ConcurrentCollectSelfTest()
+{
+    WriteBarrierCardTest();
+
+#if ENABLE_CONCURRENT_GC
+    VerifyCondition(recyclerInstance->IsConcurrentEnabled());
+
+    for (unsigned int i = 0; i < concurrentCollectCount; i++)
+    {
+        if (i % 2 == 0)
+        {
+            recyclerInstance->CollectNow<CollectNowConcurrent>();
+        }
+        else
+        {
+            recyclerInstance->CollectNow<CollectNowConcurrentPartial>();
+        }
+
+        for (unsigned int j = 0; j < operationsPerConcurrentCollect; j++)
+        {
+            DoHeapOperation();
+        }
+
+        recyclerInstance->FinishConcurrent<ForceFinishCollection>();
+        WalkHeap();
+        recyclerInstance->FinishDisposeObjectsNow<FinishDispose>();
+    }
+
+    wprintf(_u("Concurrent collect test passed\n"));
+#else
+    wprintf(_u("Concurrent collect test requires concurrent GC support\n"));
+#endif
+    wprintf(_u("==== Self test completed.\n"));
+}
+
+//////////////////// End concurrent GC tests ////////////////////
+
+// The platform checks; the concurrent GC check follows once SimpleRecyclerTest has built its heap
+void SelfTest()
+{
+    ThreadStartTest();
+    WriteWatchTest();
+#ifdef __LINUX__
+    WriteWatchMappingTest();
+#endif
+    SegmentPoolTest();
+}
@@ -42,6 +42,14 @@ inline unsigned int GetRandomInteger(unsigned int limit)
 
 extern Recycler * recyclerInstance;
 
+// Implemented in SelfTest.cpp
+void SelfTest();
+void ConcurrentCollectSelfTest();
+
+// Implemented in GCStress.cpp
+void DoHeapOperation();
+void WalkHeap();
+
 #include "GCStress.h"
 #include "RecyclerTestObject.h"
 
@@ -3,6 +3,7 @@
 // Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
 //-------------------------------------------------------------------------------------------------------
 #include "stdafx.h"
+#include "ChakraCore.h"
 #include "catch.hpp"
 #include <process.h>
 
@@ -1108,6 +1109,230 @@ namespace JsRTApiTest
         JsRTApiTest::RunWithAttributes(JsRTApiTest::ByteCodeWithCallbackTest);
     }
 
+    void CodeCacheRunScript(const char *script, JsValueRef *result)
+    {
+        REQUIRE(JsRunScriptUtf8(script, JS_SOURCE_CONTEXT_NONE, "", result) == JsNoError);
+    }
+
+    void CodeCacheRunInNewRuntime(JsRuntimeAttributes attributes, const char *directory, const char *script, int expected)
+    {
+        JsContextRef current = JS_INVALID_REFERENCE;
+        JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef context = JS_INVALID_REFERENCE;
+        JsValueRef result = JS_INVALID_REFERENCE;
+        int intValue;
+
+        REQUIRE(JsGetCurrentContext(&current) == JsNoError);
+        REQUIRE(JsCreateRuntime(attributes, nullptr, &runtime) == JsNoError);
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, directory) == JsNoError);
+        REQUIRE(JsCreateContext(runtime, &context) == JsNoError);
+        REQUIRE(JsSetCurrentContext(context) == JsNoError);
+
+        CodeCacheRunScript(script, &result);
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == expected);
+
+        REQUIRE(JsSetCurrentContext(current) == JsNoError);
+        REQUIRE(JsDisposeRuntime(runtime) == JsNoError);
+    }
+
+    void CodeCacheTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        const char *script = "function twice(x) { return x * 2; } twice(21);";
+        const char *scriptFnToString = "function twice(x) { return x * 2; } twice.toString();";
+        JsValueRef result = JS_INVALID_REFERENCE;
+        int intValue;
+        const wchar_t *stringValue;
+        size_t stringLength;
+
+        char directory[MAX_PATH];
+        REQUIRE(GetTempPathA(MAX_PATH, directory) != 0);
+        REQUIRE(strcat_s(directory, "ChakraCoreCodeCacheTest") == 0);
+        CreateDirectoryA(directory, nullptr);
+
+        CHECK(JsSetRuntimeCodeCacheDirectory(runtime, nullptr) == JsNoError);
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, directory) == JsNoError);
+
+        // The first run compiles and writes the cache entries, the second one loads them
+        for (int i = 0; i < 2; i++)
+        {
+            CodeCacheRunScript(script, &result);
+            REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+            CHECK(intValue == 42);
+
+            CodeCacheRunScript(scriptFnToString, &result);
+            REQUIRE(JsStringToPointer(result, &stringValue, &stringLength) == JsNoError);
+            CHECK(wcscmp(_u("function twice(x) { return x * 2; }"), stringValue) == 0);
+        }
+
+        // A second runtime maps the entries written by the first one
+        JsContextRef current = JS_INVALID_REFERENCE;
+        JsRuntimeHandle second = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef secondContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&current) == JsNoError);
+        REQUIRE(JsCreateRuntime(attributes, nullptr, &second) == JsNoError);
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(second, directory) == JsNoError);
+        REQUIRE(JsCreateContext(second, &secondContext) == JsNoError);
+        REQUIRE(JsSetCurrentContext(secondContext) == JsNoError);
+
+        CodeCacheRunScript(script, &result);
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == 42);
+
+        REQUIRE(JsSetCurrentContext(current) == JsNoError);
+        REQUIRE(JsDisposeRuntime(second) == JsNoError);
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, nullptr) == JsNoError);
+
+        // An entry whose byte code was damaged on disk is recompiled instead of run. Use a directory of its own,
+        // so the only entry in it is one that no runtime has mapped yet.
+        const char *checksumScript = "function thrice(x) { return x * 3; } thrice(14);";
+        REQUIRE(strcat_s(directory, "/checksum") == 0);
+        CreateDirectoryA(directory, nullptr);
+        CodeCacheRunInNewRuntime(attributes, directory, checksumScript, 42);
+
+        char pattern[MAX_PATH];
+        char entryPath[MAX_PATH];
+        WIN32_FIND_DATAA findData;
+        REQUIRE(sprintf_s(pattern, _countof(pattern), "%s/*.jsbc", directory) > 0);
+        HANDLE find = FindFirstFileA(pattern, &findData);
+        REQUIRE(find != INVALID_HANDLE_VALUE);
+        FindClose(find);
+        REQUIRE(sprintf_s(entryPath, _countof(entryPath), "%s/%s", directory, findData.cFileName) > 0);
+
+        // The entry ends with the byte code image, the source and a null terminator; flip a byte near the end of the image
+        HANDLE file = CreateFileA(entryPath, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        REQUIRE(file != INVALID_HANDLE_VALUE);
+        LONG offset = (LONG)GetFileSize(file, nullptr) - (LONG)strlen(checksumScript) - 1 - 8;
+        byte value = 0;
+        DWORD bytes = 0;
+        REQUIRE(SetFilePointer(file, offset, nullptr, FILE_BEGIN) != INVALID_SET_FILE_POINTER);
+        REQUIRE(ReadFile(file, &value, 1, &bytes, nullptr));
+        value ^= 0x5a;
+        REQUIRE(SetFilePointer(file, offset, nullptr, FILE_BEGIN) != INVALID_SET_FILE_POINTER);
+        REQUIRE(WriteFile(file, &value, 1, &bytes, nullptr));
+        CloseHandle(file);
+
+        CodeCacheRunInNewRuntime(attributes, directory, checksumScript, 42);
+        CodeCacheRunInNewRuntime(attributes, directory, checksumScript, 42);
+    }
+
+    TEST_CASE("ApiTest_CodeCacheTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::CodeCacheTest);
+    }
+
+    void SharedSourceRunScript(const char *script, int expected)
+    {
+        JsValueRef result = JS_INVALID_REFERENCE;
+        int intValue;
+        REQUIRE(JsRunScriptUtf8(script, JS_SOURCE_CONTEXT_NONE, "", &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == expected);
+    }
+
+    void SharedSourceTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // Large enough to be kept compressed; every function but the last one called is deferred
+        std::string script;
+        for (int i = 0; i < 1000; i++)
+        {
+            script += "function f" + std::to_string(i) + "(a) { return a + " + std::to_string(i) + "; }\n";
+        }
+        script += "f1(1);";
+        SharedSourceRunScript(script.c_str(), 2);
+
+        // The first idle call keeps the text that was just decompressed, the second one drops it
+        SharedSourceRunScript("f2(1)", 3);
+        if (attributes & JsRuntimeAttributeEnableIdleProcessing)
+        {
+            unsigned int nextIdleTick;
+            REQUIRE(JsIdle(&nextIdleTick) == JsNoError);
+            REQUIRE(JsIdle(&nextIdleTick) == JsNoError);
+        }
+        SharedSourceRunScript("f3(1)", 4);
+        SharedSourceRunScript("f999.toString() === 'function f999(a) { return a + 999; }' ? 1 : 0", 1);
+
+        // A second runtime loading the same script shares the first one's copy
+        JsContextRef current = JS_INVALID_REFERENCE;
+        JsRuntimeHandle second = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef secondContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&current) == JsNoError);
+        REQUIRE(JsCreateRuntime(attributes, nullptr, &second) == JsNoError);
+        REQUIRE(JsCreateContext(second, &secondContext) == JsNoError);
+        REQUIRE(JsSetCurrentContext(secondContext) == JsNoError);
+
+        SharedSourceRunScript(script.c_str(), 2);
+        SharedSourceRunScript("f500(1)", 501);
+
+        REQUIRE(JsSetCurrentContext(current) == JsNoError);
+        REQUIRE(JsDisposeRuntime(second) == JsNoError);
+
+        // The first runtime still has its reference
+        SharedSourceRunScript("f998(1) + f0.toString().length", 999 + (int)strlen("function f0(a) { return a + 0; }"));
+    }
+
+    TEST_CASE("ApiTest_SharedSourceTest", "[ApiTest]")
+    {
+        JsRTApiTest::WithSetup((JsRuntimeAttributes)(JsRuntimeAttributeShareScriptSource), JsRTApiTest::SharedSourceTest);
+        JsRTApiTest::WithSetup((JsRuntimeAttributes)(JsRuntimeAttributeEnableIdleProcessing | JsRuntimeAttributeShareScriptSource | JsRuntimeAttributeCompressScriptSource),
+            JsRTApiTest::SharedSourceTest);
+    }
+
+    void SharedRegexTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        const char *script =
+            "function count(s) { return s.match(/\\d+/g).length + (new RegExp('^(a|ab)(c|bcd)$').test('abcd') ? 10 : 0); }"
+            "count('1 22 333');";
+        SharedSourceRunScript(script, 13);
+
+        // A second runtime compiling the same regexes gets the programs compiled by the first one
+        JsContextRef current = JS_INVALID_REFERENCE;
+        JsRuntimeHandle second = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef secondContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&current) == JsNoError);
+        REQUIRE(JsCreateRuntime(attributes, nullptr, &second) == JsNoError);
+        REQUIRE(JsCreateContext(second, &secondContext) == JsNoError);
+        REQUIRE(JsSetCurrentContext(secondContext) == JsNoError);
+
+        SharedSourceRunScript(script, 13);
+        SharedSourceRunScript("count('4 55') + (/\\d+/g.exec('x7').index === 1 ? 100 : 0)", 112);
+
+        REQUIRE(JsSetCurrentContext(current) == JsNoError);
+        REQUIRE(JsDisposeRuntime(second) == JsNoError);
+
+        // The first runtime still has its references
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        SharedSourceRunScript("count('6 7 8 9')", 14);
+    }
+
+    TEST_CASE("ApiTest_SharedRegexTest", "[ApiTest]")
+    {
+        JsRTApiTest::WithSetup((JsRuntimeAttributes)(JsRuntimeAttributeShareCompiledRegex), JsRTApiTest::SharedRegexTest);
+    }
+
+    void RegexBacktrackLimitTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // The multiline anchors keep the pattern on the backtracking matcher
+        const char *script =
+            "function run(n) { try { return /^(a+)+$/m.test(Array(n + 1).join('a') + 'b') ? 1 : 0; } catch (e) { return e instanceof RangeError ? 2 : 3; } }"
+            "run(30);";
+        SharedSourceRunScript(script, 2);
+
+        // Within the limit
+        SharedSourceRunScript("run(5)", 0);
+
+        REQUIRE(JsSetRuntimeRegexBacktrackLimit(runtime, 10) == JsNoError);
+        SharedSourceRunScript("run(5)", 2);
+
+        REQUIRE(JsSetRuntimeRegexBacktrackLimit(runtime, 0) == JsNoError);
+        SharedSourceRunScript("run(15)", 0);
+    }
+
+    TEST_CASE("ApiTest_RegexBacktrackLimitTest", "[ApiTest]")
+    {
+        JsRTApiTest::WithSetup((JsRuntimeAttributes)(JsRuntimeAttributeLimitRegexBacktracking), JsRTApiTest::RegexBacktrackLimitTest);
+    }
+
     void ContextCleanupTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
     {
         JsRuntimeHandle rt;
@@ -1613,4 +1838,291 @@ namespace JsRTApiTest
     {
         JsRTApiTest::RunWithAttributes(JsRTApiTest::ScriptTerminationTest);
     }
+
+    void JsonParseUtf8Test(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        const char json[] = "{\"a\":[1,-2.5e1,\"x\\u0041\xC3\xA9\xF0\x9F\x98\x80\"],\"b\":true}";
+        JsValueRef value = JS_INVALID_REFERENCE;
+        REQUIRE(JsParseJsonUtf8(json, strlen(json), &value) == JsNoError);
+
+        JsValueRef global = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        JsPropertyIdRef parsed = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetPropertyIdFromName(_u("parsed"), &parsed) == JsNoError);
+        REQUIRE(JsSetProperty(global, parsed, value, true) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        bool matches = false;
+        REQUIRE(JsRunScript(_u("parsed.b === true && parsed.a[1] === -25 && parsed.a[2] === 'xA\\u00e9\\ud83d\\ude00'"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsBooleanToBool(result, &matches) == JsNoError);
+        CHECK(matches);
+
+        // The buffer does not have to be null terminated
+        double number = 0;
+        REQUIRE(JsParseJsonUtf8("123456", 3, &value) == JsNoError);
+        REQUIRE(JsNumberToDouble(value, &number) == JsNoError);
+        CHECK(number == 123);
+
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsParseJsonUtf8("{\"a\":", 5, &value) == JsErrorScriptException);
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+        REQUIRE(JsParseJsonUtf8("\"\x01\"", 3, &value) == JsErrorScriptException);
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_JsonParseUtf8Test", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::JsonParseUtf8Test);
+    }
+
+    void CheckUtf8Copy(JsValueRef value, const char * expected)
+    {
+        char * copy = nullptr;
+        size_t length = 0;
+        REQUIRE(JsStringToPointerUtf8Copy(value, &copy, &length) == JsNoError);
+        CHECK(length == strlen(expected));
+        CHECK(memcmp(copy, expected, length) == 0);
+        REQUIRE(JsStringFree(copy) == JsNoError);
+    }
+
+    void JsonParseUtf8AsciiStringTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // Plain ASCII values (short, long, empty, object member) next to values that have to be decoded
+        const char json[] = "[\"plain ascii\", \"x\", \"\", {\"key\":\"a value that is longer than thirty-two bytes\"}, \"tab\\t\", \"caf\xC3\xA9\"]";
+        JsValueRef value = JS_INVALID_REFERENCE;
+        REQUIRE(JsParseJsonUtf8(json, strlen(json), &value) == JsNoError);
+
+        JsValueRef index = JS_INVALID_REFERENCE;
+        JsValueRef element = JS_INVALID_REFERENCE;
+        REQUIRE(JsIntToNumber(0, &index) == JsNoError);
+        REQUIRE(JsGetIndexedProperty(value, index, &element) == JsNoError);
+
+        // Read back as UTF-8 straight from the bytes, then again once the string has been widened
+        CheckUtf8Copy(element, "plain ascii");
+        const wchar_t * str = nullptr;
+        size_t length = 0;
+        REQUIRE(JsStringToPointer(element, &str, &length) == JsNoError);
+        CHECK(length == 11);
+        CHECK(!wcscmp(str, _u("plain ascii")));
+        CheckUtf8Copy(element, "plain ascii");
+
+        REQUIRE(JsIntToNumber(5, &index) == JsNoError);
+        REQUIRE(JsGetIndexedProperty(value, index, &element) == JsNoError);
+        CheckUtf8Copy(element, "caf\xC3\xA9");
+
+        JsValueRef global = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        JsPropertyIdRef parsed = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetPropertyIdFromName(_u("parsed"), &parsed) == JsNoError);
+        REQUIRE(JsSetProperty(global, parsed, value, true) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        bool matches = false;
+        REQUIRE(JsRunScript(_u("parsed[1] === 'x' && parsed[2] === '' && parsed[3].key + '!' === 'a value that is longer than thirty-two bytes!' && ")
+            _u("parsed[3].key.length === 44 && parsed[4] === 'tab\\t' && parsed[5] === 'caf\\u00e9' && Object.keys(parsed[3])[0] === 'key'"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsBooleanToBool(result, &matches) == JsNoError);
+        CHECK(matches);
+    }
+
+    TEST_CASE("ApiTest_JsonParseUtf8AsciiStringTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::JsonParseUtf8AsciiStringTest);
+    }
+
+    void JsonParseUtf8BlockBoundaryTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // The UTF-8 scanner classifies whitespace and string bytes 32 at a time. Move escapes and multibyte
+        // characters across the block boundaries, with strings and whitespace runs longer than a block.
+        struct SpecialChar
+        {
+            const char * utf8;
+            const wchar_t * utf16;
+        };
+        const SpecialChar specials[] =
+        {
+            { "", _u("") },
+            { "\\n", _u("\n") },
+            { "\\\"", _u("\"") },
+            { "\\\\", _u("\\") },
+            { "\\u20ac", _u("\x20ac") },
+            { "\xC3\xA9", _u("\xe9") },
+            { "\xE2\x82\xAC", _u("\x20ac") },
+            { "\xF0\x9F\x98\x80", _u("\xd83d\xde00") },
+        };
+        const size_t maxPrefix = 70;
+        const size_t suffix = 33;
+
+        for (size_t i = 0; i < _countof(specials); i++)
+        {
+            for (size_t prefix = 0; prefix <= maxPrefix; prefix++)
+            {
+                char json[256];
+                wchar_t expected[128];
+                size_t jsonLength = 0;
+                size_t expectedLength = 0;
+
+                // Leading whitespace moves the start of the string across the blocks as well
+                for (size_t j = 0; j < prefix % 37; j++)
+                {
+                    json[jsonLength++] = (j % 3 == 0) ? '\n' : ' ';
+                }
+                json[jsonLength++] = '"';
+                for (size_t j = 0; j < prefix; j++)
+                {
+                    json[jsonLength++] = 'a';
+                    expected[expectedLength++] = _u('a');
+                }
+                for (const char * c = specials[i].utf8; *c != '\0'; c++)
+                {
+                    json[jsonLength++] = *c;
+                }
+                for (const wchar_t * c = specials[i].utf16; *c != _u('\0'); c++)
+                {
+                    expected[expectedLength++] = *c;
+                }
+                for (size_t j = 0; j < suffix; j++)
+                {
+                    json[jsonLength++] = 'b';
+                    expected[expectedLength++] = _u('b');
+                }
+                json[jsonLength++] = '"';
+                for (size_t j = 0; j < suffix; j++)
+                {
+                    json[jsonLength++] = ' ';
+                }
+
+                JsValueRef value = JS_INVALID_REFERENCE;
+                REQUIRE(JsParseJsonUtf8(json, jsonLength, &value) == JsNoError);
+
+                const wchar_t * str = nullptr;
+                size_t length = 0;
+                REQUIRE(JsStringToPointer(value, &str, &length) == JsNoError);
+                REQUIRE(length == expectedLength);
+                CHECK(memcmp(str, expected, length * sizeof(wchar_t)) == 0);
+            }
+        }
+    }
+
+    TEST_CASE("ApiTest_JsonParseUtf8BlockBoundaryTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::JsonParseUtf8BlockBoundaryTest);
+    }
+
+    void JsonStringifyUtf8Test(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef value = JS_INVALID_REFERENCE;
+        char * json = nullptr;
+        size_t length = 0;
+
+        // Escapes and characters outside the BMP are written as UTF-8
+        REQUIRE(JsRunScript(_u("({ a: [1, -2.5, 'x\"\\n\\u00e9\\ud83d\\ude00'], b: true, c: undefined, d: null })"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyJsonUtf8(value, &json, &length) == JsNoError);
+        const char expected[] = "{\"a\":[1,-2.5,\"x\\\"\\n\xC3\xA9\xF0\x9F\x98\x80\"],\"b\":true,\"d\":null}";
+        REQUIRE(json != nullptr);
+        CHECK(length == strlen(expected));
+        CHECK(strcmp(json, expected) == 0);
+        REQUIRE(JsStringFree(json) == JsNoError);
+
+        // No JSON representation
+        REQUIRE(JsGetUndefinedValue(&value) == JsNoError);
+        json = (char *)1;
+        REQUIRE(JsStringifyJsonUtf8(value, &json, &length) == JsNoError);
+        CHECK(json == nullptr);
+        CHECK(length == 0);
+
+        // An output that grows the buffer many times has to match JSON.stringify
+        REQUIRE(JsRunScript(_u("var big = []; for (var i = 0; i < 20000; i++) { big.push({ id: i, name: 'item\\u00e9' + i, tags: ['a', 'b'] }); } big"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyJsonUtf8(value, &json, &length) == JsNoError);
+        REQUIRE(json != nullptr);
+        CHECK(json[length] == '\0');
+
+        JsValueRef stringified = JS_INVALID_REFERENCE;
+        char * expectedBig = nullptr;
+        size_t expectedBigLength = 0;
+        REQUIRE(JsRunScript(_u("JSON.stringify(big)"), JS_SOURCE_CONTEXT_NONE, _u(""), &stringified) == JsNoError);
+        REQUIRE(JsStringToPointerUtf8Copy(stringified, &expectedBig, &expectedBigLength) == JsNoError);
+        CHECK(length == expectedBigLength);
+        CHECK(memcmp(json, expectedBig, length) == 0);
+        REQUIRE(JsStringFree(expectedBig) == JsNoError);
+        REQUIRE(JsStringFree(json) == JsNoError);
+
+        // Cycles throw a TypeError, and the next call works again
+        REQUIRE(JsRunScript(_u("var cyclic = { a: [] }; cyclic.a.push(cyclic); cyclic"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyJsonUtf8(value, &json, &length) == JsErrorScriptException);
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+
+        REQUIRE(JsRunScript(_u("[cyclic.a.length]"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyJsonUtf8(value, &json, &length) == JsNoError);
+        REQUIRE(json != nullptr);
+        CHECK(strcmp(json, "[1]") == 0);
+        REQUIRE(JsStringFree(json) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_JsonStringifyUtf8Test", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::JsonStringifyUtf8Test);
+    }
+
+    bool InterpreterProfileCheck(JsValueRef profile, const char16 *check)
+    {
+        JsValueRef global = JS_INVALID_REFERENCE;
+        JsPropertyIdRef propertyId = JS_INVALID_PROPERTYID;
+        JsValueRef result = JS_INVALID_REFERENCE;
+        bool boolValue = false;
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(_u("profile"), &propertyId) == JsNoError);
+        REQUIRE(JsSetProperty(global, propertyId, profile, true) == JsNoError);
+        REQUIRE(JsRunScript(check, JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsBooleanToBool(result, &boolValue) == JsNoError);
+        return boolValue;
+    }
+
+    void InterpreterProfileTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef profile = JS_INVALID_REFERENCE;
+        JsValueRef result = JS_INVALID_REFERENCE;
+
+        JsErrorCode errorCode = JsDiagStartInterpreterProfile(runtime, JsDiagInterpreterProfileAttributeNone, 0);
+        if (errorCode == JsErrorNotImplemented)
+        {
+            // Only builds with ENABLE_INTERPRETER_OPCODE_PROFILE (build.sh --interpreter-profile) have the profiler
+            CHECK(JsDiagGetInterpreterProfile(&profile) == JsErrorNotImplemented);
+            return;
+        }
+        REQUIRE(errorCode == JsNoError);
+        CHECK(JsDiagStartInterpreterProfile(runtime, (JsDiagInterpreterProfileAttributes)0x100, 0) == JsErrorInvalidArgument);
+
+        // Counts only: opcodes and functions, no pair table
+        REQUIRE(JsRunScript(_u("function profiledFunction(n) { var s = 0; for (var i = 0; i < n; i++) { s += i; } return s; } profiledFunction(100);"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsDiagStopInterpreterProfile(runtime) == JsNoError);
+        REQUIRE(JsDiagGetInterpreterProfile(&profile) == JsNoError);
+        CHECK(InterpreterProfileCheck(profile, _u("profile.sampleInterval === 0 && profile.opcodes.length > 0 && profile.pairs.length === 0")));
+        CHECK(InterpreterProfileCheck(profile, _u("var profiledCount = profile.functions.filter(function (f) { return f.name === 'profiledFunction'; })[0].count; profiledCount > 0")));
+
+        // A stopped profile keeps its results and doesn't count any further
+        REQUIRE(JsRunScript(_u("profiledFunction(100);"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsDiagGetInterpreterProfile(&profile) == JsNoError);
+        CHECK(InterpreterProfileCheck(profile, _u("profile.functions.filter(function (f) { return f.name === 'profiledFunction'; })[0].count === profiledCount")));
+
+        // Pairs and timing samples on request
+        REQUIRE(JsDiagStartInterpreterProfile(runtime, JsDiagInterpreterProfileAttributeCountPairs, 1) == JsNoError);
+        REQUIRE(JsRunScript(_u("profiledFunction(100);"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsDiagStopInterpreterProfile(runtime) == JsNoError);
+        REQUIRE(JsDiagGetInterpreterProfile(&profile) == JsNoError);
+        CHECK(InterpreterProfileCheck(profile, _u("profile.sampleInterval === 1 && profile.pairs.length > 0 && profile.pairs.every(function (p) { return p.count > 0 && typeof p.second === 'string'; })")));
+        CHECK(InterpreterProfileCheck(profile, _u("profile.opcodes.some(function (o) { return o.sampledCount > 0; })")));
+
+        // Per function entries are capped; the rest share one entry
+        REQUIRE(JsDiagStartInterpreterProfile(runtime, JsDiagInterpreterProfileAttributeNone, 0) == JsNoError);
+        REQUIRE(JsRunScript(_u("for (var i = 0; i < 5000; i++) { (new Function('return ' + i))(); }"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsDiagStopInterpreterProfile(runtime) == JsNoError);
+        REQUIRE(JsDiagGetInterpreterProfile(&profile) == JsNoError);
+        CHECK(InterpreterProfileCheck(profile, _u("profile.functions.length <= 4097 && profile.functions.some(function (f) { return f.name === '(other)' && f.count > 0; })")));
+    }
+
+    TEST_CASE("ApiTest_InterpreterProfileTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::InterpreterProfileTest);
+    }
 }
@@ -4,10 +4,19 @@
 //-------------------------------------------------------------------------------------------------------
 
 #ifdef FLAG
+FLAG(BSTR, CodeCache,                       "Cache the byte code of utf8 scripts in the given (existing) directory", NULL)
+FLAG(bool, CompressSource,                  "With -ShareSource, keep large scripts compressed until their text is needed", false)
 FLAG(BSTR, dbgbaseline,                     "Baseline file to compare debugger output", NULL)
 FLAG(bool, DebugLaunch,                     "Create the test debugger and execute test in the debug mode", false)
 FLAG(BSTR, GenerateLibraryByteCodeHeader,   "Generate bytecode header file from library code", NULL)
+FLAG(bool, Idle,                            "Enable idle processing and call JsIdle after the script and after each round of queued tasks", false)
 FLAG(int,  InspectMaxStringLength,          "Max string length to dump in locals inspection", 16)
+FLAG(BSTR, InterpreterProfile,              "Profile interpreted opcodes and write the counts to the given CSV file at exit", NULL)
+FLAG(bool, InterpreterProfilePairs,         "With -InterpreterProfile, also count adjacent opcode pairs", false)
+FLAG(int,  InterpreterProfileSampleInterval, "With -InterpreterProfile, also time one in every N interpreted opcodes (0 = counts only)", 0)
+FLAG(bool, LimitRegexBacktracking,          "Throw a RangeError from regex matches taking more than -RegexBacktrackLimit backtracking steps", false)
 FLAG(BSTR, Serialized,                      "If source is UTF8, deserializes from bytecode file", NULL)
+FLAG(bool, ShareRegex,                      "Compile regexes into the process-wide cache shared by all runtimes", false)
+FLAG(bool, ShareSource,                     "Keep script source in the process-wide store shared by all runtimes", false)
 #undef FLAG
 #endif
@@ -199,6 +199,160 @@ Error:
     return hr;
 }
 
+static HRESULT GetInterpreterProfileField(JsValueRef object, const char *name, JsValueRef *value)
+{
+    JsPropertyIdRef propertyId = JS_INVALID_REFERENCE;
+    IfJsrtErrorFail(ChakraRTInterface::JsGetPropertyIdFromNameUtf8(name, &propertyId), E_FAIL);
+    IfJsrtErrorFail(ChakraRTInterface::JsGetProperty(object, propertyId, value), E_FAIL);
+    return S_OK;
+}
+
+static HRESULT GetInterpreterProfileNumber(JsValueRef object, const char *name, double *value)
+{
+    HRESULT hr = S_OK;
+    JsValueRef numberValue = JS_INVALID_REFERENCE;
+    *value = 0;
+    IfFailedReturn(GetInterpreterProfileField(object, name, &numberValue));
+    IfJsrtErrorFail(ChakraRTInterface::JsNumberToDouble(numberValue, value), E_FAIL);
+    return S_OK;
+}
+
+static HRESULT GetInterpreterProfileString(JsValueRef object, const char *name, char **value)
+{
+    HRESULT hr = S_OK;
+    JsValueRef stringValue = JS_INVALID_REFERENCE;
+    size_t length = 0;
+    IfFailedReturn(GetInterpreterProfileField(object, name, &stringValue));
+    IfJsrtErrorFail(ChakraRTInterface::JsStringToPointerUtf8Copy(stringValue, value, &length), E_FAIL);
+    return S_OK;
+}
+
+// Appends one row per element of profile[arrayName] to the -InterpreterProfile CSV file.
+// Rows are "kind,name,second,count,sampledCount,sampledCycles,line,column"; fields a kind doesn't have are left empty.
+static HRESULT WriteInterpreterProfileRows(HANDLE csvFileHandle, JsValueRef profile, const char *kind, const char *arrayName)
+{
+    HRESULT hr = S_OK;
+    JsValueRef rows = JS_INVALID_REFERENCE;
+    double length = 0;
+    IfFailedReturn(GetInterpreterProfileField(profile, arrayName, &rows));
+    IfFailedReturn(GetInterpreterProfileNumber(rows, "length", &length));
+
+    const bool isPair = strcmp(kind, "pair") == 0;
+    const bool isFunction = strcmp(kind, "function") == 0;
+    for (unsigned int i = 0; i < (unsigned int)length; i++)
+    {
+        JsValueRef index = JS_INVALID_REFERENCE;
+        JsValueRef row = JS_INVALID_REFERENCE;
+        IfJsrtErrorFail(ChakraRTInterface::JsDoubleToNumber(i, &index), E_FAIL);
+        IfJsrtErrorFail(ChakraRTInterface::JsGetIndexedProperty(rows, index, &row), E_FAIL);
+
+        AutoString name;
+        AutoString second;
+        double count = 0, sampledCount = 0, sampledCycles = 0, line = 0, column = 0;
+        IfFailedReturn(GetInterpreterProfileString(row, "name", &name));
+        IfFailedReturn(GetInterpreterProfileNumber(row, "count", &count));
+        if (isPair)
+        {
+            IfFailedReturn(GetInterpreterProfileString(row, "second", &second));
+        }
+        else
+        {
+            IfFailedReturn(GetInterpreterProfileNumber(row, "sampledCount", &sampledCount));
+            IfFailedReturn(GetInterpreterProfileNumber(row, "sampledCycles", &sampledCycles));
+        }
+        if (isFunction)
+        {
+            IfFailedReturn(GetInterpreterProfileNumber(row, "line", &line));
+            IfFailedReturn(GetInterpreterProfileNumber(row, "column", &column));
+        }
+
+        // Function names are quoted (doubling any quote inside); opcode names never need it
+        char quotedName[512];
+        size_t nameLength = 0;
+        const char *nameChars = *name;
+        if (isFunction)
+        {
+            quotedName[nameLength++] = '"';
+            for (; *nameChars != '\0' && nameLength < sizeof(quotedName) - 3; nameChars++)
+            {
+                if (*nameChars == '"')
+                {
+                    quotedName[nameLength++] = '"';
+                }
+                quotedName[nameLength++] = *nameChars;
+            }
+            quotedName[nameLength++] = '"';
+        }
+        else
+        {
+            for (; *nameChars != '\0' && nameLength < sizeof(quotedName) - 1; nameChars++)
+            {
+                quotedName[nameLength++] = *nameChars;
+            }
+        }
+        quotedName[nameLength] = '\0';
+
+        char csvRow[1024];
+        if (isPair)
+        {
+            _snprintf_s(csvRow, sizeof(csvRow), _TRUNCATE, "%s,%s,%s,%.0f,,,,\n", kind, quotedName, *second, count);
+        }
+        else if (isFunction)
+        {
+            _snprintf_s(csvRow, sizeof(csvRow), _TRUNCATE, "%s,%s,,%.0f,%.0f,%.0f,%.0f,%.0f\n", kind, quotedName, count, sampledCount, sampledCycles, line, column);
+        }
+        else
+        {
+            _snprintf_s(csvRow, sizeof(csvRow), _TRUNCATE, "%s,%s,,%.0f,%.0f,%.0f,,\n", kind, quotedName, count, sampledCount, sampledCycles);
+        }
+
+        DWORD written;
+        if (!WriteFile(csvFileHandle, csvRow, (DWORD)strlen(csvRow), &written, nullptr))
+        {
+            return E_FAIL;
+        }
+    }
+
+    return S_OK;
+}
+
+// Writes the runtime's interpreter opcode profile (see JsDiagGetInterpreterProfile) to csvFullPath.
+HRESULT WriteInterpreterProfile(LPCWSTR csvFullPath)
+{
+    HRESULT hr = S_OK;
+    HANDLE csvFileHandle = INVALID_HANDLE_VALUE;
+    JsValueRef profile = JS_INVALID_REFERENCE;
+    DWORD written;
+    const char *header = "kind,name,second,count,sampledCount,sampledCycles,line,column\n";
+
+    JsErrorCode errorCode = ChakraRTInterface::JsDiagGetInterpreterProfile(&profile);
+    if (errorCode == JsErrorNotImplemented)
+    {
+        fwprintf(stderr, _u("-InterpreterProfile requires ChakraCore built with the interpreter profiler (build.sh --interpreter-profile)\n"));
+        return E_FAIL;
+    }
+    IfJsrtErrorHR(errorCode);
+
+    csvFileHandle = CreateFile(csvFullPath, GENERIC_WRITE, FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (csvFileHandle == INVALID_HANDLE_VALUE)
+    {
+        return E_FAIL;
+    }
+
+    IfFalseGo(WriteFile(csvFileHandle, header, (DWORD)strlen(header), &written, nullptr));
+    IfFailGo(WriteInterpreterProfileRows(csvFileHandle, profile, "opcode", "opcodes"));
+    IfFailGo(WriteInterpreterProfileRows(csvFileHandle, profile, "pair", "pairs"));
+    IfFailGo(WriteInterpreterProfileRows(csvFileHandle, profile, "function", "functions"));
+
+Error:
+    if (csvFileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(csvFileHandle);
+    }
+
+    return hr;
+}
+
 static void CALLBACK PromiseContinuationCallback(JsValueRef task, void *callbackState)
 {
     Assert(task != JS_INVALID_REFERENCE);
@@ -339,6 +493,11 @@ HRESULT RunScript(const char* fileName, LPCSTR fileContents, BYTE *bcBuffer, cha
             // because setTimeout can add scripts to execute.
             do
             {
+                if (HostConfigFlags::flags.Idle)
+                {
+                    unsigned int nextIdleTick;
+                    IfJsErrorFailLog(ChakraRTInterface::JsIdle(&nextIdleTick));
+                }
                 IfFailGo(messageQueue->ProcessAll(fileName));
             } while(!messageQueue->IsEmpty());
         }
@@ -482,6 +641,30 @@ HRESULT ExecuteTest(const char* fileName)
             jsrtAttributes = (JsRuntimeAttributes)(jsrtAttributes | JsRuntimeAttributeSerializeLibraryByteCode);
         }
 
+        if (HostConfigFlags::flags.ShareSource)
+        {
+            jsrtAttributes = (JsRuntimeAttributes)(jsrtAttributes | JsRuntimeAttributeShareScriptSource);
+            if (HostConfigFlags::flags.CompressSource)
+            {
+                jsrtAttributes = (JsRuntimeAttributes)(jsrtAttributes | JsRuntimeAttributeCompressScriptSource);
+            }
+        }
+
+        if (HostConfigFlags::flags.ShareRegex)
+        {
+            jsrtAttributes = (JsRuntimeAttributes)(jsrtAttributes | JsRuntimeAttributeShareCompiledRegex);
+        }
+
+        if (HostConfigFlags::flags.LimitRegexBacktracking)
+        {
+            jsrtAttributes = (JsRuntimeAttributes)(jsrtAttributes | JsRuntimeAttributeLimitRegexBacktracking);
+        }
+
+        if (HostConfigFlags::flags.Idle)
+        {
+            jsrtAttributes = (JsRuntimeAttributes)(jsrtAttributes | JsRuntimeAttributeEnableIdleProcessing);
+        }
+
 #if ENABLE_TTD
         if (doTTRecord)
         {
@@ -533,11 +716,27 @@ HRESULT ExecuteTest(const char* fileName)
         ChakraRTInterface::SetCheckOpHelpersFlag(true);
 #endif
 
+        if (HostConfigFlags::flags.CodeCacheIsEnabled && HostConfigFlags::flags.CodeCache != nullptr)
+        {
+            char* codeCacheDirectory = nullptr;
+            IfFailGo(WideStringToNarrowDynamic(HostConfigFlags::flags.CodeCache, &codeCacheDirectory));
+            JsErrorCode errorCode = ChakraRTInterface::JsSetRuntimeCodeCacheDirectory(runtime, codeCacheDirectory);
+            free(codeCacheDirectory);
+            IfJsErrorFailLog(errorCode);
+        }
+
         if (!WScriptJsrt::Initialize())
         {
             IfFailGo(E_FAIL);
         }
 
+        if (HostConfigFlags::flags.InterpreterProfileIsEnabled)
+        {
+            JsDiagInterpreterProfileAttributes profileAttributes = HostConfigFlags::flags.InterpreterProfilePairs ?
+                JsDiagInterpreterProfileAttributeCountPairs : JsDiagInterpreterProfileAttributeNone;
+            IfJsErrorFailLog(ChakraRTInterface::JsDiagStartInterpreterProfile(runtime, profileAttributes, HostConfigFlags::flags.InterpreterProfileSampleInterval));
+        }
+
         if (_fullpath(fullPath, fileName, _MAX_PATH) == nullptr)
         {
             IfFailGo(E_FAIL);
@@ -583,6 +782,15 @@ Error:
         Debugger::CloseDebugger();
     }
 
+    if (HostConfigFlags::flags.InterpreterProfileIsEnabled && runtime != JS_INVALID_RUNTIME_HANDLE)
+    {
+        if (HostConfigFlags::flags.InterpreterProfile == nullptr || *HostConfigFlags::flags.InterpreterProfile == _u('\0') ||
+            FAILED(WriteInterpreterProfile(HostConfigFlags::flags.InterpreterProfile)))
+        {
+            fwprintf(stderr, _u("ERROR: failed to write the interpreter profile, use -InterpreterProfile:<csv file name>\n"));
+        }
+    }
+
     ChakraRTInterface::JsSetCurrentContext(nullptr);
 
     if (runtime != JS_INVALID_RUNTIME_HANDLE)
@@ -25,6 +25,13 @@ PRINT_USAGE() {
     echo "  -d, --debug         Debug build (by default Release build)"
     echo "  -h, --help          Show help"
     echo "      --icu=PATH      Path to ICU include folder (see example below)"
+    echo "      --jit           Build with the JIT enabled (experimental on Linux)"
+    echo "      --switch-dispatch"
+    echo "                      Dispatch interpreter and regex opcodes with a switch"
+    echo "                      instead of computed goto."
+    echo "      --interpreter-profile"
+    echo "                      Build with the interpreter opcode profiler"
+    echo "                      (see JsDiagStartInterpreterProfile)."
     echo "  -j [N], --jobs[=N]  Multicore build, allow N jobs at once"
     echo "  -n, --ninja         Build with ninja instead of make"
     echo "      --xcode         Generate XCode project"
@@ -53,6 +60,9 @@ MULTICORE_BUILD=""
 ICU_PATH=""
 STATIC_LIBRARY=""
 WITHOUT_FEATURES=""
+ENABLE_JIT=""
+SWITCH_DISPATCH=""
+INTERPRETER_PROFILE=""
 
 while [[ $# -gt 0 ]]; do
     case "$1" in
@@ -120,6 +130,18 @@ while [[ $# -gt 0 ]]; do
         STATIC_LIBRARY="-DSTATIC_LIBRARY=1"
         ;;
 
+    --jit)
+        ENABLE_JIT="-DENABLE_JIT=1"
+        ;;
+
+    --switch-dispatch)
+        SWITCH_DISPATCH="-DSWITCH_DISPATCH=1"
+        ;;
+
+    --interpreter-profile)
+        INTERPRETER_PROFILE="-DINTERPRETER_PROFILE=1"
+        ;;
+
     --without=*)
         FEATURES=$1
         FEATURES=${FEATURES:10}    # value after --without=
@@ -154,6 +176,9 @@ if [[ ${#_VERBOSE} > 0 ]]; then
     echo "ICU_PATH=${ICU_PATH}"
     echo "CMAKE_GEN=${CMAKE_GEN}"
     echo "MAKE=${MAKE}"
+    echo "ENABLE_JIT=${ENABLE_JIT}"
+    echo "SWITCH_DISPATCH=${SWITCH_DISPATCH}"
+    echo "INTERPRETER_PROFILE=${INTERPRETER_PROFILE}"
     echo ""
 fi
 
@@ -214,7 +239,7 @@ fi
 pushd $build_directory > /dev/null
 
 echo Generating $BUILD_TYPE makefiles
-cmake $CMAKE_GEN $CC_PREFIX $ICU_PATH $STATIC_LIBRARY -DCMAKE_BUILD_TYPE=$BUILD_TYPE $WITHOUT_FEATURES ../..
+cmake $CMAKE_GEN $CC_PREFIX $ICU_PATH $STATIC_LIBRARY $ENABLE_JIT $SWITCH_DISPATCH $INTERPRETER_PROFILE -DCMAKE_BUILD_TYPE=$BUILD_TYPE $WITHOUT_FEATURES ../..
 
 _RET=$?
 if [[ $? == 0 ]]; then
@@ -189,11 +189,21 @@ public:
 #if _M_X64 || _M_ARM
     size_t RecordUnwindInfo(size_t offset, BYTE *unwindInfo, size_t size)
     {
-#if _M_X64
+#if _M_X64 && PDATA_ENABLED
         Assert(offset == 0);
         Assert(XDATA_SIZE >= size);
         js_memcpy_s(GetAllocation()->allocation->xdata.address, XDATA_SIZE, unwindInfo, size);
         return 0;
+#elif _M_X64
+        // No xdata here: keep the .eh_frame alive with the allocation and hand it to the system unwinder.
+        Assert(offset == 0);
+        EmitBufferAllocation *allocation = GetAllocation();
+        Assert(allocation->ehFrame == nullptr);
+        allocation->ehFrame = HeapNewArray(BYTE, size);
+        allocation->ehFrameSize = size;
+        js_memcpy_s(allocation->ehFrame, size, unwindInfo, size);
+        PDataManager::RegisterEhFrame(allocation->ehFrame);
+        return 0;
 #else
         BYTE *xdataFinal = GetAllocation()->allocation->xdata.address + offset;
 
@@ -71,6 +71,9 @@ EmitBufferManager<SyncObject>::FreeAllocations(bool release)
             CheckBufferPermissions(allocation);
         }
 #endif
+        // Decommitted code can't be unwound either
+        this->FreeUnwindInfo(allocation);
+
         if (release)
         {
             this->allocationHeap.Free(allocation->allocation);
@@ -94,6 +97,21 @@ EmitBufferManager<SyncObject>::FreeAllocations(bool release)
     }
 }
 
+template <typename SyncObject>
+void
+EmitBufferManager<SyncObject>::FreeUnwindInfo(EmitBufferAllocation * allocation)
+{
+#if !PDATA_ENABLED && defined(_M_X64)
+    if (allocation->ehFrame != nullptr)
+    {
+        PDataManager::UnregisterEhFrame(allocation->ehFrame);
+        HeapDeleteArray(allocation->ehFrameSize, allocation->ehFrame);
+        allocation->ehFrame = nullptr;
+        allocation->ehFrameSize = 0;
+    }
+#endif
+}
+
 template <typename SyncObject>
 bool EmitBufferManager<SyncObject>::IsInHeap(__in void* address)
 {
@@ -173,6 +191,10 @@ EmitBufferManager<SyncObject>::NewAllocation(size_t bytes, ushort pdataCount, us
     allocation->bytesUsed = 0;
     allocation->nextAllocation = this->allocations;
     allocation->recorded = false;
+#if !PDATA_ENABLED && defined(_M_X64)
+    allocation->ehFrame = nullptr;
+    allocation->ehFrameSize = 0;
+#endif
 
     this->allocations = allocation;
 
@@ -215,6 +237,8 @@ EmitBufferManager<SyncObject>::FreeAllocation(void* address)
 
             VerboseHeapTrace(_u("Freeing 0x%p, allocation: 0x%p\n"), address, allocation->allocation->address);
 
+            this->FreeUnwindInfo(allocation);
+
             this->allocationHeap.Free(allocation->allocation);
             this->allocator->Free(allocation, sizeof(EmitBufferAllocation));
 
@@ -14,6 +14,11 @@ struct EmitBufferAllocation
     size_t bytesCommitted;
     bool   recorded;
     EmitBufferAllocation * nextAllocation;
+#if !PDATA_ENABLED && defined(_M_X64)
+    // Registered .eh_frame copy for the code in this allocation (see CodeGenWorkItem::RecordUnwindInfo)
+    BYTE * ehFrame;
+    size_t ehFrameSize;
+#endif
 
     BYTE * GetUnused() const            { return (BYTE*) allocation->address + bytesUsed; }
     BYTE * GetUncommitted() const       { return (BYTE*) allocation->address + bytesCommitted; }
@@ -63,6 +68,7 @@ public:
 
 private:
     void FreeAllocations(bool release);
+    void FreeUnwindInfo(EmitBufferAllocation * allocation);
 
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     bool CheckCommitFaultInjection();
@@ -267,7 +267,7 @@ Encoder::Encode()
 
     ushort xdataSize;
     ushort pdataCount;
-#ifdef _M_X64
+#if defined(_M_X64) && PDATA_ENABLED
     pdataCount = 1;
     xdataSize = (ushort)m_func->m_prologEncoder.SizeOfUnwindInfo();
 #elif _M_ARM
@@ -297,9 +297,12 @@ Encoder::Encode()
 
     m_func->GetScriptContext()->GetThreadContext()->SetValidCallTargetForCFG((PVOID) workItem->GetCodeAddress());
 
-#ifdef _M_X64
+#if defined(_M_X64) && PDATA_ENABLED
     m_func->m_prologEncoder.FinalizeUnwindInfo();
     workItem->RecordUnwindInfo(0, m_func->m_prologEncoder.GetUnwindInfo(), m_func->m_prologEncoder.SizeOfUnwindInfo());
+#elif defined(_M_X64)
+    m_func->m_prologEncoder.FinalizeEhFrame((BYTE *)workItem->GetCodeAddress(), (DWORD)codeSize);
+    workItem->RecordUnwindInfo(0, m_func->m_prologEncoder.GetEhFrame(), m_func->m_prologEncoder.SizeOfEhFrame());
 #elif _M_ARM
     m_func->m_unwindInfo.EmitUnwindInfo(workItem);
     workItem->SetCodeAddress(workItem->GetCodeAddress() | 0x1); // Set thumb mode
@@ -452,22 +452,22 @@ LowererMD::LowerLeaveNull(IR::Instr *finallyEndInstr)
 #if _M_X64
     {
         // amd64_ReturnFromCallWithFakeFrame expects to find the spill size and args size
-        // in r8 and r9.
+        // in r8 and r9 (rdx and rcx on System V).
 
         // MOV r8, spillSize
         IR::Instr *movR8 = IR::Instr::New(Js::OpCode::LdSpillSize,
-                                          IR::RegOpnd::New(nullptr, RegR8, TyMachReg, m_func),
+                                          IR::RegOpnd::New(nullptr, LowererMDArch::GetRegFakeFrameSpillSize(), TyMachReg, m_func),
                                           m_func);
         finallyEndInstr->InsertBefore(movR8);
 
 
         // MOV r9, argsSize
         IR::Instr *movR9 = IR::Instr::New(Js::OpCode::LdArgSize,
-                                          IR::RegOpnd::New(nullptr, RegR9, TyMachReg, m_func),
+                                          IR::RegOpnd::New(nullptr, LowererMDArch::GetRegFakeFrameArgsSize(), TyMachReg, m_func),
                                           m_func);
         finallyEndInstr->InsertBefore(movR9);
 
-        IR::Opnd *targetOpnd = IR::RegOpnd::New(nullptr, RegRCX, TyMachReg, m_func);
+        IR::Opnd *targetOpnd = IR::RegOpnd::New(nullptr, LowererMDArch::GetRegFakeFrameReturnTarget(), TyMachReg, m_func);
         IR::Instr *movTarget = IR::Instr::New(Js::OpCode::MOV,
             targetOpnd,
             IR::HelperCallOpnd::New(IR::HelperOp_ReturnFromCallWithFakeFrame, m_func),
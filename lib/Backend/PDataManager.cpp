@@ -48,4 +48,22 @@ void PDataManager::UnregisterPdata(RUNTIME_FUNCTION* pdata)
         Assert(success);
     }
 }
+#elif defined(_M_X64)
+
+// libgcc's frame registry: takes the start of an .eh_frame list terminated by a zero length entry.
+// (LLVM libunwind, as used on macOS, expects a single FDE instead.)
+extern "C" void __register_frame(void* begin);
+extern "C" void __deregister_frame(void* begin);
+
+void PDataManager::RegisterEhFrame(BYTE* ehFrame)
+{
+    Assert(ehFrame != nullptr);
+    __register_frame(ehFrame);
+}
+
+void PDataManager::UnregisterEhFrame(BYTE* ehFrame)
+{
+    Assert(ehFrame != nullptr);
+    __deregister_frame(ehFrame);
+}
 #endif
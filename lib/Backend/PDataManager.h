@@ -13,4 +13,15 @@ public:
     static void UnregisterPdata(RUNTIME_FUNCTION* pdata);
 };
 
+#elif defined(_M_X64)
+
+// Without PDATA, jitted frames are described to the system unwinder with DWARF .eh_frame data
+// (see PrologEncoder::FinalizeEhFrame).
+class PDataManager
+{
+public:
+    static void RegisterEhFrame(BYTE* ehFrame);
+    static void UnregisterEhFrame(BYTE* ehFrame);
+};
+
 #endif
@@ -5,6 +5,24 @@
 #include "Backend.h"
 #include "PrologEncoderMD.h"
 
+#ifndef _WIN32
+// DWARF call frame instruction opcodes and register numbers (System V AMD64 ABI, figure 3.36)
+enum : BYTE
+{
+    DW_CFA_nop              = 0x00,
+    DW_CFA_advance_loc1     = 0x02,
+    DW_CFA_def_cfa          = 0x0c,
+    DW_CFA_def_cfa_offset   = 0x0e,
+    DW_CFA_advance_loc      = 0x40,
+    DW_CFA_offset           = 0x80,
+};
+
+// Indexed by the machine encoding returned from PrologEncoderMD::GetNonVolRegToSave
+static const BYTE DwarfRegNum[16] = { 0, 2, 1, 3, 7, 6, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15 };
+static const BYTE DwarfRegRSP = 7;
+static const BYTE DwarfRegReturnAddress = 16;
+#endif
+
 void PrologEncoder::RecordNonVolRegSave()
 {
     requiredUnwindCodeNodeCount++;
@@ -71,6 +89,15 @@ void PrologEncoder::EncodeInstr(IR::Instr *instr, unsigned __int8 size)
 
     Assert(pdata);
 
+#ifndef _WIN32
+    if (!cfiInstrs)
+    {
+        // Each unwind code needs at most an advance, a CFA offset and a register save.
+        cfiInstrCapacity = (requiredUnwindCodeNodeCount + 1) * 8;
+        cfiInstrs = (BYTE *)alloc->Alloc(cfiInstrCapacity);
+    }
+#endif
+
     UnwindCode       *unwindCode       = nullptr;
     unsigned __int8   unwindCodeOp     = PrologEncoderMD::GetOp(instr);
     unsigned __int8   unwindCodeOpInfo = 0;
@@ -89,11 +116,17 @@ void PrologEncoder::EncodeInstr(IR::Instr *instr, unsigned __int8 size)
     {
         unwindCode = GetUnwindCode(1);
         unwindCodeOpInfo = PrologEncoderMD::GetNonVolRegToSave(instr);
+#ifndef _WIN32
+        RecordCfiPush(unwindCodeOpInfo);
+#endif
         break;
     }
 
     case UWOP_SAVE_XMM128:
     {
+#ifndef _WIN32
+        AssertMsg(false, "System V has no callee-saved xmm registers to describe in the .eh_frame.");
+#endif
         unwindCode       = GetUnwindCode(2);
         unwindCodeOpInfo = PrologEncoderMD::GetXmmRegToSave(instr, &uint16Val);
 
@@ -109,6 +142,9 @@ void PrologEncoder::EncodeInstr(IR::Instr *instr, unsigned __int8 size)
         size_t slots = (allocaSize - MachPtr) / MachPtr;
         Assert(IS_UNIBBLE(slots));
         unwindCodeOpInfo = TO_UNIBBLE(slots);
+#ifndef _WIN32
+        RecordCfiAlloca(allocaSize);
+#endif
         break;
     }
 
@@ -120,6 +156,9 @@ void PrologEncoder::EncodeInstr(IR::Instr *instr, unsigned __int8 size)
         Assert(IS_UNIBBLE(unwindCodeOp));
 
         size_t slots = allocaSize / MachPtr;
+#ifndef _WIN32
+        RecordCfiAlloca(allocaSize);
+#endif
         if (allocaSize > 0x7FF8)
         {
             unwindCode       = GetUnwindCode(3);
@@ -213,3 +252,115 @@ BYTE *PrologEncoder::GetUnwindInfo()
 {
     return (BYTE *)&pdata->unwindInfo;
 }
+
+#ifndef _WIN32
+void PrologEncoder::EmitCfiByte(BYTE value)
+{
+    AssertMsg(cfiInstrSize < cfiInstrCapacity, "Call frame instructions overflowed their buffer");
+    cfiInstrs[cfiInstrSize++] = value;
+}
+
+void PrologEncoder::EmitCfiULEB128(size_t value)
+{
+    do
+    {
+        BYTE byte = value & 0x7F;
+        value >>= 7;
+        EmitCfiByte(value ? (byte | 0x80) : byte);
+    } while (value);
+}
+
+// Like the Windows unwind codes, rows are located relative to the start of the prolog. Only the
+// stack probe precedes it and that makes no calls, so every call site sees the complete frame.
+void PrologEncoder::EmitCfiAdvance()
+{
+    Assert(currentInstrOffset >= cfiInstrOffset);
+    unsigned __int8 delta = currentInstrOffset - cfiInstrOffset;
+    if (delta == 0)
+    {
+        return;
+    }
+
+    if (delta < 0x40)
+    {
+        EmitCfiByte(DW_CFA_advance_loc | delta);
+    }
+    else
+    {
+        EmitCfiByte(DW_CFA_advance_loc1);
+        EmitCfiByte(delta);
+    }
+    cfiInstrOffset = currentInstrOffset;
+}
+
+void PrologEncoder::RecordCfiPush(unsigned __int8 reg)
+{
+    Assert(reg < _countof(DwarfRegNum));
+
+    EmitCfiAdvance();
+    cfaOffset += MachPtr;
+    EmitCfiByte(DW_CFA_def_cfa_offset);
+    EmitCfiULEB128(cfaOffset);
+
+    // The register was saved at CFA - cfaOffset; the offset is factored by the CIE's data alignment (-8).
+    EmitCfiByte(DW_CFA_offset | DwarfRegNum[reg]);
+    EmitCfiULEB128(cfaOffset / MachPtr);
+}
+
+void PrologEncoder::RecordCfiAlloca(size_t size)
+{
+    EmitCfiAdvance();
+    cfaOffset += size;
+    EmitCfiByte(DW_CFA_def_cfa_offset);
+    EmitCfiULEB128(cfaOffset);
+}
+
+void PrologEncoder::FinalizeEhFrame(BYTE *functionStart, DWORD codeSize)
+{
+    // CIE: "zR" augmentation with absolute pointers, code alignment 1, data alignment -8, return address in r16.
+    // Initial state on entry: CFA = rsp + 8, return address at CFA - 8.
+    static const BYTE cie[] =
+    {
+        0x00, 0x00, 0x00, 0x00,                     // CIE id
+        0x01,                                       // version
+        'z', 'R', 0x00,                             // augmentation
+        0x01,                                       // code alignment factor
+        0x78,                                       // data alignment factor (SLEB128 -8)
+        DwarfRegReturnAddress,                      // return address register
+        0x01,                                       // augmentation data length
+        0x00,                                       // FDE pointer encoding: DW_EH_PE_absptr
+        DW_CFA_def_cfa, DwarfRegRSP, MachPtr,
+        DW_CFA_offset | DwarfRegReturnAddress, 0x01,
+    };
+
+    const DWORD cieSize = ::Math::Align<DWORD>(sizeof(DWORD) + sizeof(cie), (DWORD)MachPtr);
+    const DWORD fdeHeaderSize = sizeof(DWORD) + sizeof(DWORD) + 2 * MachPtr + 1;
+    const DWORD fdeSize = ::Math::Align<DWORD>(fdeHeaderSize + cfiInstrSize, (DWORD)MachPtr);
+
+    ehFrameSize = cieSize + fdeSize + sizeof(DWORD);
+    ehFrame = (BYTE *)alloc->Alloc(ehFrameSize);
+    memset(ehFrame, DW_CFA_nop, ehFrameSize);
+
+    BYTE *current = ehFrame;
+    *(DWORD *)current = cieSize - sizeof(DWORD);
+    js_memcpy_s(current + sizeof(DWORD), cieSize - sizeof(DWORD), cie, sizeof(cie));
+    current += cieSize;
+
+    *(DWORD *)current = fdeSize - sizeof(DWORD);
+    current += sizeof(DWORD);
+    *(DWORD *)current = (DWORD)(current - ehFrame);        // CIE pointer, relative to this field
+    current += sizeof(DWORD);
+    *(BYTE **)current = functionStart;
+    current += MachPtr;
+    *(size_t *)current = codeSize;
+    current += MachPtr;
+    *current++ = 0;                                         // augmentation data length
+    if (cfiInstrSize)
+    {
+        js_memcpy_s(current, fdeSize - fdeHeaderSize, cfiInstrs, cfiInstrSize);
+    }
+
+    // The trailing zero length terminates the list for __register_frame.
+    *(DWORD *)(ehFrame + cieSize + fdeSize) = 0;
+}
+#endif
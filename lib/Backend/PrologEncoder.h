@@ -120,6 +120,20 @@ private:
     unsigned __int8   requiredUnwindCodeNodeCount;
     unsigned __int8   currentInstrOffset;
 
+#ifndef _WIN32
+    //
+    // DWARF call frame instructions mirroring the unwind codes, for the .eh_frame entry
+    // registered with the system unwinder on platforms without PDATA.
+    //
+    BYTE             *cfiInstrs;
+    DWORD             cfiInstrCapacity;
+    DWORD             cfiInstrSize;
+    unsigned __int8   cfiInstrOffset;
+    size_t            cfaOffset;
+    BYTE             *ehFrame;
+    DWORD             ehFrameSize;
+#endif
+
 public:
     PrologEncoder(ArenaAllocator *alloc)
         : alloc(alloc),
@@ -127,6 +141,15 @@ public:
           requiredUnwindCodeNodeCount(0),
           currentUnwindCodeNodeIndex(0),
           currentInstrOffset(0)
+#ifndef _WIN32
+          , cfiInstrs(nullptr),
+          cfiInstrCapacity(0),
+          cfiInstrSize(0),
+          cfiInstrOffset(0),
+          cfaOffset(MachPtr),
+          ehFrame(nullptr),
+          ehFrameSize(0)
+#endif
     {
     }
 
@@ -151,7 +174,24 @@ public:
     BYTE *GetUnwindInfo();
     void FinalizeUnwindInfo();
 
+#ifndef _WIN32
+    //
+    // DWARF .eh_frame (one CIE, one FDE and the terminator) for the function at functionStart.
+    //
+    void FinalizeEhFrame(BYTE *functionStart, DWORD codeSize);
+    DWORD SizeOfEhFrame() const { return ehFrameSize; }
+    BYTE *GetEhFrame() const { return ehFrame; }
+#endif
+
 private:
     UnwindCode *GetUnwindCode(unsigned __int8 nodeCount);
 
+#ifndef _WIN32
+    void EmitCfiByte(BYTE value);
+    void EmitCfiULEB128(size_t value);
+    void EmitCfiAdvance();
+    void RecordCfiPush(unsigned __int8 reg);
+    void RecordCfiAlloca(size_t size);
+#endif
+
 };
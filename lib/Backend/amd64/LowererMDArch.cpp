@@ -11,6 +11,13 @@ const Js::OpCode LowererMD::MDExtend32Opcode = Js::OpCode::MOVSXD;
 
 extern const IRType RegTypes[RegNumCount];
 
+#ifndef _WIN32
+// System V AMD64 ABI argument registers. Integer and floating-point arguments are assigned from
+// these independently and in order; the remaining arguments are passed on the stack without home space.
+static const RegNum IntArgRegs[] = { RegRDI, RegRSI, RegRDX, RegRCX, RegR8, RegR9 };
+static const RegNum XmmArgRegs[] = { RegXMM0, RegXMM1, RegXMM2, RegXMM3, RegXMM4, RegXMM5, RegXMM6, RegXMM7 };
+#endif
+
 BYTE
 LowererMDArch::GetDefaultIndirScale()
 {
@@ -95,6 +102,38 @@ LowererMDArch::GetRegArgR8(int32 argNum)
     return RegNOREG;
 }
 
+// amd64_ReturnFromCallWithFakeFrame finds the frame's spill size and args size in these registers.
+RegNum
+LowererMDArch::GetRegFakeFrameSpillSize()
+{
+#ifdef _WIN32
+    return RegR8;
+#else
+    return RegRDX;
+#endif
+}
+
+RegNum
+LowererMDArch::GetRegFakeFrameArgsSize()
+{
+#ifdef _WIN32
+    return RegR9;
+#else
+    return RegRCX;
+#endif
+}
+
+// Scratch register used to push the address of amd64_ReturnFromCallWithFakeFrame; must not be one of the above.
+RegNum
+LowererMDArch::GetRegFakeFrameReturnTarget()
+{
+#ifdef _WIN32
+    return RegRCX;
+#else
+    return RegR8;
+#endif
+}
+
 Js::OpCode
 LowererMDArch::GetAssignOp(IRType type)
 {
@@ -456,7 +495,7 @@ IR::Instr *
 LowererMDArch::LoadNewScObjFirstArg(IR::Instr * instr, IR::Opnd * dst, ushort extraArgs)
 {
     // Spread moves down the argument slot by one.
-    IR::Opnd *      argOpnd         = this->GetArgSlotOpnd(3 + extraArgs);
+    IR::Opnd *      argOpnd         = this->GetArgSlotOpnd(3 + extraArgs, nullptr, 1 + extraArgs);
     IR::Instr *     argInstr        = LowererMD::CreateAssign(argOpnd, dst, instr);
 
     return argInstr;
@@ -501,7 +540,7 @@ LowererMDArch::LowerCallArgs(IR::Instr *callInstr, ushort callFlags, Js::ArgSlot
             Js::Throw::OutOfMemory();
         }
 
-        IR::Opnd *      dstOpnd     = this->GetArgSlotOpnd(index, argLinkSym);
+        IR::Opnd *      dstOpnd     = this->GetArgSlotOpnd(index, argLinkSym, extraParams);
 
         argInstr->ReplaceDst(dstOpnd);
 
@@ -558,7 +597,16 @@ LowererMDArch::LowerCallArgs(IR::Instr *callInstr, ushort callFlags, Js::ArgSlot
             argCountOpnd->Use(m_func);
             *callInfoOpndRef = argCountOpnd;
         }
-        Lowerer::InsertMove(this->GetArgSlotOpnd(1 + extraParams), argCountOpnd, callInstr);
+        Lowerer::InsertMove(this->GetArgSlotOpnd(1 + extraParams, nullptr, extraParams), argCountOpnd, callInstr);
+#ifndef _WIN32
+        if (extraParams > 0)
+        {
+            // callInfo is a named parameter of the callee, so it is passed in its argument register as well
+            // as on the stack (RSI for a JavascriptMethod, later for helpers with leading parameters).
+            AssertMsg(extraParams < _countof(IntArgRegs), "callInfo must be passed in a register");
+            Lowerer::InsertMove(this->GetArgRegOpnd(IntArgRegs[extraParams], TyMachReg), argCountOpnd, callInstr);
+        }
+#endif
     }
     startCallInstr = this->LowerStartCall(startCallInstr);
 
@@ -603,6 +651,9 @@ LowererMDArch::LowerCallIDynamic(IR::Instr *callInstr, IR::Instr*saveThisArgOutI
         this->SetMaxArgSlots(Js::InlineeCallInfo::MaxInlineeArgoutCount);
     }
     callInstr->InsertBefore(IR::Instr::New(Js::OpCode::MOV, this->GetArgSlotOpnd(2), argsLength, this->m_func));
+#ifndef _WIN32
+    callInstr->InsertBefore(IR::Instr::New(Js::OpCode::MOV, this->GetArgRegOpnd(RegRSI, TyMachReg), argsLength, this->m_func));
+#endif
 
     IR::Opnd    *funcObjOpnd = callInstr->UnlinkSrc1();
     GeneratePreCall(callInstr, funcObjOpnd, insertBeforeInstrForCFG);
@@ -722,6 +773,15 @@ LowererMDArch::GeneratePreCall(IR::Instr * callInstr, IR::Opnd  *functionObjOpnd
 #endif
 
     // Setup the first call argument - pointer to the function being called.
+#ifndef _WIN32
+    if (callInstr->m_opcode != Js::OpCode::AsmJsCallI)
+    {
+        // The function object goes in the first argument register as well as in its stack slot; see CALL_ENTRYPOINT.
+        // Going through the register also avoids a MOV mem, imm64 for fixed function objects.
+        callInstr->InsertBefore(IR::Instr::New(Js::OpCode::MOV, GetArgRegOpnd(RegRDI, TyMachReg), functionObjOpnd, m_func));
+        functionObjOpnd = IR::RegOpnd::New(nullptr, RegRDI, TyMachReg, m_func);
+    }
+#endif
     IR::Instr * instrMovArg1 = IR::Instr::New(Js::OpCode::MOV, GetArgSlotOpnd(1), functionObjOpnd, m_func);
     callInstr->InsertBefore(instrMovArg1);
 }
@@ -745,8 +805,12 @@ LowererMDArch::LowerCallI(IR::Instr * callInstr, ushort callFlags, bool isHelper
     }
     else if (insertBeforeInstrForCFG != nullptr)
     {
+#ifdef _WIN32
         RegNum dstReg = insertBeforeInstrForCFG->GetDst()->AsRegOpnd()->GetReg();
         AssertMsg(dstReg == RegR8 || dstReg == RegR9, "NewScObject should insert the first Argument in R8/R9 only based on Spread call or not.");
+#else
+        AssertMsg(insertBeforeInstrForCFG->GetDst()->IsSymOpnd(), "NewScObject should insert the first Argument in its stack slot.");
+#endif
         insertBeforeInstrForCFGCheck = insertBeforeInstrForCFG;
     }
 
@@ -850,6 +914,7 @@ LowererMDArch::LowerCall(IR::Instr * callInstr, uint32 argCount)
     AssertMsg(this->helperCallArgsCount >= 0, "Fatal. helper call arguments ought to be positive");
     AssertMsg(this->helperCallArgsCount < 255, "Too many helper call arguments");
 
+#ifdef _WIN32
     uint16 argsLeft = static_cast<uint16>(this->helperCallArgsCount);
 
     while (argsLeft > 0)
@@ -864,6 +929,54 @@ LowererMDArch::LowerCall(IR::Instr * callInstr, uint32 argCount)
         --argsLeft;
     }
 
+    const uint32 helperArgSlots = (uint32)this->helperCallArgsCount;
+#else
+    // Classify the arguments front to back, then emit the moves back to front like the Win64 path.
+    IR::Opnd * helperDsts[MaxArgumentsToHelper];
+    uint16 intArgsUsed = 0;
+    uint16 xmmArgsUsed = 0;
+    uint16 stackArgsUsed = 0;
+
+    for (int argPosition = 1; argPosition <= this->helperCallArgsCount; argPosition++)
+    {
+        IR::Opnd * helperSrc = this->helperCallArgs[this->helperCallArgsCount - argPosition];
+        IRType type = helperSrc->GetType();
+        RegNum reg = RegNOREG;
+
+        if (IRType_IsFloat(type) || IRType_IsSimd128(type))
+        {
+            if (xmmArgsUsed < _countof(XmmArgRegs))
+            {
+                reg = XmmArgRegs[xmmArgsUsed++];
+            }
+        }
+        else if (intArgsUsed < _countof(IntArgRegs))
+        {
+            reg = IntArgRegs[intArgsUsed++];
+        }
+
+        if (reg != RegNOREG)
+        {
+            helperDsts[argPosition - 1] = this->GetArgRegOpnd(reg, type);
+        }
+        else
+        {
+            StackSym * helperSym = m_func->m_symTable->GetArgSlotSym(++stackArgsUsed);
+            helperSym->m_type = type;
+            helperSym->m_offset = (stackArgsUsed - 1) * MachPtr;
+            helperSym->m_allocated = true;
+            helperDsts[argPosition - 1] = IR::SymOpnd::New(helperSym, type, this->m_func);
+        }
+    }
+
+    for (int argPosition = this->helperCallArgsCount; argPosition > 0; argPosition--)
+    {
+        Lowerer::InsertMove(helperDsts[argPosition - 1], this->helperCallArgs[this->helperCallArgsCount - argPosition], callInstr);
+    }
+
+    const uint32 helperArgSlots = stackArgsUsed;
+#endif
+
 
     //
     // load the address into a register because we cannot directly access 64 bit constants
@@ -889,18 +1002,30 @@ LowererMDArch::LowerCall(IR::Instr * callInstr, uint32 argCount)
     // Reset the call
     //
 
-    this->m_func->m_argSlotsForFunctionsCalled  = max(this->m_func->m_argSlotsForFunctionsCalled , (uint32)this->helperCallArgsCount);
+    this->m_func->m_argSlotsForFunctionsCalled  = max(this->m_func->m_argSlotsForFunctionsCalled , helperArgSlots);
     this->helperCallArgsCount = 0;
 
     return retInstr;
 }
 
+IR::RegOpnd *
+LowererMDArch::GetArgRegOpnd(RegNum reg, IRType type)
+{
+    IR::RegOpnd *regOpnd = IR::RegOpnd::New(nullptr, reg, type, m_func);
+    regOpnd->m_isCallArg = true;
+    return regOpnd;
+}
+
 //
-// Returns the opnd where the corresponding argument would have been stored. On amd64,
-// the first 4 arguments go in registers and the rest are on stack.
+// Returns the opnd where the corresponding argument would have been stored. On Win64,
+// the first 4 arguments go in registers and the rest are on stack. On System V, JavascriptMethod
+// arguments are always on the stack (function and callInfo are also passed in RDI/RSI by the callers);
+// helper call arguments are assigned to registers by LowerCall. extraParams is the number of parameters
+// before callInfo: on System V those of a helper travel in registers, so the stack starts one slot
+// before callInfo, where VA_LIST_TO_VARARRAY expects it.
 //
 IR::Opnd *
-LowererMDArch::GetArgSlotOpnd(uint16 index, StackSym * argSym)
+LowererMDArch::GetArgSlotOpnd(uint16 index, StackSym * argSym, Js::ArgSlot extraParams)
 {
     Assert(index != 0);
 
@@ -918,14 +1043,23 @@ LowererMDArch::GetArgSlotOpnd(uint16 index, StackSym * argSym)
 
     IR::Opnd *argSlotOpnd = nullptr;
 
+#ifdef _WIN32
+    const uint16 argsInRegs = 4;
+    const uint16 stackSlot = index;
+#else
+    const uint16 argsInRegs = 0;
+    const uint16 stackSlot = extraParams > 1 ? index - (extraParams - 1) : index;
+    AssertMsg(stackSlot > 0 && stackSlot <= index, "Leading helper parameters are passed in registers");
+#endif
+
     if (argSym != nullptr)
     {
-        argSym->m_offset = (index - 1) * MachPtr;
+        argSym->m_offset = (stackSlot - 1) * MachPtr;
         argSym->m_allocated = true;
     }
 
     IRType type = argSym ? argSym->GetType() : TyMachReg;
-    if (argPosition <= 4)
+    if (argPosition <= argsInRegs)
     {
         RegNum reg = RegNOREG;
 
@@ -979,7 +1113,7 @@ LowererMDArch::GetArgSlotOpnd(uint16 index, StackSym * argSym)
     {
         if (argSym == nullptr)
         {
-            argSym = this->m_func->m_symTable->GetArgSlotSym(static_cast<uint16>(index));
+            argSym = this->m_func->m_symTable->GetArgSlotSym(static_cast<uint16>(stackSlot));
         }
 
         //
@@ -1511,6 +1645,7 @@ LowererMDArch::LowerEntryInstr(IR::EntryInstr * entryInstr)
     firstPrologInstr->InsertBefore(IR::PragmaInstr::New(Js::OpCode::PrologStart, 0, m_func));
     lastPrologInstr->InsertAfter(IR::PragmaInstr::New(Js::OpCode::PrologEnd, 0, m_func));
 
+#ifdef _WIN32
     //
     // Now store all the arguments in the register in the stack slots
     //
@@ -1591,6 +1726,10 @@ LowererMDArch::LowerEntryInstr(IR::EntryInstr * entryInstr)
         this->MovArgFromReg2Stack(entryInstr, RegR8, 3);
         this->MovArgFromReg2Stack(entryInstr, RegR9, 4);
     }
+#else
+    // System V: JavascriptMethod callers pass every argument on the stack as well (see CALL_ENTRYPOINT),
+    // so there is nothing to home. asm.js entry still relies on the Win64 InterpreterAsmThunk register layout.
+#endif
 
     IntConstType frameSize = Js::Constants::MinStackJIT + stackArgsSize + stackLocalsSize + savedRegSize;
     this->GeneratePrologueStackProbe(entryInstr, frameSize);
@@ -1714,14 +1853,22 @@ LowererMDArch::GeneratePrologueStackProbe(IR::Instr *entryInstr, IntConstType fr
 
     IR::RegOpnd *target;
     {
-        // MOV rdx, scriptContext
+#ifdef _WIN32
+        const RegNum frameSizeReg = RegRCX;
+        const RegNum scriptContextReg = RegRDX;
+#else
+        const RegNum frameSizeReg = IntArgRegs[0];
+        const RegNum scriptContextReg = IntArgRegs[1];
+#endif
+
+        // MOV rdx, scriptContext (rsi on System V)
         this->lowererMD->CreateAssign(
-            IR::RegOpnd::New(nullptr, RegRDX, TyMachReg, m_func),
+            IR::RegOpnd::New(nullptr, scriptContextReg, TyMachReg, m_func),
             this->lowererMD->m_lowerer->LoadScriptContextOpnd(insertInstr), insertInstr);
 
-        // MOV rcx, frameSize
+        // MOV rcx, frameSize (rdi on System V)
         this->lowererMD->CreateAssign(
-            IR::RegOpnd::New(nullptr, RegRCX, TyMachReg, this->m_func),
+            IR::RegOpnd::New(nullptr, frameSizeReg, TyMachReg, this->m_func),
             IR::AddrOpnd::New((void*)frameSize, IR::AddrOpndKindConstant, this->m_func), insertInstr);
 
         // MOV rax, ThreadContext::ProbeCurrentStack
@@ -2860,23 +3007,23 @@ LowererMDArch::LowerEHRegionReturn(IR::Instr * insertBeforeInstr, IR::Opnd * tar
     // Load the continuation address into the return register.
     insertBeforeInstr->InsertBefore(IR::Instr::New(Js::OpCode::MOV, retReg, targetOpnd, this->m_func));
 
-    // MOV r8, spillSize
+    // MOV r8, spillSize (rdx on System V)
     IR::Instr *movR8 = IR::Instr::New(Js::OpCode::LdSpillSize,
-        IR::RegOpnd::New(nullptr, RegR8, TyMachReg, m_func),
+        IR::RegOpnd::New(nullptr, GetRegFakeFrameSpillSize(), TyMachReg, m_func),
         m_func);
     insertBeforeInstr->InsertBefore(movR8);
 
 
-    // MOV r9, argsSize
+    // MOV r9, argsSize (rcx on System V)
     IR::Instr *movR9 = IR::Instr::New(Js::OpCode::LdArgSize,
-        IR::RegOpnd::New(nullptr, RegR9, TyMachReg, m_func),
+        IR::RegOpnd::New(nullptr, GetRegFakeFrameArgsSize(), TyMachReg, m_func),
         m_func);
     insertBeforeInstr->InsertBefore(movR9);
 
-    // MOV rcx, amd64_ReturnFromCallWithFakeFrame
+    // MOV rcx, amd64_ReturnFromCallWithFakeFrame (r8 on System V)
     // PUSH rcx
     // RET
-    IR::Opnd *endCallWithFakeFrame = endCallWithFakeFrame = IR::RegOpnd::New(nullptr, RegRCX, TyMachReg, m_func);
+    IR::Opnd *endCallWithFakeFrame = endCallWithFakeFrame = IR::RegOpnd::New(nullptr, GetRegFakeFrameReturnTarget(), TyMachReg, m_func);
     IR::Instr *movTarget = IR::Instr::New(Js::OpCode::MOV,
         endCallWithFakeFrame,
         IR::HelperCallOpnd::New(IR::HelperOp_ReturnFromCallWithFakeFrame, m_func),
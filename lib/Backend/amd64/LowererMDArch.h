@@ -58,7 +58,8 @@ public:
         return Math::FitsInDWord((size_t)opnd->GetMemLoc());
     }
 
-    IR::Opnd *          GetArgSlotOpnd(Js::ArgSlot slotIndex, StackSym * argSym = nullptr);
+    IR::Opnd *          GetArgSlotOpnd(Js::ArgSlot slotIndex, StackSym * argSym = nullptr, Js::ArgSlot extraParams = 1);
+    IR::RegOpnd *       GetArgRegOpnd(RegNum reg, IRType type);
     IR::Instr *         LoadNewScObjFirstArg(IR::Instr * instr, IR::Opnd * dst, ushort extraArgs = 0);
     IR::Instr *         LoadInputParamPtr(IR::Instr *instrInsert, IR::RegOpnd *optionalDstOpnd = nullptr);
     int32               LowerCallArgs(IR::Instr *callInstr, ushort callFlags, Js::ArgSlot extraParams = 1 /* for function object */, IR::IntConstOpnd **callInfoOpndRef = nullptr);
@@ -108,6 +109,9 @@ public:
     static RegNum       GetRegIMulHighDestLower();
     static RegNum       GetRegArgI4(int32 argNum);
     static RegNum       GetRegArgR8(int32 argNum);
+    static RegNum       GetRegFakeFrameSpillSize();
+    static RegNum       GetRegFakeFrameArgsSize();
+    static RegNum       GetRegFakeFrameReturnTarget();
     static Js::OpCode   GetAssignOp(IRType type);
 
     bool                GenerateFastAnd(IR::Instr * instrAnd);
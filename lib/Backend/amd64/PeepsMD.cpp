@@ -31,6 +31,15 @@ PeepsMD::ProcessImplicitRegs(IR::Instr *instr)
         this->peeps->ClearReg(RegXMM3);
         this->peeps->ClearReg(RegXMM4);
         this->peeps->ClearReg(RegXMM5);
+#ifndef _WIN32
+        // System V: rsi, rdi and the upper xmm registers are volatile as well
+        this->peeps->ClearReg(RegRSI);
+        this->peeps->ClearReg(RegRDI);
+        for (RegNum reg = RegXMM6; reg <= RegXMM15; reg = (RegNum)(reg + 1))
+        {
+            this->peeps->ClearReg(reg);
+        }
+#endif
     }
     else if (instr->m_opcode == Js::OpCode::IMUL)
     {
@@ -22,8 +22,14 @@ REGDAT(RDX,   rdx,      2,      TyInt64,      RA_CALLERSAVE | RA_BYTEABLE)
 REGDAT(RBX,   rbx,      3,      TyInt64,      RA_CALLEESAVE | RA_BYTEABLE)
 REGDAT(RSP,   rsp,      4,      TyInt64,      RA_DONTALLOCATE)
 REGDAT(RBP,   rbp,      5,      TyInt64,      RA_DONTALLOCATE)
+#ifdef _WIN32
 REGDAT(RSI,   rsi,      6,      TyInt64,      RA_CALLEESAVE)
 REGDAT(RDI,   rdi,      7,      TyInt64,      RA_CALLEESAVE)
+#else
+// System V AMD64 ABI: rsi and rdi are argument registers and are not preserved across calls
+REGDAT(RSI,   rsi,      6,      TyInt64,      RA_CALLERSAVE)
+REGDAT(RDI,   rdi,      7,      TyInt64,      RA_CALLERSAVE)
+#endif
 REGDAT(R8,    r8,       0,      TyInt64,      RA_CALLERSAVE | RA_BYTEABLE)
 REGDAT(R9,    r9,       1,      TyInt64,      RA_CALLERSAVE | RA_BYTEABLE)
 REGDAT(R10,   r10,      2,      TyInt64,      RA_CALLERSAVE | RA_BYTEABLE)
@@ -39,6 +45,7 @@ REGDAT(XMM2,  xmm2,     2,      TyFloat64,    0)
 REGDAT(XMM3,  xmm3,     3,      TyFloat64,    0)
 REGDAT(XMM4,  xmm4,     4,      TyFloat64,    0)
 REGDAT(XMM5,  xmm5,     5,      TyFloat64,    0)
+#ifdef _WIN32
 REGDAT(XMM6,  xmm6,     6,      TyFloat64,    RA_CALLEESAVE)
 REGDAT(XMM7,  xmm7,     7,      TyFloat64,    RA_CALLEESAVE)
 REGDAT(XMM8,  xmm8,     0,      TyFloat64,    RA_CALLEESAVE)
@@ -49,3 +56,16 @@ REGDAT(XMM12, xmm12,    4,      TyFloat64,    RA_CALLEESAVE)
 REGDAT(XMM13, xmm13,    5,      TyFloat64,    RA_CALLEESAVE)
 REGDAT(XMM14, xmm14,    6,      TyFloat64,    RA_CALLEESAVE)
 REGDAT(XMM15, xmm15,    7,      TyFloat64,    RA_CALLEESAVE)
+#else
+// System V AMD64 ABI: all xmm registers are volatile
+REGDAT(XMM6,  xmm6,     6,      TyFloat64,    0)
+REGDAT(XMM7,  xmm7,     7,      TyFloat64,    0)
+REGDAT(XMM8,  xmm8,     0,      TyFloat64,    0)
+REGDAT(XMM9,  xmm9,     1,      TyFloat64,    0)
+REGDAT(XMM10, xmm10,    2,      TyFloat64,    0)
+REGDAT(XMM11, xmm11,    3,      TyFloat64,    0)
+REGDAT(XMM12, xmm12,    4,      TyFloat64,    0)
+REGDAT(XMM13, xmm13,    5,      TyFloat64,    0)
+REGDAT(XMM14, xmm14,    6,      TyFloat64,    0)
+REGDAT(XMM15, xmm15,    7,      TyFloat64,    0)
+#endif
@@ -101,6 +101,15 @@
 #define VARIABLE_INT_ENCODING 1                     // Byte code serialization variable size int field encoding
 #define BYTECODE_BRANCH_ISLAND                      // Byte code short branch and branch island
 #define ENABLE_UNICODE_API 1                        // Enable use of Unicode-related APIs
+
+// Interpreter
+// Computed goto ("labels as values") is a GCC/Clang extension; other compilers use the switch loop.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(DISABLE_INTERPRETER_THREADED_DISPATCH)
+#define INTERPRETER_THREADED_DISPATCH               // Interpreter and regex matcher loops jump from handler to handler through a label table
+#endif
+#ifndef ENABLE_INTERPRETER_OPCODE_PROFILE
+#define ENABLE_INTERPRETER_OPCODE_PROFILE 0         // Per-opcode, opcode-pair and per-function interpreter counters (JsDiagGetInterpreterProfile)
+#endif
 // Language features
 // xplat-todo: revisit these features
 #ifdef _WIN32
@@ -130,10 +139,11 @@
 
 // GC features
 
-// Concurrent and Partial GC are disabled on non-Windows builds
-// xplat-todo: re-enable this in the future
-// These are disabled because these GC features depend on hardware
-// write-watch support that the Windows Memory Manager provides.
+// Concurrent and Partial GC depend on the write-watch support that the
+// Windows Memory Manager provides. On Linux the PAL emulates write watch
+// with page protection (see GetWriteWatch in pal/src/map/virtual.cpp);
+// other non-Windows builds still have them disabled.
+// xplat-todo: re-enable background page zeroing/freeing on non-Windows builds
 #ifdef _WIN32
 #define SYSINFO_IMAGE_BASE_AVAILABLE 1
 #define ENABLE_CONCURRENT_GC 1
@@ -143,8 +153,13 @@
 #define ENABLE_RECYCLER_TYPE_TRACKING 1
 #else
 #define SYSINFO_IMAGE_BASE_AVAILABLE 0
+#if defined(__linux__)
+#define ENABLE_CONCURRENT_GC 1
+#define ENABLE_PARTIAL_GC 1
+#else
 #define ENABLE_CONCURRENT_GC 0
 #define ENABLE_PARTIAL_GC 0
+#endif
 #define ENABLE_BACKGROUND_PAGE_ZEROING 0
 #define ENABLE_BACKGROUND_PAGE_FREEING 0
 #define ENABLE_RECYCLER_TYPE_TRACKING 0
@@ -166,10 +181,8 @@
 #if DISABLE_JIT
 #define ENABLE_NATIVE_CODEGEN 0
 #define ENABLE_PROFILE_INFO 0
-#define ENABLE_BACKGROUND_JOB_PROCESSOR 0
-#define ENABLE_BACKGROUND_PARSING 0                 // Disable background parsing in this mode
-                                                    // We need to decouple the Jobs infrastructure out of
-                                                    // Backend to make background parsing work with JIT disabled
+#define ENABLE_BACKGROUND_JOB_PROCESSOR 1           // The job processor doesn't depend on the Backend, so background
+#define ENABLE_BACKGROUND_PARSING 1                 // parsing still runs on its threads with JIT disabled
 #define DYNAMIC_INTERPRETER_THUNK 0
 #define DISABLE_DYNAMIC_PROFILE_DEFER_PARSE
 #define ENABLE_COPYONACCESS_ARRAY 0
@@ -185,7 +198,8 @@
 #define ENABLE_BACKGROUND_PARSING 1
 #define ENABLE_COPYONACCESS_ARRAY 1
 #ifndef DYNAMIC_INTERPRETER_THUNK
-#if defined(_M_IX86_OR_ARM32) || defined(_M_X64_OR_ARM64)
+// The interpreter thunk emitter and its asm thunks only implement the Windows calling conventions
+#if defined(_WIN32) && (defined(_M_IX86_OR_ARM32) || defined(_M_X64_OR_ARM64))
 #define DYNAMIC_INTERPRETER_THUNK 1
 #else
 #define DYNAMIC_INTERPRETER_THUNK 0
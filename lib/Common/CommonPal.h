@@ -384,7 +384,7 @@ inline __int64 _abs64(__int64 n)
     return n < 0 ? -n : n;
 }
 
-// xplat-todo: implement these for JIT and Concurrent/Partial GC
+// Used by the background job processor and the concurrent GC threads; implemented in the PAL
 uintptr_t _beginthreadex(
    void *security,
    unsigned stack_size,
@@ -17,6 +17,7 @@ PHASE(All)
         PHASE(CacheScopeInfoNames)
         PHASE(ScanAhead)
         PHASE(ParallelParse)
+        PHASE(IdleParse)
         PHASE(EarlyReferenceErrors)
     PHASE(ByteCode)
         PHASE(CachedScope)
@@ -381,6 +382,7 @@ PHASE(All)
 #define DEFAULT_CONFIG_ForceDeferParse      (false)
 #define DEFAULT_CONFIG_NoDeferParse         (false)
 #define DEFAULT_CONFIG_ForceDynamicProfile  (false)
+#define DEFAULT_CONFIG_FuseByteCode         (false)
 #define DEFAULT_CONFIG_ForceExpireOnNonCacheCollect (false)
 #define DEFAULT_CONFIG_ForceFastPath        (false)
 #define DEFAULT_CONFIG_ForceJITLoopBody     (false)
@@ -460,13 +462,18 @@ PHASE(All)
 #define DEFAULT_CONFIG_RegexProfile         (false)
 #define DEFAULT_CONFIG_RegexDebug           (false)
 #define DEFAULT_CONFIG_RegexOptimize        (true)
+#define DEFAULT_CONFIG_RegexDfa             (true)
 #define DEFAULT_CONFIG_DynamicRegexMruListSize (16)
+#define DEFAULT_CONFIG_RegexProgramCacheSize (256)
+#define DEFAULT_CONFIG_RegexBacktrackLimit (10000000)
 #define DEFAULT_CONFIG_GoptCleanupThreshold  (25)
 #define DEFAULT_CONFIG_AsmGoptCleanupThreshold  (500)
 #define DEFAULT_CONFIG_OptimizeForManyInstances (false)
 
 #define DEFAULT_CONFIG_DeferParseThreshold             (4 * 1024) // Unit is number of characters
 #define DEFAULT_CONFIG_ProfileBasedDeferParseThreshold (100)      // Unit is number of characters
+#define DEFAULT_CONFIG_ParallelParseThreshold          (0)        // Unit is number of characters, 0 disables
+#define DEFAULT_CONFIG_IdleParseBudget                 (0)        // Unit is milliseconds, 0 disables
 
 #define DEFAULT_CONFIG_ProfileBasedSpeculativeJit (true)
 #define DEFAULT_CONFIG_WininetProfileCache        (true)
@@ -684,6 +691,9 @@ PHASE(All)
 #endif
 
 #define DEFAULT_CONFIG_RecyclerForceMarkInterior (false)
+#define DEFAULT_CONFIG_RecyclerParallelMarkWorkSharing (true)
+#define DEFAULT_CONFIG_RecyclerMaxParallelMark (0)
+#define DEFAULT_CONFIG_PageSegmentPoolPageCount (0)
 
 #define DEFAULT_CONFIG_MemProtectHeap (false)
 
@@ -1024,6 +1034,7 @@ FLAGR (String,  Filename              , "Jscript source file", nullptr)
 FLAGNR(Boolean, FreeRejittedCode      , "Free rejitted code", true)
 FLAGNR(Boolean, ForceGuardPages       , "Force the addition of guard pages", false)
 FLAGNR(Boolean, PrintGuardPageBounds  , "Prints the bounds of a guard page", false)
+FLAGNR(Number,  PageSegmentPoolPageCount, "Maximum number of committed pages kept in the process-wide pool of released page segments (0 disables the pool)", DEFAULT_CONFIG_PageSegmentPoolPageCount)
 FLAGNR(Boolean, ForceLegacyEngine     , "Force a jscrip9 dll load", false)
 FLAGNR(Phases,  Force                 , "Force certain phase to run ignoring heuristics", )
 FLAGNR(Phases,  Stress                , "Stress certain phases by making them kick in even if they normally would not.", )
@@ -1044,6 +1055,7 @@ FLAGNR(Boolean, EnableContinueAfterExceptionWrappersForBuiltIns, "Enable wrapper
 FLAGNR(Boolean, EnableFunctionSourceReportForHeapEnum, "During HeapEnum, whether to report function source info (url/row/col)", DEFAULT_CONFIG_EnableFunctionSourceReportForHeapEnum)
 FLAGNR(Number,  ForceFragmentAddressSpace , "Fragment the address space", 128 * 1024 * 1024)
 FLAGNR(Number,  ForceOOMOnEBCommit, "Force CommitBuffer to return OOM", 0)
+FLAGNR(Number,  ForceOOMInBackgroundParse, "Force the Nth function parsed by a background parser job to run out of memory", 0)
 FLAGR (Boolean, ForceDynamicProfile   , "Force to always generate profiling byte code", DEFAULT_CONFIG_ForceDynamicProfile)
 FLAGNR(Boolean, ForceES5Array         , "Force using ES5Array", DEFAULT_CONFIG_ForceES5Array)
 FLAGNR(Boolean, ForceAsmJsLinkFail    , "Force asm.js link time validation to fail", DEFAULT_CONFIG_ForceAsmJsLinkFail)
@@ -1064,6 +1076,7 @@ FLAGNR(Number,  ForceSerializedBytecodeVersionSchema, "Force the byte code seria
 FLAGNR(Boolean, ForceStrictMode, "Force strict mode checks on all functions", false)
 FLAGNR(Boolean, ForceUndoDefer        , "Defer parsing of all function bodies, but undo deferral", false)
 FLAGNR(Boolean, ForceBlockingConcurrentCollect, "Force doing in-thread GC on concurrent thread- this will skip doing concurrent collect", false)
+FLAGR (Boolean, FuseByteCode          , "Fuse common adjacent byte code sequences into interpreter superinstructions", DEFAULT_CONFIG_FuseByteCode)
 FLAGNR(Boolean, FreTestDiagMode, "Enabled collection of diagnostic information on fretest builds", false)
 #ifdef BYTECODE_TESTING
 FLAGNR(Number,  ByteCodeBranchLimit,    "Short branch limit before we use the branch island", 128)
@@ -1173,6 +1186,8 @@ FLAGNR(Number,  MaxSingleCharStrJumpTableRatio, "Maximum single char string jump
 FLAGNR(Number,  MinSwitchJumpTableSize , "Minimum size of the jump table, that is created for consecutive integer case arms in a Switch Statement",DEFAULT_CONFIG_MinSwitchJumpTableSize)
 FLAGNR(Number,  MaxLinearStringCaseCount,  "Maximum number of string cases(in switch statement) for which instructions can be generated linearly",DEFAULT_CONFIG_MaxLinearStringCaseCount)
 FLAGR(Number,   MinDeferredFuncTokenCount, "Minimum length in tokens of defer-parsed function", DEFAULT_CONFIG_MinDeferredFuncTokenCount)
+FLAGR(Number,   ParallelParseThreshold, "Minimum length in characters of a script whose top-level functions are parsed on background threads (0 disables)", DEFAULT_CONFIG_ParallelParseThreshold)
+FLAGR(Number,   IdleParseBudget       , "Milliseconds of each JsIdle call spent parsing deferred functions ahead of their first call (0 disables)", DEFAULT_CONFIG_IdleParseBudget)
 #if DBG
 FLAGNR(Number,  SkipFuncCountForBailOnNoProfile,  "Initial Number of functions in a func body to be skipped from forcibly inserting BailOnNoProfile.", DEFAULT_CONFIG_SkipFuncCountForBailOnNoProfile)
 #endif
@@ -1261,6 +1276,8 @@ FLAGNR(Boolean, RecyclerTrackStress, "Stress tracked object handling by simulati
 FLAGNR(Boolean, RecyclerInduceFalsePositives, "Stress recycler by forcing false positive object marks", false)
 #endif // RECYCLER_STRESS
 FLAGNR(Boolean, RecyclerForceMarkInterior, "Force all the mark as interior", DEFAULT_CONFIG_RecyclerForceMarkInterior)
+FLAGNR(Boolean, RecyclerParallelMarkWorkSharing, "Let parallel mark threads steal mark stack pages from each other when they run out of work", DEFAULT_CONFIG_RecyclerParallelMarkWorkSharing)
+FLAGNR(Number,  RecyclerMaxParallelMark, "Maximum number of threads marking in parallel (0 for one per physical processor, up to 16)", DEFAULT_CONFIG_RecyclerMaxParallelMark)
 #if ENABLE_CONCURRENT_GC
 FLAGNR(Number,  RecyclerPriorityBoostTimeout, "Adjust priority boost timeout", 5000)
 FLAGNR(Number,  RecyclerThreadCollectTimeout, "Adjust thread collect timeout", 1000)
@@ -1359,9 +1376,12 @@ FLAGR (Boolean, RegexTracing          , "Trace all Regex invocations to the outp
 FLAGR (Boolean, RegexProfile          , "Collect usage statistics on all Regex invocations.", DEFAULT_CONFIG_RegexProfile)
 FLAGR (Boolean, RegexDebug            , "Trace compilation of UnifiedRegex expressions.", DEFAULT_CONFIG_RegexDebug)
 FLAGR (Boolean, RegexOptimize         , "Optimize regular expressions in the unified Regex system (default: true)", DEFAULT_CONFIG_RegexOptimize)
+FLAGR (Boolean, RegexDfa              , "Match regular expressions without backreferences or lookarounds with a lazily built DFA (default: true)", DEFAULT_CONFIG_RegexDfa)
 FLAGR (Number,  DynamicRegexMruListSize, "Size of the MRU list for dynamic regexes", DEFAULT_CONFIG_DynamicRegexMruListSize)
+FLAGR (Number,  RegexProgramCacheSize , "Number of compiled regexes kept in the process-wide cache when no pattern uses them", DEFAULT_CONFIG_RegexProgramCacheSize)
 #endif
 
+FLAGR (Number,  RegexBacktrackLimit   , "Number of backtracking steps a single regex match may take in a runtime which limits regex backtracking", DEFAULT_CONFIG_RegexBacktrackLimit)
 FLAGR (Boolean, OptimizeForManyInstances, "Optimize script engine for many instances (low memory footprint per engine, assume low spare CPU cycles) (default: false)", DEFAULT_CONFIG_OptimizeForManyInstances)
 FLAGNR(Phases,  TestTrace             , "Test trace for the given phase", )
 FLAGNR(Boolean, EnableEvalMapCleanup, "Enable cleaning up the eval map", true)
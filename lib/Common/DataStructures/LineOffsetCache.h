@@ -4,6 +4,10 @@
 //-------------------------------------------------------------------------------------------------------
 #pragma once
 
+#if defined(_M_IX86) || defined(_M_X64)
+#define LINE_OFFSET_CACHE_SSE2
+#endif
+
 namespace JsUtil
 {
     template <typename TAllocator>
@@ -24,6 +28,9 @@ namespace JsUtil
         typedef List<LineOffsetCacheItem, TAllocator, true /*isLeaf*/> LineOffsetCacheList;
         typedef ReadOnlyList<LineOffsetCacheItem> LineOffsetCacheReadOnlyList;
 
+        // Lines are found this many source bytes at a time, as far as the offsets being looked up require.
+        static const charcount_t ChunkByteLength = 64 * 1024;
+
     public:
 
         static int FindLineForCharacterOffset(
@@ -43,25 +50,33 @@ namespace JsUtil
             return lastLine;
         }
 
+        // Creates a cache that only knows the first line. Later lines are added as lookups need them, see
+        // EnsureCharacterOffset.
         LineOffsetCache(TAllocator* allocator,
-            _In_z_ LPCUTF8 sourceStartCharacter,
-            _In_z_ LPCUTF8 sourceEndCharacter,
-            charcount_t startingCharacterOffset = 0,
-            charcount_t startingByteOffset = 0) :
+            charcount_t startingCharacterOffset,
+            charcount_t startingByteOffset) :
             allocator(allocator),
+            scanCharacterOffset(startingCharacterOffset),
+            scanByteOffset(startingByteOffset),
             isCacheBuilt(false)
         {
             AssertMsg(allocator, "An allocator must be supplied to the cache for allocation of items.");
             LineOffsetCacheList *list = AllocatorNew(TAllocator, allocator, LineOffsetCacheList, allocator);
             this->lineOffsetCacheList = list;
-            this->BuildCache(list, sourceStartCharacter, sourceEndCharacter, startingCharacterOffset, startingByteOffset);
+            this->buildList = list;
+
+            // Add the first line in the cache list.
+            this->AddLine(list, startingCharacterOffset, startingByteOffset);
         }
 
         LineOffsetCache(TAllocator *allocator,
             _In_reads_(numberOfLines) const LineOffsetCacheItem *lines,
             __in int numberOfLines) :
             allocator(allocator),
-            isCacheBuilt(false)
+            buildList(nullptr),
+            scanCharacterOffset(0),
+            scanByteOffset(0),
+            isCacheBuilt(true)
         {
             this->lineOffsetCacheList = LineOffsetCacheReadOnlyList::New(allocator, (LineOffsetCacheItem *)lines, numberOfLines);
         }
@@ -74,10 +89,46 @@ namespace JsUtil
             }
         }
 
+        // True once every line of the source is in the cache.
+        bool IsComplete() const
+        {
+            return this->isCacheBuilt;
+        }
+
+        // True if every line that starts at or before the given character offset is in the cache.
+        bool HasCharacterOffset(charcount_t characterOffset) const
+        {
+            return this->isCacheBuilt || characterOffset < this->scanCharacterOffset;
+        }
+
+        // Scans the source for lines, resuming where the previous scan stopped, until the line holding the given
+        // character offset is known. sourceStart is the start of the source buffer (byte offset 0); the buffer may
+        // move between calls but its content may not change.
+        void EnsureCharacterOffset(
+            _In_z_ LPCUTF8 sourceStart,
+            _In_z_ LPCUTF8 sourceEnd,
+            charcount_t characterOffset)
+        {
+            AssertMsg(sourceStart, "The source start character passed in is null.");
+            AssertMsg(sourceEnd, "The source end character passed in is null.");
+            AssertMsg(sourceStart + this->scanByteOffset <= sourceEnd, "The source is shorter than the part already scanned.");
+
+            while (!this->HasCharacterOffset(characterOffset))
+            {
+                this->BuildChunk(sourceStart, sourceEnd);
+            }
+        }
+
+        void EnsureComplete(_In_z_ LPCUTF8 sourceStart, _In_z_ LPCUTF8 sourceEnd)
+        {
+            this->EnsureCharacterOffset(sourceStart, sourceEnd, UINT32_MAX);
+        }
+
         // outLineCharOffset - The character offset of the start of the line returned
         int GetLineForCharacterOffset(charcount_t characterOffset, charcount_t *outLineCharOffset, charcount_t *outByteOffset)
         {
             Assert(this->lineOffsetCacheList->Count() > 0);
+            AssertMsg(this->HasCharacterOffset(characterOffset), "The cache hasn't been built up to the offset, EnsureCharacterOffset should have been called.");
 
             // The list is sorted, so binary search to find the line info.
             int closestIndex = -1;
@@ -148,11 +199,13 @@ namespace JsUtil
         uint32 GetLineCount() const
         {
             AssertMsg(this->lineOffsetCacheList != nullptr, "The list was either not set from the ByteCode or not created.");
+            AssertMsg(this->isCacheBuilt, "The line count is only known once the cache is complete.");
             return this->lineOffsetCacheList->Count();
         }
 
         const LineOffsetCacheItem* GetItems()
         {
+            AssertMsg(this->isCacheBuilt, "The cache is only persisted once it is complete.");
             return this->lineOffsetCacheList->GetBuffer();
         }
 
@@ -162,10 +215,50 @@ namespace JsUtil
         {
             charcount_t currentCharacterOffset = inOutCharacterOffset;
             charcount_t currentByteOffset = inOutByteOffset;
+
+            // A "\r\n" that straddles maxCharacterOffset starts a line after it
+            if (ScanForNextLine(currentSourcePosition, sourceEndCharacter, sourceEndCharacter, currentCharacterOffset, currentByteOffset, maxCharacterOffset)
+                && currentCharacterOffset <= maxCharacterOffset)
+            {
+                inOutCharacterOffset = currentCharacterOffset;
+                inOutByteOffset = currentByteOffset;
+                return true;
+            }
+
+            return false;
+        }
+
+        // Scans from currentSourcePosition for the next line terminator and stops right after it (returning true), at
+        // scanLimit, or once the character offset reaches maxCharacterOffset. The offsets follow the position either way.
+        // A character that starts before scanLimit is decoded up to sourceEndCharacter.
+        static bool ScanForNextLine(_In_z_ LPCUTF8 &currentSourcePosition, _In_z_ LPCUTF8 scanLimit, _In_z_ LPCUTF8 sourceEndCharacter, charcount_t &currentCharacterOffset, charcount_t &currentByteOffset, charcount_t maxCharacterOffset)
+        {
             utf8::DecodeOptions options = utf8::doAllowThreeByteSurrogates;
 
-            while (currentSourcePosition < sourceEndCharacter)
+            // The second half of a surrogate pair is decoded from the same bytes as the first, so never stop between them.
+            while (currentSourcePosition < scanLimit || (options & utf8::doSecondSurrogatePair) != 0)
             {
+                if ((options & utf8::doSecondSurrogatePair) == 0)
+                {
+                    // Plain ASCII is one byte per character, so a run of it moves both offsets by its length.
+                    LPCUTF8 runLimit = scanLimit;
+                    if (static_cast<size_t>(scanLimit - currentSourcePosition) > maxCharacterOffset - currentCharacterOffset)
+                    {
+                        runLimit = currentSourcePosition + (maxCharacterOffset - currentCharacterOffset);
+                    }
+
+                    LPCUTF8 runEnd = SkipPlainAscii(currentSourcePosition, runLimit);
+                    charcount_t runLength = static_cast<charcount_t>(runEnd - currentSourcePosition);
+                    currentSourcePosition = runEnd;
+                    currentCharacterOffset += runLength;
+                    currentByteOffset += runLength;
+
+                    if (currentCharacterOffset >= maxCharacterOffset || currentSourcePosition >= scanLimit)
+                    {
+                        return false;
+                    }
+                }
+
                 LPCUTF8 previousCharacter = currentSourcePosition;
 
                 // Decode from UTF8 to wide char.  Note that Decode will advance the current character by 1 at least.
@@ -177,7 +270,7 @@ namespace JsUtil
                 case _u('\r'):
                     // Check if the next character is a '\n'.  If so, consume that character as well
                     // (consider as one line).
-                    if (*currentSourcePosition == '\n')
+                    if (currentSourcePosition < sourceEndCharacter && *currentSourcePosition == '\n')
                     {
                         ++currentSourcePosition;
                         ++currentCharacterOffset;
@@ -201,8 +294,6 @@ namespace JsUtil
 
                 if (wasLineEncountered)
                 {
-                    inOutCharacterOffset = currentCharacterOffset;
-                    inOutByteOffset = currentByteOffset;
                     return true;
                 }
                 else if (currentCharacterOffset >= maxCharacterOffset)
@@ -214,26 +305,83 @@ namespace JsUtil
             return false;
         }
 
-        // Builds the cache of line offsets from the passed in source.
-        void BuildCache(_In_ LineOffsetCacheList *list, _In_z_ LPCUTF8 sourceStartCharacter,
-            _In_z_ LPCUTF8 sourceEndCharacter,
-            charcount_t startingCharacterOffset = 0,
-            charcount_t startingByteOffset = 0)
+#ifdef LINE_OFFSET_CACHE_SSE2
+        static bool CanUseSSE2()
+        {
+#if defined(_M_IX86)
+            return AutoSystemInfo::Data.SSE2Available() != FALSE;
+#else
+            return true;
+#endif
+        }
+#endif
+
+        // Returns the first byte in [currentSourcePosition, limit) that is '\r', '\n' or not ASCII (or limit).
+        // Every other byte is a character that can't end a line. Checks 16 bytes at a time when SSE2 is available.
+        static LPCUTF8 SkipPlainAscii(_In_z_ LPCUTF8 currentSourcePosition, _In_z_ LPCUTF8 limit)
+        {
+            LPCUTF8 p = currentSourcePosition;
+
+#ifdef LINE_OFFSET_CACHE_SSE2
+            if (CanUseSSE2())
+            {
+                const __m128i carriageReturns = _mm_set1_epi8('\r');
+                const __m128i lineFeeds = _mm_set1_epi8('\n');
+
+                while (limit - p >= 16)
+                {
+                    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                    __m128i lineEnds = _mm_or_si128(_mm_cmpeq_epi8(bytes, carriageReturns), _mm_cmpeq_epi8(bytes, lineFeeds));
+
+                    // The sign bit of a byte is set exactly when the byte is not ASCII
+                    uint mask = static_cast<uint>(_mm_movemask_epi8(_mm_or_si128(lineEnds, bytes)));
+                    if (mask != 0)
+                    {
+                        DWORD index;
+                        _BitScanForward(&index, mask);
+                        return p + index;
+                    }
+
+                    p += 16;
+                }
+            }
+#endif
+
+            while (p < limit && *p < 0x80 && *p != '\r' && *p != '\n')
+            {
+                ++p;
+            }
+
+            return p;
+        }
+
+        // Adds the lines found in the next chunk of the source.
+        void BuildChunk(_In_z_ LPCUTF8 sourceStart, _In_z_ LPCUTF8 sourceEnd)
         {
-            AssertMsg(sourceStartCharacter, "The source start character passed in is null.");
-            AssertMsg(sourceEndCharacter, "The source end character passed in is null.");
-            AssertMsg(sourceStartCharacter <= sourceEndCharacter, "The source start character should not be beyond the source end character.");
             AssertMsg(!this->isCacheBuilt, "The cache is already built.");
+            Assert(this->buildList != nullptr);
 
-            // Add the first line in the cache list.
-            this->AddLine(list, startingCharacterOffset, startingByteOffset);
+            LPCUTF8 currentSourcePosition = sourceStart + this->scanByteOffset;
+            LPCUTF8 chunkEnd = static_cast<size_t>(sourceEnd - currentSourcePosition) > ChunkByteLength ? currentSourcePosition + ChunkByteLength : sourceEnd;
 
-            while (FindNextLine(sourceStartCharacter, sourceEndCharacter, startingCharacterOffset, startingByteOffset))
+            // The scan position only moves past a line once it is in the list, so running out of memory in AddLine
+            // leaves a cache that the next call picks up from again.
+            charcount_t characterOffset = this->scanCharacterOffset;
+            charcount_t byteOffset = this->scanByteOffset;
+            while (ScanForNextLine(currentSourcePosition, chunkEnd, sourceEnd, characterOffset, byteOffset, UINT32_MAX))
             {
-                this->AddLine(list, startingCharacterOffset, startingByteOffset);
+                this->AddLine(this->buildList, characterOffset, byteOffset);
+                this->scanCharacterOffset = characterOffset;
+                this->scanByteOffset = byteOffset;
             }
 
-            isCacheBuilt = true;
+            this->scanCharacterOffset = characterOffset;
+            this->scanByteOffset = byteOffset;
+
+            if (currentSourcePosition >= sourceEnd)
+            {
+                this->isCacheBuilt = true;
+            }
         }
 
         // Tracks a new line offset in the cache.
@@ -264,6 +412,13 @@ namespace JsUtil
 
         // Line offset cache list used for quickly finding line/column offsets.
         LineOffsetCacheReadOnlyList* lineOffsetCacheList;
+
+        // The same list while lines are still being added to it, nullptr for a cache read from byte code
+        LineOffsetCacheList* buildList;
+
+        // Where the scan for lines stopped; every line starting before this character offset is in the list
+        charcount_t scanCharacterOffset;
+        charcount_t scanByteOffset;
         bool isCacheBuilt;
     };
 }
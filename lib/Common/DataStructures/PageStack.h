@@ -15,6 +15,20 @@ private:
     static const size_t EntriesPerChunk = (AutoSystemInfo::PageSize - sizeof(Chunk)) / sizeof(T);
 
 public:
+    // A list of full chunks detached from one stack so that they can be attached to another.
+    // Used to share work between stacks; the caller is responsible for synchronizing access.
+    class ChunkList
+    {
+    public:
+        ChunkList() : head(nullptr) {}
+
+        bool IsEmpty() const { return head == nullptr; }
+
+    private:
+        friend class PageStack<T>;
+        Chunk * head;
+    };
+
     PageStack(PagePool * pagePool);
     ~PageStack();
 
@@ -26,6 +40,10 @@ public:
 
     uint Split(uint targetCount, __in_ecount(targetCount) PageStack<T> ** targetStacks);
 
+    bool HasSpareChunk() const { return currentChunk != nullptr && currentChunk->nextChunk != nullptr; }
+    void GiveChunk(ChunkList * chunkList);
+    bool TakeChunk(ChunkList * chunkList);
+
     void Abort();
     void Release();
 
@@ -44,7 +62,7 @@ public:
     }
 #endif
 
-    static const uint MaxSplitTargets = 3;     // Not counting original stack, so this supports 4-way parallel
+    static const uint MaxSplitTargets = 15;    // Not counting original stack, so this supports 16-way parallel
 
 private:
     Chunk * CreateChunk();
@@ -353,6 +371,62 @@ uint PageStack<T>::Split(uint targetCount, __in_ecount(targetCount) PageStack<T>
 }
 
 
+template <typename T>
+void PageStack<T>::GiveChunk(ChunkList * chunkList)
+{
+    // Move the chunk just below the current one to the list.
+    // Chunks below the current chunk are always full, so the receiving stack can consume it as is.
+    Assert(HasSpareChunk());
+
+    Chunk * chunk = currentChunk->nextChunk;
+    currentChunk->nextChunk = chunk->nextChunk;
+
+    chunk->nextChunk = chunkList->head;
+    chunkList->head = chunk;
+
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    this->pageCount--;
+#endif
+#if DBG
+    this->count -= EntriesPerChunk;
+#endif
+}
+
+
+template <typename T>
+bool PageStack<T>::TakeChunk(ChunkList * chunkList)
+{
+    // Replace the (empty) current chunk with a full chunk from the list.
+    Assert(IsEmpty());
+
+    Chunk * chunk = chunkList->head;
+    if (chunk == nullptr)
+    {
+        return false;
+    }
+    chunkList->head = chunk->nextChunk;
+
+    if (currentChunk != nullptr)
+    {
+        FreeChunk(currentChunk);
+    }
+
+    chunk->nextChunk = nullptr;
+    currentChunk = chunk;
+    chunkStart = currentChunk->entries;
+    chunkEnd = &currentChunk->entries[EntriesPerChunk];
+    nextEntry = chunkEnd;
+
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    this->pageCount++;
+#endif
+#if DBG
+    this->count = EntriesPerChunk;
+#endif
+    return true;
+}
+
+
 template <typename T>
 void PageStack<T>::Abort()
 {
@@ -214,6 +214,13 @@ Allocation* Heap::Alloc(size_t bytes, ushort pdataCount, ushort xdataSize, bool
     size_t bytesToAllocate = PowerOf2Policy::GetSize(bytes);
     BucketId bucket = (BucketId) GetBucketForSize(bytesToAllocate);
 
+#ifndef _WIN32
+    // Pages being written aren't executable here (see ProtectAllocationWithExecuteReadWrite), so code
+    // must not share a page with another allocation that may be running meanwhile. This costs up to a
+    // page per jitted function over the bucketed allocation.
+    bucket = BucketId::LargeObjectList;
+#endif
+
     if (bucket == BucketId::LargeObjectList)
     {
         Allocation * allocation = AllocLargeObject(bytes, pdataCount, xdataSize, canAllocInPreReservedHeapPageSegment, isAnyJittedCode, isAllJITCodeInPreReservedRegion);
@@ -274,7 +281,12 @@ BOOL Heap::ProtectAllocationWithExecuteReadWrite(Allocation *allocation, __in_op
     }
     else
     {
+#ifdef _WIN32
         protectFlags = PAGE_EXECUTE_READWRITE;
+#else
+        // Keep code pages W^X: writable or executable, never both.
+        protectFlags = PAGE_READWRITE;
+#endif
     }
     return this->ProtectAllocation(allocation, protectFlags, PAGE_EXECUTE, addressInPage);
 }
@@ -290,7 +302,11 @@ BOOL Heap::ProtectAllocationWithExecuteReadOnly(Allocation *allocation, __in_opt
     {
         protectFlags = PAGE_EXECUTE;
     }
+#ifdef _WIN32
     return this->ProtectAllocation(allocation, protectFlags, PAGE_EXECUTE_READWRITE, addressInPage);
+#else
+    return this->ProtectAllocation(allocation, protectFlags, PAGE_READWRITE, addressInPage);
+#endif
 }
 
 BOOL Heap::ProtectAllocation(__in Allocation* allocation, DWORD dwVirtualProtectFlags, DWORD desiredOldProtectFlag, __in_opt char* addressInPage)
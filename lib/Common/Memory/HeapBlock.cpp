@@ -1052,6 +1052,9 @@ SmallHeapBlockT<TBlockAttributes>::Sweep(RecyclerSweep& recyclerSweep, bool queu
     }
 
     RECYCLER_STATS_ADD(recycler, heapBlockFreeByteCount[this->GetHeapBlockType()], expectFreeCount * this->objectSize);
+    RECYCLER_STATS_ADD(recycler, heapBlockPageCount[this->GetHeapBlockType()], TBlockAttributes::PageCount);
+    RECYCLER_STATS_ADD(recycler, heapBlockLiveByteCount[this->GetHeapBlockType()], localMarkCount * this->objectSize);
+    RECYCLER_STATS_INC_IF(localMarkCount * 4 < objectCount, recycler, heapBlockSparseCount[this->GetHeapBlockType()]);
 
     Assert(!hasPendingDispose || (this->freeCount != 0));
     SweepState state = SweepStateSwept;
@@ -627,6 +627,22 @@ HeapBlockMap32::ResetWriteWatch(Recycler * recycler)
 #endif
     });
 }
+
+#ifdef RECYCLER_WRITE_BARRIER
+void
+HeapBlockMap32::ResetWriteBarrier(Recycler * recycler)
+{
+    // Only clear the card table for barrier segments; the other segments are tracked by write watch.
+    this->ForEachSegment(recycler, [=] (char * segmentStart, size_t segmentLength, Segment * segment, PageAllocator * segmentPageAllocator) {
+        Assert(segmentLength % AutoSystemInfo::PageSize == 0);
+
+        if (segmentPageAllocator == recycler->GetRecyclerWithBarrierPageAllocator())
+        {
+            RecyclerWriteBarrierManager::ResetWriteBarrier(segmentStart, segmentLength / AutoSystemInfo::PageSize);
+        }
+    });
+}
+#endif
 #endif
 
 bool
@@ -905,15 +921,20 @@ HeapBlockMap32::Rescan(Recycler * recycler, bool resetWriteWatch)
                 Assert(HeapBlockMap64::GetNodeStartAddress(pageAddress) == this->startAddress);
 #endif
 
-                // TODO: We are not resetting the write barrier here when RescanFlags_ResetWriteWatch is passed.
-                // We never have previously, but it still seems like we should.
-
                 BYTE writeBarrierByte = RecyclerWriteBarrierManager::GetWriteBarrier(pageAddress);
                 SwbVerboseTrace(recycler->GetRecyclerFlagsTable(), _u("Address: 0x%p, Write Barrier value: %u\n"), pageAddress, writeBarrierByte);
                 bool isDirty = (writeBarrierByte == 1);
 
                 if (isDirty)
                 {
+                    // Same as WRITE_WATCH_FLAG_RESET: clear the card before scanning the page so that
+                    // any write that happens during the scan dirties it again for the next rescan.
+                    if (resetWriteWatch)
+                    {
+                        RecyclerWriteBarrierManager::ResetWriteBarrier(pageAddress, 1);
+                        MemoryBarrier();
+                    }
+
                     if (RescanPage(pageAddress, &anyObjectsScannedOnPage, recycler) && anyObjectsScannedOnPage)
                     {
                         scannedPageCount++;
@@ -1391,6 +1412,19 @@ HeapBlockMap64::ResetWriteWatch(Recycler * recycler)
         node = node->next;
     }
 }
+
+#ifdef RECYCLER_WRITE_BARRIER
+void
+HeapBlockMap64::ResetWriteBarrier(Recycler * recycler)
+{
+    Node * node = this->list;
+    while (node != nullptr)
+    {
+        node->map.ResetWriteBarrier(recycler);
+        node = node->next;
+    }
+}
+#endif
 #endif
 
 void
@@ -71,6 +71,9 @@ public:
 
 #if ENABLE_CONCURRENT_GC || ENABLE_PARTIAL_GC
     void ResetWriteWatch(Recycler * recycler);
+#ifdef RECYCLER_WRITE_BARRIER
+    void ResetWriteBarrier(Recycler * recycler);
+#endif
     uint Rescan(Recycler * recycler, bool resetWriteWatch);
 #endif
     void MakeAllPagesReadOnly(Recycler* recycler);
@@ -259,6 +262,9 @@ public:
 
 #if ENABLE_CONCURRENT_GC || ENABLE_PARTIAL_GC
     void ResetWriteWatch(Recycler * recycler);
+#ifdef RECYCLER_WRITE_BARRIER
+    void ResetWriteBarrier(Recycler * recycler);
+#endif
     uint Rescan(Recycler * recycler, bool resetWriteWatch);
 #endif
     void MakeAllPagesReadOnly(Recycler* recycler);
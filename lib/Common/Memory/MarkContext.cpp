@@ -13,6 +13,8 @@
 MarkContext::MarkContext(Recycler * recycler, PagePool * pagePool) :
     recycler(recycler),
     pagePool(pagePool),
+    workQueue(nullptr),
+    workerIndex(0),
     markStack(pagePool),
     trackStack(pagePool)
 {
@@ -82,6 +84,30 @@ uint MarkContext::Split(uint targetCount, __in_ecount(targetCount) MarkContext *
 }
 
 
+void MarkContext::ShareWork()
+{
+    Assert(this->workQueue != nullptr && this->workQueue->IsEnabled());
+
+    if (this->markStack.HasSpareChunk())
+    {
+        this->workQueue->GiveWork(this);
+    }
+}
+
+
+bool MarkContext::StealWork()
+{
+    Assert(this->markStack.IsEmpty());
+
+    if (this->workQueue == nullptr || !this->workQueue->IsEnabled())
+    {
+        return false;
+    }
+
+    return this->workQueue->TakeWork(this);
+}
+
+
 void MarkContext::ProcessTracked()
 {
     if (trackStack.IsEmpty())
@@ -101,4 +127,135 @@ void MarkContext::ProcessTracked()
 }
 
 
+ParallelMarkWorkQueue::ParallelMarkWorkQueue() :
+    workerCount(0),
+    chunkCount(0),
+    activeWorkerCount(0),
+    waitingWorkerCount(0),
+    enabled(false)
+{
+}
+
+
+void ParallelMarkWorkQueue::Enable(uint workerCount, __in_ecount(workerCount) MarkContext ** workers)
+{
+    Assert(!this->enabled);
+    Assert(workerCount <= MaxWorkerCount);
+    Assert(this->chunkCount == 0);
+    Assert(this->activeWorkerCount == 0 && this->waitingWorkerCount == 0);
+
+    for (uint i = 0; i < workerCount; i++)
+    {
+        Assert(workers[i]->sharedChunks.IsEmpty());
+        workers[i]->workerIndex = i;
+        this->workers[i] = workers[i];
+    }
+    this->workerCount = workerCount;
+    this->enabled = true;
+}
+
+
+void ParallelMarkWorkQueue::Disable()
+{
+    // All workers must have finished by the time the parallel mark is done.
+    Assert(this->chunkCount == 0);
+    Assert(this->activeWorkerCount == 0 && this->waitingWorkerCount == 0);
+#if DBG
+    for (uint i = 0; i < this->workerCount; i++)
+    {
+        Assert(this->workers[i]->sharedChunks.IsEmpty());
+    }
+#endif
+
+    this->workerCount = 0;
+    this->enabled = false;
+}
 
+
+void ParallelMarkWorkQueue::EnterWorker()
+{
+    Assert(this->enabled);
+
+    InterlockedIncrement(&this->activeWorkerCount);
+}
+
+
+void ParallelMarkWorkQueue::GiveWork(MarkContext * markContext)
+{
+    AutoCriticalSection autocs(&markContext->sharedChunksCs);
+
+    markContext->markStack.GiveChunk(&markContext->sharedChunks);
+    InterlockedIncrement(&this->chunkCount);
+}
+
+
+bool ParallelMarkWorkQueue::StealChunk(MarkContext * markContext)
+{
+    // Take back our own shared pages first, then try the other workers, starting with our neighbor
+    // so that the idle threads don't all go after the same one.
+    for (uint i = 0; i < this->workerCount; i++)
+    {
+        MarkContext * victim = this->workers[(markContext->workerIndex + i) % this->workerCount];
+
+        // Unsynchronized peek; the list is checked again under the lock
+        if (victim->sharedChunks.IsEmpty())
+        {
+            continue;
+        }
+
+        AutoCriticalSection autocs(&victim->sharedChunksCs);
+        if (markContext->markStack.TakeChunk(&victim->sharedChunks))
+        {
+            InterlockedDecrement(&this->chunkCount);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool ParallelMarkWorkQueue::TakeWork(MarkContext * markContext)
+{
+    Assert(this->activeWorkerCount != 0);
+
+    if (StealChunk(markContext))
+    {
+        return true;
+    }
+
+    // Nothing to steal. Go idle, and wait for an active worker to share some of its work, or for
+    // all of them to finish. Our own shared list is empty now, and only active workers add pages,
+    // so once the active count drops to zero there is no work left anywhere.
+    InterlockedIncrement(&this->waitingWorkerCount);
+    InterlockedDecrement(&this->activeWorkerCount);
+
+    uint spinCount = 0;
+    while (this->activeWorkerCount != 0)
+    {
+        if (this->chunkCount != 0)
+        {
+            // Count ourselves as active before stealing, so that nobody can see all the workers
+            // idle while we hold a page.
+            InterlockedIncrement(&this->activeWorkerCount);
+            if (StealChunk(markContext))
+            {
+                InterlockedDecrement(&this->waitingWorkerCount);
+                return true;
+            }
+            InterlockedDecrement(&this->activeWorkerCount);
+        }
+
+        if (++spinCount < 64)
+        {
+            YieldProcessor();
+        }
+        else
+        {
+            SwitchToThread();
+        }
+    }
+
+    InterlockedDecrement(&this->waitingWorkerCount);
+    return false;
+}
@@ -5,11 +5,14 @@
 namespace Memory
 {
 class Recycler;
+class ParallelMarkWorkQueue;
 
 typedef JsUtil::SynchronizedDictionary<void *, void *, NoCheckHeapAllocator, PrimeSizePolicy, RecyclerPointerComparer, JsUtil::SimpleDictionaryEntry, Js::DefaultContainerLockPolicy, CriticalSection> MarkMap;
 
 class MarkContext
 {
+    friend class ParallelMarkWorkQueue;
+
 private:
     struct MarkCandidate
     {
@@ -27,6 +30,7 @@ public:
     void Clear();
 
     Recycler * GetRecycler() { return this->recycler; }
+    void SetWorkQueue(ParallelMarkWorkQueue * workQueue) { this->workQueue = workQueue; }
 
     bool AddMarkedObject(void * obj, size_t byteCount);
 #if ENABLE_CONCURRENT_GC
@@ -98,9 +102,17 @@ public:
     }
 #endif
 
+private:
+    void ShareWork();
+    bool StealWork();
+
 private:
     Recycler * recycler;
     PagePool * pagePool;
+    ParallelMarkWorkQueue * workQueue;
+    uint workerIndex;                                   // Our position among the workQueue's workers
+    CriticalSection sharedChunksCs;
+    PageStack<MarkCandidate>::ChunkList sharedChunks;   // Mark stack pages given up for idle workers to steal
     PageStack<MarkCandidate> markStack;
     PageStack<FinalizableObject *> trackStack;
 
@@ -111,5 +123,45 @@ private:
 #endif
 };
 
+// Load balancing for parallel mark, by work stealing.
+// Each parallel mark thread processes its own MarkContext.  While some thread is out of work, the
+// threads that still have work set full pages of their mark stack aside in their context's shared
+// list, and the idle threads steal them from there, looking at their neighbors first.
+// Marking is complete once no thread is active: only active threads share pages, and a thread only
+// goes idle once its own shared list is empty, so no page can be left behind.
+// The shared lists are guarded by a critical section per context rather than being lock-free deques.
+// The unit of sharing is a whole mark stack page, so the lock is taken once per page given or stolen,
+// and only while some thread is idle; pushing and popping objects on a thread's own mark stack is not
+// synchronized at all. The pages are chained through the pages themselves, not held in a fixed size
+// array, which is what a Chase-Lev style deque would need.
+class ParallelMarkWorkQueue
+{
+public:
+    // One worker per participating MarkContext: the main markContext and the recycler's parallel contexts
+    static const uint MaxWorkerCount = 16;
+
+    ParallelMarkWorkQueue();
+
+    void Enable(uint workerCount, __in_ecount(workerCount) MarkContext ** workers);
+    void Disable();
+    bool IsEnabled() const { return this->enabled; }
+
+    // Cheap check done by active threads between objects; may be stale.
+    bool HasWaitingWorkers() const { return this->waitingWorkerCount != 0; }
+
+    void EnterWorker();
+    void GiveWork(MarkContext * markContext);
+    bool TakeWork(MarkContext * markContext);
+
+private:
+    bool StealChunk(MarkContext * markContext);
+
+    MarkContext * workers[MaxWorkerCount];
+    uint workerCount;
+    LONG volatile chunkCount;
+    LONG volatile activeWorkerCount;
+    LONG volatile waitingWorkerCount;
+    bool enabled;
+};
 
 }
@@ -174,39 +174,61 @@ void MarkContext::ProcessMark()
     }
 #endif
 
-#if defined(_M_IX86) || defined(_M_X64)
-    MarkCandidate current, next;
+    // When marking in parallel, share work with idle threads and steal work once we run out.
+    // (See ParallelMarkWorkQueue)
+    bool shareWork = parallel && this->workQueue != nullptr && this->workQueue->IsEnabled();
+    if (shareWork)
+    {
+        this->workQueue->EnterWorker();
+    }
 
-    while (markStack.Pop(&current))
+    do
     {
-        // Process entries and prefetch as we go.
-        while (markStack.Pop(&next))
+#if defined(_M_IX86) || defined(_M_X64)
+        MarkCandidate current, next;
+
+        while (markStack.Pop(&current))
         {
-            // Prefetch the next entry so it's ready when we need it.
-            _mm_prefetch((char *)next.obj, _MM_HINT_T0);
+            // Process entries and prefetch as we go.
+            while (markStack.Pop(&next))
+            {
+                // Prefetch the next entry so it's ready when we need it.
+                _mm_prefetch((char *)next.obj, _MM_HINT_T0);
 
-            // Process the previously retrieved entry.
-            ScanObject<parallel, interior>(current.obj, current.byteCount);
+                // Process the previously retrieved entry.
+                ScanObject<parallel, interior>(current.obj, current.byteCount);
 
-            current = next;
-        }
+                current = next;
 
-        // The stack is empty, but we still have a previously retrieved entry; process it now.
-        ScanObject<parallel, interior>(current.obj, current.byteCount);
+                if (shareWork && this->workQueue->HasWaitingWorkers())
+                {
+                    ShareWork();
+                }
+            }
 
-        // Processing that entry may have generated more entries in the mark stack, so continue the loop.
-    }
+            // The stack is empty, but we still have a previously retrieved entry; process it now.
+            ScanObject<parallel, interior>(current.obj, current.byteCount);
+
+            // Processing that entry may have generated more entries in the mark stack, so continue the loop.
+        }
 #else
-    // _mm_prefetch intrinsic is specific to Intel platforms.
-    // CONSIDER: There does seem to be a compiler intrinsic for prefetch on ARM,
-    // however, the information on this is scarce, so for now just don't do prefetch on ARM.
-    MarkCandidate current;
+        // _mm_prefetch intrinsic is specific to Intel platforms.
+        // CONSIDER: There does seem to be a compiler intrinsic for prefetch on ARM,
+        // however, the information on this is scarce, so for now just don't do prefetch on ARM.
+        MarkCandidate current;
 
-    while (markStack.Pop(&current))
-    {
-        ScanObject<parallel, interior>(current.obj, current.byteCount);
-    }
+        while (markStack.Pop(&current))
+        {
+            ScanObject<parallel, interior>(current.obj, current.byteCount);
+
+            if (shareWork && this->workQueue->HasWaitingWorkers())
+            {
+                ShareWork();
+            }
+        }
 #endif
+    }
+    while (shareWork && StealWork());
 
     Assert(markStack.IsEmpty());
 }
@@ -6,6 +6,161 @@
 
 #define UpdateMinimum(dst, src) if (dst > src) { dst = src; }
 
+//=============================================================================================================
+// PageSegmentPool
+//=============================================================================================================
+
+PageSegmentPool PageSegmentPool::Instance;
+
+PageSegmentPool::PageSegmentPool() :
+    head(nullptr),
+    pooledPageCount(0)
+{
+}
+
+bool
+PageSegmentPool::Add(__in char * address, size_t pageCount, DWORD allocFlags, const void * owner, AllocationPolicyManager * policyManager)
+{
+    Assert(address != nullptr);
+    Assert(sizeof(PooledSegmentEntry) <= AutoSystemInfo::PageSize);
+
+    AutoCriticalSection autoCS(&cs);
+    if (pooledPageCount + pageCount > (size_t)CONFIG_FLAG(PageSegmentPoolPageCount))
+    {
+        return false;
+    }
+
+    // The pages stay charged to the policy manager of the allocator that released them until
+    // another allocator takes them (and is charged in turn) or the pool gives them back to the OS.
+    PooledSegmentEntry * entry = (PooledSegmentEntry *)address;
+    entry->pageCount = pageCount;
+    entry->allocFlags = allocFlags;
+    entry->owner = owner;
+    entry->policyManager = policyManager;
+    entry->next = head;
+    head = entry;
+    pooledPageCount += pageCount;
+    return true;
+}
+
+char *
+PageSegmentPool::Take(size_t pageCount, DWORD allocFlags, const void * owner, AllocationPolicyManager * policyManager, bool zeroPages)
+{
+    // Unsynchronized peek; the pool is empty (or disabled) most of the time
+    if (head == nullptr)
+    {
+        return nullptr;
+    }
+
+    PooledSegmentEntry * entry = nullptr;
+    bool sameOwner = false;
+    {
+        AutoCriticalSection autoCS(&cs);
+        PooledSegmentEntry ** prev = &head;
+        while (*prev != nullptr)
+        {
+            if ((*prev)->pageCount == pageCount && (*prev)->allocFlags == allocFlags)
+            {
+                PooledSegmentEntry * candidate = *prev;
+                const size_t byteCount = pageCount * AutoSystemInfo::PageSize;
+
+                // Pages going back to the policy manager they are charged to stay charged. Otherwise charge the
+                // taker first, and move on if it is over its limit. The previous owner is released under the lock
+                // so that its policy manager can't go away in DetachPolicyManager meanwhile.
+                if (candidate->policyManager != policyManager)
+                {
+                    if (policyManager != nullptr && !policyManager->RequestAlloc(byteCount))
+                    {
+                        break;
+                    }
+                    if (candidate->policyManager != nullptr)
+                    {
+                        candidate->policyManager->ReportFree(byteCount);
+                    }
+                }
+
+                // A policy manager that is still attached identifies a live runtime, so together with the
+                // allocator it tells us whether the pages are coming back to the allocator that released them
+                sameOwner = candidate->owner == owner && policyManager != nullptr && candidate->policyManager == policyManager;
+
+                entry = candidate;
+                *prev = entry->next;
+                pooledPageCount -= pageCount;
+                break;
+            }
+            prev = &(*prev)->next;
+        }
+    }
+
+    if (entry == nullptr)
+    {
+        return nullptr;
+    }
+
+    // The pages are still committed with whatever the previous owner left in them. Only the allocator that wrote
+    // them may see that again, and only if it doesn't zero its pages anyway.
+    if (zeroPages || !sameOwner)
+    {
+        memset(entry, 0, pageCount * AutoSystemInfo::PageSize);
+    }
+    else
+    {
+        memset(entry, 0, sizeof(PooledSegmentEntry));
+    }
+    return (char *)entry;
+}
+
+void
+PageSegmentPool::DetachPolicyManager(AllocationPolicyManager * policyManager)
+{
+    Assert(policyManager != nullptr);
+
+    // The policy manager is about to be deleted. Keep its pooled segments for the other allocators,
+    // but stop charging them to it.
+    AutoCriticalSection autoCS(&cs);
+    for (PooledSegmentEntry * entry = head; entry != nullptr; entry = entry->next)
+    {
+        if (entry->policyManager == policyManager)
+        {
+            policyManager->ReportFree(entry->pageCount * AutoSystemInfo::PageSize);
+            entry->policyManager = nullptr;
+        }
+    }
+}
+
+void
+PageSegmentPool::Flush()
+{
+    PooledSegmentEntry * entry;
+    {
+        AutoCriticalSection autoCS(&cs);
+        entry = head;
+        head = nullptr;
+        pooledPageCount = 0;
+
+        for (PooledSegmentEntry * charged = entry; charged != nullptr; charged = charged->next)
+        {
+            if (charged->policyManager != nullptr)
+            {
+                charged->policyManager->ReportFree(charged->pageCount * AutoSystemInfo::PageSize);
+                charged->policyManager = nullptr;
+            }
+        }
+    }
+
+    while (entry != nullptr)
+    {
+        PooledSegmentEntry * next = entry->next;
+#if defined(_M_X64_OR_ARM64) && defined(RECYCLER_WRITE_BARRIER_BYTE)
+        // Pooled segments are still reserved, so the write barrier hears of them only once they are released
+        RecyclerWriteBarrierManager::OnSegmentFree((char *)entry, entry->pageCount);
+#endif
+        BOOL success = ::VirtualFree(entry, 0, MEM_RELEASE);
+        Assert(success);
+        entry = next;
+    }
+}
+
 //=============================================================================================================
 // Segment
 //=============================================================================================================
@@ -53,6 +208,49 @@ bool SegmentBase<T>::IsInPreReservedHeapPageAllocator() const
     return this->allocator->GetVirtualAllocator() != nullptr;
 }
 
+template<typename T>
+bool SegmentBase<T>::CanUseSegmentPool() const
+{
+    // Only plain data segments can be shared. Pre-reserved and custom heap segments
+    // belong to a specific reservation or carry executable protection, and secondary
+    // allocations (xdata) are tied to the owning allocator.
+    return this->secondaryAllocPageCount == 0
+        && this->leadingGuardPageCount == 0
+        && this->trailingGuardPageCount == 0
+        && !this->IsInPreReservedHeapPageAllocator()
+        && !this->IsInCustomHeapAllocator();
+}
+
+template<typename T>
+bool
+SegmentBase<T>::ReleaseToSegmentPool()
+{
+#ifdef PAGEALLOCATOR_PROTECT_FREEPAGE
+    // Free pages are not accessible, so we can't write the pool entry into them
+    return false;
+#else
+    Assert(this->address != nullptr);
+    Assert(this->secondaryAllocator == nullptr);
+
+    if (!CanUseSegmentPool())
+    {
+        return false;
+    }
+
+    // The write barrier isn't told about the segment going away here: the reservation stays, and the pool tells
+    // it when it releases the segment. If the pool is full, the destructor frees the segment and tells it as usual.
+    if (!PageSegmentPool::Instance.Add(this->address, this->segmentPageCount, allocator->allocFlags, allocator, allocator->GetAllocationPolicyManager()))
+    {
+        return false;
+    }
+
+    // The reservation now belongs to the pool; the destructor must not free it again.
+    // The pages stay charged to our policy manager while they are in the pool.
+    this->address = nullptr;
+    return true;
+#endif
+}
+
 template<typename T>
 bool
 SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
@@ -90,21 +288,31 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
     }
 #endif
 
-    if (!this->allocator->RequestAlloc(totalPages * AutoSystemInfo::PageSize))
+    bool committed = (allocFlags & MEM_COMMIT) != 0;
+    if (committed && CanUseSegmentPool() && !this->allocator->DisableAllocationOutOfMemory())
     {
-        return false;
+        // Reuse a committed segment released by a page allocator if there is one. The pool charges the pages to our
+        // policy manager as it hands them over, unless they are charged to it already.
+        this->address = PageSegmentPool::Instance.Take(totalPages, this->allocator->allocFlags, this->allocator,
+            this->allocator->GetAllocationPolicyManager(), this->allocator->ZeroPages());
     }
 
-    this->address = (char *)GetAllocator()->GetVirtualAllocator()->Alloc(NULL, totalPages * AutoSystemInfo::PageSize, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator());
-
     if (this->address == nullptr)
     {
-        this->allocator->ReportFailure(totalPages * AutoSystemInfo::PageSize);
-        return false;
+        if (!this->allocator->RequestAlloc(totalPages * AutoSystemInfo::PageSize))
+        {
+            return false;
+        }
+
+        this->address = (char *)GetAllocator()->GetVirtualAllocator()->Alloc(NULL, totalPages * AutoSystemInfo::PageSize, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator());
+        if (this->address == nullptr)
+        {
+            this->allocator->ReportFailure(totalPages * AutoSystemInfo::PageSize);
+            return false;
+        }
     }
 
     originalAddress = this->address;
-    bool committed = (allocFlags & MEM_COMMIT) != 0;
     if (addGuardPages)
     {
 #if DBG_DUMP
@@ -634,6 +842,11 @@ PageAllocatorBase<T>::~PageAllocatorBase()
 
     ReleaseSegmentList(&segments);
     ReleaseSegmentList(&fullSegments);
+    FOREACH_DLISTBASE_ENTRY(PageSegmentBase<T>, emptySegment, &emptySegments)
+    {
+        ReleaseEmptySegmentToPool(&emptySegment);
+    }
+    NEXT_DLISTBASE_ENTRY;
     ReleaseSegmentList(&emptySegments);
     ReleaseSegmentList(&decommitSegments);
     ReleaseSegmentList(&largeSegments);
@@ -1439,6 +1652,7 @@ PageAllocatorBase<T>::ReleasePages(__in void * address, uint pageCount, __in voi
         {
             Assert(emptySegments.Head().GetDecommitPageCount() == 0);
             LogFreeSegment(&emptySegments.Head());
+            ReleaseEmptySegmentToPool(&emptySegments.Head());
             emptySegments.RemoveHead(&NoThrowNoMemProtectHeapAllocator::Instance);
             this->freePageCount -= maxAllocPageCount;
 
@@ -1816,6 +2030,7 @@ PageAllocatorBase<T>::DecommitNow(bool all)
         {
             Assert(emptySegments.Head().GetDecommitPageCount() == 0);
             LogFreeSegment(&emptySegments.Head());
+            ReleaseEmptySegmentToPool(&emptySegments.Head());
             emptySegments.RemoveHead(&NoThrowNoMemProtectHeapAllocator::Instance);
 
             pageToDecommit -= maxAllocPageCount;
@@ -2282,6 +2497,19 @@ void PageAllocatorBase<TVirtualAlloc>::ReleaseSegmentList(DListBase<T> * segment
     segmentList->Clear(&NoThrowNoMemProtectHeapAllocator::Instance);
 }
 
+template<typename T>
+void
+PageAllocatorBase<T>::ReleaseEmptySegmentToPool(PageSegmentBase<T> * segment)
+{
+    Assert(segment->IsEmpty());
+    Assert(segment->GetDecommitPageCount() == 0);
+
+    if (segment->ReleaseToSegmentPool())
+    {
+        PAGE_ALLOC_TRACE_AND_STATS_0(_u("Released empty segment to the segment pool"));
+    }
+}
+
 template<typename T>
 BOOL
 HeapPageAllocator<T>::ProtectPages(__in char* address, size_t pageCount, __in void* segmentParam, DWORD dwVirtualProtectFlags, DWORD desiredOldProtectFlag)
@@ -98,6 +98,52 @@ public:
     virtual ~SecondaryAllocator() {};
 };
 
+/*
+ * The page segment pool is a process-wide cache of committed segment reservations
+ * released by page allocators. When an allocator gives up an empty segment, the
+ * reservation is parked here instead of being returned to the OS, so that another
+ * allocator (typically one owned by a busier runtime on another thread) can pick
+ * it up without paying for a VirtualFree/VirtualAlloc round trip and the page
+ * faults of recommitting the memory.
+ * Pooled segments are kept in a lock protected singly linked list; the entries are
+ * stored in the first page of the pooled reservations themselves. Each operation
+ * moves a whole segment, so the lock is taken once per segment rather than once per
+ * page. The total number of pooled pages is bounded by the PageSegmentPoolPageCount flag,
+ * which is 0 (pool disabled) by default.
+ * Pooled pages remain charged to the allocation policy manager of the allocator that
+ * released them, so they keep counting against that runtime's memory limit until
+ * another allocator takes them over and is charged for them in turn.
+ * Pages taken by an allocator other than the one that released them are zeroed, so
+ * that nothing written by one runtime is visible to another.
+ */
+class PageSegmentPool
+{
+public:
+    PageSegmentPool();
+
+    bool Add(__in char * address, size_t pageCount, DWORD allocFlags, const void * owner, AllocationPolicyManager * policyManager);
+    char * Take(size_t pageCount, DWORD allocFlags, const void * owner, AllocationPolicyManager * policyManager, bool zeroPages);
+    void DetachPolicyManager(AllocationPolicyManager * policyManager);
+    void Flush();
+
+    size_t GetPageCount() const { return pooledPageCount; }
+
+    static PageSegmentPool Instance;
+private:
+    struct PooledSegmentEntry
+    {
+        PooledSegmentEntry * next;
+        size_t pageCount;
+        DWORD allocFlags;
+        const void * owner;             // The page allocator that released the segment; only compared
+        AllocationPolicyManager * policyManager;
+    };
+
+    CriticalSection cs;
+    PooledSegmentEntry * head;
+    size_t pooledPageCount;
+};
+
 /*
  * A segment is a collection of pages. A page corresponds to the concept of an
  * OS memory page. Segments allocate memory using the OS VirtualAlloc call.
@@ -129,6 +175,7 @@ public:
     bool IsInPreReservedHeapPageAllocator() const;
 
     bool Initialize(DWORD allocFlags, bool excludeGuardPages);
+    bool ReleaseToSegmentPool();
 
 #if DBG
     virtual bool IsPageSegment() const
@@ -168,6 +215,8 @@ protected:
     static const uint maxGuardPages = 15;
     static const uint minGuardPages =  1;
 
+    bool CanUseSegmentPool() const;
+
     SecondaryAllocator* secondaryAllocator;
     char * address;
     PageAllocatorBase<TVirtualAlloc> * allocator;
@@ -717,6 +766,7 @@ private:
 
     template <typename T>
     void ReleaseSegmentList(DListBase<T> * segmentList);
+    void ReleaseEmptySegmentToPool(PageSegmentBase<TVirtualAlloc> * segment);
 
 protected:
     // Instrumentation
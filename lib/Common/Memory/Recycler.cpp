@@ -132,13 +132,8 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
 #endif
     threadPageAllocator(pageAllocator),
     markPagePool(configFlagsTable),
-    parallelMarkPagePool1(configFlagsTable),
-    parallelMarkPagePool2(configFlagsTable),
-    parallelMarkPagePool3(configFlagsTable),
     markContext(this, &this->markPagePool),
-    parallelMarkContext1(this, &this->parallelMarkPagePool1),
-    parallelMarkContext2(this, &this->parallelMarkPagePool2),
-    parallelMarkContext3(this, &this->parallelMarkPagePool3),
+    parallelMarkContextCount(0),
 #if ENABLE_PARTIAL_GC
     clientTrackedObjectAllocator(_u("CTO-List"), GetPageAllocator(), Js::Throw::OutOfMemory),
 #endif
@@ -166,8 +161,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     concurrentThread(NULL),
     concurrentWorkReadyEvent(NULL),
     concurrentWorkDoneEvent(NULL),
-    parallelThread1(this, &Recycler::ParallelWorkFunc<0>),
-    parallelThread2(this, &Recycler::ParallelWorkFunc<1>),
     priorityBoost(false),
     isAborting(false),
 #if DBG
@@ -254,12 +247,11 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     , objectBeforeCollectCallbackMap(nullptr)
     , objectBeforeCollectCallbackState(ObjectBeforeCollectCallback_None)
 {
+    markContext.SetWorkQueue(&parallelMarkWorkQueue);
+
 #ifdef RECYCLER_MARK_TRACK
     this->markMap = NoCheckHeapNew(MarkMap, &NoCheckHeapAllocator::Instance, 163, &markMapCriticalSection);
     markContext.SetMarkMap(markMap);
-    parallelMarkContext1.SetMarkMap(markMap);
-    parallelMarkContext2.SetMarkMap(markMap);
-    parallelMarkContext3.SetMarkMap(markMap);
 #endif
 
 #ifdef RECYCLER_MEMORY_VERIFY
@@ -326,9 +318,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     // recycler requires at least Recycler::PrimaryMarkStackReservedPageCount to function properly for the main mark context
     this->markContext.SetMaxPageCount(max(static_cast<size_t>(GetRecyclerFlagsTable().MaxMarkStackPageCount), static_cast<size_t>(Recycler::PrimaryMarkStackReservedPageCount)));
-    this->parallelMarkContext1.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext2.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext3.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
 
     if (GetRecyclerFlagsTable().IsEnabled(Js::GCMemoryThresholdFlag))
     {
@@ -510,9 +499,12 @@ Recycler::~Recycler()
 #endif
 
     markContext.Release();
-    parallelMarkContext1.Release();
-    parallelMarkContext2.Release();
-    parallelMarkContext3.Release();
+    for (uint i = 0; i < this->parallelMarkContextCount; i++)
+    {
+        this->parallelMarkContexts[i]->markContext.Release();
+        HeapDelete(this->parallelMarkContexts[i]);
+    }
+    this->parallelMarkContextCount = 0;
 
     // Clean up the weak reference map so that
     // objects being finalized can safely refer to weak references
@@ -826,8 +818,9 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
 
 #if ENABLE_CONCURRENT_GC
     // Default to non-concurrent
-    uint numProcs = (uint)AutoSystemInfo::Data.GetNumberOfPhysicalProcessors();
-    this->maxParallelism = (numProcs > 4) || CUSTOM_PHASE_FORCE1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase) ? 4 : numProcs;
+    this->maxParallelism = GetDefaultMaxParallelism();
+    CreateParallelMarkContexts(this->maxParallelism - 1);
+    this->maxParallelism = this->parallelMarkContextCount + 1;
 
     if (forceInThread)
     {
@@ -2100,9 +2093,11 @@ Recycler::ResetMarkCollectionState()
 
     // If we aborted after doing a background parallel Mark, we wouldn't have cleaned up the
     // parallel markContexts yet. Clean these up now.
-    // Note parallelMarkContext1 is not used in background parallel (see DoBackgroundParallelMark)
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+    // Note the first parallel context is not used in background parallel (see DoBackgroundParallelMark)
+    for (uint i = 1; i < this->parallelMarkContextCount; i++)
+    {
+        this->parallelMarkContexts[i]->markContext.Cleanup();
+    }
 
     this->ClearNeedOOMRescan();
     DebugOnly(this->isProcessingRescan = false);
@@ -2256,18 +2251,80 @@ Recycler::FinishMark(DWORD waitTime)
 }
 
 #if ENABLE_CONCURRENT_GC
+void
+Recycler::SetMaxParallelism(uint maxParallelism)
+{
+    // Only lowers (or restores) the parallelism picked in Initialize; the parallel threads
+    // are started on demand, so this can be changed between collections.
+    Assert(!this->CollectionInProgress());
+
+    this->maxParallelism = max(1u, min(maxParallelism, this->parallelMarkContextCount + 1));
+}
+
+uint
+Recycler::GetDefaultMaxParallelism() const
+{
+    // One mark thread per physical processor, or as configured, up to the number of contexts we can mark with
+    uint maxParallelism = (uint)AutoSystemInfo::Data.GetNumberOfPhysicalProcessors();
+    uint configuredParallelism = (uint)CUSTOM_CONFIG_FLAG(GetRecyclerFlagsTable(), RecyclerMaxParallelMark);
+    if (configuredParallelism != 0)
+    {
+        maxParallelism = min(maxParallelism, configuredParallelism);
+    }
+
+    if (CUSTOM_PHASE_FORCE1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase))
+    {
+        // Parallel mark forced on: mark at least 4 ways even on fewer processors
+        maxParallelism = max(maxParallelism, configuredParallelism != 0 ? configuredParallelism : 4u);
+    }
+
+    return max(1u, min(maxParallelism, MaxParallelMarkContextCount + 1));
+}
+
+void
+Recycler::CreateParallelMarkContexts(uint count)
+{
+    // Created up front for the most parallelism we may use. The page pools don't hold any pages
+    // until their contexts are marked, and the threads are started on demand.
+    Assert(this->parallelMarkContextCount == 0);
+    Assert(count <= MaxParallelMarkContextCount);
+
+    for (uint i = 0; i < count; i++)
+    {
+        ParallelMarkContext * parallelMarkContext = HeapNewNoThrow(ParallelMarkContext, this, GetRecyclerFlagsTable());
+        if (parallelMarkContext == nullptr)
+        {
+            // Mark with the contexts we have
+            break;
+        }
+
+        parallelMarkContext->markContext.SetWorkQueue(&parallelMarkWorkQueue);
+#ifdef RECYCLER_MARK_TRACK
+        parallelMarkContext->markContext.SetMarkMap(markMap);
+#endif
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+        parallelMarkContext->markContext.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
+#endif
+        this->parallelMarkContexts[this->parallelMarkContextCount++] = parallelMarkContext;
+    }
+}
+
 void
 Recycler::DoParallelMark()
 {
     Assert(this->enableParallelMark);
-    Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+    Assert(this->maxParallelism > 1 && this->maxParallelism <= this->parallelMarkContextCount + 1);
 
     // Split the mark stack into [this->maxParallelism] equal pieces.
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    MarkContext * splitContexts[3] = { &parallelMarkContext1, &parallelMarkContext2, &parallelMarkContext3 };
+    MarkContext * splitContexts[MaxParallelMarkContextCount];
+    for (uint i = 0; i < this->maxParallelism - 1; i++)
+    {
+        splitContexts[i] = &this->parallelMarkContexts[i]->markContext;
+    }
     uint actualSplitCount = markContext.Split(this->maxParallelism - 1, splitContexts);
 
-    Assert(actualSplitCount <= 3);
+    Assert(actualSplitCount <= this->maxParallelism - 1);
 
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
@@ -2285,24 +2342,37 @@ Recycler::DoParallelMark()
         StartQueueTrackedObject();
     }
 
+    // Let the threads balance their work once their own portion of the split runs out
+    bool shareWork = CUSTOM_CONFIG_FLAG(GetRecyclerFlagsTable(), RecyclerParallelMarkWorkSharing);
+    if (shareWork)
+    {
+        MarkContext * workers[ParallelMarkWorkQueue::MaxWorkerCount];
+        workers[0] = &markContext;
+        for (uint i = 0; i < actualSplitCount; i++)
+        {
+            workers[i + 1] = splitContexts[i];
+        }
+        parallelMarkWorkQueue.Enable(actualSplitCount + 1, workers);
+    }
+
     // Kick off marking on the background thread
     bool concurrentSuccess = StartConcurrent(CollectionStateParallelMark);
 
-    // If there's enough work to split, then kick off marking on parallel threads too.
+    // If there's enough work to split, then kick off marking on parallel threads too; parallel thread i
+    // marks splitContexts[i + 1]. Stop at the first one that fails to start.
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    if (concurrentSuccess && actualSplitCount >= 2)
+    uint parallelThreadCount = actualSplitCount - 1;
+    uint startedParallelThreadCount = 0;
+    if (concurrentSuccess)
     {
-        parallelSuccess1 = parallelThread1.StartConcurrent();
-        if (parallelSuccess1 && actualSplitCount == 3)
+        while (startedParallelThreadCount < parallelThreadCount && GetParallelThread(startedParallelThreadCount)->StartConcurrent())
         {
-            parallelSuccess2 = parallelThread2.StartConcurrent();
+            startedParallelThreadCount++;
         }
     }
 
     // Process our portion of the split.
-    this->ProcessParallelMark(false, &parallelMarkContext1);
+    this->ProcessParallelMark(false, splitContexts[0]);
 
     // If we successfully launched parallel work, wait for it to complete.
     // If we failed, then process the work in-thread now.
@@ -2315,28 +2385,21 @@ Recycler::DoParallelMark()
         this->ProcessParallelMark(false, &markContext);
     }
 
-    if (actualSplitCount >= 2)
+    for (uint i = 0; i < parallelThreadCount; i++)
     {
-        if (parallelSuccess1)
+        if (i < startedParallelThreadCount)
         {
-            parallelThread1.WaitForConcurrent();
+            GetParallelThread(i)->WaitForConcurrent();
         }
         else
         {
-            this->ProcessParallelMark(false, &parallelMarkContext2);
+            this->ProcessParallelMark(false, splitContexts[i + 1]);
         }
+    }
 
-        if (actualSplitCount == 3)
-        {
-            if (parallelSuccess2)
-            {
-                parallelThread2.WaitForConcurrent();
-            }
-            else
-            {
-                this->ProcessParallelMark(false, &parallelMarkContext3);
-            }
-        }
+    if (shareWork)
+    {
+        parallelMarkWorkQueue.Disable();
     }
 
     this->collectionState = CollectionStateMark;
@@ -2364,20 +2427,22 @@ Recycler::DoBackgroundParallelMark()
 {
     // Split the mark stack into [this->maxParallelism - 1] equal pieces (thus, "- 2" below).
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    // The parallel threads are hardwired to use parallelMarkContext2/3, so we split using those.
+    // Parallel thread i is hardwired to parallel context i + 1, so we split using those.
     uint actualSplitCount = 0;
-    MarkContext * splitContexts[2] = { &parallelMarkContext2, &parallelMarkContext3 };
+    MarkContext * splitContexts[MaxParallelMarkContextCount];
     if (this->enableParallelMark)
     {
-        Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+        Assert(this->maxParallelism > 0 && this->maxParallelism <= this->parallelMarkContextCount + 1);
         if (this->maxParallelism > 2)
         {
+            for (uint i = 0; i < this->maxParallelism - 2; i++)
+            {
+                splitContexts[i] = &this->parallelMarkContexts[i + 1]->markContext;
+            }
             actualSplitCount = markContext.Split(this->maxParallelism - 2, splitContexts);
         }
     }
 
-    Assert(actualSplitCount <= 2);
-
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
     {
@@ -2394,14 +2459,25 @@ Recycler::DoBackgroundParallelMark()
 
     this->collectionState = CollectionStateBackgroundParallelMark;
 
-    // Kick off marking on parallel threads too, if there is work for them
+    bool shareWork = CUSTOM_CONFIG_FLAG(GetRecyclerFlagsTable(), RecyclerParallelMarkWorkSharing);
+    if (shareWork)
+    {
+        MarkContext * workers[ParallelMarkWorkQueue::MaxWorkerCount];
+        workers[0] = &markContext;
+        for (uint i = 0; i < actualSplitCount; i++)
+        {
+            workers[i + 1] = splitContexts[i];
+        }
+        parallelMarkWorkQueue.Enable(actualSplitCount + 1, workers);
+    }
+
+    // Kick off marking on parallel threads too, if there is work for them; parallel thread i marks
+    // splitContexts[i]. Stop at the first one that fails to start.
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    parallelSuccess1 = parallelThread1.StartConcurrent();
-    if (parallelSuccess1 && actualSplitCount == 2)
+    uint startedParallelThreadCount = 0;
+    while (startedParallelThreadCount < actualSplitCount && GetParallelThread(startedParallelThreadCount)->StartConcurrent())
     {
-        parallelSuccess2 = parallelThread2.StartConcurrent();
+        startedParallelThreadCount++;
     }
 
     // Process our portion of the split.
@@ -2409,27 +2485,23 @@ Recycler::DoBackgroundParallelMark()
 
     // If we successfully launched parallel work, wait for it to complete.
     // If we failed, then process the work in-thread now.
-    if (parallelSuccess1)
-    {
-        parallelThread1.WaitForConcurrent();
-    }
-    else
-    {
-        this->ProcessParallelMark(true, &parallelMarkContext2);
-    }
-
-    if (actualSplitCount == 2)
+    for (uint i = 0; i < actualSplitCount; i++)
     {
-        if (parallelSuccess2)
+        if (i < startedParallelThreadCount)
         {
-            parallelThread2.WaitForConcurrent();
+            GetParallelThread(i)->WaitForConcurrent();
         }
         else
         {
-            this->ProcessParallelMark(true, &parallelMarkContext3);
+            this->ProcessParallelMark(true, splitContexts[i]);
         }
     }
 
+    if (shareWork)
+    {
+        parallelMarkWorkQueue.Disable();
+    }
+
     this->collectionState = CollectionStateConcurrentMark;
 }
 #endif
@@ -2466,7 +2538,7 @@ Recycler::RootMark(CollectionState markState)
     this->collectionState = markState;
 
 #if ENABLE_CONCURRENT_GC
-    if (this->enableParallelMark)
+    if (this->enableParallelMark && this->maxParallelism > 1)
     {
         this->DoParallelMark();
     }
@@ -2548,15 +2620,11 @@ Recycler::EndMark()
     // Clean up mark contexts, which will release held free pages
     // Do this for all contexts before we decommit, to make sure all pages are freed
     markContext.Cleanup();
-    parallelMarkContext1.Cleanup();
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+    ForEachParallelMarkContext([](MarkContext * context) { context->Cleanup(); });
 
     // Decommit all pages
     markContext.DecommitPages();
-    parallelMarkContext1.DecommitPages();
-    parallelMarkContext2.DecommitPages();
-    parallelMarkContext3.DecommitPages();
+    ForEachParallelMarkContext([](MarkContext * context) { context->DecommitPages(); });
 
     GCETW(GC_DECOMMIT_CONCURRENT_COLLECT_PAGE_ALLOCATOR_STOP, (this));
 
@@ -2643,9 +2711,7 @@ Recycler::EndMarkOnLowMemory()
     while (this->NeedOOMRescan());
 
     Assert(!markContext.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext1.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext2.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext3.GetPageAllocator()->DisableAllocationOutOfMemory());
+    ForEachParallelMarkContext([](MarkContext * context) { Assert(!context->GetPageAllocator()->DisableAllocationOutOfMemory()); });
     CUSTOM_PHASE_PRINT_TRACE1(GetRecyclerFlagsTable(), Js::RecyclerPhase, _u("EndMarkOnLowMemory iterations: %d\n"), iterations);
 
 #if ENABLE_PARTIAL_GC
@@ -2670,7 +2736,9 @@ Recycler::EndMarkOnLowMemory()
 bool
 Recycler::IsMarkStackEmpty()
 {
-    return (markContext.IsEmpty() && parallelMarkContext1.IsEmpty() && parallelMarkContext2.IsEmpty() && parallelMarkContext3.IsEmpty());
+    bool isEmpty = markContext.IsEmpty();
+    ForEachParallelMarkContext([&](MarkContext * context) { isEmpty = isEmpty && context->IsEmpty(); });
+    return isEmpty;
 }
 #endif
 
@@ -2799,6 +2867,12 @@ Recycler::Sweep(bool concurrent)
                     // We haven't done any partial collection yet, just get out of partial collect mode
                     this->inPartialCollectMode = false;
                 }
+#ifdef RECYCLER_WRITE_BARRIER
+                else
+                {
+                    heapBlockMap.ResetWriteBarrier(this);
+                }
+#endif
                 RECYCLER_PROFILE_EXEC_END(this, Js::ResetWriteWatchPhase);
             }
 #endif
@@ -4048,9 +4122,7 @@ Recycler::ProcessTrackedObjects()
 
     // If we did a parallel mark, we need to process any queued tracked objects from the parallel mark stack as well.
     // If we didn't, this will do nothing.
-    parallelMarkContext1.ProcessTracked();
-    parallelMarkContext2.ProcessTracked();
-    parallelMarkContext3.ProcessTracked();
+    ForEachParallelMarkContext([](MarkContext * context) { context->ProcessTracked(); });
 
     DebugOnly(this->isProcessingTrackedObjects = false);
 
@@ -4534,8 +4606,10 @@ Recycler::FinalizeConcurrent(bool restoreState)
 
     // Shutdown parallel threads and return the handle for them so the caller can
     // close it.
-    parallelThread1.Shutdown();
-    parallelThread2.Shutdown();
+    for (uint i = 1; i < this->parallelMarkContextCount; i++)
+    {
+        this->parallelMarkContexts[i]->parallelThread.Shutdown();
+    }
 
 #ifdef IDLE_DECOMMIT_ENABLED
     if (concurrentIdleDecommitEvent != nullptr)
@@ -4604,32 +4678,20 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
     else
     {
         bool startConcurrentThread = true;
-        bool startedParallelThread1 = false;
-        bool startedParallelThread2 = false;
+        uint startedParallelThreadCount = 0;
 
-        if (startAllThreads)
+        if (startAllThreads && this->enableParallelMark)
         {
-            if (this->enableParallelMark && this->maxParallelism > 2)
+            // Besides the main and the concurrent thread, there is a parallel thread for each additional way
+            uint parallelThreadCount = this->maxParallelism > 2 ? this->maxParallelism - 2 : 0;
+            while (startedParallelThreadCount < parallelThreadCount)
             {
-                if (!parallelThread1.EnableConcurrent(true))
+                if (!GetParallelThread(startedParallelThreadCount)->EnableConcurrent(true))
                 {
                     startConcurrentThread = false;
+                    break;
                 }
-                else
-                {
-                    startedParallelThread1 = true;
-                    if (this->maxParallelism > 3)
-                    {
-                        if (!parallelThread2.EnableConcurrent(true))
-                        {
-                            startConcurrentThread = false;
-                        }
-                        else
-                        {
-                            startedParallelThread2 = true;
-                        }
-                    }
-                }
+                startedParallelThreadCount++;
             }
         }
 
@@ -4652,13 +4714,9 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
             }
         }
 
-        if (startedParallelThread1)
+        for (uint i = 0; i < startedParallelThreadCount; i++)
         {
-            parallelThread1.Shutdown();
-            if (startedParallelThread2)
-            {
-                parallelThread2.Shutdown();
-            }
+            GetParallelThread(i)->Shutdown();
         }
     }
 
@@ -6098,14 +6156,9 @@ RecyclerParallelThread::EnableConcurrent(bool waitForThread)
 }
 
 
-template <uint parallelId>
 void
-Recycler::ParallelWorkFunc()
+Recycler::ParallelWorkFunc(MarkContext * markContext)
 {
-    Assert(parallelId == 0 || parallelId == 1);
-
-    MarkContext * markContext = (parallelId == 0 ? &this->parallelMarkContext2 : &this->parallelMarkContext3);
-
     switch (this->collectionState)
     {
         case CollectionStateParallelMark:
@@ -6182,7 +6235,6 @@ RecyclerParallelThread::StaticThreadProc(LPVOID lpParameter)
     {
         RecyclerParallelThread * parallelThread = (RecyclerParallelThread *)lpParameter;
         Recycler * recycler = parallelThread->recycler;
-        RecyclerParallelThread::WorkFunc workFunc = parallelThread->workFunc;
 
         Assert(recycler->IsConcurrentEnabled());
 
@@ -6219,8 +6271,8 @@ RecyclerParallelThread::StaticThreadProc(LPVOID lpParameter)
                 break;
             }
 
-            // Invoke the workFunc to do real work
-            (recycler->*workFunc)();
+            // Mark our context
+            recycler->ParallelWorkFunc(parallelThread->markContext);
 
             // We always wait after the first time
             mustWait = true;
@@ -6255,9 +6307,8 @@ RecyclerParallelThread::StaticBackgroundWorkCallback(void * callbackData)
 {
     RecyclerParallelThread * parallelThread = (RecyclerParallelThread *)callbackData;
     Recycler * recycler = parallelThread->recycler;
-    RecyclerParallelThread::WorkFunc workFunc = parallelThread->workFunc;
 
-    (recycler->*workFunc)();
+    recycler->ParallelWorkFunc(parallelThread->markContext);
 
     SetEvent(parallelThread->concurrentWorkDoneEvent);
 }
@@ -6703,6 +6754,50 @@ Recycler::PrintMemoryStats()
         , collectionStats.numEmptySmallBlocks[HeapBlock::SmallLeafBlockType]
         + collectionStats.numEmptySmallBlocks[HeapBlock::MediumLeafBlockType],
         collectionStats.numZeroedOutSmallBlocks);
+
+    // Objects never move, so sparsely populated blocks keep their pages until every object in them dies.
+    // "Excess" is the number of pages that could be released if the live objects were packed densely.
+    const size_t smallPageCount = SmallAllocationBlockAttributes::PageCount;
+    const size_t mediumPageCount = MediumAllocationBlockAttributes::PageCount;
+    size_t excessPageCount = 0;
+
+    Output::Print(_u("\nFragmentation  %6s %6s %10s %10s %10s %6s\n"), _u("Blocks"), _u("Sparse"), _u("Pages"), _u("LiveBytes"), _u("Excess"), _u("Occ%%"));
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("Small"), HeapBlock::SmallNormalBlockType, smallPageCount);
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("SmFin"), HeapBlock::SmallFinalizableBlockType, smallPageCount);
+#ifdef RECYCLER_WRITE_BARRIER
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("SmSWB"), HeapBlock::SmallNormalBlockWithBarrierType, smallPageCount);
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("SmFinSWB"), HeapBlock::SmallFinalizableBlockWithBarrierType, smallPageCount);
+#endif
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("SmLeaf"), HeapBlock::SmallLeafBlockType, smallPageCount);
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("Medium"), HeapBlock::MediumNormalBlockType, mediumPageCount);
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("MdFin"), HeapBlock::MediumFinalizableBlockType, mediumPageCount);
+#ifdef RECYCLER_WRITE_BARRIER
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("MdSWB"), HeapBlock::MediumNormalBlockWithBarrierType, mediumPageCount);
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("MdFinSWB"), HeapBlock::MediumFinalizableBlockWithBarrierType, mediumPageCount);
+#endif
+    excessPageCount += PrintHeapBlockFragmentationStats(_u("MdLeaf"), HeapBlock::MediumLeafBlockType, mediumPageCount);
+    Output::Print(_u("  Total excess: %d pages (%d bytes)\n"), excessPageCount, excessPageCount * AutoSystemInfo::PageSize);
+}
+
+size_t
+Recycler::PrintHeapBlockFragmentationStats(char16 const * name, HeapBlock::HeapBlockType type, size_t blockPageCount)
+{
+    Assert(type < HeapBlock::SmallBlockTypeCount);
+
+    size_t pageCount = collectionStats.heapBlockPageCount[type];
+    size_t liveByteCount = collectionStats.heapBlockLiveByteCount[type];
+    size_t blockCount = pageCount / blockPageCount;
+
+    // Live objects packed into as few blocks as possible
+    size_t blockByteCount = blockPageCount * AutoSystemInfo::PageSize;
+    size_t minPageCount = ((liveByteCount + blockByteCount - 1) / blockByteCount) * blockPageCount;
+    size_t excessPageCount = pageCount - min(pageCount, minPageCount);
+
+    Output::Print(_u(" %8s    : %6d %6d %10d %10d %10d %6.1f\n"), name,
+        blockCount, collectionStats.heapBlockSparseCount[type], pageCount, liveByteCount, excessPageCount,
+        pageCount == 0 ? 0.0 : (double)liveByteCount / (double)(pageCount * AutoSystemInfo::PageSize) * 100);
+
+    return excessPageCount;
 }
 
 void
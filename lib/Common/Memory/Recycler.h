@@ -463,6 +463,11 @@ struct RecyclerCollectionStats
     // Empty/zero heap block stats
     uint numEmptySmallBlocks[HeapBlock::SmallBlockTypeCount];
     uint numZeroedOutSmallBlocks;
+
+    // Fragmentation stats for small/medium heap blocks that still have live objects after sweep
+    size_t heapBlockPageCount[HeapBlock::SmallBlockTypeCount];      // pages held by these blocks
+    size_t heapBlockLiveByteCount[HeapBlock::SmallBlockTypeCount];  // bytes of marked objects in these blocks
+    size_t heapBlockSparseCount[HeapBlock::SmallBlockTypeCount];    // blocks less than a quarter full
 };
 #define RECYCLER_STATS_INC_IF(cond, r, f) if (cond) { RECYCLER_STATS_INC(r, f); }
 #define RECYCLER_STATS_INC(r, f) ++r->collectionStats.f
@@ -544,11 +549,9 @@ struct CollectionParam
 class RecyclerParallelThread
 {
 public:
-    typedef void (Recycler::* WorkFunc)();
-
-    RecyclerParallelThread(Recycler * recycler, WorkFunc workFunc) :
+    RecyclerParallelThread(Recycler * recycler, MarkContext * markContext) :
         recycler(recycler),
-        workFunc(workFunc),
+        markContext(markContext),
         concurrentWorkReadyEvent(NULL),
         concurrentWorkDoneEvent(NULL),
         concurrentThread(NULL)
@@ -575,8 +578,8 @@ private:
     static void CALLBACK StaticBackgroundWorkCallback(void * callbackData);
 
 private:
-    WorkFunc workFunc;
     Recycler * recycler;
+    MarkContext * markContext;      // the context this thread marks
     HANDLE concurrentWorkReadyEvent;// main thread uses this event to tell concurrent threads that the work is ready
     HANDLE concurrentWorkDoneEvent;// concurrent threads use this event to tell main thread that the work allocated is done
     HANDLE concurrentThread;
@@ -584,6 +587,27 @@ private:
 };
 #endif
 
+// A mark context for parallel marking, with the page pool for its mark stack and, when concurrent GC is
+// enabled, the thread that marks it.
+class ParallelMarkContext
+{
+public:
+    ParallelMarkContext(Recycler * recycler, Js::ConfigFlagsTable& configFlagsTable) :
+        pagePool(configFlagsTable),
+        markContext(recycler, &pagePool)
+#if ENABLE_CONCURRENT_GC
+        , parallelThread(recycler, &markContext)
+#endif
+    {
+    }
+
+    PagePool pagePool;
+    MarkContext markContext;
+#if ENABLE_CONCURRENT_GC
+    RecyclerParallelThread parallelThread;
+#endif
+};
+
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
 class AutoProtectPages
 {
@@ -786,21 +810,45 @@ private:
 
     MarkContext markContext;
 
-    // Contexts for parallel marking.
-    // We support up to 4 way parallelism, main context + 3 additional parallel contexts.
-    MarkContext parallelMarkContext1;
-    MarkContext parallelMarkContext2;
-    MarkContext parallelMarkContext3;
+    // Contexts for parallel marking, main context + up to maxParallelism - 1 additional parallel contexts.
+    // The first additional context is marked by the main thread during an in-thread parallel mark; each of
+    // the others has its own parallel thread. They are created in Initialize, once maxParallelism is known.
+    static const uint MaxParallelMarkContextCount = ParallelMarkWorkQueue::MaxWorkerCount - 1;
+    ParallelMarkContext * parallelMarkContexts[MaxParallelMarkContextCount];
+    uint parallelMarkContextCount;
 
-    // Page pools for above markContexts
+    template <typename Fn>
+    void ForEachParallelMarkContext(Fn fn) const
+    {
+        for (uint i = 0; i < this->parallelMarkContextCount; i++)
+        {
+            fn(&this->parallelMarkContexts[i]->markContext);
+        }
+    }
+
+#if ENABLE_CONCURRENT_GC
+    void CreateParallelMarkContexts(uint count);
+#endif
+
+    // Page pool for the main markContext
     PagePool markPagePool;
-    PagePool parallelMarkPagePool1;
-    PagePool parallelMarkPagePool2;
-    PagePool parallelMarkPagePool3;
+
+    // Lets the parallel mark threads balance the work between the above markContexts
+    ParallelMarkWorkQueue parallelMarkWorkQueue;
 
     bool IsMarkStackEmpty();
-    bool HasPendingMarkObjects() const { return markContext.HasPendingMarkObjects() || parallelMarkContext1.HasPendingMarkObjects() || parallelMarkContext2.HasPendingMarkObjects() || parallelMarkContext3.HasPendingMarkObjects(); }
-    bool HasPendingTrackObjects() const { return markContext.HasPendingTrackObjects() || parallelMarkContext1.HasPendingTrackObjects() || parallelMarkContext2.HasPendingTrackObjects() || parallelMarkContext3.HasPendingTrackObjects(); }
+    bool HasPendingMarkObjects() const
+    {
+        bool hasPending = markContext.HasPendingMarkObjects();
+        ForEachParallelMarkContext([&](MarkContext * context) { hasPending = hasPending || context->HasPendingMarkObjects(); });
+        return hasPending;
+    }
+    bool HasPendingTrackObjects() const
+    {
+        bool hasPending = markContext.HasPendingTrackObjects();
+        ForEachParallelMarkContext([&](MarkContext * context) { hasPending = hasPending || context->HasPendingTrackObjects(); });
+        return hasPending;
+    }
 
     RecyclerCollectionWrapper * collectionWrapper;
     HANDLE mainThreadHandle;
@@ -915,6 +963,7 @@ private:
     bool enableConcurrentSweep;
 
     uint maxParallelism;        // Max # of total threads to run in parallel
+    uint GetDefaultMaxParallelism() const;
 
     byte backgroundRescanCount;             // for ETW events and stats
     byte backgroundFinishMarkCount;
@@ -924,11 +973,8 @@ private:
     HANDLE concurrentThread;
 
 
-    template <uint parallelId>
-    void ParallelWorkFunc();
-
-    RecyclerParallelThread parallelThread1;
-    RecyclerParallelThread parallelThread2;
+    void ParallelWorkFunc(MarkContext * markContext);
+    RecyclerParallelThread * GetParallelThread(uint parallelId) { return &this->parallelMarkContexts[parallelId + 1]->parallelThread; }
 
 #if DBG
     // Variable indicating if the concurrent thread has exited or not
@@ -1018,6 +1064,7 @@ private:
     RecyclerCollectionStats collectionStats;
     void PrintHeapBlockStats(char16 const * name, HeapBlock::HeapBlockType type);
     void PrintHeapBlockMemoryStats(char16 const * name, HeapBlock::HeapBlockType type);
+    size_t PrintHeapBlockFragmentationStats(char16 const * name, HeapBlock::HeapBlockType type, size_t blockPageCount);
     void PrintCollectStats();
     void PrintHeuristicCollectionStats();
     void PrintMarkCollectionStats();
@@ -1078,6 +1125,11 @@ public:
 
     void Prime();
 
+#if ENABLE_CONCURRENT_GC
+    uint GetMaxParallelism() const { return this->enableParallelMark ? this->maxParallelism : 1; }
+    void SetMaxParallelism(uint maxParallelism);
+#endif
+
     void* GetOwnerContext() { return (void*) this->collectionWrapper; }
     PageAllocator * GetPageAllocator() { return threadPageAllocator; }
 
@@ -1095,9 +1147,7 @@ public:
     {
         this->needOOMRescan = false;
         markContext.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext1.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext2.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext3.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
+        ForEachParallelMarkContext([](MarkContext * context) { context->GetPageAllocator()->ResetDisableAllocationOutOfMemory(); });
     }
 
     BOOL RequestConcurrentWrapperCallback();
@@ -197,6 +197,13 @@ RecyclerSweep::FinishSweep()
                     recycler->enablePartialCollect = false;
                     recycler->FinishPartialCollect(this);
                 }
+#ifdef RECYCLER_WRITE_BARRIER
+                else
+                {
+                    // The card table is the remembered set for barrier pages; start it clean for the next partial collect.
+                    recycler->heapBlockMap.ResetWriteBarrier(recycler);
+                }
+#endif
                 RECYCLER_PROFILE_EXEC_END(recycler, Js::ResetWriteWatchPhase);
             }
         }
@@ -406,7 +406,31 @@ typedef unsigned char* ChakraBytePtr;
         ///     Calling <c>JsSetException</c> will also dispatch the exception to the script debugger
         ///     (if any) giving the debugger a chance to break on the exception.
         /// </summary>
-        JsRuntimeAttributeDispatchSetExceptionsToDebugger = 0x00000040
+        JsRuntimeAttributeDispatchSetExceptionsToDebugger = 0x00000040,
+        /// <summary>
+        ///     Script source is kept in a store shared by the whole process instead of in the runtime,
+        ///     so runtimes with this attribute that load the same script keep one copy of its text.
+        /// </summary>
+        JsRuntimeAttributeShareScriptSource = 0x00000080,
+        /// <summary>
+        ///     With <c>JsRuntimeAttributeShareScriptSource</c>, large scripts are kept compressed and
+        ///     decompressed when their text is needed again (deferred parsing, <c>toString</c>, debugging).
+        ///     Text that has not been needed since the previous <c>JsIdle</c> call is dropped again, so
+        ///     this is most useful together with <c>JsRuntimeAttributeEnableIdleProcessing</c>.
+        /// </summary>
+        JsRuntimeAttributeCompressScriptSource = 0x00000100,
+        /// <summary>
+        ///     Regular expressions are compiled into a cache shared by the whole process instead of in the
+        ///     runtime, so runtimes with this attribute compile each pattern and flags combination once.
+        /// </summary>
+        JsRuntimeAttributeShareCompiledRegex = 0x00000200,
+        /// <summary>
+        ///     A single regular expression match may only backtrack a limited number of times, so that
+        ///     patterns with catastrophic backtracking can't stall the runtime. A match exceeding the
+        ///     limit throws a <c>RangeError</c> which script can catch. See
+        ///     <c>JsSetRuntimeRegexBacktrackLimit</c>.
+        /// </summary>
+        JsRuntimeAttributeLimitRegexBacktracking = 0x00000400
     } JsRuntimeAttributes;
 
     /// <summary>
@@ -1287,6 +1311,64 @@ typedef unsigned char* ChakraBytePtr;
             _Outptr_result_buffer_(*stringLength) char **stringValue,
             _Out_ size_t *stringLength);
 
+    /// <summary>
+    ///     Parses a JSON text encoded as Utf8 into a value, as <c>JSON.parse</c> would.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The text is scanned directly from the Utf8 buffer; it is not converted to a UTF-16
+    ///     string first. The buffer does not need to be null terminated. No reviver is applied.
+    ///     Plain ASCII string values keep their bytes and are only converted to UTF-16 when
+    ///     needed, so reading them back with <c>JsStringToPointerUtf8Copy</c> doesn't convert them.
+    ///
+    ///     Experimental. We may update the name or behavior until it is stable.
+    ///     </para>
+    ///     <para>
+    ///     Requires an active script context.
+    ///     </para>
+    /// </remarks>
+    /// <param name="json">The JSON text, encoded as Utf8.</param>
+    /// <param name="length">The length of the JSON text in bytes.</param>
+    /// <param name="result">The parsed value.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    ///     A malformed JSON text results in <c>JsErrorScriptException</c> with a SyntaxError.
+    /// </returns>
+    CHAKRA_API
+        JsParseJsonUtf8(
+            _In_reads_(length) const char *json,
+            _In_ size_t length,
+            _Out_ JsValueRef *result);
+
+    /// <summary>
+    ///     Serializes a value into a JSON text encoded as Utf8, as <c>JSON.stringify</c> would.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The text is written directly into a Utf8 buffer; no intermediate string is created.
+    ///     No replacer or indentation is applied. The buffer is null terminated and must be
+    ///     freed with <c>JsStringFree</c>. When the value has no JSON representation (for
+    ///     example a function or <c>undefined</c>), <paramref name="json"/> is set to <c>nullptr</c>.
+    ///
+    ///     Experimental. We may update the name or behavior until it is stable.
+    ///     </para>
+    ///     <para>
+    ///     Requires an active script context.
+    ///     </para>
+    /// </remarks>
+    /// <param name="value">The value to serialize.</param>
+    /// <param name="json">The JSON text, encoded as Utf8.</param>
+    /// <param name="length">The length of the JSON text in bytes, not counting the null terminator.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    ///     A circular structure results in <c>JsErrorScriptException</c> with a TypeError.
+    /// </returns>
+    CHAKRA_API
+        JsStringifyJsonUtf8(
+            _In_ JsValueRef value,
+            _Outptr_result_maybenull_ char **json,
+            _Out_ size_t *length);
+
     /// <summary>
     ///     Gets the symbol associated with the property ID.
     /// </summary>
@@ -163,4 +163,73 @@ JsGetModuleHostInfo(
     _In_ JsModuleHostInfoKind moduleHostInfo,
     _Outptr_result_maybenull_ void** hostInfo);
 
+/// <summary>
+///     Sets the directory a runtime uses as a persistent byte code cache.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Once a directory is set, scripts run or parsed through <c>JsRunScriptUtf8</c>,
+///     <c>JsParseScriptUtf8</c> and <c>JsParseScriptWithAttributesUtf8</c> are looked up in it by a
+///     hash of their source. On a hit, the cached byte code is mapped read-only and functions are
+///     deserialized from it when they are first called, so the script is not parsed again. On a
+///     miss, the script is compiled in full (without deferred parsing) and its byte code is written
+///     to the directory for later runtimes and processes.
+///     </para>
+///     <para>
+///     Because of that full compile, a miss is slower than running the script with no cache at all.
+///     Only set a cache directory for scripts that are loaded again across runtimes or processes.
+///     </para>
+///     <para>
+///     Modules, library code, scripts in debug mode and time-travel debugging runtimes always
+///     bypass the cache. Entries are keyed by the engine's byte code version as well as the source,
+///     so engine builds sharing a directory keep separate entries. An entry whose contents fail a
+///     checksum is ignored and replaced.
+///     The directory must already exist; files that can't be read or written only cost a compile.
+///     </para>
+///     <para>
+///     Cached byte code is run without being verified, so whoever can write to the directory can run
+///     arbitrary code in the process. Only use a directory that is writable by principals trusted to
+///     do that, such as a private directory of the user the process runs as, never a shared
+///     temporary directory. The checksum only detects entries damaged by accident, for example by a
+///     full disk; it is no protection against an entry written on purpose.
+///     </para>
+///     <para>
+///     Mapped entries stay mapped until the runtime is disposed. Passing null or an empty string
+///     turns the cache off for scripts loaded afterwards.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime to set the cache directory for.</param>
+/// <param name="directory">The cache directory, encoded as utf8, or null.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+JsSetRuntimeCodeCacheDirectory(
+    _In_ JsRuntimeHandle runtime,
+    _In_opt_z_ const char *directory);
+
+/// <summary>
+///     Sets how many backtracking steps a single regular expression match may take in a runtime.
+/// </summary>
+/// <remarks>
+///     <para>
+///     A step is one return to an earlier choice point of the pattern, such as an alternative or a
+///     loop iteration. A match that takes more steps throws a catchable <c>RangeError</c>. Runtimes
+///     created with <c>JsRuntimeAttributeLimitRegexBacktracking</c> start with a limit of 10000000
+///     steps; other runtimes have no limit until one is set.
+///     </para>
+///     <para>
+///     Patterns matched with the lazily built DFA never backtrack and are not limited.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime to set the limit for.</param>
+/// <param name="limit">The limit, or 0 for no limit.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+JsSetRuntimeRegexBacktrackLimit(
+    _In_ JsRuntimeHandle runtime,
+    _In_ unsigned int limit);
+
 #endif // _CHAKRACORE_H_
@@ -104,6 +104,22 @@ typedef __int64 int64_t;
         JsDiagStepTypeStepBack = 3
     } JsDiagStepType;
 
+    /// <summary>
+    ///     Options for JsDiagStartInterpreterProfile.
+    /// </summary>
+    typedef enum _JsDiagInterpreterProfileAttributes
+    {
+        /// <summary>
+        ///     Only count opcodes and functions.
+        /// </summary>
+        JsDiagInterpreterProfileAttributeNone = 0x0,
+        /// <summary>
+        ///     Also count adjacent opcode pairs. The pair table takes several megabytes, so it is only allocated
+        ///     when this is asked for.
+        /// </summary>
+        JsDiagInterpreterProfileAttributeCountPairs = 0x1
+    } JsDiagInterpreterProfileAttributes;
+
     /// <summary>
     ///     User implemented callback routine for debug events.
     /// </summary>
@@ -635,6 +651,65 @@ typedef __int64 int64_t;
         _In_ unsigned int stackFrameIndex,
         _Out_ JsValueRef *evalResult);
 
+    /// <summary>
+    ///     Starts counting interpreter opcode executions in the runtime, clearing any previous results.
+    /// </summary>
+    /// <param name="runtimeHandle">Runtime to profile.</param>
+    /// <param name="attributes">What to count besides opcodes and functions.</param>
+    /// <param name="timingSampleInterval">
+    ///     Zero to only count opcodes, otherwise one in every timingSampleInterval opcodes is also timed with the
+    ///     processor timestamp counter. The time of a sample runs until the next opcode of the same function,
+    ///     so calls include the time spent in the callee.
+    /// </param>
+    /// <remarks>
+    ///     The profiler is only available in builds with ENABLE_INTERPRETER_OPCODE_PROFILE
+    ///     (build.sh --interpreter-profile); other builds return <c>JsErrorNotImplemented</c>.
+    ///     Only code running in the interpreter is counted. The first 4096 functions interpreted while
+    ///     profiling get their own counts; any later function is counted under a single entry named "(other)".
+    /// </remarks>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsDiagStartInterpreterProfile(
+            _In_ JsRuntimeHandle runtimeHandle,
+            _In_ JsDiagInterpreterProfileAttributes attributes,
+            _In_ unsigned int timingSampleInterval);
+
+    /// <summary>
+    ///     Stops counting interpreter opcode executions. Results stay available through JsDiagGetInterpreterProfile.
+    /// </summary>
+    /// <param name="runtimeHandle">Runtime to stop profiling.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsDiagStopInterpreterProfile(
+            _In_ JsRuntimeHandle runtimeHandle);
+
+    /// <summary>
+    ///     Gets the interpreter opcode profile of the current runtime.
+    /// </summary>
+    /// <param name="profile">Object with the opcode, opcode pair and per function counts.</param>
+    /// <remarks>
+    ///     <para>
+    ///     {
+    ///         "sampleInterval" : 100,
+    ///         "opcodes" : [{ "name" : "Ld_A", "count" : 1200, "sampledCount" : 12, "sampledCycles" : 410 }, ...],
+    ///         "pairs" : [{ "name" : "Ld_A", "second" : "Ret", "count" : 40 }, ...],
+    ///         "functions" : [{ "name" : "foo", "line" : 3, "column" : 1, "count" : 800, "sampledCount" : 8, "sampledCycles" : 300 }, ...]
+    ///     }
+    ///     </para>
+    ///     Lines and columns are zero-based. Opcodes, pairs and functions that never executed are omitted.
+    ///     "pairs" is empty unless the profile was started with <c>JsDiagInterpreterProfileAttributeCountPairs</c>.
+    /// </remarks>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsDiagGetInterpreterProfile(
+            _Out_ JsValueRef *profile);
+
     /////////////////////
     /// <summary>
     ///     TimeTravel move options as bit flag enum.
@@ -13,6 +13,7 @@
 #include "Common/ByteSwap.h"
 #include "Library/DataView.h"
 #include "Library/JavascriptSymbol.h"
+#include "Library/JSON.h"
 #include "Base/ThreadContextTlsEntry.h"
 #include "Codex/Utf8Helper.h"
 
@@ -117,7 +118,11 @@ JsErrorCode CreateRuntimeCore(_In_ JsRuntimeAttributes attributes, _In_opt_ cons
             JsRuntimeAttributeDisableEval |
             JsRuntimeAttributeDisableNativeCodeGeneration |
             JsRuntimeAttributeEnableExperimentalFeatures |
-            JsRuntimeAttributeDispatchSetExceptionsToDebugger
+            JsRuntimeAttributeDispatchSetExceptionsToDebugger |
+            JsRuntimeAttributeShareScriptSource |
+            JsRuntimeAttributeCompressScriptSource |
+            JsRuntimeAttributeShareCompiledRegex |
+            JsRuntimeAttributeLimitRegexBacktracking
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
             | JsRuntimeAttributeSerializeLibraryByteCode
 #endif
@@ -140,9 +145,7 @@ JsErrorCode CreateRuntimeCore(_In_ JsRuntimeAttributes attributes, _In_opt_ cons
             )
         {
             threadContext->OptimizeForManyInstances(true);
-#if ENABLE_NATIVE_CODEGEN
             threadContext->EnableBgJit(false);
-#endif
         }
 
         if (!threadContext->IsRentalThreadingEnabledInJSRT()
@@ -169,6 +172,26 @@ JsErrorCode CreateRuntimeCore(_In_ JsRuntimeAttributes attributes, _In_opt_ cons
             threadContext->SetThreadContextFlag(ThreadContextFlagNoJIT);
         }
 
+        if (attributes & JsRuntimeAttributeShareScriptSource)
+        {
+            threadContext->SetThreadContextFlag(ThreadContextFlagShareSource);
+
+            if (attributes & JsRuntimeAttributeCompressScriptSource)
+            {
+                threadContext->SetThreadContextFlag(ThreadContextFlagCompressSource);
+            }
+        }
+
+        if (attributes & JsRuntimeAttributeShareCompiledRegex)
+        {
+            threadContext->SetThreadContextFlag(ThreadContextFlagShareRegex);
+        }
+
+        if (attributes & JsRuntimeAttributeLimitRegexBacktracking)
+        {
+            threadContext->SetRegexBacktrackLimit((uint)CONFIG_FLAG_RELEASE(RegexBacktrackLimit));
+        }
+
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
         if (Js::Configuration::Global.flags.PrimeRecycler)
         {
@@ -1108,6 +1131,31 @@ CHAKRA_API JsStringToPointer(_In_ JsValueRef stringValue, _Outptr_result_buffer_
 
 CHAKRA_API JsStringToPointerUtf8Copy(_In_ JsValueRef stringValue, _Outptr_result_buffer_(*stringLength) char **stringPtr, _Out_ size_t *stringLength)
 {
+    VALIDATE_JSREF(stringValue);
+    PARAM_NOT_NULL(stringPtr);
+    *stringPtr = nullptr;
+    PARAM_NOT_NULL(stringLength);
+    *stringLength = 0;
+
+    // Strings that still hold their ASCII bytes (e.g. values from JsParseJsonUtf8) are already
+    // valid UTF-8; copy the bytes instead of widening the string and narrowing it back
+    if (Js::JavascriptString::Is(stringValue) && VirtualTableInfo<Js::AsciiString>::HasVirtualTable(stringValue))
+    {
+        Js::AsciiString * asciiString = static_cast<Js::AsciiString *>(stringValue);
+        size_t length = asciiString->GetLength();
+        char * copy = (char *)malloc(length + 1);
+        if (copy == nullptr)
+        {
+            return JsErrorOutOfMemory;
+        }
+
+        js_memcpy_s(copy, length + 1, asciiString->GetAsciiBuffer(), length);
+        copy[length] = '\0';
+        *stringPtr = copy;
+        *stringLength = length;
+        return JsNoError;
+    }
+
     const wchar_t* wstr;
     size_t wstrLen;
     JsErrorCode err = JsStringToPointer(stringValue, &wstr, &wstrLen);
@@ -1134,6 +1182,38 @@ CHAKRA_API JsStringToPointerUtf8Copy(_In_ JsValueRef stringValue, _Outptr_result
     return err;
 }
 
+CHAKRA_API JsParseJsonUtf8(_In_reads_(length) const char *json, _In_ size_t length, _Out_ JsValueRef *result)
+{
+    PARAM_NOT_NULL(json);
+    PARAM_NOT_NULL(result);
+    *result = JS_INVALID_REFERENCE;
+
+    if (length > INT_MAX)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        *result = (JsValueRef)JSON::ParseUtf8((LPCUTF8)json, static_cast<uint>(length), scriptContext);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsStringifyJsonUtf8(_In_ JsValueRef value, _Outptr_result_maybenull_ char **json, _Out_ size_t *length)
+{
+    PARAM_NOT_NULL(json);
+    PARAM_NOT_NULL(length);
+    *json = nullptr;
+    *length = 0;
+
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        VALIDATE_INCOMING_REFERENCE(value, scriptContext);
+
+        *json = JSON::StringifyUtf8((Js::Var)value, scriptContext, length);
+        return JsNoError;
+    });
+}
+
 CHAKRA_API JsConvertValueToString(_In_ JsValueRef value, _Out_ JsValueRef *result)
 {
     return ContextAPIWrapper<true>([&] (Js::ScriptContext *scriptContext) -> JsErrorCode {
@@ -2835,6 +2915,21 @@ CHAKRA_API JsIdle(_Out_opt_ unsigned int *nextIdleTick)
 
             unsigned int ticks = runtime->Idle();
 
+            uint idleParseBudget = CONFIG_FLAG(IdleParseBudget);
+            if (idleParseBudget != 0)
+            {
+                BEGIN_ENTER_SCRIPT(scriptContext, true, true, true)
+                {
+                    scriptContext->ParseDeferredFunctionsOnIdle(idleParseBudget);
+                }
+                END_ENTER_SCRIPT
+            }
+
+            if (scriptContext->GetThreadContext()->CompressSource())
+            {
+                scriptContext->GetThreadContext()->TrimSharedSource();
+            }
+
             *nextIdleTick = ticks;
 
             return JsNoError;
@@ -2902,7 +2997,16 @@ JsErrorCode RunScriptCore(const byte *script, size_t cb, LoadScriptFlag loadScri
         {
             loadScriptFlag = (LoadScriptFlag)(loadScriptFlag | LoadScriptFlag_Module);
         }
-        scriptFunction = scriptContext->LoadScript(script, cb, &si, &se, &utf8SourceInfo, Js::Constants::GlobalCode, loadScriptFlag);
+
+        JsrtCodeCache * codeCache = JsrtContext::GetCurrent()->GetRuntime()->GetCodeCache();
+        if (codeCache != nullptr && codeCache->IsEnabled() && JsrtCodeCache::CanCache(scriptContext, cb, loadScriptFlag))
+        {
+            scriptFunction = codeCache->LoadScript(scriptContext, script, cb, &si, &se, &utf8SourceInfo, loadScriptFlag);
+        }
+        else
+        {
+            scriptFunction = scriptContext->LoadScript(script, cb, &si, &se, &utf8SourceInfo, Js::Constants::GlobalCode, loadScriptFlag);
+        }
 
 #if ENABLE_TTD
         //
@@ -3385,6 +3489,49 @@ CHAKRA_API JsRunSerializedScriptUtf8(
         buffer, sourceContext, url, false, result);
 }
 
+CHAKRA_API JsSetRuntimeCodeCacheDirectory(_In_ JsRuntimeHandle runtimeHandle, _In_opt_z_ const char *directory)
+{
+    return GlobalAPIWrapper([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        JsrtRuntime * runtime = JsrtRuntime::FromHandle(runtimeHandle);
+        if (runtime->GetThreadContext()->IsInScript())
+        {
+            return JsErrorRuntimeInUse;
+        }
+
+        if (directory == nullptr || *directory == '\0')
+        {
+            runtime->SetCodeCacheDirectory(nullptr);
+            return JsNoError;
+        }
+
+        utf8::NarrowToWide wideDirectory(directory);
+        if (!wideDirectory)
+        {
+            return JsErrorOutOfMemory;
+        }
+
+        return runtime->SetCodeCacheDirectory(wideDirectory) ? JsNoError : JsErrorInvalidArgument;
+    });
+}
+
+CHAKRA_API JsSetRuntimeRegexBacktrackLimit(_In_ JsRuntimeHandle runtimeHandle, _In_ unsigned int limit)
+{
+    return GlobalAPIWrapper([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+        if (threadContext->IsInScript())
+        {
+            return JsErrorRuntimeInUse;
+        }
+
+        threadContext->SetRegexBacktrackLimit(limit);
+        return JsNoError;
+    });
+}
+
 CHAKRA_API JsStringFree(_In_ char* stringValue)
 {
     if (stringValue == nullptr)
@@ -0,0 +1,415 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "JsrtPch.h"
+#include "JsrtCodeCache.h"
+#include "ByteCode/ByteCodeSerializer.h"
+
+// Parser Includes
+#include "screrror.h"   // For CompileScriptException
+
+JsrtCodeCache::JsrtCodeCache() :
+    directory(nullptr),
+    directoryLength(0),
+    entries(nullptr)
+{
+}
+
+JsrtCodeCache::~JsrtCodeCache()
+{
+    SetDirectory(nullptr);
+
+    MappedEntry * entry = this->entries;
+    while (entry != nullptr)
+    {
+        MappedEntry * next = entry->next;
+        UnmapViewOfFile(entry->view);
+        HeapDelete(entry);
+        entry = next;
+    }
+    this->entries = nullptr;
+}
+
+bool JsrtCodeCache::SetDirectory(const char16 * directory)
+{
+    if (this->directory != nullptr)
+    {
+        HeapDeleteArray(this->directoryLength + 1, this->directory);
+        this->directory = nullptr;
+        this->directoryLength = 0;
+    }
+
+    if (directory == nullptr || *directory == _u('\0'))
+    {
+        return true;
+    }
+
+    // Leave room for the separator, the entry name and the temporary file suffix
+    size_t length = wcslen(directory);
+    if (length + 40 >= _MAX_PATH)
+    {
+        return false;
+    }
+
+    this->directory = HeapNewArray(char16, length + 1);
+    js_wmemcpy_s(this->directory, length + 1, directory, length + 1);
+    this->directoryLength = length;
+    return true;
+}
+
+bool JsrtCodeCache::CanCache(Js::ScriptContext * scriptContext, size_t cb, LoadScriptFlag loadScriptFlag)
+{
+    // Only plain utf8 global code. Modules and library code load through their own paths, debug mode needs the
+    // debugger's view of a fresh parse, and profiling and TTD register what the parser produces.
+    if ((loadScriptFlag & LoadScriptFlag_Utf8Source) != LoadScriptFlag_Utf8Source ||
+        (loadScriptFlag & (LoadScriptFlag_Module | LoadScriptFlag_LibraryCode)) != 0 ||
+        cb == 0 || cb > MaxSourceLength)
+    {
+        return false;
+    }
+
+    if (scriptContext->IsScriptContextInDebugMode() || scriptContext->IsProfiling())
+    {
+        return false;
+    }
+
+#if ENABLE_TTD
+    if (scriptContext->IsTTDActive() || scriptContext->ShouldPerformRecordTopLevelFunction())
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+static const uint64 HashPrime = 0x100000001b3ull;
+static const uint64 HashOffsetBasis = 0xcbf29ce484222325ull;
+
+uint64 JsrtCodeCache::HashBytes(uint64 hash, const byte * bytes, size_t cb)
+{
+    // FNV-1a over 8 byte words with an extra shift to carry high bits down, so hashing a large script costs
+    // well under its parse
+    size_t i = 0;
+    for (; i + sizeof(uint64) <= cb; i += sizeof(uint64))
+    {
+        uint64 word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * HashPrime;
+        hash ^= hash >> 32;
+    }
+    for (; i < cb; i++)
+    {
+        hash = (hash ^ bytes[i]) * HashPrime;
+    }
+
+    return hash;
+}
+
+uint64 JsrtCodeCache::ComputeHash(const byte * script, size_t cb, uint32 loadScriptFlag)
+{
+    // Entries also keep the source and a hit compares it in full, so a collision only costs a miss. The byte code
+    // version goes into the key rather than just the header check: otherwise two builds sharing a directory would
+    // each reject and rewrite the other's entries on every load.
+    byte fileVersionScheme;
+    DWORD version[4];
+    Js::ByteCodeSerializer::GetFileVersion(&fileVersionScheme, &version[0], &version[1], &version[2], &version[3]);
+
+    uint64 hash = HashOffsetBasis;
+    hash = (hash ^ fileVersionScheme) * HashPrime;
+    for (size_t i = 0; i < _countof(version); i++)
+    {
+        hash = (hash ^ version[i]) * HashPrime;
+    }
+    hash = (hash ^ loadScriptFlag) * HashPrime;
+    hash = (hash ^ cb) * HashPrime;
+
+    return HashBytes(hash, script, cb);
+}
+
+// Not a MAC: it detects accidental damage, not a file replaced on purpose
+uint64 JsrtCodeCache::ComputeImageChecksum(const byte * image, size_t imageSize)
+{
+    return HashBytes((HashOffsetBasis ^ imageSize) * HashPrime, image, imageSize);
+}
+
+bool JsrtCodeCache::IsSameSource(const MappedEntry * entry, uint64 hash, const byte * script, size_t cb, uint32 loadScriptFlag)
+{
+    return entry->sourceHash == hash &&
+        entry->sourceLength == cb &&
+        entry->loadScriptFlag == loadScriptFlag &&
+        memcmp(entry->source, script, cb) == 0;
+}
+
+// Temporary files written by this process so far
+static LONG volatile temporaryFileCount = 0;
+
+bool JsrtCodeCache::GetEntryPath(uint64 hash, bool temporary, char16 * path, size_t pathLength) const
+{
+    static const char16 hexDigits[] = _u("0123456789abcdef");
+    static const char16 extension[] = _u(".jsbc");
+    static const char16 temporaryExtension[] = _u(".tmp");
+    // Separator, hash, extension, then for temporary files the process id, thread id and count with their dots
+    static const size_t maxNameLength = 1 + 16 + _countof(extension) - 1 + 3 * (1 + 8) + _countof(temporaryExtension) - 1;
+
+    Assert(this->directory != nullptr);
+    if (this->directoryLength + maxNameLength >= pathLength)
+    {
+        return false;
+    }
+
+    char16 * current = path;
+    js_wmemcpy_s(current, pathLength, this->directory, this->directoryLength);
+    current += this->directoryLength;
+    if (this->directoryLength > 0 && current[-1] != _u('/') && current[-1] != _u('\\'))
+    {
+        *current++ = _u('/');
+    }
+
+    for (int shift = 60; shift >= 0; shift -= 4)
+    {
+        *current++ = hexDigits[(hash >> shift) & 0xf];
+    }
+    js_wmemcpy_s(current, _countof(extension), extension, _countof(extension));
+    current += _countof(extension) - 1;
+
+    if (temporary)
+    {
+        // One temporary file per write, so that runtimes on different threads or in different processes publishing
+        // the same entry can't interleave their writes
+        const DWORD uniqueIds[] = { GetCurrentProcessId(), GetCurrentThreadId(), (DWORD)InterlockedIncrement(&temporaryFileCount) };
+        for (size_t i = 0; i < _countof(uniqueIds); i++)
+        {
+            *current++ = _u('.');
+            for (int shift = 28; shift >= 0; shift -= 4)
+            {
+                *current++ = hexDigits[(uniqueIds[i] >> shift) & 0xf];
+            }
+        }
+        js_wmemcpy_s(current, _countof(temporaryExtension), temporaryExtension, _countof(temporaryExtension));
+        current += _countof(temporaryExtension) - 1;
+    }
+
+    *current = _u('\0');
+    Assert((size_t)(current - path) < pathLength);
+    return true;
+}
+
+JsrtCodeCache::MappedEntry * JsrtCodeCache::FindOrMapEntry(Js::ScriptContext * scriptContext, uint64 hash, const byte * script, size_t cb, uint32 loadScriptFlag)
+{
+    for (MappedEntry * entry = this->entries; entry != nullptr; entry = entry->next)
+    {
+        if (IsSameSource(entry, hash, script, cb, loadScriptFlag))
+        {
+            return entry;
+        }
+    }
+
+    char16 path[_MAX_PATH];
+    if (!GetEntryPath(hash, false, path, _countof(path)))
+    {
+        return nullptr;
+    }
+
+    // FILE_SHARE_DELETE lets another process replace the entry while we have it open
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    const uint64 sizeWithoutImage = sizeof(FileHeader) + (uint64)cb + 1;
+    const uint64 maxSize = sizeWithoutImage + UINT_MAX;
+    byte * view = nullptr;
+    uint64 fileSize = 0;
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && (uint64)size.QuadPart > sizeWithoutImage && (uint64)size.QuadPart <= maxSize)
+    {
+        fileSize = (uint64)size.QuadPart;
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, (DWORD)(fileSize >> 32), (DWORD)fileSize, nullptr);
+        if (mapping != nullptr)
+        {
+            view = (byte *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)fileSize);
+
+            // The view keeps the mapping and the file alive
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+
+    if (view == nullptr)
+    {
+        return nullptr;
+    }
+
+    const FileHeader * header = (const FileHeader *)view;
+    byte * image = view + sizeof(FileHeader);
+    if (header->magic != FileMagic ||
+        header->version != FileVersion ||
+        header->sourceHash != hash ||
+        header->sourceLength != cb ||
+        header->loadScriptFlag != loadScriptFlag ||
+        fileSize != sizeWithoutImage + header->imageSize ||
+        view[fileSize - 1] != 0 ||
+        memcmp(image + header->imageSize, script, cb) != 0 ||
+        ComputeImageChecksum(image, header->imageSize) != header->imageChecksum ||
+        FAILED(Js::ByteCodeSerializer::ValidateBuffer(scriptContext, image, header->imageSize)))
+    {
+        // Written by an incompatible engine, damaged, or a hash collision. Nothing points into the view yet,
+        // so drop it and let the caller compile and rewrite the entry. The deserializer trusts every offset in
+        // the image; the checksum keeps a truncated or corrupted file from being run, but a file written on
+        // purpose passes it, which is why the directory must only be writable by trusted principals.
+        UnmapViewOfFile(view);
+        return nullptr;
+    }
+
+    MappedEntry * entry = HeapNewNoThrowStruct(MappedEntry);
+    if (entry == nullptr)
+    {
+        UnmapViewOfFile(view);
+        return nullptr;
+    }
+
+    entry->sourceHash = hash;
+    entry->sourceLength = cb;
+    entry->loadScriptFlag = loadScriptFlag;
+    entry->view = view;
+    entry->image = image;
+    entry->source = (LPCUTF8)(image + header->imageSize);
+    entry->next = this->entries;
+    this->entries = entry;
+    return entry;
+}
+
+Js::JavascriptFunction * JsrtCodeCache::Deserialize(Js::ScriptContext * scriptContext, const MappedEntry * entry, SRCINFO const * srcInfo, Js::Utf8SourceInfo ** utf8SourceInfo)
+{
+    uint32 flags = 0;
+    if (CONFIG_FLAG(CreateFunctionProxy) && !scriptContext->IsProfiling())
+    {
+        flags = fscrAllowFunctionProxy;
+    }
+
+    SRCINFO * hsi = scriptContext->AddHostSrcInfo(srcInfo);
+    Js::FunctionBody * functionBody = nullptr;
+    HRESULT hr = Js::ByteCodeSerializer::DeserializeFromBuffer(scriptContext, flags, entry->source, hsi, entry->image, nullptr, &functionBody);
+    if (FAILED(hr))
+    {
+        return nullptr;
+    }
+
+    *utf8SourceInfo = functionBody->GetUtf8SourceInfo();
+    return scriptContext->GetLibrary()->CreateScriptFunction(functionBody);
+}
+
+void JsrtCodeCache::Store(Js::ScriptContext * scriptContext, Js::JavascriptFunction * function, uint64 hash, uint32 loadScriptFlag)
+{
+    if (CONFIG_FLAG(ForceSerialized) && function->GetFunctionProxy() != nullptr)
+    {
+        function->GetFunctionProxy()->EnsureDeserialized();
+    }
+
+    Js::FunctionBody * functionBody = function->GetFunctionBody();
+    Js::Utf8SourceInfo * sourceInfo = functionBody->GetUtf8SourceInfo();
+    size_t cb = sourceInfo->GetCbLength(_u("JsrtCodeCache::Store"));
+    LPCUTF8 source = sourceInfo->GetSource(_u("JsrtCodeCache::Store"));
+
+    byte * image = nullptr;
+    DWORD imageSize = 0;
+    HRESULT hr;
+
+    BEGIN_TEMP_ALLOCATOR(tempAllocator, scriptContext, _u("JsrtCodeCache"));
+    hr = Js::ByteCodeSerializer::SerializeToBuffer(scriptContext, tempAllocator, static_cast<DWORD>(cb), source, functionBody, functionBody->GetHostSrcInfo(), true, &image, &imageSize);
+    END_TEMP_ALLOCATOR(tempAllocator, scriptContext);
+
+    if (SUCCEEDED(hr))
+    {
+        FileHeader header;
+        header.magic = FileMagic;
+        header.version = FileVersion;
+        header.sourceHash = hash;
+        header.sourceLength = cb;
+        header.loadScriptFlag = loadScriptFlag;
+        header.imageSize = imageSize;
+        header.imageChecksum = ComputeImageChecksum(image, imageSize);
+
+        // A failed write only costs the next process a compile
+        WriteEntry(hash, &header, image, source, cb);
+    }
+
+    if (image != nullptr)
+    {
+        CoTaskMemFree(image);
+    }
+}
+
+static bool WriteAll(HANDLE file, const void * buffer, size_t size)
+{
+    DWORD written = 0;
+    return size <= UINT_MAX && WriteFile(file, buffer, (DWORD)size, &written, nullptr) && written == size;
+}
+
+bool JsrtCodeCache::WriteEntry(uint64 hash, const FileHeader * header, const byte * image, LPCUTF8 source, size_t cb) const
+{
+    char16 path[_MAX_PATH];
+    char16 temporaryPath[_MAX_PATH];
+    if (!GetEntryPath(hash, false, path, _countof(path)) || !GetEntryPath(hash, true, temporaryPath, _countof(temporaryPath)))
+    {
+        return false;
+    }
+
+    // The name is unique to this write, so a file that is already there was not created by us
+    HANDLE file = CreateFileW(temporaryPath, GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    const utf8char_t terminator = 0;
+    bool written = WriteAll(file, header, sizeof(FileHeader)) &&
+        WriteAll(file, image, header->imageSize) &&
+        WriteAll(file, source, cb) &&
+        WriteAll(file, &terminator, sizeof(terminator));
+    CloseHandle(file);
+
+    // Publish with a rename so that readers only ever see complete entries
+    if (!written || !MoveFileExW(temporaryPath, path, MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileW(temporaryPath);
+        return false;
+    }
+    return true;
+}
+
+Js::JavascriptFunction * JsrtCodeCache::LoadScript(Js::ScriptContext * scriptContext, const byte * script, size_t cb, SRCINFO const * srcInfo,
+    CompileScriptException * se, Js::Utf8SourceInfo ** utf8SourceInfo, LoadScriptFlag loadScriptFlag)
+{
+    Assert(IsEnabled() && CanCache(scriptContext, cb, loadScriptFlag));
+
+    // Only the expression flag changes the generated code; the rest is implied by CanCache
+    uint32 keyFlags = loadScriptFlag & LoadScriptFlag_Expression;
+    uint64 hash = ComputeHash(script, cb, keyFlags);
+
+    MappedEntry * entry = FindOrMapEntry(scriptContext, hash, script, cb, keyFlags);
+    if (entry != nullptr)
+    {
+        Js::JavascriptFunction * function = Deserialize(scriptContext, entry, srcInfo, utf8SourceInfo);
+        if (function != nullptr)
+        {
+            return function;
+        }
+
+        // The entry passed validation but didn't load. It is mapped, so it can't be replaced; just compile.
+        return scriptContext->LoadScript(script, cb, srcInfo, se, utf8SourceInfo, Js::Constants::GlobalCode, loadScriptFlag);
+    }
+
+    // Compile everything up front, since the serializer needs every nested function body. This makes a miss slower
+    // than not using the cache at all; JsSetRuntimeCodeCacheDirectory documents that trade-off for hosts.
+    Js::JavascriptFunction * function = scriptContext->LoadScript(script, cb, srcInfo, se, utf8SourceInfo, Js::Constants::GlobalCode,
+        (LoadScriptFlag)(loadScriptFlag | LoadScriptFlag_disableDeferredParse));
+    if (function != nullptr)
+    {
+        Store(scriptContext, function, hash, keyFlags);
+    }
+    return function;
+}
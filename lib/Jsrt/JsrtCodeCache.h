@@ -0,0 +1,82 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+// On-disk byte code cache behind JsSetRuntimeCodeCacheDirectory.
+//
+// Utf8 scripts run or parsed through JsRunScriptUtf8 / JsParseScriptUtf8 are looked up by a hash of their source and
+// of the engine's byte code version, so builds sharing a directory keep separate entries. Each entry holds a
+// ByteCodeSerializer image and its checksum, followed by a copy of the source. A hit maps the entry read-only and
+// deserializes lazily from the mapping: only the global function is read up front and nested functions are read
+// when first called. The source holder points into the mapping too, so a hit copies nothing.
+//
+// The image is executed as trusted byte code. The checksum only catches files that were truncated or damaged by
+// accident; anyone who can write to the directory can compute it too, so the directory itself must only be
+// writable by principals trusted to run code in the process.
+//
+// A miss compiles the whole script without deferral, so the image is complete, and publishes the entry
+// with a write to a temporary file, unique to the writer, followed by a rename. Readers never see a partial file. That first run is
+// slower than an uncached one, which only pays off for scripts that are loaded again.
+//
+// Deserialized byte code points straight into the view, so views stay mapped until the runtime is disposed.
+class JsrtCodeCache
+{
+public:
+    JsrtCodeCache();
+    ~JsrtCodeCache();
+
+    // nullptr turns lookups off; views mapped so far stay alive either way
+    bool SetDirectory(const char16 * directory);
+    bool IsEnabled() const { return this->directory != nullptr; }
+
+    static bool CanCache(Js::ScriptContext * scriptContext, size_t cb, LoadScriptFlag loadScriptFlag);
+
+    // Same contract as ScriptContext::LoadScript for the global code of a utf8 script that passed CanCache
+    Js::JavascriptFunction * LoadScript(Js::ScriptContext * scriptContext, const byte * script, size_t cb, SRCINFO const * srcInfo,
+        CompileScriptException * se, Js::Utf8SourceInfo ** utf8SourceInfo, LoadScriptFlag loadScriptFlag);
+
+private:
+    static const uint32 FileMagic = 0x63436843; // "ChCc"
+    static const uint32 FileVersion = 2;
+    static const size_t MaxSourceLength = 256 * 1024 * 1024;
+
+    // File layout: header, byte code image (imageSize bytes), source (sourceLength bytes plus a null terminator)
+    struct FileHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 sourceHash;
+        uint64 sourceLength;
+        uint32 loadScriptFlag;
+        uint32 imageSize;
+        uint64 imageChecksum;
+    };
+
+    struct MappedEntry
+    {
+        uint64 sourceHash;
+        size_t sourceLength;
+        uint32 loadScriptFlag;
+        byte * view;
+        byte * image;
+        LPCUTF8 source;
+        MappedEntry * next;
+    };
+
+    static uint64 HashBytes(uint64 hash, const byte * bytes, size_t cb);
+    static uint64 ComputeHash(const byte * script, size_t cb, uint32 loadScriptFlag);
+    static uint64 ComputeImageChecksum(const byte * image, size_t imageSize);
+    static bool IsSameSource(const MappedEntry * entry, uint64 hash, const byte * script, size_t cb, uint32 loadScriptFlag);
+
+    bool GetEntryPath(uint64 hash, bool temporary, char16 * path, size_t pathLength) const;
+    MappedEntry * FindOrMapEntry(Js::ScriptContext * scriptContext, uint64 hash, const byte * script, size_t cb, uint32 loadScriptFlag);
+    Js::JavascriptFunction * Deserialize(Js::ScriptContext * scriptContext, const MappedEntry * entry, SRCINFO const * srcInfo, Js::Utf8SourceInfo ** utf8SourceInfo);
+    void Store(Js::ScriptContext * scriptContext, Js::JavascriptFunction * function, uint64 hash, uint32 loadScriptFlag);
+    bool WriteEntry(uint64 hash, const FileHeader * header, const byte * image, LPCUTF8 source, size_t cb) const;
+
+    char16 * directory;
+    size_t directoryLength;
+    MappedEntry * entries;
+};
@@ -7,6 +7,7 @@ DEBUGOBJECTPROPERTY(arguments)
 DEBUGOBJECTPROPERTY(breakpointId)
 DEBUGOBJECTPROPERTY(className)
 DEBUGOBJECTPROPERTY(column)
+DEBUGOBJECTPROPERTY(count)
 DEBUGOBJECTPROPERTY(debuggerOnlyProperties)
 DEBUGOBJECTPROPERTY(display)
 DEBUGOBJECTPROPERTY(error)
@@ -16,6 +17,7 @@ DEBUGOBJECTPROPERTY(firstStatementColumn)
 DEBUGOBJECTPROPERTY(firstStatementLine)
 DEBUGOBJECTPROPERTY(functionCallsReturn)
 DEBUGOBJECTPROPERTY(functionHandle)
+DEBUGOBJECTPROPERTY(functions)
 DEBUGOBJECTPROPERTY(globals)
 DEBUGOBJECTPROPERTY(handle)
 DEBUGOBJECTPROPERTY(index)
@@ -23,14 +25,20 @@ DEBUGOBJECTPROPERTY(line)
 DEBUGOBJECTPROPERTY(lineCount)
 DEBUGOBJECTPROPERTY(locals)
 DEBUGOBJECTPROPERTY(name)
+DEBUGOBJECTPROPERTY(opcodes)
+DEBUGOBJECTPROPERTY(pairs)
 DEBUGOBJECTPROPERTY(parentScriptId)
 DEBUGOBJECTPROPERTY(properties)
 DEBUGOBJECTPROPERTY(propertyAttributes)
 DEBUGOBJECTPROPERTY(returnValue)
+DEBUGOBJECTPROPERTY(sampleInterval)
+DEBUGOBJECTPROPERTY(sampledCount)
+DEBUGOBJECTPROPERTY(sampledCycles)
 DEBUGOBJECTPROPERTY(scopes)
 DEBUGOBJECTPROPERTY(scriptHandle)
 DEBUGOBJECTPROPERTY(scriptId)
 DEBUGOBJECTPROPERTY(scriptType)
+DEBUGOBJECTPROPERTY(second)
 DEBUGOBJECTPROPERTY(source)
 DEBUGOBJECTPROPERTY(sourceLength)
 DEBUGOBJECTPROPERTY(sourceText)
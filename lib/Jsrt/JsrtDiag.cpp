@@ -716,3 +716,136 @@ CHAKRA_API JsDiagEvaluateUtf8(
 
     return JsDiagEvaluate(wstr, stackFrameIndex, evalResult);
 }
+
+CHAKRA_API JsDiagStartInterpreterProfile(
+    _In_ JsRuntimeHandle runtimeHandle,
+    _In_ JsDiagInterpreterProfileAttributes attributes,
+    _In_ unsigned int timingSampleInterval)
+{
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+    return GlobalAPIWrapper([&]() -> JsErrorCode {
+
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        if ((attributes & ~JsDiagInterpreterProfileAttributeCountPairs) != 0)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+
+        if (threadContext->IsInScript())
+        {
+            return JsErrorRuntimeInUse;
+        }
+
+        Js::InterpreterOpcodeProfile * profile = threadContext->EnsureInterpreterOpcodeProfile();
+        const bool countPairs = (attributes & JsDiagInterpreterProfileAttributeCountPairs) != 0;
+        if (profile == nullptr || !profile->Start(countPairs, timingSampleInterval))
+        {
+            return JsErrorOutOfMemory;
+        }
+
+        return JsNoError;
+    });
+#else
+    return JsErrorNotImplemented;
+#endif
+}
+
+CHAKRA_API JsDiagStopInterpreterProfile(
+    _In_ JsRuntimeHandle runtimeHandle)
+{
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+    return GlobalAPIWrapper([&]() -> JsErrorCode {
+
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        Js::InterpreterOpcodeProfile * profile = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext()->GetInterpreterOpcodeProfile();
+        if (profile != nullptr)
+        {
+            profile->Stop();
+        }
+
+        return JsNoError;
+    });
+#else
+    return JsErrorNotImplemented;
+#endif
+}
+
+CHAKRA_API JsDiagGetInterpreterProfile(
+    _Out_ JsValueRef *profile)
+{
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+    return ContextAPIWrapper<false>([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+
+        PARAM_NOT_NULL(profile);
+
+        *profile = JS_INVALID_REFERENCE;
+
+        Js::InterpreterOpcodeProfile * opcodeProfile = scriptContext->GetThreadContext()->GetInterpreterOpcodeProfile();
+
+        Js::JavascriptLibrary * library = scriptContext->GetLibrary();
+        Js::DynamicObject * profileObject = library->CreateObject();
+        Js::JavascriptArray * opcodesArray = library->CreateArray();
+        Js::JavascriptArray * pairsArray = library->CreateArray();
+        Js::JavascriptArray * functionsArray = library->CreateArray();
+
+        if (opcodeProfile != nullptr)
+        {
+            uint32 index = 0;
+            opcodeProfile->MapOpcodes([&](Js::OpCode op, uint64 count, uint64 sampledCount, uint64 sampledCycles)
+            {
+                Js::DynamicObject * opcodeObject = library->CreateObject();
+                const char16 * name = Js::OpCodeUtil::GetOpCodeName(op);
+                JsrtDebugUtils::AddPropertyToObject(opcodeObject, JsrtDebugPropertyId::name, name, wcslen(name), scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(opcodeObject, JsrtDebugPropertyId::count, (double)count, scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(opcodeObject, JsrtDebugPropertyId::sampledCount, (double)sampledCount, scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(opcodeObject, JsrtDebugPropertyId::sampledCycles, (double)sampledCycles, scriptContext);
+                opcodesArray->DirectSetItemAt(index++, opcodeObject);
+            });
+
+            index = 0;
+            opcodeProfile->MapPairs([&](Js::OpCode first, Js::OpCode second, uint64 count)
+            {
+                Js::DynamicObject * pairObject = library->CreateObject();
+                const char16 * firstName = Js::OpCodeUtil::GetOpCodeName(first);
+                const char16 * secondName = Js::OpCodeUtil::GetOpCodeName(second);
+                JsrtDebugUtils::AddPropertyToObject(pairObject, JsrtDebugPropertyId::name, firstName, wcslen(firstName), scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(pairObject, JsrtDebugPropertyId::second, secondName, wcslen(secondName), scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(pairObject, JsrtDebugPropertyId::count, (double)count, scriptContext);
+                pairsArray->DirectSetItemAt(index++, pairObject);
+            });
+
+            index = 0;
+            opcodeProfile->MapFunctions([&](const Js::InterpreterOpcodeProfileEntry * entry)
+            {
+                Js::DynamicObject * functionObject = library->CreateObject();
+                const char16 * name = entry->functionName != nullptr ? entry->functionName : _u("");
+                JsrtDebugUtils::AddPropertyToObject(functionObject, JsrtDebugPropertyId::name, name, wcslen(name), scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(functionObject, JsrtDebugPropertyId::line, (uint32)entry->line, scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(functionObject, JsrtDebugPropertyId::column, (uint32)entry->column, scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(functionObject, JsrtDebugPropertyId::count, (double)entry->count, scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(functionObject, JsrtDebugPropertyId::sampledCount, (double)entry->sampledCount, scriptContext);
+                JsrtDebugUtils::AddPropertyToObject(functionObject, JsrtDebugPropertyId::sampledCycles, (double)entry->sampledCycles, scriptContext);
+                functionsArray->DirectSetItemAt(index++, functionObject);
+            });
+        }
+
+        JsrtDebugUtils::AddPropertyToObject(profileObject, JsrtDebugPropertyId::sampleInterval,
+            (uint32)(opcodeProfile != nullptr ? opcodeProfile->GetTimingSampleInterval() : 0), scriptContext);
+        JsrtDebugUtils::AddPropertyToObject(profileObject, JsrtDebugPropertyId::opcodes, (Js::Var)opcodesArray, scriptContext);
+        JsrtDebugUtils::AddPropertyToObject(profileObject, JsrtDebugPropertyId::pairs, (Js::Var)pairsArray, scriptContext);
+        JsrtDebugUtils::AddPropertyToObject(profileObject, JsrtDebugPropertyId::functions, (Js::Var)functionsArray, scriptContext);
+
+        *profile = profileObject;
+
+        return JsNoError;
+    });
+#else
+    PARAM_NOT_NULL(profile);
+    *profile = JS_INVALID_REFERENCE;
+    return JsErrorNotImplemented;
+#endif
+}
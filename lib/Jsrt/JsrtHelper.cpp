@@ -107,6 +107,16 @@ void JsrtCallbackState::ObjectBeforeCallectCallbackWrapper(JsObjectBeforeCollect
         ThreadBoundThreadContextManager::DestroyContextAndEntryForCurrentThread();
     }
 
+#if defined(CHAKRA_STATIC_LIBRARY)
+    // Static library hosts don't get the DLL process detach notification (see ChakraCore/ChakraCoreDllFunc.cpp),
+    // so release the process-wide caches when the process exits instead
+    static void __cdecl UninitializeProcess()
+    {
+        UnifiedRegex::ProgramCache::Clear();
+        PageSegmentPool::Instance.Flush();
+    }
+#endif
+
     _NOINLINE bool InitializeProcess()
     {
 #if !defined(_WIN32)
@@ -168,6 +178,8 @@ void JsrtCallbackState::ObjectBeforeCallectCallbackWrapper(JsObjectBeforeCollect
     #ifdef DYNAMIC_PROFILE_STORAGE
         DynamicProfileStorage::Initialize();
     #endif
+
+        atexit(UninitializeProcess);
 #endif // STATIC_LIBRARY
         return true;
     }
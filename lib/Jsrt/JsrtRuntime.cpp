@@ -28,16 +28,25 @@ JsrtRuntime::JsrtRuntime(ThreadContext * threadContext, bool useIdle, bool dispa
     serializeByteCodeForLibrary = false;
 #endif
     this->jsrtDebugManager = nullptr;
+    this->codeCache = nullptr;
 }
 
 JsrtRuntime::~JsrtRuntime()
 {
+    // Segments our page allocators released to the process-wide pool are still charged to the policy manager
+    PageSegmentPool::Instance.DetachPolicyManager(allocationPolicyManager);
     HeapDelete(allocationPolicyManager);
     if (this->jsrtDebugManager != nullptr)
     {
         HeapDelete(this->jsrtDebugManager);
         this->jsrtDebugManager = nullptr;
     }
+    if (this->codeCache != nullptr)
+    {
+        // Byte code deserialized from the cache points into its views, so this has to wait for the thread context to go away
+        HeapDelete(this->codeCache);
+        this->codeCache = nullptr;
+    }
 }
 
 // This is called at process detach.
@@ -141,3 +150,16 @@ JsrtDebugManager * JsrtRuntime::GetJsrtDebugManager()
 {
     return this->jsrtDebugManager;
 }
+
+bool JsrtRuntime::SetCodeCacheDirectory(const char16 * directory)
+{
+    if (this->codeCache == nullptr)
+    {
+        if (directory == nullptr || *directory == _u('\0'))
+        {
+            return true;
+        }
+        this->codeCache = HeapNew(JsrtCodeCache);
+    }
+    return this->codeCache->SetDirectory(directory);
+}
@@ -7,6 +7,7 @@
 #include "ChakraCore.h"
 #include "JsrtThreadService.h"
 #include "JsrtDebugManager.h"
+#include "JsrtCodeCache.h"
 
 class JsrtContext;
 
@@ -46,6 +47,9 @@ public:
     void DeleteJsrtDebugManager();
     JsrtDebugManager * GetJsrtDebugManager();
 
+    bool SetCodeCacheDirectory(const char16 * directory);
+    JsrtCodeCache * GetCodeCache() { return this->codeCache; }
+
 private:
     static void __cdecl RecyclerCollectCallbackStatic(void * context, RecyclerCollectCallBackFlags flags);
 
@@ -63,4 +67,5 @@ private:
     bool serializeByteCodeForLibrary;
 #endif
     JsrtDebugManager * jsrtDebugManager;
+    JsrtCodeCache * codeCache;
 };
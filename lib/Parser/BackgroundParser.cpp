@@ -7,7 +7,7 @@
 #define ASSERT_THREAD() AssertMsg(mainThreadId == GetCurrentThreadContextId(), \
     "Cannot use this member of BackgroundParser from thread other than the creating context's current thread")
 
-#if ENABLE_NATIVE_CODEGEN
+#if ENABLE_BACKGROUND_PARSING
 BackgroundParser::BackgroundParser(Js::ScriptContext *scriptContext)
     :   JsUtil::WaitableJobManager(scriptContext->GetThreadContext()->GetJobProcessor()),
         scriptContext(scriptContext),
@@ -94,7 +94,27 @@ bool BackgroundParser::Process(JsUtil::Job *const job, Parser *parser, CompileSc
     parser->SetCurrBackgroundParseItem(backgroundItem);
     backgroundItem->SetParser(parser);
 
-    HRESULT hr = parser->ParseFunctionInBackground(backgroundItem->GetParseNode(), backgroundItem->GetParseContext(), backgroundItem->IsDeferred(), pse);
+    HRESULT hr;
+    try
+    {
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+        if (CheckParseFaultInjection())
+        {
+            Js::Throw::OutOfMemory();
+        }
+#endif
+        hr = parser->ParseFunctionInBackground(backgroundItem->GetParseNode(), backgroundItem->GetParseContext(), backgroundItem->IsDeferred(), pse);
+    }
+    catch (Js::OutOfMemoryException)
+    {
+        // Out of memory outside the parser's own allocators, which report it as a parse error. Fail the job the same
+        // way: otherwise the main thread would bind a function whose body was never parsed.
+        hr = pse->ProcessError(nullptr, ERRnoMemory, nullptr);
+    }
+    catch (Js::StackOverflowException)
+    {
+        hr = pse->ProcessError(nullptr, VBSERR_OutOfStack, nullptr);
+    }
     backgroundItem->SetMaxBlockId(parser->GetLastBlockId());
     backgroundItem->SetHR(hr);
     if (FAILED(hr))
@@ -106,6 +126,20 @@ bool BackgroundParser::Process(JsUtil::Job *const job, Parser *parser, CompileSc
     return hr == S_OK;
 }
 
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+bool BackgroundParser::CheckParseFaultInjection()
+{
+    if (Js::Configuration::Global.flags.ForceOOMInBackgroundParse == 0)
+    {
+        return false;
+    }
+
+    // Jobs run on any thread, and the count is process-wide so that a test can pick the job that fails
+    static LONG volatile parseCount = 0;
+    return InterlockedIncrement(&parseCount) == Js::Configuration::Global.flags.ForceOOMInBackgroundParse;
+}
+#endif
+
 void BackgroundParser::JobProcessed(JsUtil::Job *const job, const bool succeeded)
 {
     // This is called from inside a lock, so we can mess with background parser attributes.
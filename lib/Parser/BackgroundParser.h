@@ -4,7 +4,7 @@
 //-------------------------------------------------------------------------------------------------------
 #pragma once
 
-#if ENABLE_NATIVE_CODEGEN
+#if ENABLE_BACKGROUND_PARSING
 typedef DList<ParseNode*, ArenaAllocator> NodeDList;
 
 struct BackgroundParseItem sealed : public JsUtil::Job
@@ -90,6 +90,9 @@ public:
 
 private:
     void AddToParseQueue(BackgroundParseItem *const item, bool prioritize, bool lock);
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    static bool CheckParseFaultInjection();
+#endif
 
 private:
     Js::ScriptContext *scriptContext;
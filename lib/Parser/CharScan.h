@@ -0,0 +1,257 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#if defined(_M_IX86) || defined(_M_X64)
+#define REGEX_CHAR_SCAN_SSE2
+#endif
+
+namespace UnifiedRegex
+{
+    // Scans of the input for the instructions which skip to the next candidate match or over a run of characters.
+    // Each returns the first offset in [offset, end) at which the scan stops, or end if there is none, looking at 16
+    // characters at a time when SSE2 is available.
+    class CharScan : private Chars<char16>
+    {
+    private:
+#ifdef REGEX_CHAR_SCAN_SSE2
+        static const CharCount BlockLength = 16;
+
+        static inline bool CanUseSSE2()
+        {
+#if defined(_M_IX86)
+            return AutoSystemInfo::Data.SSE2Available() != FALSE;
+#else
+            return true;
+#endif
+        }
+
+        // The set scan needs the SSSE3 byte shuffle, which every processor with SSE4.1 has
+        static inline bool CanUseByteShuffle()
+        {
+            return AutoSystemInfo::Data.SSE4_1Available() != FALSE;
+        }
+
+        static inline uint FirstSetBit(uint mask)
+        {
+            Assert(mask != 0);
+            DWORD index;
+            _BitScanForward(&index, mask);
+            return index;
+        }
+
+        static inline __m128i Load(const Char* p)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        // Bit i set for each of the 16 characters at p equal to c, which is broadcast to all lanes
+        static inline uint EqualChars(const Char* p, __m128i c)
+        {
+            const __m128i lo = _mm_cmpeq_epi16(Load(p), c);
+            const __m128i hi = _mm_cmpeq_epi16(Load(p + 8), c);
+            // 0/-1 lanes survive the signed saturation, leaving one byte per character
+            return (uint)_mm_movemask_epi8(_mm_packs_epi16(lo, hi));
+        }
+
+        // Bit i set in inSet for each of the 16 characters at p which is ASCII and in the set with the given nibble
+        // map, and in ascii for each which is ASCII
+        static inline void ClassifyAsciiChars(const Char* p, __m128i nibbleMap, uint& inSet, uint& ascii)
+        {
+            const __m128i lo = Load(p);
+            const __m128i hi = Load(p + 8);
+            const __m128i nonAsciiBits = _mm_set1_epi16((short)(0xFFFF & ~MaxUCharAscii));
+            const __m128i zero = _mm_setzero_si128();
+            ascii = (uint)_mm_movemask_epi8(_mm_packs_epi16(
+                _mm_cmpeq_epi16(_mm_and_si128(lo, nonAsciiBits), zero),
+                _mm_cmpeq_epi16(_mm_and_si128(hi, nonAsciiBits), zero)));
+
+            // One byte per character, in 0..MaxUCharAscii. Only meaningful for the ASCII characters.
+            const __m128i bytes = _mm_packus_epi16(_mm_andnot_si128(nonAsciiBits, lo), _mm_andnot_si128(nonAsciiBits, hi));
+            const __m128i lowNibbles = _mm_and_si128(bytes, _mm_set1_epi8(0xF));
+            const __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0xF));
+            const __m128i rows = _mm_shuffle_epi8(nibbleMap, lowNibbles);
+            const __m128i columns = _mm_shuffle_epi8(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0), highNibbles);
+            inSet = (uint)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(rows, columns), columns));
+        }
+#endif
+
+    public:
+        // Whether the scans look at more than one character at a time
+        static inline bool IsVectorized()
+        {
+#ifdef REGEX_CHAR_SCAN_SSE2
+            return CanUseSSE2();
+#else
+            return false;
+#endif
+        }
+
+        // First offset of c
+        static inline CharCount FindChar(const Char* const input, CharCount offset, const CharCount end, const Char c)
+        {
+#ifdef REGEX_CHAR_SCAN_SSE2
+            if (CanUseSSE2())
+            {
+                const __m128i matchC = _mm_set1_epi16((short)c);
+                while (offset + BlockLength <= end)
+                {
+                    const uint found = EqualChars(input + offset, matchC);
+                    if (found != 0)
+                    {
+                        return offset + FirstSetBit(found);
+                    }
+                    offset += BlockLength;
+                }
+            }
+#endif
+            while (offset < end && input[offset] != c)
+            {
+                offset++;
+            }
+            return offset;
+        }
+
+        // First offset of c0 or c1
+        static inline CharCount FindChar2(const Char* const input, CharCount offset, const CharCount end, const Char c0, const Char c1)
+        {
+#ifdef REGEX_CHAR_SCAN_SSE2
+            if (CanUseSSE2())
+            {
+                const __m128i matchC0 = _mm_set1_epi16((short)c0);
+                const __m128i matchC1 = _mm_set1_epi16((short)c1);
+                while (offset + BlockLength <= end)
+                {
+                    const uint found = EqualChars(input + offset, matchC0) | EqualChars(input + offset, matchC1);
+                    if (found != 0)
+                    {
+                        return offset + FirstSetBit(found);
+                    }
+                    offset += BlockLength;
+                }
+            }
+#endif
+            while (offset < end && input[offset] != c0 && input[offset] != c1)
+            {
+                offset++;
+            }
+            return offset;
+        }
+
+        // First offset of a character other than c
+        static inline CharCount FindNotChar(const Char* const input, CharCount offset, const CharCount end, const Char c)
+        {
+#ifdef REGEX_CHAR_SCAN_SSE2
+            if (CanUseSSE2())
+            {
+                const __m128i matchC = _mm_set1_epi16((short)c);
+                while (offset + BlockLength <= end)
+                {
+                    const uint found = ~EqualChars(input + offset, matchC) & 0xFFFF;
+                    if (found != 0)
+                    {
+                        return offset + FirstSetBit(found);
+                    }
+                    offset += BlockLength;
+                }
+            }
+#endif
+            while (offset < end && input[offset] == c)
+            {
+                offset++;
+            }
+            return offset;
+        }
+
+        // First offset of a character which is in the set (IsIn) or not in the set (!IsIn). Non-ASCII characters are
+        // looked up one at a time.
+        template <bool IsIn>
+        static inline CharCount FindInSet(const Char* const input, CharCount offset, const CharCount end, const RuntimeCharSet<Char>& set)
+        {
+#ifdef REGEX_CHAR_SCAN_SSE2
+            if (CanUseByteShuffle())
+            {
+                const __m128i nibbleMap = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.GetAsciiNibbleMap()));
+                while (offset + BlockLength <= end)
+                {
+                    uint inSet;
+                    uint ascii;
+                    ClassifyAsciiChars(input + offset, nibbleMap, inSet, ascii);
+                    const uint found = (IsIn ? inSet : ~inSet) & ascii;
+                    uint candidates = found | (~ascii & 0xFFFF);
+                    while (candidates != 0)
+                    {
+                        const uint i = FirstSetBit(candidates);
+                        if ((found & (1u << i)) != 0 || set.Get(input[offset + i]) == IsIn)
+                        {
+                            return offset + i;
+                        }
+                        candidates &= candidates - 1;
+                    }
+                    offset += BlockLength;
+                }
+            }
+#endif
+            while (offset < end && set.Get(input[offset]) != IsIn)
+            {
+                offset++;
+            }
+            return offset;
+        }
+
+        // First offset i at which input[i] is first and input[i + distance] is second. The input must extend at least
+        // distance characters past end.
+        static inline CharCount FindCharPair(const Char* const input, CharCount offset, const CharCount end, const Char first, const Char second, const CharCount distance)
+        {
+#ifdef REGEX_CHAR_SCAN_SSE2
+            if (CanUseSSE2())
+            {
+                const __m128i matchFirst = _mm_set1_epi16((short)first);
+                const __m128i matchSecond = _mm_set1_epi16((short)second);
+                while (offset + BlockLength <= end)
+                {
+                    const uint found = EqualChars(input + offset, matchFirst) & EqualChars(input + offset + distance, matchSecond);
+                    if (found != 0)
+                    {
+                        return offset + FirstSetBit(found);
+                    }
+                    offset += BlockLength;
+                }
+            }
+#endif
+            while (offset < end && (input[offset] != first || input[offset + distance] != second))
+            {
+                offset++;
+            }
+            return offset;
+        }
+
+        // Index of the first character at which left and right differ, or length if they don't
+        static inline CharCount FindMismatch(const Char* const left, const Char* const right, const CharCount length)
+        {
+            CharCount i = 0;
+#ifdef REGEX_CHAR_SCAN_SSE2
+            if (CanUseSSE2())
+            {
+                while (length - i >= 8)
+                {
+                    const uint equal = (uint)_mm_movemask_epi8(_mm_cmpeq_epi16(Load(left + i), Load(right + i)));
+                    if (equal != 0xFFFF)
+                    {
+                        // Two mask bits per character
+                        return i + FirstSetBit(~equal & 0xFFFF) / 2;
+                    }
+                    i += 8;
+                }
+            }
+#endif
+            while (i < length && left[i] == right[i])
+            {
+                i++;
+            }
+            return i;
+        }
+    };
+}
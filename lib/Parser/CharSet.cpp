@@ -1763,6 +1763,7 @@ namespace UnifiedRegex
     {
         root = nullptr;
         direct.Clear();
+        memset(asciiNibbleMap, 0, sizeof(asciiNibbleMap));
     }
 
     void RuntimeCharSet<char16>::FreeBody(ArenaAllocator* allocator)
@@ -1808,6 +1809,12 @@ namespace UnifiedRegex
             root = other.rep.full.root == nullptr ? nullptr : other.rep.full.root->Clone(allocator);
             direct.CloneFrom(other.rep.full.direct);
         }
+
+        for (uint k = 0; k <= MaxUCharAscii; k++)
+        {
+            if (direct.Get(k))
+                asciiNibbleMap[k & 0xF] |= (uint8)(1 << (k >> 4));
+        }
     }
 
     bool RuntimeCharSet<char16>::Get_helper(uint k) const
@@ -721,6 +721,9 @@ namespace UnifiedRegex
         CharSetNode* root;
         // Entries for first 256 characters
         CharBitvec direct;
+        // ASCII members again, for scanning with a byte shuffle: bit (c >> 4) of entry (c & 0xF) is set for each
+        // member c <= MaxUCharAscii
+        uint8 asciiNibbleMap[16];
 
     public:
         RuntimeCharSet();
@@ -738,6 +741,11 @@ namespace UnifiedRegex
                 return Get_helper(CTU(kc));
         }
 
+        inline const uint8* GetAsciiNibbleMap() const
+        {
+            return asciiNibbleMap;
+        }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
         void Print(DebugWriter* w) const;
 #endif
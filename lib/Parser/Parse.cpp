@@ -84,6 +84,8 @@ Parser::Parser(Js::ScriptContext* scriptContext, BOOL strictMode, PageAllocator
     m_stoppedDeferredParse = FALSE;
     m_hasParallelJob = false;
     m_doingFastScan = false;
+    // Background parsers only exist while a parallel parse is under way
+    m_doParallelParse = isBackground || PHASE_ON1(Js::ParallelParsePhase);
     m_scriptContext = scriptContext;
     m_pCurrentAstSize = nullptr;
     m_arrayDepth = 0;
@@ -5379,13 +5381,26 @@ void Parser::ParseTopLevelDeferredFunc(ParseNodePtr pnodeFnc, ParseNodePtr pnode
 bool Parser::DoParallelParse(ParseNodePtr pnodeFnc) const
 {
 #if ENABLE_BACKGROUND_PARSING
-    if (!PHASE_ON_RAW(Js::ParallelParsePhase, m_sourceContextInfo->sourceContextId, pnodeFnc->sxFnc.functionId))
+    if (!this->m_doParallelParse)
     {
         return false;
     }
 
+    if (PHASE_ON1(Js::ParallelParsePhase))
+    {
+        if (!PHASE_ON_RAW(Js::ParallelParsePhase, m_sourceContextInfo->sourceContextId, pnodeFnc->sxFnc.functionId))
+        {
+            return false;
+        }
+
+        BackgroundParser *bgp = m_scriptContext->GetBackgroundParser();
+        return bgp != nullptr;
+    }
+
+    // Enabled by -ParallelParseThreshold: without background threads the jobs would just run serially at the
+    // end of the parse, which only costs the fast scan.
     BackgroundParser *bgp = m_scriptContext->GetBackgroundParser();
-    return bgp != nullptr;
+    return bgp != nullptr && bgp->Processor()->ProcessesInBackground();
 #else
     return false;
 #endif
@@ -8561,9 +8576,9 @@ Js::PropertyId PnPid::PropertyIdFromNameNode() const
 
 PidRefStack* Parser::PushPidRef(IdentPtr pid)
 {
-    if (PHASE_ON1(Js::ParallelParsePhase))
+    if (this->m_doParallelParse)
     {
-        // NOTE: the phase check is here to protect perf. See OSG 1020424.
+        // NOTE: the parallel parse check is here to protect perf. See OSG 1020424.
         // In some LS AST-rewrite cases we lose a lot of perf searching the PID ref stack rather
         // than just pushing on the top. This hasn't shown up as a perf issue in non-LS benchmarks.
         return pid->FindOrAddPidRef(&m_nodeAllocator, GetCurrentBlock()->sxBlock.blockId, GetCurrentFunctionNode()->sxFnc.functionId);
@@ -10788,6 +10803,12 @@ ParseNodePtr Parser::Parse(LPCUTF8 pszSrc, size_t offset, size_t length, charcou
     m_originalLength = length;
     m_nextFunctionId = nextFunctionId;
 
+    // Scripts past the threshold hand the functions the main thread reaches to the background parser, so the
+    // main thread only fast-scans them and byte code generation can start as soon as the jobs drain.
+    uint parallelParseThreshold = CONFIG_FLAG(ParallelParseThreshold);
+    m_doParallelParse = PHASE_ON1(Js::ParallelParsePhase) ||
+        (parallelParseThreshold != 0 && length >= parallelParseThreshold && !isDeferred && !PHASE_OFF1(Js::ParallelParsePhase));
+
     if(m_parseType != ParseType_Deferred)
     {
         JS_ETW(EventWriteJSCRIPT_PARSE_METHOD_START(m_sourceContextInfo->dwHostSourceContext, GetScriptContext(), *m_nextFunctionId, 0, m_parseType, Js::Constants::GlobalFunction));
@@ -10,5 +10,7 @@
 #include "CharSet.h"
 #include "CharMap.h"
 #include "CharTrie.h"
+#include "CharScan.h"
 #include "TextbookBoyerMoore.h"
 #include "RegexRuntime.h"
+#include "RegexProgramCache.h"
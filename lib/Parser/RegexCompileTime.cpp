@@ -4356,7 +4356,10 @@ namespace UnifiedRegex
         , instLen(0)
         , instNext(0)
         , nextLoopId(0)
-    {}
+    {
+        // Instruction bodies of a shared program live with the rest of it, in its cache entry
+        Assert(!program->IsShared() || rtAllocator == program->cacheEntry->GetArena());
+    }
 
     void Compiler::CaptureNoLiterals(Program* program)
     {
@@ -4368,7 +4371,7 @@ namespace UnifiedRegex
     {
         // Program will own literal buffer. Prepare buffer and nodes for case-invariant matching if necessary.
         CharCount finalLen = root->TransferPass0(*this, litbuf);
-        program->rep.insts.litbuf = finalLen == 0 ? 0 : RecyclerNewArrayLeaf(scriptContext->GetRecycler(), Char, finalLen);
+        program->rep.insts.litbuf = finalLen == 0 ? 0 : GetProgramAllocator().NewArrayLeaf<Char>(finalLen);
 
         program->rep.insts.litbufLen = 0;
         root->TransferPass1(*this, litbuf);
@@ -4384,7 +4387,7 @@ namespace UnifiedRegex
 
     void Compiler::CaptureInsts()
     {
-        program->rep.insts.insts = RecyclerNewArrayLeaf(scriptContext->GetRecycler(), uint8, instNext);
+        program->rep.insts.insts = GetProgramAllocator().NewArrayLeaf<uint8>(instNext);
 
         program->rep.insts.instsLen = instNext;
         memcpy_s(program->rep.insts.insts, instNext, instBuf, instNext);
@@ -4462,7 +4465,9 @@ namespace UnifiedRegex
         {
             // SPECIAL CASE: Octoquad/trigrams
             // (must handle before converting to case-insensitive form since the later interferes with octoquad pattern recognizer)
-            if (OctoquadIdentifier::Qualifies(program))
+            // Octoquad matching also needs the trigram info of the pattern, which a shared program can't provide to the
+            // patterns of other script contexts
+            if (!program->IsShared() && OctoquadIdentifier::Qualifies(program))
             {
                 int numCodes;
                 char localCodeToChar[TrigramAlphabet::AlphaCount];
@@ -4604,6 +4609,15 @@ namespace UnifiedRegex
 
                     compiler.Emit<SuccInst>();
                     compiler.CaptureInsts();
+
+                    // Backtracking takes exponential time on some inputs when the pattern is not deterministic. If the
+                    // pattern allows, match it with automata instead. Deterministic patterns, which backtracking matches
+                    // in at most quadratic time, stay with the instructions above; the automata are only used where
+                    // backtracking can take exponential time.
+                    if (REGEX_CONFIG_FLAG(RegexDfa) && !root->isDeterministic)
+                    {
+                        program->nfa = NfaBuilder::Build(compiler, root);
+                    }
                 }
             }
             else
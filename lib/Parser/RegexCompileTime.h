@@ -586,6 +586,7 @@ namespace UnifiedRegex
         friend LoopNode;
         friend MatchSetNode;
         friend AssertionNode;
+        friend class NfaBuilder;
 
     private:
         static const CharCount initInstBufSize = 128;
@@ -656,6 +657,11 @@ namespace UnifiedRegex
             return program;
         }
 
+        inline ProgramAllocator GetProgramAllocator() const
+        {
+            return program->GetAllocator(scriptContext->GetRecycler());
+        }
+
         void SetBOIInstructionsProgramTag()
         {
             Assert(this->program->tag == Program::InstructionsTag
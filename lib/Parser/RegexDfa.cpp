@@ -0,0 +1,1491 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "ParserPch.h"
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // NfaBuilder
+    // ----------------------------------------------------------------------
+
+    NfaBuilder::NfaBuilder(Compiler& compiler, const Char* litbuf)
+        : compiler(compiler)
+        , allocator(compiler.ctAllocator)
+        , litbuf(litbuf)
+        , failed(false)
+        , intervalStarts(nullptr)
+        , intervalClasses(nullptr)
+        , numIntervals(0)
+        , numClasses(0)
+        , classPairs(nullptr)
+        , classSets(nullptr)
+        , classSetWords(0)
+        , classSetsLength(0)
+        , classSetsCapacity(0)
+        , setNodes(nullptr)
+        , setNodeClassSets(nullptr)
+        , setNodesMask(0)
+        , states(nullptr)
+        , numStates(0)
+        , isReverse(false)
+        , withCaptures(false)
+    {
+    }
+
+    Nfa* NfaBuilder::Build(Compiler& compiler, Node* root)
+    {
+        Program* const program = compiler.program;
+
+        // Backreferences and lookarounds need the backtracking matcher. So, for now, do word boundaries and multiline
+        // anchors, which depend on the characters around an input offset.
+        uint16 unsupportedFeatures = Node::HasMatchGroup | Node::HasAssertion | Node::HasWordBoundary;
+        if ((program->flags & MultilineRegexFlag) != 0)
+        {
+            unsupportedFeatures |= Node::HasBOL | Node::HasEOL;
+        }
+        if ((root->features & unsupportedFeatures) != 0)
+        {
+            return nullptr;
+        }
+
+        NfaBuilder builder(compiler, program->rep.insts.litbuf);
+        ArenaAllocator* const allocator = builder.allocator;
+
+        uint numCharTests = 0;
+        uint numSetNodes = 0;
+        if (!builder.IsSupported(root, numCharTests, numSetNodes) || numCharTests > Nfa::MaxStates)
+        {
+            return nullptr;
+        }
+
+        //
+        // Partition the characters into intervals which no character test of the pattern splits
+        //
+
+        CharSet<Char> boundaries;
+        boundaries.Set(allocator, MinChar);
+        boundaries.Set(allocator, (Char)(MaxUCharAscii + 1));
+        builder.CollectBoundaries(root, boundaries);
+
+        uint numIntervals = 0;
+        {
+            Char lower;
+            Char upper;
+            uint searchStart = 0;
+            while (searchStart <= MaxUChar && boundaries.GetNextRange(UTC(searchStart), &lower, &upper))
+            {
+                numIntervals += CTU(upper) - CTU(lower) + 1;
+                searchStart = CTU(upper) + 1;
+            }
+        }
+        if (numIntervals > Nfa::MaxIntervals)
+        {
+            boundaries.FreeBody(allocator);
+            return nullptr;
+        }
+
+        builder.intervalStarts = AnewArray(allocator, Char, numIntervals);
+        {
+            Char lower;
+            Char upper;
+            uint searchStart = 0;
+            while (searchStart <= MaxUChar && boundaries.GetNextRange(UTC(searchStart), &lower, &upper))
+            {
+                for (uint c = CTU(lower); c <= CTU(upper); c++)
+                {
+                    builder.intervalStarts[builder.numIntervals++] = UTC(c);
+                }
+                searchStart = CTU(upper) + 1;
+            }
+        }
+        boundaries.FreeBody(allocator);
+        Assert(builder.numIntervals == numIntervals);
+        Assert(builder.intervalStarts[0] == MinChar);
+
+        //
+        // Group the intervals into classes: two intervals are in the same class if every character test of the pattern
+        // treats them alike
+        //
+
+        builder.intervalClasses = AnewArrayZ(allocator, uint16, numIntervals);
+        builder.classPairs = AnewArray(allocator, uint16, 2 * numIntervals);
+        builder.numClasses = 1;
+        builder.RefineClasses(root);
+        if (builder.failed)
+        {
+            return nullptr;
+        }
+        builder.classSetWords = (builder.numClasses + 31) / 32;
+
+        builder.setNodesMask = 1;
+        while (builder.setNodesMask + 1 < 2 * numSetNodes)
+        {
+            builder.setNodesMask = builder.setNodesMask * 2 + 1;
+        }
+        builder.setNodes = AnewArrayZ(allocator, MatchSetNode*, builder.setNodesMask + 1);
+        builder.setNodeClassSets = AnewArray(allocator, uint32, builder.setNodesMask + 1);
+        builder.states = AnewArray(allocator, NfaState, Nfa::MaxStates);
+
+        //
+        // Build the automata
+        //
+
+        const ProgramAllocator programAllocator = compiler.GetProgramAllocator();
+        Nfa* const nfa = programAllocator.New<Nfa>();
+        nfa->numGroups = program->numGroups;
+        if (!builder.BuildAutomaton(root, false, program->numGroups > 1, nfa->forward, programAllocator) ||
+            !builder.BuildAutomaton(root, true, false, nfa->reverse, programAllocator) ||
+            nfa->forward.numLeaves * 2 * program->numGroups > Nfa::MaxThreadCaptures)
+        {
+            return nullptr;
+        }
+
+        nfa->simulationStackSize = 1;
+        for (uint32 i = 0; i < nfa->forward.numStates; i++)
+        {
+            const NfaState& state = nfa->forward.states[i];
+            switch (state.kind)
+            {
+            case NfaState::Consume:
+            case NfaState::Match:
+                break;
+            case NfaState::Split:
+            case NfaState::Save:
+                nfa->simulationStackSize += 2;
+                break;
+            case NfaState::ResetGroups:
+                nfa->simulationStackSize += state.arg2 - state.arg + 2;
+                break;
+            default:
+                nfa->simulationStackSize++;
+                break;
+            }
+        }
+
+        nfa->numClasses = builder.numClasses;
+        nfa->classSetWords = builder.classSetWords;
+        nfa->classSets = programAllocator.NewArrayLeaf<uint32>(builder.classSetsLength);
+        js_memcpy_s(nfa->classSets, builder.classSetsLength * sizeof(uint32), builder.classSets, builder.classSetsLength * sizeof(uint32));
+
+        for (uint c = 0; c <= MaxUCharAscii; c++)
+        {
+            nfa->asciiClasses[c] = (uint8)builder.intervalClasses[builder.FindInterval(UTC(c))];
+        }
+        const uint firstNonAscii = builder.FindInterval((Char)(MaxUCharAscii + 1));
+        Assert(builder.intervalStarts[firstNonAscii] == MaxUCharAscii + 1);
+        nfa->numIntervals = numIntervals - firstNonAscii;
+        nfa->intervalStarts = programAllocator.NewArrayLeaf<Char>(nfa->numIntervals);
+        nfa->intervalClasses = programAllocator.NewArrayLeaf<uint8>(nfa->numIntervals);
+        for (uint i = 0; i < nfa->numIntervals; i++)
+        {
+            nfa->intervalStarts[i] = builder.intervalStarts[firstNonAscii + i];
+            nfa->intervalClasses[i] = (uint8)builder.intervalClasses[firstNonAscii + i];
+        }
+
+        return nfa;
+    }
+
+    bool NfaBuilder::IsSupported(Node* node, uint& numCharTests, uint& numSetNodes)
+    {
+        PROBE_STACK(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        switch (node->tag)
+        {
+        case Node::Empty:
+        case Node::BOL:
+        case Node::EOL:
+            return true;
+
+        case Node::MatchChar:
+            numCharTests++;
+            return true;
+
+        case Node::MatchLiteral:
+            numCharTests += ((MatchLiteralNode*)node)->length;
+            return true;
+
+        case Node::MatchSet:
+            numCharTests++;
+            numSetNodes++;
+            return true;
+
+        case Node::Concat:
+            for (ConcatNode* curr = (ConcatNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                if (!IsSupported(curr->head, numCharTests, numSetNodes))
+                    return false;
+            }
+            return true;
+
+        case Node::Alt:
+            for (AltNode* curr = (AltNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                if (!IsSupported(curr->head, numCharTests, numSetNodes))
+                    return false;
+            }
+            return true;
+
+        case Node::DefineGroup:
+            return IsSupported(((DefineGroupNode*)node)->body, numCharTests, numSetNodes);
+
+        case Node::Loop:
+        {
+            // An iteration which matches empty ends the loop, which is not a regular language
+            Node* const body = ((LoopNode*)node)->body;
+            return !body->thisConsumes.CouldMatchEmpty() && IsSupported(body, numCharTests, numSetNodes);
+        }
+
+        default:
+            return false;
+        }
+    }
+
+    void NfaBuilder::CollectBoundaries(Node* node, CharSet<Char>& boundaries)
+    {
+        PROBE_STACK(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        switch (node->tag)
+        {
+        case Node::MatchChar:
+        {
+            MatchCharNode* const charNode = (MatchCharNode*)node;
+            AddCharBoundaries(charNode->cs, charNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1, boundaries);
+            break;
+        }
+
+        case Node::MatchLiteral:
+        {
+            MatchLiteralNode* const literalNode = (MatchLiteralNode*)node;
+            const int width = literalNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1;
+            for (CharCount i = 0; i < literalNode->length; i++)
+            {
+                AddCharBoundaries(litbuf + literalNode->offset + i * width, width, boundaries);
+            }
+            break;
+        }
+
+        case Node::MatchSet:
+        {
+            MatchSetNode* const setNode = (MatchSetNode*)node;
+            Char lower;
+            Char upper;
+            uint searchStart = 0;
+            while (searchStart <= MaxUChar && setNode->set.GetNextRange(UTC(searchStart), &lower, &upper))
+            {
+                boundaries.Set(allocator, lower);
+                if (upper != MaxChar)
+                {
+                    boundaries.Set(allocator, UTC(CTU(upper) + 1));
+                }
+                searchStart = CTU(upper) + 1;
+            }
+            break;
+        }
+
+        case Node::Concat:
+            for (ConcatNode* curr = (ConcatNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                CollectBoundaries(curr->head, boundaries);
+            }
+            break;
+
+        case Node::Alt:
+            for (AltNode* curr = (AltNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                CollectBoundaries(curr->head, boundaries);
+            }
+            break;
+
+        case Node::DefineGroup:
+            CollectBoundaries(((DefineGroupNode*)node)->body, boundaries);
+            break;
+
+        case Node::Loop:
+            CollectBoundaries(((LoopNode*)node)->body, boundaries);
+            break;
+        }
+    }
+
+    void NfaBuilder::AddCharBoundaries(const Char* cs, int numChars, CharSet<Char>& boundaries)
+    {
+        for (int i = 0; i < numChars; i++)
+        {
+            boundaries.Set(allocator, cs[i]);
+            if (cs[i] != MaxChar)
+            {
+                boundaries.Set(allocator, UTC(CTU(cs[i]) + 1));
+            }
+        }
+    }
+
+    void NfaBuilder::RefineClasses(Node* node)
+    {
+        PROBE_STACK(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        if (failed)
+        {
+            return;
+        }
+
+        switch (node->tag)
+        {
+        case Node::MatchChar:
+        {
+            MatchCharNode* const charNode = (MatchCharNode*)node;
+            RefineClassesByChars(charNode->cs, charNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1);
+            break;
+        }
+
+        case Node::MatchLiteral:
+        {
+            MatchLiteralNode* const literalNode = (MatchLiteralNode*)node;
+            const int width = literalNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1;
+            for (CharCount i = 0; i < literalNode->length && !failed; i++)
+            {
+                RefineClassesByChars(litbuf + literalNode->offset + i * width, width);
+            }
+            break;
+        }
+
+        case Node::MatchSet:
+            RefineClassesBySet((MatchSetNode*)node);
+            break;
+
+        case Node::Concat:
+            for (ConcatNode* curr = (ConcatNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                RefineClasses(curr->head);
+            }
+            break;
+
+        case Node::Alt:
+            for (AltNode* curr = (AltNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                RefineClasses(curr->head);
+            }
+            break;
+
+        case Node::DefineGroup:
+            RefineClasses(((DefineGroupNode*)node)->body);
+            break;
+
+        case Node::Loop:
+            RefineClasses(((LoopNode*)node)->body);
+            break;
+        }
+    }
+
+    void NfaBuilder::RefineClassesByChars(const Char* cs, int numChars)
+    {
+        // Split each class into its intervals which are one of the characters and those which are not. Each character
+        // is an interval of its own.
+        memset(classPairs, 0xff, 2 * numClasses * sizeof(uint16));
+        uint newNumClasses = 0;
+        for (uint i = 0; i < numIntervals; i++)
+        {
+            bool isIn = false;
+            for (int j = 0; j < numChars; j++)
+            {
+                if (intervalStarts[i] == cs[j])
+                {
+                    isIn = true;
+                    break;
+                }
+            }
+
+            uint16& newClass = classPairs[2 * intervalClasses[i] + (isIn ? 1 : 0)];
+            if (newClass == (uint16)-1)
+            {
+                newClass = (uint16)newNumClasses++;
+            }
+            intervalClasses[i] = newClass;
+        }
+
+        numClasses = newNumClasses;
+        if (numClasses > Nfa::MaxClasses)
+        {
+            failed = true;
+        }
+    }
+
+    void NfaBuilder::RefineClassesBySet(MatchSetNode* node)
+    {
+        memset(classPairs, 0xff, 2 * numClasses * sizeof(uint16));
+        uint newNumClasses = 0;
+        for (uint i = 0; i < numIntervals; i++)
+        {
+            const bool isIn = node->set.Get(intervalStarts[i]) != node->isNegation;
+            uint16& newClass = classPairs[2 * intervalClasses[i] + (isIn ? 1 : 0)];
+            if (newClass == (uint16)-1)
+            {
+                newClass = (uint16)newNumClasses++;
+            }
+            intervalClasses[i] = newClass;
+        }
+
+        numClasses = newNumClasses;
+        if (numClasses > Nfa::MaxClasses)
+        {
+            failed = true;
+        }
+    }
+
+    uint NfaBuilder::FindInterval(Char c) const
+    {
+        uint lo = 0;
+        uint hi = numIntervals - 1;
+        while (lo < hi)
+        {
+            const uint mid = (lo + hi + 1) / 2;
+            if (intervalStarts[mid] <= c)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return lo;
+    }
+
+    uint32 NfaBuilder::AddCharsClassSet(const Char* cs, int numChars)
+    {
+        const uint32 classSet = AllClassesSet();
+        memset(classSets + classSet, 0, classSetWords * sizeof(uint32));
+        for (int i = 0; i < numChars; i++)
+        {
+            const uint16 characterClass = intervalClasses[FindInterval(cs[i])];
+            classSets[classSet + characterClass / 32] |= 1u << (characterClass % 32);
+        }
+        return classSet;
+    }
+
+    uint32 NfaBuilder::SetClassSet(MatchSetNode* node)
+    {
+        uint i = (uint)(reinterpret_cast<uintptr_t>(node) >> 4) & setNodesMask;
+        while (setNodes[i] != nullptr)
+        {
+            if (setNodes[i] == node)
+            {
+                return setNodeClassSets[i];
+            }
+            i = (i + 1) & setNodesMask;
+        }
+
+        const uint32 classSet = AllClassesSet();
+        memset(classSets + classSet, 0, classSetWords * sizeof(uint32));
+        for (uint j = 0; j < numIntervals; j++)
+        {
+            if (node->set.Get(intervalStarts[j]) != node->isNegation)
+            {
+                const uint16 characterClass = intervalClasses[j];
+                classSets[classSet + characterClass / 32] |= 1u << (characterClass % 32);
+            }
+        }
+
+        setNodes[i] = node;
+        setNodeClassSets[i] = classSet;
+        return classSet;
+    }
+
+    uint32 NfaBuilder::AllClassesSet()
+    {
+        if (classSetsLength + classSetWords > classSetsCapacity)
+        {
+            const uint newCapacity = max(classSetsCapacity * 2, classSetWords * 64);
+            uint32* const newClassSets = AnewArray(allocator, uint32, newCapacity);
+            if (classSets != nullptr)
+            {
+                js_memcpy_s(newClassSets, newCapacity * sizeof(uint32), classSets, classSetsLength * sizeof(uint32));
+                AdeleteArray(allocator, classSetsCapacity, classSets);
+            }
+            classSets = newClassSets;
+            classSetsCapacity = newCapacity;
+        }
+
+        const uint32 classSet = classSetsLength;
+        classSetsLength += classSetWords;
+        for (uint i = 0; i < classSetWords; i++)
+        {
+            classSets[classSet + i] = (uint32)-1;
+        }
+        if (numClasses % 32 != 0)
+        {
+            classSets[classSet + classSetWords - 1] = (1u << (numClasses % 32)) - 1;
+        }
+        return classSet;
+    }
+
+    uint32 NfaBuilder::NewState(NfaState::StateKind kind, uint32 next, uint32 arg, uint32 arg2)
+    {
+        if (numStates >= Nfa::MaxStates)
+        {
+            failed = true;
+            return 0;
+        }
+
+        NfaState& state = states[numStates];
+        state.kind = kind;
+        state.next = next;
+        state.arg = arg;
+        state.arg2 = arg2;
+        return numStates++;
+    }
+
+    // Build the states matching node and then continuing at next. States are built back to front, so the forward
+    // automaton builds sequences last to first and the reverse automaton first to last.
+    uint32 NfaBuilder::BuildNode(Node* node, uint32 next)
+    {
+        PROBE_STACK(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        if (failed)
+        {
+            return 0;
+        }
+
+        switch (node->tag)
+        {
+        case Node::Empty:
+            return next;
+
+        case Node::BOL:
+            return NewState(isReverse ? NfaState::AssertEnd : NfaState::AssertStart, next);
+
+        case Node::EOL:
+            return NewState(isReverse ? NfaState::AssertStart : NfaState::AssertEnd, next);
+
+        case Node::MatchChar:
+        {
+            MatchCharNode* const charNode = (MatchCharNode*)node;
+            return NewState(NfaState::Consume, next, AddCharsClassSet(charNode->cs, charNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1));
+        }
+
+        case Node::MatchLiteral:
+        {
+            MatchLiteralNode* const literalNode = (MatchLiteralNode*)node;
+            const int width = literalNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1;
+            for (CharCount i = 0; i < literalNode->length && !failed; i++)
+            {
+                const CharCount j = isReverse ? i : literalNode->length - 1 - i;
+                next = NewState(NfaState::Consume, next, AddCharsClassSet(litbuf + literalNode->offset + j * width, width));
+            }
+            return next;
+        }
+
+        case Node::MatchSet:
+            return NewState(NfaState::Consume, next, SetClassSet((MatchSetNode*)node));
+
+        case Node::Concat:
+        {
+            if (isReverse)
+            {
+                for (ConcatNode* curr = (ConcatNode*)node; curr != nullptr; curr = curr->tail)
+                {
+                    next = BuildNode(curr->head, next);
+                }
+                return next;
+            }
+
+            int numItems = 0;
+            for (ConcatNode* curr = (ConcatNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                numItems++;
+            }
+            Node** const items = AnewArray(allocator, Node*, numItems);
+            int i = 0;
+            for (ConcatNode* curr = (ConcatNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                items[i++] = curr->head;
+            }
+            while (i > 0)
+            {
+                next = BuildNode(items[--i], next);
+            }
+            AdeleteArray(allocator, numItems, items);
+            return next;
+        }
+
+        case Node::Alt:
+        {
+            // Alternatives are tried in order: the first one is the preferred branch of the first split, and so on
+            int numItems = 0;
+            for (AltNode* curr = (AltNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                numItems++;
+            }
+            Node** const items = AnewArray(allocator, Node*, numItems);
+            int i = 0;
+            for (AltNode* curr = (AltNode*)node; curr != nullptr; curr = curr->tail)
+            {
+                items[i++] = curr->head;
+            }
+            uint32 rest = BuildNode(items[--i], next);
+            while (i > 0)
+            {
+                const uint32 item = BuildNode(items[--i], next);
+                rest = NewState(NfaState::Split, item, rest);
+            }
+            AdeleteArray(allocator, numItems, items);
+            return rest;
+        }
+
+        case Node::DefineGroup:
+        {
+            DefineGroupNode* const groupNode = (DefineGroupNode*)node;
+            if (!withCaptures)
+            {
+                return BuildNode(groupNode->body, next);
+            }
+            const uint32 groupId = (uint32)groupNode->groupId;
+            const uint32 end = NewState(NfaState::Save, next, 2 * groupId + 1);
+            const uint32 body = BuildNode(groupNode->body, end);
+            return NewState(NfaState::Save, body, 2 * groupId);
+        }
+
+        case Node::Loop:
+            return BuildLoop((LoopNode*)node, next);
+
+        default:
+            Assert(false);
+            failed = true;
+            return 0;
+        }
+    }
+
+    uint32 NfaBuilder::BuildLoop(LoopNode* node, uint32 next)
+    {
+        const CountDomain& repeats = node->repeats;
+
+        // Iterations beyond the minimum
+        uint32 optional;
+        if (repeats.IsUnbounded())
+        {
+            const uint32 loop = NewState(NfaState::Split, next, next);
+            const uint32 body = BuildIteration(node, loop);
+            if (failed)
+            {
+                return 0;
+            }
+            if (node->isGreedy)
+            {
+                states[loop].next = body;
+            }
+            else
+            {
+                states[loop].arg = body;
+            }
+            optional = loop;
+        }
+        else
+        {
+            // e{0,n} is (e(e(...)?)?)?
+            optional = next;
+            for (CharCount i = repeats.lower; i < (CharCount)repeats.upper && !failed; i++)
+            {
+                const uint32 body = BuildIteration(node, optional);
+                optional = node->isGreedy ? NewState(NfaState::Split, body, next) : NewState(NfaState::Split, next, body);
+            }
+        }
+
+        uint32 entry = optional;
+        for (CharCount i = 0; i < repeats.lower && !failed; i++)
+        {
+            entry = BuildIteration(node, entry);
+        }
+        return entry;
+    }
+
+    uint32 NfaBuilder::BuildIteration(LoopNode* node, uint32 next)
+    {
+        const uint32 body = BuildNode(node->body, next);
+        if (!withCaptures || !node->body->ContainsDefineGroup())
+        {
+            return body;
+        }
+
+        // Each iteration starts with the groups of the body undefined
+        int minGroupId = compiler.program->numGroups;
+        int maxGroupId = -1;
+        node->body->AccumDefineGroups(compiler.scriptContext, minGroupId, maxGroupId);
+        Assert(minGroupId <= maxGroupId);
+        return NewState(NfaState::ResetGroups, body, (uint32)minGroupId, (uint32)maxGroupId);
+    }
+
+    bool NfaBuilder::BuildAutomaton(Node* root, bool isReverse, bool withCaptures, NfaAutomaton& automaton, const ProgramAllocator& programAllocator)
+    {
+        this->isReverse = isReverse;
+        this->withCaptures = withCaptures;
+        numStates = 0;
+
+        const uint32 match = NewState(NfaState::Match, 0);
+        uint32 start = BuildNode(root, match);
+        uint32 unanchoredStart = start;
+        if (!isReverse)
+        {
+            // Record where the overall match starts, for simulations
+            start = NewState(NfaState::Save, start, 0);
+
+            // Try the pattern here, or, at a lower priority, skip a character and try again
+            unanchoredStart = NewState(NfaState::Split, start);
+            const uint32 skip = NewState(NfaState::Consume, unanchoredStart, AllClassesSet());
+            states[unanchoredStart].arg = skip;
+        }
+        if (failed)
+        {
+            return false;
+        }
+
+        automaton.states = programAllocator.NewArrayLeaf<NfaState>(numStates);
+        js_memcpy_s(automaton.states, numStates * sizeof(NfaState), states, numStates * sizeof(NfaState));
+        automaton.numStates = numStates;
+        automaton.anchoredStart = start;
+        automaton.unanchoredStart = unanchoredStart;
+        automaton.numLeaves = 0;
+        for (uint32 i = 0; i < numStates; i++)
+        {
+            if (states[i].kind == NfaState::Consume || states[i].kind == NfaState::Match)
+            {
+                automaton.numLeaves++;
+            }
+        }
+        return true;
+    }
+
+    // ----------------------------------------------------------------------
+    // LazyDfa
+    // ----------------------------------------------------------------------
+
+    void LazyDfa::Initialize(Recycler* recycler, const Nfa* nfa, const NfaAutomaton* automaton, bool isLeftmostFirst)
+    {
+        this->recycler = recycler;
+        this->nfa = nfa;
+        this->automaton = automaton;
+        this->isLeftmostFirst = isLeftmostFirst;
+        maxStates = max(MinStates, min(2 * Nfa::MaxStates, (uint)(MaxCacheBytes / (nfa->numClasses * sizeof(uint32) + 16))));
+
+        numStates = 0;
+        stateCapacity = 0;
+        transitions = nullptr;
+        listStarts = nullptr;
+        stateFlags = nullptr;
+        lists = nullptr;
+        listsLength = 0;
+        listsCapacity = 0;
+        buckets = nullptr;
+        bucketsMask = 0;
+        for (uint i = 0; i < _countof(startStates); i++)
+        {
+            startStates[i] = UnknownState;
+        }
+        numResets = 0;
+
+        scratchList = nullptr;
+        scratchLength = 0;
+        stack = nullptr;
+        visited = nullptr;
+        visitStamp = 0;
+    }
+
+    void LazyDfa::EnsureScratch()
+    {
+        if (scratchList != nullptr)
+        {
+            return;
+        }
+
+        scratchList = RecyclerNewArrayLeaf(recycler, uint32, automaton->numStates);
+        stack = RecyclerNewArrayLeaf(recycler, uint32, 2 * automaton->numStates + 1);
+        visited = RecyclerNewArrayLeafZ(recycler, uint32, automaton->numStates);
+        GrowStates();
+    }
+
+    void LazyDfa::BeginVisit()
+    {
+        if (++visitStamp == 0)
+        {
+            memset(visited, 0, automaton->numStates * sizeof(uint32));
+            visitStamp = 1;
+        }
+        scratchLength = 0;
+    }
+
+    // Append the leaves reachable from an NFA state to the scratch list, in priority order. Return true if a match was
+    // reached and everything after it was cut.
+    bool LazyDfa::AddClosure(uint32 nfaState, bool startHolds)
+    {
+        const NfaState* const states = automaton->states;
+        uint stackLength = 0;
+        stack[stackLength++] = nfaState;
+        while (stackLength != 0)
+        {
+            const uint32 id = stack[--stackLength];
+            if (visited[id] == visitStamp)
+            {
+                continue;
+            }
+            visited[id] = visitStamp;
+
+            const NfaState& state = states[id];
+            switch (state.kind)
+            {
+            case NfaState::Consume:
+                scratchList[scratchLength++] = id;
+                break;
+
+            case NfaState::Match:
+                scratchList[scratchLength++] = id;
+                if (isLeftmostFirst)
+                {
+                    // Everything not yet explored has a lower priority than this match
+                    return true;
+                }
+                break;
+
+            case NfaState::AssertEnd:
+                // Whether the input ends here is only known when the next character is looked at
+                scratchList[scratchLength++] = id;
+                break;
+
+            case NfaState::AssertStart:
+                if (startHolds)
+                {
+                    stack[stackLength++] = state.next;
+                }
+                break;
+
+            case NfaState::Split:
+                stack[stackLength++] = state.arg;
+                stack[stackLength++] = state.next;
+                break;
+
+            default:
+                stack[stackLength++] = state.next;
+                break;
+            }
+        }
+        return false;
+    }
+
+    bool LazyDfa::ReachesMatchAtEnd(uint32 nfaState, bool startHolds)
+    {
+        const NfaState* const states = automaton->states;
+        uint stackLength = 0;
+        stack[stackLength++] = nfaState;
+        while (stackLength != 0)
+        {
+            const uint32 id = stack[--stackLength];
+            if (visited[id] == visitStamp)
+            {
+                continue;
+            }
+            visited[id] = visitStamp;
+
+            const NfaState& state = states[id];
+            switch (state.kind)
+            {
+            case NfaState::Consume:
+                break;
+
+            case NfaState::Match:
+                return true;
+
+            case NfaState::AssertStart:
+                if (startHolds)
+                {
+                    stack[stackLength++] = state.next;
+                }
+                break;
+
+            case NfaState::Split:
+                stack[stackLength++] = state.arg;
+                stack[stackLength++] = state.next;
+                break;
+
+            default:
+                stack[stackLength++] = state.next;
+                break;
+            }
+        }
+        return false;
+    }
+
+    uint32 LazyDfa::HashList(const uint32* list, uint length) const
+    {
+        uint32 hash = 2166136261u;
+        for (uint i = 0; i < length; i++)
+        {
+            hash = (hash ^ list[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    // Find the state for the list in the scratch space, adding it if it is new
+    uint32 LazyDfa::FindOrAddState()
+    {
+        if (scratchLength == 0)
+        {
+            return DeadState;
+        }
+
+        const uint32 hash = HashList(scratchList, scratchLength);
+        uint i = hash & bucketsMask;
+        while (buckets[i] != 0)
+        {
+            const uint32 state = buckets[i] - 1;
+            const uint length = listStarts[state + 1] - listStarts[state];
+            if (length == scratchLength && memcmp(lists + listStarts[state], scratchList, length * sizeof(uint32)) == 0)
+            {
+                return state;
+            }
+            i = (i + 1) & bucketsMask;
+        }
+
+        if (numStates == stateCapacity && !GrowStates())
+        {
+            Reset();
+        }
+        if (listsLength + scratchLength > listsCapacity)
+        {
+            const uint newCapacity = max(listsCapacity * 2, max(scratchLength, automaton->numStates) * 4);
+            if (listsCapacity >= MaxListEntries || newCapacity > MaxListEntries && listsLength + scratchLength > MaxListEntries)
+            {
+                Reset();
+            }
+            else
+            {
+                uint32* const newLists = RecyclerNewArrayLeaf(recycler, uint32, newCapacity);
+                if (lists != nullptr)
+                {
+                    js_memcpy_s(newLists, newCapacity * sizeof(uint32), lists, listsLength * sizeof(uint32));
+                }
+                lists = newLists;
+                listsCapacity = newCapacity;
+            }
+        }
+        Assert(numStates < stateCapacity);
+        Assert(listsLength + scratchLength <= listsCapacity);
+
+        const uint32 state = numStates++;
+        listStarts[state] = listsLength;
+        js_memcpy_s(lists + listsLength, (listsCapacity - listsLength) * sizeof(uint32), scratchList, scratchLength * sizeof(uint32));
+        listsLength += scratchLength;
+        listStarts[state + 1] = listsLength;
+        memset(transitions + state * nfa->numClasses, 0xff, nfa->numClasses * sizeof(uint32));
+
+        stateFlags[state] = 0;
+        const NfaState* const states = automaton->states;
+        for (uint j = 0; j < scratchLength; j++)
+        {
+            if (states[scratchList[j]].kind == NfaState::Match)
+            {
+                stateFlags[state] = IsMatchFlag;
+                break;
+            }
+        }
+
+        i = hash & bucketsMask;
+        while (buckets[i] != 0)
+        {
+            i = (i + 1) & bucketsMask;
+        }
+        buckets[i] = state + 1;
+        return state;
+    }
+
+    bool LazyDfa::GrowStates()
+    {
+        if (stateCapacity == maxStates)
+        {
+            return false;
+        }
+
+        const uint newCapacity = stateCapacity == 0 ? MinStates : min(stateCapacity * 2, maxStates);
+        const uint numClasses = nfa->numClasses;
+
+        uint32* const newTransitions = RecyclerNewArrayLeaf(recycler, uint32, newCapacity * numClasses);
+        uint32* const newListStarts = RecyclerNewArrayLeaf(recycler, uint32, newCapacity + 1);
+        uint8* const newStateFlags = RecyclerNewArrayLeaf(recycler, uint8, newCapacity);
+        if (numStates != 0)
+        {
+            js_memcpy_s(newTransitions, newCapacity * numClasses * sizeof(uint32), transitions, numStates * numClasses * sizeof(uint32));
+            js_memcpy_s(newListStarts, (newCapacity + 1) * sizeof(uint32), listStarts, (numStates + 1) * sizeof(uint32));
+            js_memcpy_s(newStateFlags, newCapacity, stateFlags, numStates);
+        }
+        transitions = newTransitions;
+        listStarts = newListStarts;
+        stateFlags = newStateFlags;
+        stateCapacity = newCapacity;
+
+        // At least twice as many buckets as states, and a power of 2
+        bucketsMask = 1;
+        while (bucketsMask + 1 < 2 * newCapacity)
+        {
+            bucketsMask = bucketsMask * 2 + 1;
+        }
+        buckets = RecyclerNewArrayLeaf(recycler, uint32, bucketsMask + 1);
+        Rehash();
+        return true;
+    }
+
+    void LazyDfa::Rehash()
+    {
+        memset(buckets, 0, (bucketsMask + 1) * sizeof(uint32));
+        for (uint32 state = 0; state < numStates; state++)
+        {
+            uint i = HashList(lists + listStarts[state], listStarts[state + 1] - listStarts[state]) & bucketsMask;
+            while (buckets[i] != 0)
+            {
+                i = (i + 1) & bucketsMask;
+            }
+            buckets[i] = state + 1;
+        }
+    }
+
+    // Drop all states, when the cache is full. The caller must not use any state it obtained before.
+    void LazyDfa::Reset()
+    {
+        numStates = 0;
+        listsLength = 0;
+        memset(buckets, 0, (bucketsMask + 1) * sizeof(uint32));
+        for (uint i = 0; i < _countof(startStates); i++)
+        {
+            startStates[i] = UnknownState;
+        }
+        numResets++;
+    }
+
+    uint32 LazyDfa::ComputeStartState(uint index, bool isAnchored, bool startHolds)
+    {
+        EnsureScratch();
+        BeginVisit();
+        AddClosure(isAnchored ? automaton->anchoredStart : automaton->unanchoredStart, startHolds);
+        const uint32 state = FindOrAddState();
+        startStates[index] = state;
+        return state;
+    }
+
+    uint32 LazyDfa::ComputeNextState(uint32 state, uint8 characterClass)
+    {
+        const NfaState* const states = automaton->states;
+        const uint32* const list = lists + listStarts[state];
+        const uint length = listStarts[state + 1] - listStarts[state];
+
+        BeginVisit();
+        for (uint i = 0; i < length; i++)
+        {
+            const NfaState& nfaState = states[list[i]];
+            if (nfaState.kind == NfaState::Consume && nfa->Consumes(nfaState, characterClass) && AddClosure(nfaState.next, false))
+            {
+                break;
+            }
+        }
+
+        const uint resets = numResets;
+        const uint32 next = FindOrAddState();
+        if (numResets == resets)
+        {
+            transitions[state * nfa->numClasses + characterClass] = next;
+        }
+        return next;
+    }
+
+    bool LazyDfa::ComputeAcceptsAtEnd(uint32 state, bool startHolds)
+    {
+        const NfaState* const states = automaton->states;
+        const uint32* const list = lists + listStarts[state];
+        const uint length = listStarts[state + 1] - listStarts[state];
+
+        BeginVisit();
+        bool accepts = false;
+        for (uint i = 0; i < length && !accepts; i++)
+        {
+            const NfaState& nfaState = states[list[i]];
+            accepts =
+                nfaState.kind == NfaState::Match ||
+                (nfaState.kind == NfaState::AssertEnd && ReachesMatchAtEnd(nfaState.next, startHolds));
+        }
+
+        stateFlags[state] |= (AcceptsAtEndKnownFlag << startHolds) | (accepts ? AcceptsAtEndFlag << startHolds : 0);
+        return accepts;
+    }
+
+    // ----------------------------------------------------------------------
+    // DfaMatcher
+    // ----------------------------------------------------------------------
+
+    DfaMatcher::DfaMatcher(Recycler* recycler, const Nfa* nfa)
+        : recycler(recycler)
+        , nfa(nfa)
+        , numGiveUps(0)
+        , captures(nullptr)
+        , simulationStack(nullptr)
+        , visited(nullptr)
+        , visitStamp(0)
+    {
+        forwardDfa.Initialize(recycler, nfa, &nfa->forward, true);
+        reverseDfa.Initialize(recycler, nfa, &nfa->reverse, false);
+        threadStates[0] = threadStates[1] = nullptr;
+        threadCaptures[0] = threadCaptures[1] = nullptr;
+    }
+
+    DfaMatcher* DfaMatcher::New(Recycler* recycler, const Nfa* nfa)
+    {
+        return RecyclerNew(recycler, DfaMatcher, recycler, nfa);
+    }
+
+    bool DfaMatcher::Match(Matcher& matcher, const Char* const input, const CharCount inputLength, CharCount offset, bool isAnchored, GroupInfo* groupInfos, uint& qcTicks)
+    {
+        Assert(offset <= inputLength);
+
+        if (numGiveUps < MaxGiveUps)
+        {
+            CharCount matchEnd = 0;
+            ScanResult result = ScanForward(input, inputLength, offset, isAnchored, matchEnd);
+            if (result == NotFound)
+            {
+                groupInfos[0].Reset();
+                return false;
+            }
+
+            if (result == Found)
+            {
+                CharCount matchStart = offset;
+                if (!isAnchored)
+                {
+                    result = ScanReverse(input, inputLength, offset, matchEnd, matchStart);
+                    Assert(result != NotFound);
+                }
+
+                if (result == Found)
+                {
+                    if (nfa->numGroups == 1)
+                    {
+                        groupInfos[0].offset = matchStart;
+                        groupInfos[0].length = matchEnd - matchStart;
+                        return true;
+                    }
+
+                    // Recover the groups from the extent of the match
+                    const bool found = Simulate(matcher, input, inputLength, matchStart, matchEnd, true, groupInfos, qcTicks);
+                    Assert(found && groupInfos[0].offset == matchStart && groupInfos[0].EndOffset() == matchEnd);
+                    return found;
+                }
+            }
+
+            Assert(result == GaveUp);
+            numGiveUps++;
+        }
+
+        return Simulate(matcher, input, inputLength, offset, inputLength, isAnchored, groupInfos, qcTicks);
+    }
+
+    // Find the end of the leftmost-first match starting at or after offset
+    DfaMatcher::ScanResult DfaMatcher::ScanForward(const Char* const input, const CharCount inputLength, CharCount offset, bool isAnchored, CharCount& matchEnd)
+    {
+        LazyDfa& dfa = forwardDfa;
+        uint32 state = dfa.StartState(isAnchored, offset == 0);
+        if (state == LazyDfa::DeadState)
+        {
+            return NotFound;
+        }
+
+        bool found = false;
+        if (dfa.IsMatch(state))
+        {
+            found = true;
+            matchEnd = offset;
+        }
+
+        const uint numClasses = nfa->numClasses;
+        const uint32* transitions = dfa.transitions;
+        uint resets = dfa.numResets;
+        CharCount lastResetOffset = CharCountFlag;
+        for (CharCount inputOffset = offset; inputOffset < inputLength; inputOffset++)
+        {
+            const uint8 characterClass = nfa->ClassOf(input[inputOffset]);
+            uint32 next = transitions[state * numClasses + characterClass];
+            if (next == LazyDfa::UnknownState)
+            {
+                next = dfa.ComputeNextState(state, characterClass);
+                transitions = dfa.transitions;
+                if (dfa.numResets != resets)
+                {
+                    // The cache filled up. Carry on with a fresh cache, unless it is not paying for itself on this input.
+                    if (lastResetOffset != CharCountFlag && inputOffset - lastResetOffset < MinCharsPerState * dfa.maxStates)
+                    {
+                        return GaveUp;
+                    }
+                    lastResetOffset = inputOffset;
+                    resets = dfa.numResets;
+                }
+            }
+
+            if (next == LazyDfa::DeadState)
+            {
+                return found ? Found : NotFound;
+            }
+            state = next;
+            if (dfa.IsMatch(state))
+            {
+                found = true;
+                matchEnd = inputOffset + 1;
+            }
+        }
+
+        if (dfa.AcceptsAtEnd(state, inputLength == 0))
+        {
+            found = true;
+            matchEnd = inputLength;
+        }
+        return found ? Found : NotFound;
+    }
+
+    // Find the start of the match ending at matchEnd, which is the earliest offset at or after offset a match can start at
+    DfaMatcher::ScanResult DfaMatcher::ScanReverse(const Char* const input, const CharCount inputLength, CharCount offset, CharCount matchEnd, CharCount& matchStart)
+    {
+        LazyDfa& dfa = reverseDfa;
+        uint32 state = dfa.StartState(true, matchEnd == inputLength);
+        if (state == LazyDfa::DeadState)
+        {
+            return NotFound;
+        }
+
+        bool found = false;
+        if (dfa.IsMatch(state))
+        {
+            found = true;
+            matchStart = matchEnd;
+        }
+
+        const uint numClasses = nfa->numClasses;
+        const uint32* transitions = dfa.transitions;
+        uint resets = dfa.numResets;
+        CharCount lastResetOffset = CharCountFlag;
+        for (CharCount inputOffset = matchEnd; inputOffset > offset; inputOffset--)
+        {
+            const uint8 characterClass = nfa->ClassOf(input[inputOffset - 1]);
+            uint32 next = transitions[state * numClasses + characterClass];
+            if (next == LazyDfa::UnknownState)
+            {
+                next = dfa.ComputeNextState(state, characterClass);
+                transitions = dfa.transitions;
+                if (dfa.numResets != resets)
+                {
+                    if (lastResetOffset != CharCountFlag && lastResetOffset - inputOffset < MinCharsPerState * dfa.maxStates)
+                    {
+                        return GaveUp;
+                    }
+                    lastResetOffset = inputOffset;
+                    resets = dfa.numResets;
+                }
+            }
+
+            if (next == LazyDfa::DeadState)
+            {
+                return found ? Found : NotFound;
+            }
+            state = next;
+            if (dfa.IsMatch(state))
+            {
+                found = true;
+                matchStart = inputOffset - 1;
+            }
+        }
+
+        if (offset == 0 && dfa.AcceptsAtEnd(state, inputLength == 0))
+        {
+            found = true;
+            matchStart = 0;
+        }
+        return found ? Found : NotFound;
+    }
+
+    // Simulate the forward NFA over input[offset, limit), one thread per NFA leaf, in priority order. Each thread
+    // carries the captures of the path which reached it first.
+    bool DfaMatcher::Simulate(Matcher& matcher, const Char* const input, const CharCount inputLength, CharCount offset, CharCount limit, bool isAnchored, GroupInfo* groupInfos, uint& qcTicks)
+    {
+        const NfaAutomaton& automaton = nfa->forward;
+        const uint numSlots = 2 * nfa->numGroups;
+
+        if (captures == nullptr)
+        {
+            for (uint i = 0; i < 2; i++)
+            {
+                threadStates[i] = RecyclerNewArrayLeaf(recycler, uint32, automaton.numLeaves);
+                threadCaptures[i] = RecyclerNewArrayLeaf(recycler, CharCount, automaton.numLeaves * numSlots);
+            }
+            captures = RecyclerNewArrayLeaf(recycler, CharCount, numSlots);
+            simulationStack = RecyclerNewArrayLeaf(recycler, SimulationStackEntry, nfa->simulationStackSize);
+            visited = RecyclerNewArrayLeafZ(recycler, uint32, automaton.numStates);
+        }
+
+        for (uint i = 0; i < numSlots; i++)
+        {
+            captures[i] = CharCountFlag;
+        }
+
+        uint current = 0;
+        uint numThreads = 0;
+        bool hasMatch = false;
+        if (++visitStamp == 0)
+        {
+            memset(visited, 0, automaton.numStates * sizeof(uint32));
+            visitStamp = 1;
+        }
+        AddThread(current, numThreads, isAnchored ? automaton.anchoredStart : automaton.unanchoredStart, offset, inputLength, hasMatch);
+
+        bool found = false;
+        for (CharCount inputOffset = offset; numThreads != 0; inputOffset++)
+        {
+            matcher.QueryContinue(qcTicks);
+
+            const uint next = 1 - current;
+            uint numNextThreads = 0;
+            bool nextHasMatch = false;
+            if (++visitStamp == 0)
+            {
+                memset(visited, 0, automaton.numStates * sizeof(uint32));
+                visitStamp = 1;
+            }
+
+            const bool canConsume = inputOffset < limit;
+            const uint8 characterClass = canConsume ? nfa->ClassOf(input[inputOffset]) : 0;
+            for (uint i = 0; i < numThreads; i++)
+            {
+                const NfaState& state = automaton.states[threadStates[current][i]];
+                const CharCount* const threadCaptures = this->threadCaptures[current] + i * numSlots;
+                if (state.kind == NfaState::Match)
+                {
+                    // The best match so far. Lower priority threads can no longer better it.
+                    found = true;
+                    groupInfos[0].offset = threadCaptures[0];
+                    groupInfos[0].length = inputOffset - threadCaptures[0];
+                    for (int groupId = 1; groupId < nfa->numGroups; groupId++)
+                    {
+                        const CharCount end = threadCaptures[2 * groupId + 1];
+                        if (end == CharCountFlag)
+                        {
+                            groupInfos[groupId].Reset();
+                        }
+                        else
+                        {
+                            groupInfos[groupId].offset = threadCaptures[2 * groupId];
+                            groupInfos[groupId].length = end - threadCaptures[2 * groupId];
+                        }
+                    }
+                    break;
+                }
+
+                if (canConsume && !nextHasMatch && nfa->Consumes(state, characterClass))
+                {
+                    js_memcpy_s(captures, numSlots * sizeof(CharCount), threadCaptures, numSlots * sizeof(CharCount));
+                    AddThread(next, numNextThreads, state.next, inputOffset + 1, inputLength, nextHasMatch);
+                }
+            }
+
+            if (!canConsume)
+            {
+                break;
+            }
+            current = next;
+            numThreads = numNextThreads;
+        }
+
+        if (!found)
+        {
+            groupInfos[0].Reset();
+        }
+        return found;
+    }
+
+    // Add a thread for each leaf reachable from an NFA state to a thread list, with the captures of the path to it
+    void DfaMatcher::AddThread(uint list, uint& listLength, uint32 nfaState, CharCount inputOffset, CharCount inputLength, bool& hasMatch)
+    {
+        const NfaState* const states = nfa->forward.states;
+        const uint numSlots = 2 * nfa->numGroups;
+        uint stackLength = 0;
+        simulationStack[stackLength].stateOrSlot = nfaState;
+        simulationStack[stackLength++].value = 0;
+        while (stackLength != 0)
+        {
+            const SimulationStackEntry entry = simulationStack[--stackLength];
+            if ((entry.stateOrSlot & RestoreFlag) != 0)
+            {
+                captures[entry.stateOrSlot & ~RestoreFlag] = entry.value;
+                continue;
+            }
+
+            const uint32 id = entry.stateOrSlot;
+            if (visited[id] == visitStamp)
+            {
+                continue;
+            }
+            visited[id] = visitStamp;
+
+            const NfaState& state = states[id];
+            switch (state.kind)
+            {
+            case NfaState::Consume:
+            case NfaState::Match:
+                Assert(listLength < nfa->forward.numLeaves);
+                threadStates[list][listLength] = id;
+                js_memcpy_s(threadCaptures[list] + listLength * numSlots, numSlots * sizeof(CharCount), captures, numSlots * sizeof(CharCount));
+                listLength++;
+                if (state.kind == NfaState::Match)
+                {
+                    // Everything not yet explored has a lower priority than this match
+                    hasMatch = true;
+                    return;
+                }
+                break;
+
+            case NfaState::Split:
+                simulationStack[stackLength].stateOrSlot = state.arg;
+                simulationStack[stackLength++].value = 0;
+                simulationStack[stackLength].stateOrSlot = state.next;
+                simulationStack[stackLength++].value = 0;
+                break;
+
+            case NfaState::AssertStart:
+                if (inputOffset == 0)
+                {
+                    simulationStack[stackLength].stateOrSlot = state.next;
+                    simulationStack[stackLength++].value = 0;
+                }
+                break;
+
+            case NfaState::AssertEnd:
+                if (inputOffset == inputLength)
+                {
+                    simulationStack[stackLength].stateOrSlot = state.next;
+                    simulationStack[stackLength++].value = 0;
+                }
+                break;
+
+            case NfaState::Save:
+                // Restore the slot once everything reached through this state has been explored
+                simulationStack[stackLength].stateOrSlot = state.arg | RestoreFlag;
+                simulationStack[stackLength++].value = captures[state.arg];
+                captures[state.arg] = inputOffset;
+                simulationStack[stackLength].stateOrSlot = state.next;
+                simulationStack[stackLength++].value = 0;
+                break;
+
+            case NfaState::ResetGroups:
+                for (uint32 groupId = state.arg; groupId <= state.arg2; groupId++)
+                {
+                    simulationStack[stackLength].stateOrSlot = (2 * groupId + 1) | RestoreFlag;
+                    simulationStack[stackLength++].value = captures[2 * groupId + 1];
+                    captures[2 * groupId + 1] = CharCountFlag;
+                }
+                simulationStack[stackLength].stateOrSlot = state.next;
+                simulationStack[stackLength++].value = 0;
+                break;
+
+            default:
+                Assert(false);
+                break;
+            }
+            Assert(stackLength <= nfa->simulationStackSize);
+        }
+    }
+}
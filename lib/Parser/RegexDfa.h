@@ -0,0 +1,329 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+//
+// Linear time matching for patterns without backreferences or lookarounds.
+//
+// When such a pattern is compiled we also build a Thompson NFA for it, and one for its reverse, over an alphabet
+// of character classes (sets of characters the pattern never distinguishes). A match is then found by:
+//  - scanning forward with a DFA, built lazily from the NFA, for the end of the leftmost match, taking alternatives
+//    and loop iterations in the same order as the backtracking matcher would;
+//  - scanning backward from that end with the DFA of the reverse NFA for the start of the match;
+//  - if the pattern has capturing groups, simulating the NFA over the matched text to recover them.
+// The DFA states are cached per matcher within a fixed budget. When the cache thrashes the DFA gives up on that
+// input and the match is found by simulating the NFA over the whole input, which is slower but still linear.
+//
+#pragma once
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // Nfa
+    // ----------------------------------------------------------------------
+
+    struct NfaState
+    {
+        enum StateKind : uint8
+        {
+            Consume,        // Consume a character whose class is in the class set at arg, continue at next
+            Split,          // Continue at next, or failing that at arg
+            AssertStart,    // Continue at next if at the start of the input (^ forward, $ reversed)
+            AssertEnd,      // Continue at next if at the end of the input ($ forward, ^ reversed)
+            Save,           // Record the input offset in capture slot arg, continue at next
+            ResetGroups,    // Undefine groups arg..arg2 (at the start of a loop iteration), continue at next
+            Match
+        };
+
+        StateKind kind;
+        uint32 next;
+        uint32 arg;
+        uint32 arg2;
+    };
+
+    struct NfaAutomaton
+    {
+        // In run-time allocator, owned by Nfa
+        NfaState* states;
+        uint32 numStates;
+        // Number of Consume and Match states
+        uint32 numLeaves;
+        uint32 anchoredStart;
+        // Start which also tries each later input offset, at a lower priority than all earlier ones (forward only)
+        uint32 unanchoredStart;
+    };
+
+    class Nfa : private Chars<char16>
+    {
+        friend class NfaBuilder;
+        friend class LazyDfa;
+        friend class DfaMatcher;
+
+    public:
+        // Limits on the patterns we build an NFA for
+        static const uint MaxStates = 2048;
+        static const uint MaxClasses = 256;
+        static const uint MaxIntervals = 4096;
+        static const uint MaxThreadCaptures = 32 * 1024;
+
+    private:
+        uint8 asciiClasses[MaxUCharAscii + 1];
+        // Non-ASCII characters in [intervalStarts[i], intervalStarts[i + 1]) are all in class intervalClasses[i].
+        // intervalStarts[0] is the first non-ASCII character.
+        Char* intervalStarts;
+        uint8* intervalClasses;
+        uint numIntervals;
+        uint numClasses;
+
+        // Class sets of Consume states, one bit per class, classSetWords words per set
+        uint32* classSets;
+        uint classSetWords;
+
+        NfaAutomaton forward;
+        NfaAutomaton reverse;
+
+        int numGroups;
+        // Bound on the size of the work stack of an NFA simulation step
+        uint32 simulationStackSize;
+
+    public:
+        inline uint8 ClassOf(Char c) const
+        {
+            if (CTU(c) <= MaxUCharAscii)
+            {
+                return asciiClasses[CTU(c)];
+            }
+
+            uint lo = 0;
+            uint hi = numIntervals - 1;
+            while (lo < hi)
+            {
+                const uint mid = (lo + hi + 1) / 2;
+                if (intervalStarts[mid] <= c)
+                    lo = mid;
+                else
+                    hi = mid - 1;
+            }
+            return intervalClasses[lo];
+        }
+
+        inline bool Consumes(const NfaState& state, uint8 characterClass) const
+        {
+            Assert(state.kind == NfaState::Consume);
+            return (classSets[state.arg + characterClass / 32] & (1u << (characterClass % 32))) != 0;
+        }
+    };
+
+    // ----------------------------------------------------------------------
+    // NfaBuilder
+    // ----------------------------------------------------------------------
+
+    class NfaBuilder : private Chars<char16>
+    {
+    private:
+        Compiler& compiler;
+        ArenaAllocator* const allocator;
+        const Char* litbuf;
+        bool failed;
+
+        // Intervals of characters the pattern never distinguishes, and the class of each
+        Char* intervalStarts;
+        uint16* intervalClasses;
+        uint numIntervals;
+        uint numClasses;
+        uint16* classPairs;
+
+        // Class sets of Consume states
+        uint32* classSets;
+        uint classSetWords;
+        uint classSetsLength;
+        uint classSetsCapacity;
+
+        // Class set of each MatchSet node, keyed by node
+        MatchSetNode** setNodes;
+        uint32* setNodeClassSets;
+        uint setNodesMask;
+
+        NfaState* states;
+        uint32 numStates;
+        bool isReverse;
+        bool withCaptures;
+
+        NfaBuilder(Compiler& compiler, const Char* litbuf);
+
+        bool IsSupported(Node* node, uint& numCharTests, uint& numSetNodes);
+        void CollectBoundaries(Node* node, CharSet<Char>& boundaries);
+        void AddCharBoundaries(const Char* cs, int numChars, CharSet<Char>& boundaries);
+        void RefineClasses(Node* node);
+        void RefineClassesByChars(const Char* cs, int numChars);
+        void RefineClassesBySet(MatchSetNode* node);
+
+        uint FindInterval(Char c) const;
+        uint32 AddCharsClassSet(const Char* cs, int numChars);
+        uint32 SetClassSet(MatchSetNode* node);
+        uint32 AllClassesSet();
+
+        uint32 NewState(NfaState::StateKind kind, uint32 next, uint32 arg = 0, uint32 arg2 = 0);
+        uint32 BuildNode(Node* node, uint32 next);
+        uint32 BuildLoop(LoopNode* node, uint32 next);
+        uint32 BuildIteration(LoopNode* node, uint32 next);
+        bool BuildAutomaton(Node* root, bool isReverse, bool withCaptures, NfaAutomaton& automaton, const ProgramAllocator& programAllocator);
+
+    public:
+        // Build the NFAs for a pattern, or return null if it needs backtracking or is too large
+        static Nfa* Build(Compiler& compiler, Node* root);
+    };
+
+    // ----------------------------------------------------------------------
+    // LazyDfa
+    // ----------------------------------------------------------------------
+
+    // DFA for one of the NFAs of a pattern. A DFA state is the list of NFA Consume, Match and pending AssertEnd states
+    // reachable at some input offset, in priority order. States and transitions are added as the input needs them.
+    class LazyDfa : private Chars<char16>
+    {
+        friend class DfaMatcher;
+
+    private:
+        static const uint32 UnknownState = (uint32)-1;
+        static const uint32 DeadState = (uint32)-2;
+
+        // Budget for the states and transitions of one DFA
+        static const uint MaxCacheBytes = 256 * 1024;
+        static const uint MinStates = 16;
+        static const uint MaxListEntries = 64 * 1024;
+
+        enum StateFlags : uint8
+        {
+            IsMatchFlag = 1 << 0,
+            // Indexed by whether the start assertion holds
+            AcceptsAtEndKnownFlag = 1 << 1,
+            AcceptsAtEndFlag = 1 << 3
+        };
+
+        Recycler* recycler;
+        const Nfa* nfa;
+        const NfaAutomaton* automaton;
+        // Stop at the first match in priority order (forward), or find all matches (reverse)
+        bool isLeftmostFirst;
+        uint maxStates;
+
+        uint numStates;
+        uint stateCapacity;
+        uint32* transitions;
+        uint32* listStarts;
+        uint8* stateFlags;
+        uint32* lists;
+        uint listsLength;
+        uint listsCapacity;
+        uint32* buckets;
+        uint bucketsMask;
+        uint32 startStates[4];
+        uint numResets;
+
+        // Scratch space for computing a state
+        uint32* scratchList;
+        uint scratchLength;
+        uint32* stack;
+        uint32* visited;
+        uint32 visitStamp;
+
+        void Initialize(Recycler* recycler, const Nfa* nfa, const NfaAutomaton* automaton, bool isLeftmostFirst);
+        void EnsureScratch();
+        void BeginVisit();
+        bool AddClosure(uint32 nfaState, bool startHolds);
+        bool ReachesMatchAtEnd(uint32 nfaState, bool startHolds);
+        uint32 FindOrAddState();
+        bool GrowStates();
+        void Reset();
+        void Rehash();
+        uint32 HashList(const uint32* list, uint length) const;
+
+        uint32 ComputeStartState(uint index, bool isAnchored, bool startHolds);
+        uint32 ComputeNextState(uint32 state, uint8 characterClass);
+        bool ComputeAcceptsAtEnd(uint32 state, bool startHolds);
+
+        inline uint32 StartState(bool isAnchored, bool startHolds)
+        {
+            const uint index = (isAnchored ? 2 : 0) + (startHolds ? 1 : 0);
+            const uint32 state = startStates[index];
+            return state != UnknownState ? state : ComputeStartState(index, isAnchored, startHolds);
+        }
+
+        inline uint32 NextState(uint32 state, uint8 characterClass)
+        {
+            const uint32 next = transitions[state * nfa->numClasses + characterClass];
+            return next != UnknownState ? next : ComputeNextState(state, characterClass);
+        }
+
+        inline bool IsMatch(uint32 state) const
+        {
+            return (stateFlags[state] & IsMatchFlag) != 0;
+        }
+
+        inline bool AcceptsAtEnd(uint32 state, bool startHolds)
+        {
+            const uint8 flags = stateFlags[state];
+            if ((flags & (AcceptsAtEndKnownFlag << startHolds)) != 0)
+            {
+                return (flags & (AcceptsAtEndFlag << startHolds)) != 0;
+            }
+            return ComputeAcceptsAtEnd(state, startHolds);
+        }
+    };
+
+    // ----------------------------------------------------------------------
+    // DfaMatcher
+    // ----------------------------------------------------------------------
+
+    class DfaMatcher : private Chars<char16>
+    {
+    private:
+        enum ScanResult
+        {
+            NotFound,
+            Found,
+            GaveUp
+        };
+
+        // Give up on an input if the DFA cache is reset before this many characters per cached state are scanned
+        static const uint MinCharsPerState = 10;
+        // Stop using the DFA after giving up on this many inputs
+        static const uint MaxGiveUps = 8;
+
+        static const uint32 RestoreFlag = 1u << 31;
+
+        struct SimulationStackEntry
+        {
+            uint32 stateOrSlot;
+            CharCount value;
+        };
+
+        Recycler* recycler;
+        const Nfa* nfa;
+        LazyDfa forwardDfa;
+        LazyDfa reverseDfa;
+        uint numGiveUps;
+
+        // Scratch space for simulating the NFA
+        uint32* threadStates[2];
+        CharCount* threadCaptures[2];
+        CharCount* captures;
+        SimulationStackEntry* simulationStack;
+        uint32* visited;
+        uint32 visitStamp;
+
+        DfaMatcher(Recycler* recycler, const Nfa* nfa);
+
+        ScanResult ScanForward(const Char* const input, const CharCount inputLength, CharCount offset, bool isAnchored, CharCount& matchEnd);
+        ScanResult ScanReverse(const Char* const input, const CharCount inputLength, CharCount offset, CharCount matchEnd, CharCount& matchStart);
+        bool Simulate(Matcher& matcher, const Char* const input, const CharCount inputLength, CharCount offset, CharCount limit, bool isAnchored, GroupInfo* groupInfos, uint& qcTicks);
+        void AddThread(uint list, uint& listLength, uint32 nfaState, CharCount inputOffset, CharCount inputLength, bool& hasMatch);
+
+    public:
+        static DfaMatcher* New(Recycler* recycler, const Nfa* nfa);
+
+        // Same contract as Matcher::Match: sets groupInfos on success, resets group 0 on failure
+        bool Match(Matcher& matcher, const Char* const input, const CharCount inputLength, CharCount offset, bool isAnchored, GroupInfo* groupInfos, uint& qcTicks);
+    };
+}
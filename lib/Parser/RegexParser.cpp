@@ -2883,12 +2883,29 @@ namespace UnifiedRegex
         Assert(IsLiteral);
 
         Program* program = nullptr;
+        Program* cachedProgram = nullptr;
+
+        // Runtimes which share compiled regexes only compile a pattern once per process. On a miss, the program is
+        // compiled into a new cache entry and published once its pattern exists.
+        ProgramCache::AutoCompile cacheCompile(this->scriptContext);
 
         if (buildAST)
         {
-            const auto recycler = this->scriptContext->GetRecycler();
-            program = Program::New(recycler, flags);
-            this->CaptureSourceAndGroups(recycler, program, currentCharacter, bodyChars);
+            if (cacheCompile.IsSharing())
+            {
+                Char* source = AnewArray(ctAllocator, Char, bodyChars + 1);
+                this->ConvertToUnicode(source, bodyChars, currentCharacter);
+                source[bodyChars] = 0;
+                cachedProgram = cacheCompile.Lookup(source, bodyChars, flags);
+                AdeleteArray(ctAllocator, bodyChars + 1, source);
+            }
+
+            if (cachedProgram == nullptr)
+            {
+                const auto recycler = this->scriptContext->GetRecycler();
+                program = cacheCompile.NewProgram(flags);
+                this->CaptureSourceAndGroups(recycler, program, currentCharacter, bodyChars);
+            }
         }
 
         currentCharacter += totalLen;
@@ -2899,7 +2916,15 @@ namespace UnifiedRegex
             return nullptr;
         }
 
-        RegexPattern* pattern = RegexPattern::New(this->scriptContext, program, true);
+        if (cachedProgram != nullptr)
+        {
+#ifdef PROFILE_EXEC
+            this->scriptContext->ProfileEnd(Js::RegexCompilePhase);
+#endif
+            return cacheCompile.NewPattern(cachedProgram, true);
+        }
+
+        RegexPattern* pattern = cacheCompile.NewPattern(program, true);
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
         RegexStats* stats = 0;
@@ -2919,11 +2944,10 @@ namespace UnifiedRegex
             this->scriptContext->GetRegexStatsDatabase()->BeginProfile();
 #endif
 
-        ArenaAllocator* rtAllocator = this->scriptContext->RegexAllocator();
         Compiler::Compile
             ( this->scriptContext
               , ctAllocator
-              , rtAllocator
+              , cacheCompile.GetRuntimeAllocator()
               , standardChars
               , program
               , root
@@ -2934,6 +2958,7 @@ namespace UnifiedRegex
               , stats
 #endif
                 );
+        cacheCompile.Publish();
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
         if (REGEX_CONFIG_FLAG(RegexProfile))
@@ -2967,7 +2992,7 @@ namespace UnifiedRegex
         Assert(body != 0);
 
         // Program will own source string
-        program->source = RecyclerNewArrayLeaf(recycler, Char, bodyChars + 1);
+        program->source = program->GetAllocator(recycler).NewArrayLeaf<Char>(bodyChars + 1);
         // Don't need to zero out since we're writing to the buffer right here
         this->ConvertToUnicode(program->source, bodyChars, body);
         program->source[bodyChars] = 0;
@@ -26,6 +26,14 @@ namespace UnifiedRegex
     }
     void RegexPattern::Finalize(bool isShutdown)
     {
+        // Every pattern, shallow clones included, holds its own reference to a shared program. It outlives the script
+        // context, so let go of it even at shutdown.
+        if(rep.unified.program->IsShared())
+        {
+            ProgramCache::Release(rep.unified.program);
+            return;
+        }
+
         if(isShutdown)
             return;
 
@@ -122,6 +130,10 @@ namespace UnifiedRegex
         // of a clone might be longer than the original.
 
         RegexPattern *result = UnifiedRegex::RegexPattern::New(scriptContext, rep.unified.program, isLiteral);
+        if (rep.unified.program->IsShared())
+        {
+            ProgramCache::AddRef(rep.unified.program);
+        }
         Matcher *matcherClone = rep.unified.matcher ? rep.unified.matcher->CloneToScriptContext(scriptContext, result) : nullptr;
         result->rep.unified.matcher = matcherClone;
         result->isShallowClone = true;
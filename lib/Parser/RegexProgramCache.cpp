@@ -0,0 +1,344 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "ParserPch.h"
+
+namespace UnifiedRegex
+{
+    ProgramCacheEntry::ProgramCacheEntry(char16* source, CharCount sourceLen, RegexFlags flags, uint8 parserOptions, hash_t hashCode)
+        // Programs are small; commit their pages one at a time and give them back as soon as the entry goes
+        : pageAllocator(nullptr, Js::Configuration::Global.flags, PageAllocatorType_Max, 0, false,
+#if ENABLE_BACKGROUND_PAGE_FREEING
+            nullptr,
+#endif
+            1),
+        arena(_u("RegexProgramCache"), &pageAllocator, Js::Throw::OutOfMemory),
+        program(nullptr),
+        source(source),
+        sourceLen(sourceLen),
+        flags(flags),
+        hashCode(hashCode),
+        parserOptions(parserOptions),
+        isCompiling(true),
+        isCached(false),
+        refCount(0),
+        nextInBucket(nullptr),
+        previous(nullptr),
+        next(nullptr)
+    {
+#if DBG
+        // Used by the compiling thread, then by whichever thread holds the cache lock
+        pageAllocator.SetDisableThreadAccessCheck();
+#endif
+    }
+
+    ProgramCacheEntry::~ProgramCacheEntry()
+    {
+        HeapDeleteArray(this->sourceLen + 1, this->source);
+    }
+
+    CriticalSection ProgramCache::cs;
+    ProgramCacheEntry* ProgramCache::buckets[ProgramCache::BucketCount];
+    ProgramCacheEntry* ProgramCache::mostRecentlyUsed = nullptr;
+    ProgramCacheEntry* ProgramCache::leastRecentlyUsed = nullptr;
+    uint ProgramCache::count = 0;
+
+    uint8 ProgramCache::GetParserOptions(Js::ScriptContext* scriptContext)
+    {
+        // The parser looks at these even for patterns without the u or y flag
+        Js::ScriptConfiguration const * config = scriptContext->GetConfig();
+        return (config->IsES6UnicodeExtensionsEnabled() ? 1 : 0) | (config->IsES6RegExStickyEnabled() ? 2 : 0);
+    }
+
+    ProgramCacheEntry* ProgramCache::Find(const char16* source, CharCount sourceLen, RegexFlags flags, uint8 parserOptions, hash_t hashCode)
+    {
+        Assert(cs.IsLocked());
+
+        const RegexKey key(source, sourceLen, flags);
+        for (ProgramCacheEntry* entry = buckets[hashCode % BucketCount]; entry != nullptr; entry = entry->nextInBucket)
+        {
+            if (entry->hashCode == hashCode &&
+                entry->parserOptions == parserOptions &&
+                RegexKeyComparer::Equals(key, RegexKey(entry->source, entry->sourceLen, entry->flags)))
+            {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void ProgramCache::MoveToFront(ProgramCacheEntry* entry)
+    {
+        Assert(cs.IsLocked());
+
+        if (entry == mostRecentlyUsed)
+        {
+            return;
+        }
+
+        // Unlink from the use list
+        entry->previous->next = entry->next;
+        if (entry->next != nullptr)
+        {
+            entry->next->previous = entry->previous;
+        }
+        else
+        {
+            leastRecentlyUsed = entry->previous;
+        }
+
+        entry->previous = nullptr;
+        entry->next = mostRecentlyUsed;
+        mostRecentlyUsed->previous = entry;
+        mostRecentlyUsed = entry;
+    }
+
+    void ProgramCache::UnlinkFromBucket(ProgramCacheEntry* entry)
+    {
+        Assert(cs.IsLocked());
+
+        ProgramCacheEntry** link = &buckets[entry->hashCode % BucketCount];
+        while (*link != entry)
+        {
+            link = &(*link)->nextInBucket;
+        }
+        *link = entry->nextInBucket;
+    }
+
+    void ProgramCache::Unlink(ProgramCacheEntry* entry)
+    {
+        Assert(cs.IsLocked());
+        Assert(entry->refCount == 0 && !entry->isCompiling);
+
+        UnlinkFromBucket(entry);
+
+        if (entry->previous != nullptr)
+        {
+            entry->previous->next = entry->next;
+        }
+        else
+        {
+            mostRecentlyUsed = entry->next;
+        }
+        if (entry->next != nullptr)
+        {
+            entry->next->previous = entry->previous;
+        }
+        else
+        {
+            leastRecentlyUsed = entry->previous;
+        }
+
+        count--;
+    }
+
+    void ProgramCache::Trim(uint maxCount)
+    {
+        Assert(cs.IsLocked());
+
+        // Programs in use can't go; skip over them
+        ProgramCacheEntry* entry = leastRecentlyUsed;
+        while (count > maxCount && entry != nullptr)
+        {
+            ProgramCacheEntry* const previous = entry->previous;
+            if (entry->refCount == 0)
+            {
+                Unlink(entry);
+                HeapDelete(entry);
+            }
+            entry = previous;
+        }
+    }
+
+    void ProgramCache::AddRef(Program* program)
+    {
+        Assert(program->IsShared());
+
+        AutoCriticalSection autocs(&cs);
+        program->cacheEntry->refCount++;
+    }
+
+    void ProgramCache::Release(Program* program)
+    {
+        Assert(program->IsShared());
+
+        AutoCriticalSection autocs(&cs);
+        ProgramCacheEntry* const entry = program->cacheEntry;
+        Assert(entry->refCount != 0);
+        if (--entry->refCount != 0)
+        {
+            return;
+        }
+
+        if (entry->isCached)
+        {
+            Trim((uint)REGEX_CONFIG_FLAG(RegexProgramCacheSize));
+        }
+        else
+        {
+            HeapDelete(entry);
+        }
+    }
+
+    void ProgramCache::Clear()
+    {
+        // Programs still referenced by patterns that were never finalized keep their entries
+        AutoCriticalSection autocs(&cs);
+        Trim(0);
+    }
+
+    ProgramCache::AutoCompile::AutoCompile(Js::ScriptContext* scriptContext)
+        : scriptContext(scriptContext),
+        isSharing(scriptContext->GetThreadContext()->ShareRegex()),
+        hasPattern(false),
+        hashCode(0),
+        cachedProgram(nullptr),
+        entry(nullptr)
+    {
+    }
+
+    ProgramCache::AutoCompile::~AutoCompile()
+    {
+        if (this->entry != nullptr)
+        {
+            // Compilation threw, so the program was never published. Give the key up; if compilation got as far as
+            // creating the pattern, the entry goes when the pattern does.
+            {
+                AutoCriticalSection autocs(&cs);
+                UnlinkFromBucket(this->entry);
+            }
+
+            if (this->hasPattern)
+            {
+                this->entry->refCount = 1;
+            }
+            else
+            {
+                HeapDelete(this->entry);
+            }
+        }
+        else if (this->cachedProgram != nullptr && !this->hasPattern)
+        {
+            Release(this->cachedProgram);
+        }
+    }
+
+    Program* ProgramCache::AutoCompile::Lookup(const char16* source, CharCount sourceLen, RegexFlags flags)
+    {
+        Assert(this->isSharing);
+        Assert(this->entry == nullptr && this->cachedProgram == nullptr);
+
+        this->hashCode = RegexKeyComparer::GetHashCode(RegexKey(source, sourceLen, flags));
+        const uint8 parserOptions = GetParserOptions(this->scriptContext);
+
+        AutoCriticalSection autocs(&cs);
+        ProgramCacheEntry* const cached = Find(source, sourceLen, flags, parserOptions, this->hashCode);
+        if (cached == nullptr)
+        {
+            // Claim the key, so that the program is compiled only once. If there isn't the memory for an entry, compile
+            // the program for this script context only.
+            char16* const key = HeapNewNoThrowArray(char16, sourceLen + 1);
+            if (key == nullptr)
+            {
+                return nullptr;
+            }
+            js_wmemcpy_s(key, sourceLen + 1, source, sourceLen);
+            key[sourceLen] = 0;
+
+            ProgramCacheEntry* const newEntry = HeapNewNoThrow(ProgramCacheEntry, key, sourceLen, flags, parserOptions, this->hashCode);
+            if (newEntry == nullptr)
+            {
+                HeapDeleteArray(sourceLen + 1, key);
+                return nullptr;
+            }
+
+            ProgramCacheEntry** const bucket = &buckets[this->hashCode % BucketCount];
+            newEntry->nextInBucket = *bucket;
+            *bucket = newEntry;
+            this->entry = newEntry;
+            return nullptr;
+        }
+
+        if (cached->isCompiling)
+        {
+            // Another thread is compiling the same program. Compile one for this script context rather than wait for it.
+            return nullptr;
+        }
+
+        cached->refCount++;
+        MoveToFront(cached);
+
+        this->cachedProgram = cached->program;
+        return this->cachedProgram;
+    }
+
+    Program* ProgramCache::AutoCompile::NewProgram(RegexFlags flags)
+    {
+        Assert(this->cachedProgram == nullptr);
+
+        if (this->entry == nullptr)
+        {
+            // Not sharing, not looked up, or another thread is compiling the same program
+            return Program::New(this->scriptContext->GetRecycler(), flags);
+        }
+
+        // Only this thread uses the entry until it is published
+        Assert(this->entry->program == nullptr);
+        Program* const program = Anew(this->entry->GetArena(), Program, flags);
+        program->cacheEntry = this->entry;
+        this->entry->program = program;
+        return program;
+    }
+
+    ArenaAllocator* ProgramCache::AutoCompile::GetRuntimeAllocator() const
+    {
+        return this->entry != nullptr ? this->entry->GetArena() : this->scriptContext->RegexAllocator();
+    }
+
+    RegexPattern* ProgramCache::AutoCompile::NewPattern(Program* program, bool isLiteral)
+    {
+        Assert(!this->hasPattern);
+        Assert(program->IsShared() == (program == this->cachedProgram || (this->entry != nullptr && program == this->entry->program)));
+
+        RegexPattern* const pattern = RegexPattern::New(this->scriptContext, program, isLiteral);
+        this->hasPattern = true;
+        return pattern;
+    }
+
+    void ProgramCache::AutoCompile::Publish()
+    {
+        if (this->entry == nullptr)
+        {
+            return;
+        }
+
+        Assert(this->hasPattern);
+        ProgramCacheEntry* const entry = this->entry;
+        Assert(entry->program != nullptr);
+
+        AutoCriticalSection autocs(&cs);
+        Assert(entry->isCompiling);
+        Assert(Find(entry->source, entry->sourceLen, entry->flags, entry->parserOptions, entry->hashCode) == entry);
+
+        entry->isCompiling = false;
+        entry->next = mostRecentlyUsed;
+        if (mostRecentlyUsed != nullptr)
+        {
+            mostRecentlyUsed->previous = entry;
+        }
+        else
+        {
+            leastRecentlyUsed = entry;
+        }
+        mostRecentlyUsed = entry;
+
+        // The pattern's reference
+        entry->refCount = 1;
+        entry->isCached = true;
+        count++;
+        Trim((uint)REGEX_CONFIG_FLAG(RegexProgramCacheSize));
+
+        this->entry = nullptr;
+    }
+}
@@ -0,0 +1,118 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace UnifiedRegex
+{
+    struct Program;
+    struct RegexPattern;
+
+    // A compiled program in the process-wide cache, with the arena holding it and everything it owns
+    class ProgramCacheEntry
+    {
+        friend class ProgramCache;
+
+    public:
+        // Only ProgramCache creates and deletes entries. The entry takes over the key's source, a heap array.
+        ProgramCacheEntry(char16* source, CharCount sourceLen, RegexFlags flags, uint8 parserOptions, hash_t hashCode);
+        ~ProgramCacheEntry();
+
+        ArenaAllocator* GetArena() { return &this->arena; }
+
+    private:
+        // Each entry has pages of its own, so that its program can be compiled without holding the cache lock
+        PageAllocator pageAllocator;
+        ArenaAllocator arena;
+        Program* program;
+        // The key, which stays valid while the program is being compiled
+        char16* source;
+        CharCount sourceLen;
+        RegexFlags flags;
+        hash_t hashCode;
+        // Parser options the program was compiled with, see ProgramCache::GetParserOptions
+        uint8 parserOptions;
+        // Whether the program is still being compiled. The entry is in its bucket, but not in the use list.
+        bool isCompiling;
+        // Whether the entry was published. The pattern of a program whose compilation failed still owns its entry.
+        bool isCached;
+        uint refCount;
+
+        ProgramCacheEntry* nextInBucket;
+        // Most recently used entries first
+        ProgramCacheEntry* previous;
+        ProgramCacheEntry* next;
+    };
+
+    // Process-wide cache of compiled regex programs.
+    //
+    // Runtimes created with JsRuntimeAttributeShareCompiledRegex compile regexes into this cache instead of into the
+    // recycler and regex allocator of their script context, so every script context, in every such runtime, that
+    // compiles the same source with the same flags uses the same program. Programs are immutable once published and
+    // reference counted by their patterns. Unreferenced programs stay cached for the next script context that needs
+    // them; the least recently used ones are evicted once the cache holds more than RegexProgramCacheSize programs.
+    class ProgramCache
+    {
+    public:
+        static void AddRef(Program* program);
+        static void Release(Program* program);
+
+        // Frees the unreferenced programs, for when the process is done with all runtimes
+        static void Clear();
+
+        // Looks up and compiles a program for a pattern. For a script context which shares its regexes, a lookup which
+        // misses adds an entry for the key which is still being compiled, and the program is compiled into it without
+        // holding the cache lock, so that lookups of other keys don't wait for it. A lookup of the same key in the
+        // meantime compiles a program for its own script context rather than wait. Otherwise programs are compiled for
+        // the script context as usual.
+        class AutoCompile
+        {
+        public:
+            AutoCompile(Js::ScriptContext* scriptContext);
+            ~AutoCompile();
+
+            bool IsSharing() const { return this->isSharing; }
+
+            // The cached program for the given source and flags, or null if there is none and it is to be compiled
+            Program* Lookup(const char16* source, CharCount sourceLen, RegexFlags flags);
+
+            // The program to compile, and the allocator for its instruction bodies. After a lookup which added an entry,
+            // the program is in that entry; otherwise it is on the recycler of the script context.
+            Program* NewProgram(RegexFlags flags);
+            ArenaAllocator* GetRuntimeAllocator() const;
+
+            // The pattern for a looked up or new program, which takes over the reference to a shared program
+            RegexPattern* NewPattern(Program* program, bool isLiteral);
+
+            // Makes the compiled program in the new cache entry available to other lookups
+            void Publish();
+
+        private:
+            Js::ScriptContext* scriptContext;
+            bool isSharing;
+            bool hasPattern;
+            hash_t hashCode;
+            // Program found by the lookup, with a reference taken to it
+            Program* cachedProgram;
+            // Entry of the new program until it is published
+            ProgramCacheEntry* entry;
+        };
+
+    private:
+        static const uint BucketCount = 128;
+
+        static uint8 GetParserOptions(Js::ScriptContext* scriptContext);
+        static ProgramCacheEntry* Find(const char16* source, CharCount sourceLen, RegexFlags flags, uint8 parserOptions, hash_t hashCode);
+        static void MoveToFront(ProgramCacheEntry* entry);
+        static void UnlinkFromBucket(ProgramCacheEntry* entry);
+        static void Unlink(ProgramCacheEntry* entry);
+        static void Trim(uint maxCount);
+
+        static CriticalSection cs;
+        static ProgramCacheEntry* buckets[BucketCount];
+        static ProgramCacheEntry* mostRecentlyUsed;
+        static ProgramCacheEntry* leastRecentlyUsed;
+        static uint count;
+    };
+}
@@ -117,27 +117,18 @@ namespace UnifiedRegex
             stats->numCompares++;
     }
 
-    void Matcher::InstStats() const
+    void Matcher::CompStats(const CharCount numCompares) const
     {
         if (stats != 0)
-            stats->numInsts++;
+            stats->numCompares += numCompares;
     }
-#endif
 
-    inline void Matcher::QueryContinue(uint &qcTicks)
+    void Matcher::InstStats() const
     {
-        // See definition of TimePerQc for description of regex QC heuristics
-
-        Assert(!(TicksPerQc & TicksPerQc - 1)); // must be a power of 2
-        Assert(!(TicksPerQcTimeCheck & TicksPerQcTimeCheck - 1)); // must be a power of 2
-        Assert(TicksPerQcTimeCheck < TicksPerQc);
-
-        if(PHASE_OFF1(Js::RegexQcPhase))
-            return;
-        if(++qcTicks & TicksPerQcTimeCheck - 1)
-            return;
-        DoQueryContinue(qcTicks);
+        if (stats != 0)
+            stats->numInsts++;
     }
+#endif
 
     inline bool Matcher::HardFail
         ( const Char* const input
@@ -428,6 +419,21 @@ namespace UnifiedRegex
             return false;
         }
 
+        if (CharScan::IsVectorized())
+        {
+            const CharCount endOffset = inputLength - 1;
+            const CharCount matchOffset = CharScan::FindCharPair(input, inputOffset, endOffset, cs[0], cs[1], 1);
+#if ENABLE_REGEX_CONFIG_OPTIONS
+            matcher.CompStats(matchOffset - inputOffset + 1);
+#endif
+            if (matchOffset >= endOffset)
+            {
+                return false;
+            }
+            inputOffset = matchOffset;
+            return true;
+        }
+
         const uint matchC0 = Chars<char16>::CTU(cs[0]);
         const uint matchC1 = Chars<char16>::CTU(cs[1]);
 
@@ -1468,36 +1474,21 @@ namespace UnifiedRegex
             return matcher.Fail(FAIL_PARAMETERS);
 
         const Char *const literalBuffer = matcher.program->rep.insts.litbuf;
-        const Char * literalCurr = literalBuffer + offset;
-        const Char * inputCurr = input + inputOffset;
+        const CharCount mismatchIndex = CharScan::FindMismatch(literalBuffer + offset, input + inputOffset, length);
 
+        if (mismatchIndex < length)
+        {
 #if ENABLE_REGEX_CONFIG_OPTIONS
-        matcher.CompStats();
+            matcher.CompStats(mismatchIndex + 1);
 #endif
-        if (*literalCurr != *inputCurr)
-        {
-            inputOffset++;
+            inputOffset += mismatchIndex + 1;
             return matcher.Fail(FAIL_PARAMETERS);
         }
 
-        const Char *const literalEnd = literalCurr + length;
-        literalCurr++;
-        inputCurr++;
-
-        while (literalCurr < literalEnd)
-        {
 #if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
+        matcher.CompStats(length);
 #endif
-            if (*literalCurr != *inputCurr++)
-            {
-                inputOffset = (CharCount)(inputCurr - input);
-                return matcher.Fail(FAIL_PARAMETERS);
-            }
-            literalCurr++;
-        }
-
-        inputOffset = (CharCount)(inputCurr - input);
+        inputOffset += length;
         instPointer += sizeof(*this);
         return false;
     }
@@ -1653,16 +1644,11 @@ namespace UnifiedRegex
     inline bool SyncToCharAndContinueInst::Exec(REGEX_INST_EXEC_PARAMETERS) const
     {
         const Char matchC = c;
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindChar(input, inputOffset, inputLength, matchC);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-        matcher.CompStats();
-#endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset + 1);
 #endif
-            inputOffset++;
-        }
 
         matchStart = inputOffset;
         instPointer += sizeof(*this);
@@ -1687,16 +1673,11 @@ namespace UnifiedRegex
     {
         const Char matchC0 = cs[0];
         const Char matchC1 = cs[1];
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindChar2(input, inputOffset, inputLength, matchC0, matchC1);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-        matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset + 1);
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC0 && input[inputOffset] != matchC1)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
 
         matchStart = inputOffset;
         instPointer += sizeof(*this);
@@ -1722,18 +1703,12 @@ namespace UnifiedRegex
     inline bool SyncToSetAndContinueInst<IsNegation>::Exec(REGEX_INST_EXEC_PARAMETERS) const
     {
         const RuntimeCharSet<Char>& matchSet = this->set;
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindInSet<!IsNegation>(input, inputOffset, inputLength, matchSet);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-        matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset + 1);
 #endif
 
-        while (inputOffset < inputLength && matchSet.Get(input[inputOffset]) == IsNegation)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
-
         matchStart = inputOffset;
         instPointer += sizeof(*this);
         return false;
@@ -1790,16 +1765,11 @@ namespace UnifiedRegex
     inline bool SyncToCharAndConsumeInst::Exec(REGEX_INST_EXEC_PARAMETERS) const
     {
         const Char matchC = c;
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindChar(input, inputOffset, inputLength, matchC);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-        matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset + 1);
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -1827,16 +1797,11 @@ namespace UnifiedRegex
     {
         const Char matchC0 = cs[0];
         const Char matchC1 = cs[1];
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindChar2(input, inputOffset, inputLength, matchC0, matchC1);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-        matcher.CompStats();
-#endif
-        while (inputOffset < inputLength && (input[inputOffset] != matchC0 && input[inputOffset] != matchC1))
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset + 1);
 #endif
-            inputOffset++;
-        }
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -1864,16 +1829,11 @@ namespace UnifiedRegex
     inline bool SyncToSetAndConsumeInst<IsNegation>::Exec(REGEX_INST_EXEC_PARAMETERS) const
     {
         const RuntimeCharSet<Char>& matchSet = this->set;
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindInSet<!IsNegation>(input, inputOffset, inputLength, matchSet);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-        matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset + 1);
 #endif
-        while (inputOffset < inputLength && matchSet.Get(input[inputOffset]) == IsNegation)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -1951,13 +1911,11 @@ namespace UnifiedRegex
             inputOffset = matchStart + backup.lower;
 
         const Char matchC = c;
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindChar(input, inputOffset, inputLength, matchC);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset);
 #endif
-            inputOffset++;
-        }
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -2014,13 +1972,11 @@ namespace UnifiedRegex
             inputOffset = matchStart + backup.lower;
 
         const RuntimeCharSet<Char>& matchSet = this->set;
-        while (inputOffset < inputLength && matchSet.Get(input[inputOffset]) == IsNegation)
-        {
+        const CharCount syncStartOffset = inputOffset;
+        inputOffset = CharScan::FindInSet<!IsNegation>(input, inputOffset, inputLength, matchSet);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
+        matcher.CompStats(inputOffset - syncStartOffset);
 #endif
-            inputOffset++;
-        }
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -3268,21 +3224,11 @@ namespace UnifiedRegex
 #endif
         if(Mode == ChompMode::Star || (inputOffset < inputLength && input[inputOffset] == matchC))
         {
-            while(true)
-            {
-                if(Mode != ChompMode::Star)
-                    ++inputOffset;
+            const CharCount runStartOffset = Mode == ChompMode::Star ? inputOffset : inputOffset + 1;
+            inputOffset = CharScan::FindNotChar(input, runStartOffset, inputLength, matchC);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-                matcher.CompStats();
+            matcher.CompStats(inputOffset - runStartOffset + 1);
 #endif
-                if(inputOffset < inputLength && input[inputOffset] == matchC)
-                {
-                    if(Mode == ChompMode::Star)
-                        ++inputOffset;
-                    continue;
-                }
-                break;
-            }
 
             instPointer += sizeof(*this);
             return false;
@@ -3315,21 +3261,11 @@ namespace UnifiedRegex
 #endif
         if(Mode == ChompMode::Star || (inputOffset < inputLength && matchSet.Get(input[inputOffset])))
         {
-            while(true)
-            {
-                if(Mode != ChompMode::Star)
-                    ++inputOffset;
+            const CharCount runStartOffset = Mode == ChompMode::Star ? inputOffset : inputOffset + 1;
+            inputOffset = CharScan::FindInSet<false>(input, runStartOffset, inputLength, matchSet);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-                matcher.CompStats();
+            matcher.CompStats(inputOffset - runStartOffset + 1);
 #endif
-                if(inputOffset < inputLength && matchSet.Get(input[inputOffset]))
-                {
-                    if(Mode == ChompMode::Star)
-                        ++inputOffset;
-                    continue;
-                }
-                break;
-            }
 
             instPointer += sizeof(*this);
             return false;
@@ -3365,21 +3301,11 @@ namespace UnifiedRegex
 #endif
         if(Mode == ChompMode::Star || (inputOffset < inputLength && input[inputOffset] == matchC))
         {
-            while(true)
-            {
-                if(Mode != ChompMode::Star)
-                    ++inputOffset;
+            const CharCount runStartOffset = Mode == ChompMode::Star ? inputOffset : inputOffset + 1;
+            inputOffset = CharScan::FindNotChar(input, runStartOffset, inputLength, matchC);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-                matcher.CompStats();
+            matcher.CompStats(inputOffset - runStartOffset + 1);
 #endif
-                if(inputOffset < inputLength && input[inputOffset] == matchC)
-                {
-                    if(Mode == ChompMode::Star)
-                        ++inputOffset;
-                    continue;
-                }
-                break;
-            }
 
             if(!noNeedToSave)
             {
@@ -3432,21 +3358,11 @@ namespace UnifiedRegex
 #endif
         if(Mode == ChompMode::Star || (inputOffset < inputLength && matchSet.Get(input[inputOffset])))
         {
-            while(true)
-            {
-                if(Mode != ChompMode::Star)
-                    ++inputOffset;
+            const CharCount runStartOffset = Mode == ChompMode::Star ? inputOffset : inputOffset + 1;
+            inputOffset = CharScan::FindInSet<false>(input, runStartOffset, inputLength, matchSet);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-                matcher.CompStats();
+            matcher.CompStats(inputOffset - runStartOffset + 1);
 #endif
-                if(inputOffset < inputLength && matchSet.Get(input[inputOffset]))
-                {
-                    if(Mode == ChompMode::Star)
-                        ++inputOffset;
-                    continue;
-                }
-                break;
-            }
 
             if(!noNeedToSave)
             {
@@ -4241,6 +4157,9 @@ namespace UnifiedRegex
         , literalNextSyncInputOffsets(nullptr)
         , recycler(scriptContext->GetRecycler())
         , previousQcTime(0)
+        , backtrackCount(0)
+        , backtrackLimit(UINT_MAX)
+        , dfaMatcher(nullptr)
 #if ENABLE_REGEX_CONFIG_OPTIONS
         , stats(0)
         , w(0)
@@ -4354,6 +4273,23 @@ namespace UnifiedRegex
         Output::Flush();
     }
 
+    void Matcher::ThrowBacktrackLimitExceeded()
+    {
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        if (stats != 0)
+        {
+            stats->numBacktracks += backtrackCount;
+            stats->numBacktrackLimitHits++;
+        }
+        this->stats = 0;
+        this->w = 0;
+#endif
+
+        // Don't leave a partial match behind for lastIndex and the RegExp constructor's $n properties
+        groupInfos[0].Reset();
+        Js::JavascriptError::ThrowRangeError(pattern->GetScriptContext(), JSERR_RegExpBacktrackLimit);
+    }
+
     bool Matcher::Fail(const Char* const input, CharCount &inputOffset, const uint8 *&instPointer, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks)
     {
         if (!contStack.IsEmpty())
@@ -4380,6 +4316,9 @@ namespace UnifiedRegex
             if (cont == 0)
                 break;
 
+            if (++backtrackCount > backtrackLimit)
+                ThrowBacktrackLimitExceeded();
+
             Assert(cont->tag >= minContTag && cont->tag <= maxContTag);
             // All these cases RESUME EXECUTION if backtracking finds a stop point
             const Cont::ContTag tag = cont->tag;
@@ -4409,42 +4348,114 @@ namespace UnifiedRegex
     const uint32 maxInstTag = instTags[(sizeof(instTags) / sizeof(uint32)) - 1];
 #endif
 
-    inline void Matcher::Run(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool firstIteration)
+    inline void Matcher::ResetForMatchHere(ContStack &contStack, AssertionStack &assertionStack)
+    {
+        // Reset the continuation and assertion stacks ready for fresh run
+        // NOTE: We used to do this after the Run, but it's safer to do it here in case unusual control flow exits
+        //       the matcher without executing the clears.
+        contStack.Clear();
+        // assertionStack may be non-empty since we can hard fail directly out of matcher without popping assertion
+        assertionStack.Clear();
+
+        Assert(contStack.IsEmpty());
+        Assert(assertionStack.IsEmpty());
+
+        ResetInnerGroups(0, program->numGroups - 1);
+#if DBG
+        ResetLoopInfos();
+#endif
+    }
+
+    inline bool Matcher::Run(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool loopMatchHere)
     {
-        CharCount inputOffset = matchStart;
-        const uint8 *instPointer = program->rep.insts.insts;
-        Assert(instPointer != 0);
+        CharCount inputOffset;
+        const uint8 *instPointer;
 
-        while (true)
-        {
-            Assert(inputOffset >= matchStart && inputOffset <= inputLength);
-            Assert(instPointer >= program->rep.insts.insts && instPointer < program->rep.insts.insts + program->rep.insts.instsLen);
-            Assert(((Inst*)instPointer)->tag >= minInstTag && ((Inst*)instPointer)->tag <= maxInstTag);
 #if ENABLE_REGEX_CONFIG_OPTIONS
-            if (w != 0)
-                Print(w, input, inputLength, inputOffset, instPointer, contStack, assertionStack);
-            InstStats();
+#define BEFORE_INST_STATS() \
+        if (w != 0) \
+            Print(w, input, inputLength, inputOffset, instPointer, contStack, assertionStack); \
+        InstStats();
+#else
+#define BEFORE_INST_STATS()
+#endif
+#define BEFORE_INST() \
+        Assert(inputOffset >= matchStart && inputOffset <= inputLength); \
+        Assert(instPointer >= program->rep.insts.insts && instPointer < program->rep.insts.insts + program->rep.insts.instsLen); \
+        Assert(((Inst*)instPointer)->tag >= minInstTag && ((Inst*)instPointer)->tag <= maxInstTag); \
+        BEFORE_INST_STATS()
+
+#ifdef INTERPRETER_THREADED_DISPATCH
+        // As in the byte code interpreter loop, each instruction ends by jumping straight to the handler of the next
+        // one, so that every handler has its own indirect jump instead of all of them sharing the switch's. Taking
+        // the handlers' addresses keeps GCC and Clang from inlining this function, which is why the retry from each
+        // start offset is in here too: a match costs one call, not one per start offset.
+        static void *const threadedDispatchTable[] =
+        {
+#define M(TagName) &&InstHandler_##TagName,
+#define MTemplate(TagName, ...) M(TagName)
+#include "RegexOpCodes.h"
+#undef M
+#undef MTemplate
+        };
+#define INST_CASE(TagName) case Inst::TagName: InstHandler_##TagName:
+#define INST_DONE() \
+        { \
+            BEFORE_INST() \
+            goto *threadedDispatchTable[((const Inst*)instPointer)->tag]; \
+        }
+#else
+#define INST_CASE(TagName) case Inst::TagName:
+#define INST_DONE() break
 #endif
-            const Inst *inst = (const Inst*)instPointer;
-            const Inst::InstTag tag = inst->tag;
-            switch (tag)
+
+        // Need to continue matching even if matchStart == inputLim since some patterns may match an empty string at the end
+        // of the input. For instance: /a*$/.exec("b")
+        bool firstIteration = true;
+        do
+        {
+            ResetForMatchHere(contStack, assertionStack);
+            inputOffset = matchStart;
+            instPointer = program->rep.insts.insts;
+            Assert(instPointer != 0);
+
+            while (true)
             {
+                BEFORE_INST()
+                const Inst::InstTag tag = ((const Inst*)instPointer)->tag;
+                switch (tag)
+                {
 #define MBase(TagName, ClassName) \
-                case Inst::TagName: \
-                    if (((const ClassName *)inst)->Exec(*this, input, inputLength, matchStart, inputOffset, nextSyncInputOffset, instPointer, contStack, assertionStack, qcTicks, firstIteration)) \
-                        return; \
-                    break;
+                    INST_CASE(TagName) \
+                        if (((const ClassName *)instPointer)->Exec(*this, input, inputLength, matchStart, inputOffset, nextSyncInputOffset, instPointer, contStack, assertionStack, qcTicks, firstIteration)) \
+                            goto StopExecution; \
+                        INST_DONE();
 #define M(TagName) MBase(TagName, TagName##Inst)
 #define MTemplate(TagName, TemplateDeclaration, GenericClassName, SpecializedClassName) MBase(TagName, SpecializedClassName)
 #include "RegexOpCodes.h"
 #undef MBase
 #undef M
 #undef MTemplate
-            default:
-                Assert(false);
-                __assume(false);
+                default:
+                    Assert(false);
+                    __assume(false);
+                }
             }
-        }
+
+        StopExecution:
+            // Leave the continuation and assertion stack memory in place so we don't have to alloc next time
+            if (WasLastMatchSuccessful())
+            {
+                return true;
+            }
+            firstIteration = false;
+        } while (loopMatchHere && ++matchStart <= inputLength);
+
+#undef INST_CASE
+#undef INST_DONE
+#undef BEFORE_INST
+#undef BEFORE_INST_STATS
+        return false;
     }
 
 #if DBG
@@ -4455,30 +4466,6 @@ namespace UnifiedRegex
     }
 #endif
 
-    inline bool Matcher::MatchHere(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool firstIteration)
-    {
-        // Reset the continuation and assertion stacks ready for fresh run
-        // NOTE: We used to do this after the Run, but it's safer to do it here in case unusual control flow exits
-        //       the matcher without executing the clears.
-        contStack.Clear();
-        // assertionStack may be non-empty since we can hard fail directly out of matcher without popping assertion
-        assertionStack.Clear();
-
-        Assert(contStack.IsEmpty());
-        Assert(assertionStack.IsEmpty());
-
-        ResetInnerGroups(0, program->numGroups - 1);
-#if DBG
-        ResetLoopInfos();
-#endif
-
-        Run(input, inputLength, matchStart, nextSyncInputOffset, contStack, assertionStack, qcTicks, firstIteration);
-
-        // Leave the continuation and assertion stack memory in place so we don't have to alloc next time
-
-        return WasLastMatchSuccessful();
-    }
-
     inline bool Matcher::MatchSingleCharCaseInsensitive(const Char* const input, const CharCount inputLength, CharCount offset, const Char c)
     {
         CaseInsensitive::MappingSource mappingSource = program->GetCaseMappingSource();
@@ -4774,6 +4761,7 @@ namespace UnifiedRegex
         Assert(offset <= inputLength);
         bool res;
         bool loopMatchHere = true;
+        backtrackCount = 0;
         Program const *prog = this->program;
         bool isStickyPresent = this->pattern->IsSticky();
         switch (prog->tag)
@@ -4800,6 +4788,20 @@ namespace UnifiedRegex
                 previousQcTime = 0;
                 uint qcTicks = 0;
 
+                // Patterns which can backtrack catastrophically don't stall the runtime past its limit
+                const uint limit = scriptContext->GetThreadContext()->GetRegexBacktrackLimit();
+                backtrackLimit = limit == 0 ? UINT_MAX : limit;
+
+                if (prog->nfa != nullptr)
+                {
+                    if (dfaMatcher == nullptr)
+                    {
+                        dfaMatcher = DfaMatcher::New(recycler, prog->nfa);
+                    }
+                    res = dfaMatcher->Match(*this, input, inputLength, offset, !loopMatchHere, groupInfos, qcTicks);
+                    break;
+                }
+
                 // This is the next offset in the input from where we will try to sync. For sync instructions that back up, this
                 // is used to avoid trying to sync when we have not yet reached the offset in the input we last synced to before
                 // backing up.
@@ -4807,16 +4809,9 @@ namespace UnifiedRegex
 
                 RegexStacks * regexStacks = scriptContext->RegexStacks();
 
-                // Need to continue matching even if matchStart == inputLim since some patterns may match an empty string at the end
-                // of the input. For instance: /a*$/.exec("b")
-                bool firstIteration = true;
-                do
-                {
-                    // Let there be only one call to MatchHere(), as that call expands the interpreter loop in-place. Having
-                    // multiple calls to MatchHere() would bloat the code.
-                    res = MatchHere(input, inputLength, offset, nextSyncInputOffset, regexStacks->contStack, regexStacks->assertionStack, qcTicks, firstIteration);
-                    firstIteration = false;
-                } while(!res && loopMatchHere && ++offset <= inputLength);
+                // Let there be only one call to Run(), as it holds the interpreter loop. Having multiple calls to Run() would
+                // bloat the code where it is inlined.
+                res = Run(input, inputLength, offset, nextSyncInputOffset, regexStacks->contStack, regexStacks->assertionStack, qcTicks, loopMatchHere);
 
                 break;
             }
@@ -4855,6 +4850,8 @@ namespace UnifiedRegex
         }
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
+        if (stats != 0)
+            stats->numBacktracks += backtrackCount;
         this->stats = 0;
         this->w = 0;
 #endif
@@ -4937,6 +4934,8 @@ namespace UnifiedRegex
         , flags(flags)
         , numGroups(0)
         , numLoops(0)
+        , nfa(nullptr)
+        , cacheEntry(nullptr)
     {
         tag = InstructionsTag;
         rep.insts.insts = 0;
@@ -4951,6 +4950,11 @@ namespace UnifiedRegex
         return RecyclerNew(recycler, Program, flags);
     }
 
+    ProgramAllocator Program::GetAllocator(Recycler *recycler) const
+    {
+        return IsShared() ? ProgramAllocator(cacheEntry->GetArena()) : ProgramAllocator(recycler);
+    }
+
     ScannerInfo **Program::CreateScannerArrayForSyncToLiterals(Recycler *const recycler)
     {
         Assert(tag == InstructionsTag);
@@ -4959,7 +4963,7 @@ namespace UnifiedRegex
 
         return
             rep.insts.scannersForSyncToLiterals =
-                RecyclerNewArrayZ(recycler, ScannerInfo *, ScannersMixin::MaxNumSyncLiterals);
+                GetAllocator(recycler).NewArrayZ<ScannerInfo *>(ScannersMixin::MaxNumSyncLiterals);
     }
 
     ScannerInfo *Program::AddScannerForSyncToLiterals(
@@ -4978,7 +4982,7 @@ namespace UnifiedRegex
 
         return
             rep.insts.scannersForSyncToLiterals[scannerIndex] =
-                RecyclerNewLeaf(recycler, ScannerInfo, offset, length, isEquivClass);
+                GetAllocator(recycler).NewLeaf<ScannerInfo>(offset, length, isEquivClass);
     }
 
     void Program::FreeBody(ArenaAllocator* rtAllocator)
@@ -17,6 +17,9 @@ namespace UnifiedRegex
     class ContStack;
     class AssertionStack;
     class OctoquadMatcher;
+    class Nfa;
+    class DfaMatcher;
+    class ProgramCacheEntry;
 
     enum class ChompMode : uint8
     {
@@ -28,13 +31,60 @@ namespace UnifiedRegex
     // Programs
     // ----------------------------------------------------------------------
 
+    // Allocator for a program and the parts of it which are not instruction bodies. A program compiled for one script
+    // context lives on its recycler. A program in the process-wide cache outlives any recycler, so it lives in the arena
+    // of its cache entry, as do its instruction bodies.
+    class ProgramAllocator
+    {
+    private:
+        Recycler* recycler;
+        ArenaAllocator* arena;
+
+    public:
+        explicit ProgramAllocator(Recycler* recycler) : recycler(recycler), arena(nullptr)
+        {
+            Assert(recycler);
+        }
+
+        explicit ProgramAllocator(ArenaAllocator* arena) : recycler(nullptr), arena(arena)
+        {
+            Assert(arena);
+        }
+
+        template <typename T, typename... TArgs>
+        T* New(TArgs... args) const
+        {
+            return arena ? Anew(arena, T, args...) : RecyclerNew(recycler, T, args...);
+        }
+
+        template <typename T, typename... TArgs>
+        T* NewLeaf(TArgs... args) const
+        {
+            return arena ? Anew(arena, T, args...) : RecyclerNewLeaf(recycler, T, args...);
+        }
+
+        template <typename T>
+        T* NewArrayZ(size_t count) const
+        {
+            return arena ? AnewArrayZ(arena, T, count) : RecyclerNewArrayZ(recycler, T, count);
+        }
+
+        template <typename T>
+        T* NewArrayLeaf(size_t count) const
+        {
+            return arena ? AnewArray(arena, T, count) : RecyclerNewArrayLeaf(recycler, T, count);
+        }
+    };
+
     struct Program : private Chars<char16>
     {
         friend class Compiler;
         friend struct MatchLiteralNode;
         friend struct AltNode;
         friend class Matcher;
+        friend class NfaBuilder;
         friend struct LoopInfo;
+        friend class ProgramCache;
 
         template <typename ScannerT>
         friend struct SyncToLiteralAndConsumeInstT;
@@ -134,10 +184,22 @@ namespace UnifiedRegex
             Other other;
         } rep;
 
+        // Automata for matching without backtracking, or null if the pattern needs backtracking (InstructionsTag only)
+        Nfa* nfa;
+
+        // Entry of the process-wide cache holding the program, or null if the program belongs to one script context
+        ProgramCacheEntry* cacheEntry;
+
     public:
         Program(RegexFlags flags);
         static Program *New(Recycler *recycler, RegexFlags flags);
 
+        // Shared programs are immutable and may be used by script contexts of several runtimes at once
+        inline bool IsShared() const { return cacheEntry != nullptr; }
+        // Allocator for the parts of the program which are not instruction bodies, given the recycler of the script
+        // context compiling it
+        ProgramAllocator GetAllocator(Recycler *recycler) const;
+
         static size_t GetOffsetOfTag() { return offsetof(Program, tag); }
         static size_t GetOffsetOfRep() { return offsetof(Program, rep); }
         static size_t GetOffsetOfBOILiteral2Literal() { return offsetof(BOILiteral2, literal); }
@@ -1690,6 +1752,7 @@ namespace UnifiedRegex
 
         friend GroupInfo;
         friend LoopInfo;
+        friend class DfaMatcher;
 
     public:
         static const uint TicksPerQc;
@@ -1722,6 +1785,13 @@ namespace UnifiedRegex
 
         uint previousQcTime;
 
+        // Backtracking steps taken by the current match, and how many it may take before it throws
+        uint backtrackCount;
+        uint backtrackLimit;
+
+        // Created on the first match of a program with an NFA
+        DfaMatcher* dfaMatcher;
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
         RegexStats* stats;
         DebugWriter* w;
@@ -1767,6 +1837,7 @@ namespace UnifiedRegex
         void PopStats(ContStack& contStack, const Char* const input) const;
         void UnPopStats(ContStack& contStack, const Char* const input) const;
         void CompStats() const;
+        void CompStats(const CharCount numCompares) const;
         void InstStats() const;
 #endif
 
@@ -1776,6 +1847,9 @@ namespace UnifiedRegex
     public:
         static void TraceQueryContinue(const uint now);
 
+    private:
+        void ThrowBacktrackLimitExceeded();
+
     private:
         // Try backtracking, or return true if should stop. There could be a match using a later starting point.
         bool Fail(const Char* const input, CharCount &inputOffset, const uint8 *&instPointer, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks);
@@ -1784,8 +1858,9 @@ namespace UnifiedRegex
         // As above, but control whether to try backtracking or later matches
         inline bool HardFail(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &inputOffset, const uint8 *&instPointer, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, HardFailMode mode);
 
-        inline void Run(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool firstIteration);
-        inline bool MatchHere(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool firstIteration);
+        inline void ResetForMatchHere(ContStack &contStack, AssertionStack &assertionStack);
+        // Run the program from matchStart, then from each later offset until it matches if loopMatchHere
+        inline bool Run(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool loopMatchHere);
 
         // Return true if assertion succeeded
         inline bool PopAssertion(CharCount &inputOffset, const uint8 *&instPointer, ContStack &contStack, AssertionStack &assertionStack, bool isFailed);
@@ -1858,6 +1933,21 @@ namespace UnifiedRegex
         void ResetLoopInfos();
 #endif
     };
+
+    inline void Matcher::QueryContinue(uint &qcTicks)
+    {
+        // See definition of TimePerQc for description of regex QC heuristics
+
+        Assert(!(TicksPerQc & TicksPerQc - 1)); // must be a power of 2
+        Assert(!(TicksPerQcTimeCheck & TicksPerQcTimeCheck - 1)); // must be a power of 2
+        Assert(TicksPerQcTimeCheck < TicksPerQc);
+
+        if(PHASE_OFF1(Js::RegexQcPhase))
+            return;
+        if(++qcTicks & TicksPerQcTimeCheck - 1)
+            return;
+        DoQueryContinue(qcTicks);
+    }
 }
 
 #undef INST_BODY_FREE
@@ -19,6 +19,8 @@ namespace UnifiedRegex
         , numPops(0)
         , stackHWM(0)
         , numInsts(0)
+        , numBacktracks(0)
+        , numBacktrackLimitHits(0)
     {
         for (int i = 0; i < NumPhases; i++)
             phaseTicks[i] = 0;
@@ -113,6 +115,17 @@ namespace UnifiedRegex
             w->PrintEOL(_u("numInsts    : %10I64u   (%10.4f%%)"), numInsts, pc);
         }
 
+        if (totals == 0 || totals->numBacktracks == 0)
+            w->PrintEOL(_u("numBacktracks: %9I64u"), numBacktracks);
+        else
+        {
+            double pc = (double)numBacktracks * 100.0 / (double)totals->numBacktracks;
+            w->PrintEOL(_u("numBacktracks: %9I64u   (%10.4f%%)"), numBacktracks, pc);
+        }
+
+        if (numBacktrackLimitHits > 0)
+            w->PrintEOL(_u("#limitHits  : %10I64u"), numBacktrackLimitHits);
+
         w->Unindent();
     }
 
@@ -129,6 +142,8 @@ namespace UnifiedRegex
         if (other->stackHWM > stackHWM)
             stackHWM = other->stackHWM;
         numInsts += other->numInsts;
+        numBacktracks += other->numBacktracks;
+        numBacktrackLimitHits += other->numBacktrackLimitHits;
     }
 
     RegexStats::Ticks RegexStatsDatabase::Now()
@@ -201,8 +216,50 @@ namespace UnifiedRegex
 
         totals.Print(w, 0, ticksPerMillisecond);
 
+        // The patterns most likely to stall the runtime
+        PrintTop(w, _u("backtracking steps"), [](RegexStats* stats) { return stats->numBacktracks; }, totals.numBacktracks, false);
+        PrintTop(w, _u("execute time"), [](RegexStats* stats) { return (uint64)stats->phaseTicks[RegexStats::Execute]; }, (uint64)totals.phaseTicks[RegexStats::Execute], true);
+
         allocator->Free(w, sizeof(DebugWriter));
     }
+
+    void RegexStatsDatabase::PrintTop(DebugWriter* w, const char16* title, uint64 (*rank)(RegexStats* stats), uint64 total, bool isTicks)
+    {
+        w->EOL();
+        w->PrintEOL(_u("Top %d by %s"), TopCount, title);
+        const int count = map->Count();
+        if (count == 0)
+            return;
+        w->Indent();
+
+        // Pick the largest remaining one each time; there are only a few to pick
+        bool* const picked = AnewArrayZ(allocator, bool, count);
+        for (int n = 0; n < TopCount; n++)
+        {
+            int top = -1;
+            for (int i = 0; i < count; i++)
+            {
+                if (!picked[i] && rank(map->GetValueAt(i)) > 0 && (top < 0 || rank(map->GetValueAt(i)) > rank(map->GetValueAt(top))))
+                    top = i;
+            }
+            if (top < 0)
+                break;
+            picked[top] = true;
+
+            RegexStats* const stats = map->GetValueAt(top);
+            const uint64 value = rank(stats);
+            const double pc = (double)value * 100.0 / (double)total;
+            if (isTicks)
+                w->Print(_u("%2d: %10.4fms (%8.4f%%) "), n + 1, (double)value / (double)ticksPerMillisecond, pc);
+            else
+                w->Print(_u("%2d: %10I64u   (%8.4f%%) "), n + 1, value, pc);
+            stats->pattern->Print(w);
+            w->EOL();
+        }
+        AdeleteArray(allocator, count, picked);
+
+        w->Unindent();
+    }
 }
 
 #endif
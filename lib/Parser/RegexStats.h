@@ -52,6 +52,10 @@ namespace UnifiedRegex
         uint64 stackHWM;
         // Number of instructions executed
         uint64 numInsts;
+        // Number of backtracking steps, as limited by the runtime's regex backtrack limit
+        uint64 numBacktracks;
+        // Number of matches which exceeded the backtrack limit
+        uint64 numBacktrackLimitHits;
 
         RegexStats(RegexPattern* pattern);
 
@@ -69,9 +73,14 @@ namespace UnifiedRegex
         ArenaAllocator* allocator;
         RegexStatsMap* map;
 
+        // Number of patterns listed in each of the rankings after the full statistics
+        static const int TopCount = 10;
+
         static RegexStats::Ticks Now();
         static RegexStats::Ticks Freq();
 
+        void PrintTop(DebugWriter* w, const char16* title, uint64 (*rank)(RegexStats* stats), uint64 total, bool isTicks);
+
     public:
         RegexStatsDatabase(ArenaAllocator* allocator);
 
@@ -89,6 +89,215 @@ struct AorW< OLECHAR >
     }
 };
 
+#if defined(_M_IX86) || defined(_M_X64)
+#define SCANNER_SSE2
+#endif
+
+/*****************************************************************************
+*
+*  Bulk skipping of ASCII runs.
+*
+*  Whitespace between tokens, comment bodies, the plain part of string
+*  literals and identifier tails are almost always ASCII and need no
+*  per-character attention. These helpers skip such a run, 16 code units at
+*  a time when SSE2 is available, and return the first unit that does need
+*  attention (or last). Non-ASCII units always end a run, so multi-unit
+*  characters, LS/PS and the multi-unit count stay on the per-character paths.
+*/
+#ifdef SCANNER_SSE2
+static inline bool CanUseSSE2()
+{
+#if defined(_M_IX86)
+    return AutoSystemInfo::Data.SSE2Available() != FALSE;
+#else
+    return true;
+#endif
+}
+
+static inline uint FirstSetBit(uint mask)
+{
+    Assert(mask != 0);
+    DWORD index;
+    _BitScanForward(&index, mask);
+    return index;
+}
+
+// The 16 code units at p, one byte each. char16 units from 0x80 narrow to 0xFF, and from 0x8000 to 0,
+// so they still hit the non-ASCII or NUL test that every stop set below includes.
+template <typename CharType>
+static inline __m128i LoadUnits(const CharType* p)
+{
+    if (sizeof(CharType) == sizeof(utf8char_t))
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    return _mm_packus_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8)));
+}
+
+static inline __m128i BlankBytes(__m128i bytes)
+{
+    return _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')));
+}
+
+// 0xFF where the byte is NUL, CR, LF or not ASCII
+static inline __m128i LineEndBytes(__m128i bytes)
+{
+    __m128i lineEnd = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')));
+    __m128i nul = _mm_cmpeq_epi8(bytes, _mm_setzero_si128());
+    return _mm_or_si128(_mm_or_si128(lineEnd, nul), _mm_cmplt_epi8(bytes, _mm_setzero_si128()));
+}
+
+static inline __m128i BlockCommentSpecialBytes(__m128i bytes)
+{
+    return _mm_or_si128(LineEndBytes(bytes), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('*')));
+}
+
+// 0xFF where the byte is one of [A-Za-z0-9_$]; non-ASCII bytes compare as negative and never match
+static inline __m128i IdentifierBytes(__m128i bytes)
+{
+    __m128i lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+    __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+    __m128i other = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('_')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('$')));
+    return _mm_or_si128(_mm_or_si128(letter, digit), other);
+}
+
+// Bit i set for each of the 16 code units at p matched by classify
+template <__m128i (*classify)(__m128i), typename CharType>
+static inline uint ClassifyUnits(const CharType* p)
+{
+    return (uint)_mm_movemask_epi8(classify(LoadUnits(p)));
+}
+#endif
+
+// Skips spaces and tabs
+template <typename CharType>
+static const CharType* SkipBlanks(const CharType* current, const CharType* last)
+{
+#ifdef SCANNER_SSE2
+    if (CanUseSSE2())
+    {
+        while (last - current >= 16)
+        {
+            uint nonBlank = ~ClassifyUnits<BlankBytes>(current) & 0xFFFF;
+            if (nonBlank != 0)
+            {
+                return current + FirstSetBit(nonBlank);
+            }
+            current += 16;
+        }
+    }
+#endif
+    while (current < last && (*current == ' ' || *current == '\t'))
+    {
+        current++;
+    }
+    return current;
+}
+
+// Skips the body of a line comment up to a line break, NUL or non-ASCII unit
+template <typename CharType>
+static const CharType* SkipLineCommentChars(const CharType* current, const CharType* last)
+{
+#ifdef SCANNER_SSE2
+    if (CanUseSSE2())
+    {
+        while (last - current >= 16)
+        {
+            uint special = ClassifyUnits<LineEndBytes>(current);
+            if (special != 0)
+            {
+                return current + FirstSetBit(special);
+            }
+            current += 16;
+        }
+    }
+#endif
+    while (current < last && *current != '\n' && *current != '\r' && *current != 0 && *current < 0x80)
+    {
+        current++;
+    }
+    return current;
+}
+
+// Same as above, also stopping at '*'
+template <typename CharType>
+static const CharType* SkipBlockCommentChars(const CharType* current, const CharType* last)
+{
+#ifdef SCANNER_SSE2
+    if (CanUseSSE2())
+    {
+        while (last - current >= 16)
+        {
+            uint special = ClassifyUnits<BlockCommentSpecialBytes>(current);
+            if (special != 0)
+            {
+                return current + FirstSetBit(special);
+            }
+            current += 16;
+        }
+    }
+#endif
+    while (current < last && *current != '*' && *current != '\n' && *current != '\r' && *current != 0 && *current < 0x80)
+    {
+        current++;
+    }
+    return current;
+}
+
+// Skips the characters a string literal or template takes as is, stopping at the delimiter, '\\', '$',
+// a line break, NUL or a non-ASCII unit
+template <typename CharType>
+static const CharType* SkipPlainStringChars(const CharType* current, const CharType* last, OLECHAR delim)
+{
+    Assert(delim < 0x80);
+#ifdef SCANNER_SSE2
+    if (CanUseSSE2())
+    {
+        __m128i delimBytes = _mm_set1_epi8((char)delim);
+        while (last - current >= 16)
+        {
+            __m128i bytes = LoadUnits(current);
+            __m128i quoteOrEscape = _mm_or_si128(_mm_cmpeq_epi8(bytes, delimBytes), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')));
+            __m128i special = _mm_or_si128(_mm_or_si128(quoteOrEscape, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('$'))), LineEndBytes(bytes));
+            uint mask = (uint)_mm_movemask_epi8(special);
+            if (mask != 0)
+            {
+                return current + FirstSetBit(mask);
+            }
+            current += 16;
+        }
+    }
+#endif
+    while (current < last && *current != delim && *current != '\\' && *current != '$' &&
+        *current != '\n' && *current != '\r' && *current != 0 && *current < 0x80)
+    {
+        current++;
+    }
+    return current;
+}
+
+// Skips whole blocks of ASCII identifier characters; the caller classifies whatever is left one unit at a time
+template <typename CharType>
+static const CharType* SkipIdentifierBlocks(const CharType* current, const CharType* last)
+{
+#ifdef SCANNER_SSE2
+    if (CanUseSSE2())
+    {
+        while (last - current >= 16)
+        {
+            uint nonIdentifier = ~ClassifyUnits<IdentifierBytes>(current) & 0xFFFF;
+            if (nonIdentifier != 0)
+            {
+                return current + FirstSetBit(nonIdentifier);
+            }
+            current += 16;
+        }
+    }
+#endif
+    return current;
+}
+
 BOOL Token::IsKeyword() const
 {
     // keywords (but not future reserved words)
@@ -454,6 +663,7 @@ BOOL Scanner<EncodingPolicy>::FastIdentifierContinue(EncodedCharPtr&p, EncodedCh
 {
     if (EncodingPolicy::MultiUnitEncoding)
     {
+        p = SkipIdentifierBlocks(p, last);
         while (p < last)
         {
             EncodedChar currentChar = *p;
@@ -1173,6 +1383,15 @@ tokens Scanner<EncodingPolicy>::ScanStringConstant(OLECHAR delim, EncodedCharPtr
 
     for (;;)
     {
+        // Plain ASCII runs are taken as is, so copy them to the buffers in one go
+        EncodedCharPtr pchPlain = SkipPlainStringChars(p, last, delim);
+        if (pchPlain != p)
+        {
+            m_tempChBuf.AppendChars(p, pchPlain);
+            m_tempChBufSecondary.template AppendChars<createRawString>(p, pchPlain);
+            p = pchPlain;
+        }
+
         switch ((rawch = ch = this->ReadFirst(p, last)))
         {
         case kchRET:
@@ -1601,6 +1820,7 @@ tokens Scanner<EncodingPolicy>::SkipComment(EncodedCharPtr *pp, /* out */ bool*
 
     for (;;)
     {
+        p = SkipBlockCommentChars(p, last);
         switch((ch = this->ReadFirst(p, last)))
         {
         case '*':
@@ -1886,6 +2106,7 @@ LEof:
         case 0x000C:
         case 0x0020:
             Assert(chType == _C_WSP);
+            p = SkipBlanks(p, last);
             continue;
 
         case '.':
@@ -2157,6 +2378,7 @@ LSkipLineComment:
                 pchT = NULL;
                 for (;;)
                 {
+                    p = SkipLineCommentChars(p, last);
                     switch ((ch = this->ReadFirst(p, last)))
                     {
                     case kchLS:         // 0x2028, classifies as new line
@@ -624,6 +624,35 @@ public:
             }
         }
 
+        template<typename CharType> void AppendChars(const CharType *pchMin, const CharType *pchLim)
+        {
+            return AppendChars<true>(pchMin, pchLim);
+        }
+
+        // Appends a run of single-unit characters, widening each unit to OLECHAR
+        template<bool performAppend, typename CharType> void AppendChars(const CharType *pchMin, const CharType *pchLim)
+        {
+            if (performAppend)
+            {
+                Assert(pchMin <= pchLim);
+                uint32 cch = (uint32)(pchLim - pchMin);
+                while (m_cchMax - m_ichCur < cch)
+                {
+                    Grow();
+                }
+
+                Assert(m_ichCur + cch <= m_cchMax);
+                __analysis_assume(m_ichCur + cch <= m_cchMax);
+
+                OLECHAR *pchDest = m_prgch + m_ichCur;
+                for (uint32 ich = 0; ich < cch; ich++)
+                {
+                    pchDest[ich] = static_cast<OLECHAR>(pchMin[ich]);
+                }
+                m_ichCur += cch;
+            }
+        }
+
         void Grow()
         {
             Assert(m_pscanner != nullptr);
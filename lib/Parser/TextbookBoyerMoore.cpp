@@ -168,6 +168,51 @@ namespace UnifiedRegex
         return inputChar == pat[index * 4];
     }
 
+    // Patterns up to this long are found by scanning for their first and last characters, which looks at a block of
+    // input at a time and so beats skipping by the last occurrence of a character in such a short pattern
+    static const CharCount MaxPairScanPatLen = 16;
+
+    static bool MatchByFirstAndLastChar
+        ( const char16 *const input
+        , const CharCount inputLength
+        , CharCount& inputOffset
+        , const char16* pat
+        , const CharCount patLen
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        , RegexStats* stats
+#endif
+        )
+    {
+        Assert(patLen > 0 && patLen <= inputLength);
+
+        const CharCount lastPatCharIndex = patLen - 1;
+        const CharCount endOffset = inputLength - lastPatCharIndex;
+        const CharCount numInnerChars = patLen > 2 ? patLen - 2 : 0;
+
+        CharCount offset = inputOffset;
+        while (true)
+        {
+            const CharCount candidateOffset = CharScan::FindCharPair(input, offset, endOffset, pat[0], pat[lastPatCharIndex], lastPatCharIndex);
+            if (candidateOffset >= endOffset)
+            {
+                return false;
+            }
+
+            // Match the rest of the pattern
+            const CharCount mismatchIndex = CharScan::FindMismatch(input + candidateOffset + 1, pat + 1, numInnerChars);
+#if ENABLE_REGEX_CONFIG_OPTIONS
+            if (stats != 0)
+                stats->numCompares += mismatchIndex < numInnerChars ? mismatchIndex + 1 : numInnerChars;
+#endif
+            if (mismatchIndex == numInnerChars)
+            {
+                inputOffset = candidateOffset;
+                return true;
+            }
+            offset = candidateOffset + 1;
+        }
+    }
+
     template <typename C>
     template <uint equivClassSize, uint lastPatCharEquivClass>
     bool TextbookBoyerMoore<C>::Match
@@ -188,6 +233,20 @@ namespace UnifiedRegex
         if (inputLength < patLen)
             return false;
 
+        if (equivClassSize == 1 && patLen <= MaxPairScanPatLen && CharScan::IsVectorized())
+        {
+            return MatchByFirstAndLastChar
+                ( input
+                , inputLength
+                , inputOffset
+                , pat
+                , patLen
+#if ENABLE_REGEX_CONFIG_OPTIONS
+                , stats
+#endif
+                );
+        }
+
         CharCount offset = inputOffset;
 
         const CharCount endOffset = inputLength - (patLen - 1);
@@ -313,6 +372,20 @@ namespace UnifiedRegex
         if (inputLength < patLen)
             return false;
 
+        if (equivClassSize == 1 && patLen <= MaxPairScanPatLen && CharScan::IsVectorized())
+        {
+            return MatchByFirstAndLastChar
+                ( input
+                , inputLength
+                , inputOffset
+                , pat
+                , patLen
+#if ENABLE_REGEX_CONFIG_OPTIONS
+                , stats
+#endif
+                );
+        }
+
         const int32* const localGoodSuffix = goodSuffix;
         const LastOccMap* const localLastOccurrence = &lastOccurrence;
 
@@ -538,6 +538,9 @@ namespace Js
         , regAllocLoadCount(0)
         , regAllocStoreCount(0)
         , callCountStats(0)
+#endif
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+        , interpreterOpcodeProfileEntry(nullptr)
 #endif
     {
         SetCountField(CounterFields::ConstantCount, 1);
@@ -2574,7 +2577,7 @@ namespace Js
             bool doSlowLookup = !canAllocateLineCache;
             if (canAllocateLineCache)
             {
-                HRESULT hr = this->GetUtf8SourceInfo()->EnsureLineOffsetCacheNoThrow();
+                HRESULT hr = this->GetUtf8SourceInfo()->EnsureLineOffsetCacheNoThrow(startCharOfStatement);
                 if (FAILED(hr))
                 {
                     if (hr != E_OUTOFMEMORY)
@@ -1896,6 +1896,10 @@ namespace Js
         NoWriteBarrierField<uint> regAllocLoadCount;
         NoWriteBarrierField<uint> callCountStats;
 #endif
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+        // Owned by the thread's InterpreterOpcodeProfile; created the first time this function is interpreted while profiling
+        NoWriteBarrierField<InterpreterOpcodeProfileEntry *> interpreterOpcodeProfileEntry;
+#endif
 
         // >>>>>>WARNING! WARNING!<<<<<<<<<<
         //
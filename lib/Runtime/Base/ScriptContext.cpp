@@ -78,6 +78,7 @@ namespace Js
         raiseMessageToDebuggerFunctionType(nullptr),
         transitionToDebugModeIfFirstSourceFn(nullptr),
         sourceSize(0),
+        idleParseQueueHead(0),
         deferredBody(false),
         isScriptContextActuallyClosed(false),
         isFinalized(false),
@@ -371,6 +372,11 @@ namespace Js
         {
             this->calleeUtf8SourceInfoList.Unroot(this->GetRecycler());
         }
+
+        if (this->idleParseQueue)
+        {
+            this->idleParseQueue.Unroot(this->GetRecycler());
+        }
     }
 
     ScriptContext::~ScriptContext()
@@ -1024,6 +1030,126 @@ namespace Js
         return CONFIG_FLAG(DeferTopLevelTillFirstCall) && !AutoSystemInfo::Data.IsLowMemoryProcess();
     }
 
+    void ScriptContext::AddIdleParseCandidates(ParseableFunctionInfo *functionInfo)
+    {
+        if (CONFIG_FLAG(IdleParseBudget) == 0 || this->IsClosed() || functionInfo->GetUtf8SourceInfo()->GetIsLibraryCode())
+        {
+            return;
+        }
+
+        Recycler *recycler = this->GetRecycler();
+        if (!this->idleParseQueue)
+        {
+            this->idleParseQueue.Root(RecyclerNew(recycler, IdleParseQueue, recycler), recycler);
+        }
+
+        // Functions nested in ones that were compiled along with this one are queued too, so the queue ends up in
+        // source order. The queue only holds weak references: a function that gets collected is simply skipped.
+        functionInfo->ForEachNestedFunc([&](FunctionProxy *proxy, uint32) -> bool
+        {
+            if (proxy != nullptr && !proxy->IsDeferredDeserializeFunction())
+            {
+                ParseableFunctionInfo *nestedInfo = proxy->GetParseableFunctionInfo();
+                if (nestedInfo->IsFunctionParsed())
+                {
+                    this->AddIdleParseCandidates(nestedInfo);
+                }
+                else
+                {
+                    this->idleParseQueue->Add(recycler->CreateWeakReferenceHandle<ParseableFunctionInfo>(nestedInfo));
+                }
+            }
+            return true;
+        });
+    }
+
+    void ScriptContext::ParseDeferredFunctionsOnIdle(uint budget)
+    {
+        if (this->IsClosed() || !this->idleParseQueue || AutoSystemInfo::Data.IsLowMemoryProcess())
+        {
+            return;
+        }
+
+        const DWORD start = GetTickCount();
+        IdleParseQueue *queue = this->idleParseQueue;
+
+        // Each call picks up where the previous one stopped, so an idle tick costs only the functions it parses. Parsing
+        // a function queues its own deferred nested functions behind everything that was already waiting.
+        while (this->idleParseQueueHead < queue->Count())
+        {
+            if (GetTickCount() - start >= budget)
+            {
+                PHASE_PRINT_TESTTRACE1(Js::IdleParsePhase, _u("IdleParse: budget spent with functions left in the queue\n"));
+                break;
+            }
+
+            // The head moves past a function only once it is done with. A function that runs out of memory or stack
+            // stays at the head, to be tried again on a later idle tick.
+            ParseableFunctionInfo *functionInfo = queue->Item(this->idleParseQueueHead)->Get();
+            if (functionInfo == nullptr || functionInfo->IsFunctionParsed())
+            {
+                // Collected, or parsed by its first call already
+                this->idleParseQueueHead++;
+                continue;
+            }
+
+            JavascriptExceptionObject *exceptionObject = nullptr;
+            try
+            {
+                functionInfo->Parse();
+            }
+            catch (OutOfMemoryException)
+            {
+                break;
+            }
+            catch (StackOverflowException)
+            {
+                break;
+            }
+            catch (JavascriptExceptionObject *caughtException)
+            {
+                exceptionObject = caughtException;
+            }
+
+            if (exceptionObject != nullptr)
+            {
+                // Like UndeferGlobalFunctions, give up quietly on OOM/SOE. Any other error is left for the function's
+                // first call to report; skip the function and go on with the rest of the queue.
+                if (exceptionObject == this->threadContext->GetPendingOOMErrorObject() ||
+                    exceptionObject == this->threadContext->GetPendingSOErrorObject())
+                {
+                    break;
+                }
+                PHASE_PRINT_VERBOSE_TESTTRACE1(Js::IdleParsePhase, _u("IdleParse: skipped %s\n"), functionInfo->GetDisplayName());
+                this->idleParseQueueHead++;
+                continue;
+            }
+
+            PHASE_PRINT_VERBOSE_TESTTRACE1(Js::IdleParsePhase, _u("IdleParse: parsed %s\n"), functionInfo->GetDisplayName());
+            this->idleParseQueueHead++;
+        }
+
+        // Drop the entries already handled once they make up half of the queue, so that compacting stays linear overall
+        if (this->idleParseQueueHead == queue->Count())
+        {
+            queue->Clear();
+            this->idleParseQueueHead = 0;
+        }
+        else if (this->idleParseQueueHead >= 64 && this->idleParseQueueHead >= queue->Count() / 2)
+        {
+            int remaining = queue->Count() - this->idleParseQueueHead;
+            for (int i = 0; i < remaining; i++)
+            {
+                queue->Item(i, queue->Item(this->idleParseQueueHead + i));
+            }
+            while (queue->Count() > remaining)
+            {
+                queue->RemoveAtEnd();
+            }
+            this->idleParseQueueHead = 0;
+        }
+    }
+
     RegexPatternMruMap* ScriptContext::GetDynamicRegexMap() const
     {
         Assert(!isScriptContextActuallyClosed);
@@ -1136,7 +1262,7 @@ namespace Js
 #endif
 
 #if ENABLE_BACKGROUND_PARSING
-        if (PHASE_ON1(Js::ParallelParsePhase))
+        if (PHASE_ON1(Js::ParallelParsePhase) || CONFIG_FLAG(ParallelParseThreshold) != 0)
         {
             this->backgroundParser = BackgroundParser::New(this);
         }
@@ -4603,6 +4729,7 @@ void ScriptContext::RegisterPrototypeChainEnsuredToHaveOnlyWritableDataPropertie
         dest.hash = TAGHASH((hash_t)dest.str);
     }
 
+
     void ScriptContext::PrintStats()
     {
 #if ENABLE_PROFILE_INFO
@@ -430,6 +430,11 @@ namespace Js
 
         bool DoUndeferGlobalFunctions() const;
 
+        // Queues the still-deferred functions nested in a newly generated function for ParseDeferredFunctionsOnIdle.
+        void AddIdleParseCandidates(ParseableFunctionInfo *functionInfo);
+        // Parses queued deferred functions ahead of their first call, for up to budget milliseconds. Must be called in script.
+        void ParseDeferredFunctionsOnIdle(uint budget);
+
         bool IsUndeclBlockVar(Var var) const { return this->javascriptLibrary->IsUndeclBlockVar(var); }
 
         void TrackPid(const PropertyRecord* propertyRecord);
@@ -818,6 +823,11 @@ private:
         typedef JsUtil::List<RecyclerWeakReference<Utf8SourceInfo>*, Recycler, false, Js::FreeListedRemovePolicy> SourceList;
         RecyclerRootPtr<SourceList> sourceList;
 
+        // Deferred functions waiting to be parsed by ParseDeferredFunctionsOnIdle, oldest first, from idleParseQueueHead on
+        typedef JsUtil::List<RecyclerWeakReference<ParseableFunctionInfo>*, Recycler> IdleParseQueue;
+        RecyclerRootPtr<IdleParseQueue> idleParseQueue;
+        int idleParseQueueHead;
+
 #ifdef ENABLE_SCRIPT_PROFILING
         IActiveScriptProfilerHeapEnum* heapEnum;
 
@@ -0,0 +1,558 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeBasePch.h"
+
+namespace Js
+{
+    // -------- Chunk compression (LZ4 block format) ------------//
+    namespace
+    {
+        const uint MinMatch = 4;
+        const uint LastLiterals = 5;    // the last 5 bytes of a block are always literals
+        const uint MatchFindLimit = 12; // and no match starts in the last 12
+        const uint MaxOffset = 0xFFFF;
+        const uint HashBits = 12;
+
+        inline uint32 Read32(const byte * p)
+        {
+            uint32 value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline uint Hash(uint32 sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HashBits);
+        }
+
+        inline byte * WriteLength(byte * out, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                *out++ = 255;
+            }
+            *out++ = (byte)length;
+            return out;
+        }
+
+        inline byte * WriteLiterals(byte * out, byte * token, const byte * literals, size_t length)
+        {
+            *token = (byte)((length >= 15 ? 15 : length) << 4);
+            if (length >= 15)
+            {
+                out = WriteLength(out, length - 15);
+            }
+            memcpy(out, literals, length);
+            return out + length;
+        }
+
+        // Returns the compressed size, or 0 if it doesn't fit in dstCapacity
+        size_t CompressBlock(const byte * src, size_t srcLength, byte * dst, size_t dstCapacity)
+        {
+            const byte * const end = src + srcLength;
+            const byte * anchor = src;
+            byte * out = dst;
+            byte * const outEnd = dst + dstCapacity;
+
+            if (srcLength >= MatchFindLimit)
+            {
+                uint32 table[1 << HashBits] = { 0 };
+                const byte * const matchLimit = end - LastLiterals;
+                const byte * const findLimit = end - MatchFindLimit;
+
+                for (const byte * p = src + 1; p <= findLimit;)
+                {
+                    uint32 sequence = Read32(p);
+                    uint hash = Hash(sequence);
+                    const byte * candidate = src + table[hash];
+                    table[hash] = (uint32)(p - src);
+
+                    if (candidate >= p || (size_t)(p - candidate) > MaxOffset || Read32(candidate) != sequence)
+                    {
+                        p++;
+                        continue;
+                    }
+
+                    while (p > anchor && candidate > src && p[-1] == candidate[-1])
+                    {
+                        p--;
+                        candidate--;
+                    }
+
+                    const byte * matchEnd = p + MinMatch;
+                    for (const byte * c = candidate + MinMatch; matchEnd < matchLimit && *matchEnd == *c; c++)
+                    {
+                        matchEnd++;
+                    }
+
+                    size_t literalLength = p - anchor;
+                    size_t matchLength = matchEnd - p - MinMatch;
+                    if ((size_t)(outEnd - out) < 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1)
+                    {
+                        return 0;
+                    }
+
+                    byte * token = out++;
+                    out = WriteLiterals(out, token, anchor, literalLength);
+
+                    size_t offset = p - candidate;
+                    *out++ = (byte)offset;
+                    *out++ = (byte)(offset >> 8);
+
+                    *token |= (byte)(matchLength >= 15 ? 15 : matchLength);
+                    if (matchLength >= 15)
+                    {
+                        out = WriteLength(out, matchLength - 15);
+                    }
+
+                    p = matchEnd;
+                    anchor = p;
+                }
+            }
+
+            size_t literalLength = end - anchor;
+            if ((size_t)(outEnd - out) < 1 + literalLength / 255 + 1 + literalLength)
+            {
+                return 0;
+            }
+            byte * token = out++;
+            out = WriteLiterals(out, token, anchor, literalLength);
+            return out - dst;
+        }
+
+        inline bool ReadLength(const byte *& in, const byte * inEnd, size_t * length)
+        {
+            byte b;
+            do
+            {
+                if (in >= inEnd)
+                {
+                    return false;
+                }
+                b = *in++;
+                *length += b;
+            } while (b == 255);
+            return true;
+        }
+
+        // Fails on anything that would read or write out of bounds, or that doesn't fill dst exactly
+        bool DecompressBlock(const byte * src, size_t srcLength, byte * dst, size_t dstLength)
+        {
+            const byte * in = src;
+            const byte * const inEnd = src + srcLength;
+            byte * out = dst;
+            byte * const outEnd = dst + dstLength;
+
+            for (;;)
+            {
+                if (in >= inEnd)
+                {
+                    return false;
+                }
+                uint token = *in++;
+
+                size_t literalLength = token >> 4;
+                if (literalLength == 15 && !ReadLength(in, inEnd, &literalLength))
+                {
+                    return false;
+                }
+                if ((size_t)(inEnd - in) < literalLength || (size_t)(outEnd - out) < literalLength)
+                {
+                    return false;
+                }
+                memcpy(out, in, literalLength);
+                in += literalLength;
+                out += literalLength;
+
+                if (in == inEnd)
+                {
+                    return out == outEnd;
+                }
+
+                if (inEnd - in < 2)
+                {
+                    return false;
+                }
+                size_t offset = in[0] | (in[1] << 8);
+                in += 2;
+                if (offset == 0 || offset > (size_t)(out - dst))
+                {
+                    return false;
+                }
+
+                size_t matchLength = token & 15;
+                if (matchLength == 15 && !ReadLength(in, inEnd, &matchLength))
+                {
+                    return false;
+                }
+                matchLength += MinMatch;
+                if ((size_t)(outEnd - out) < matchLength)
+                {
+                    return false;
+                }
+
+                const byte * match = out - offset;
+                if (offset >= matchLength)
+                {
+                    memcpy(out, match, matchLength);
+                }
+                else
+                {
+                    // Overlapping copy repeats the last offset bytes
+                    for (size_t i = 0; i < matchLength; i++)
+                    {
+                        out[i] = match[i];
+                    }
+                }
+                out += matchLength;
+            }
+        }
+    }
+
+    // -------- SharedSource ------------//
+    SharedSource::SharedSource(int hashCode, size_t byteLength) :
+        hashCode(hashCode),
+        byteLength(byteLength),
+        refCount(1),
+        source(nullptr),
+        compressedData(nullptr),
+        compressedLength(0),
+        chunkEnds(nullptr),
+        chunkCount(0),
+        expansion(nullptr),
+        expansionRefCount(0),
+        next(nullptr)
+    {
+    }
+
+    SharedSource::~SharedSource()
+    {
+        Assert(this->refCount == 0);
+        Assert(this->expansionRefCount == 0);
+
+        if (this->source != nullptr)
+        {
+            HeapDeleteArray(this->byteLength + 1, this->source);
+        }
+        if (this->compressedData != nullptr)
+        {
+            HeapDeleteArray(this->compressedLength, this->compressedData);
+            HeapDeleteArray(this->chunkCount, this->chunkEnds);
+        }
+        Assert(this->expansion == nullptr);
+    }
+
+    size_t SharedSource::GetChunkByteLength(uint chunk) const
+    {
+        Assert(chunk < this->chunkCount);
+        return chunk + 1 < this->chunkCount ? ChunkSize : this->byteLength - (size_t)chunk * ChunkSize;
+    }
+
+    bool SharedSource::Compress(LPCUTF8 source)
+    {
+        Assert(this->compressedData == nullptr);
+
+        uint chunkCount = (uint)((this->byteLength + ChunkSize - 1) / ChunkSize);
+        uint32 * chunkEnds = HeapNewNoThrowArray(uint32, chunkCount);
+        byte * buffer = HeapNewNoThrowArray(byte, this->byteLength);
+        if (chunkEnds == nullptr || buffer == nullptr)
+        {
+            if (chunkEnds != nullptr)
+            {
+                HeapDeleteArray(chunkCount, chunkEnds);
+            }
+            if (buffer != nullptr)
+            {
+                HeapDeleteArray(this->byteLength, buffer);
+            }
+            return false;
+        }
+
+        // Chunk offsets are 32 bit; the store only takes sources well below that (see Acquire)
+        size_t length = 0;
+        this->chunkCount = chunkCount;
+        for (uint chunk = 0; chunk < chunkCount; chunk++)
+        {
+            const byte * raw = source + (size_t)chunk * ChunkSize;
+            size_t rawLength = GetChunkByteLength(chunk);
+
+            // A chunk is only kept compressed if that makes it strictly smaller, so its size says which it is
+            size_t chunkLength = CompressBlock(raw, rawLength, buffer + length, rawLength - 1);
+            if (chunkLength == 0)
+            {
+                memcpy(buffer + length, raw, rawLength);
+                chunkLength = rawLength;
+            }
+            length += chunkLength;
+            chunkEnds[chunk] = (uint32)length;
+        }
+
+        // Not worth a decompression on every use unless it saves at least an eighth
+        byte * compressedData = nullptr;
+        if (length <= this->byteLength - this->byteLength / 8)
+        {
+            compressedData = HeapNewNoThrowArray(byte, length);
+            if (compressedData != nullptr)
+            {
+                js_memcpy_s(compressedData, length, buffer, length);
+            }
+        }
+        HeapDeleteArray(this->byteLength, buffer);
+
+        if (compressedData == nullptr)
+        {
+            HeapDeleteArray(chunkCount, chunkEnds);
+            this->chunkCount = 0;
+            return false;
+        }
+
+        this->compressedData = compressedData;
+        this->compressedLength = length;
+        this->chunkEnds = chunkEnds;
+        return true;
+    }
+
+    bool SharedSource::DecompressChunk(uint chunk, utf8char_t * buffer) const
+    {
+        Assert(IsCompressed());
+
+        size_t start = chunk == 0 ? 0 : this->chunkEnds[chunk - 1];
+        size_t length = this->chunkEnds[chunk] - start;
+        size_t rawLength = GetChunkByteLength(chunk);
+        if (length == rawLength)
+        {
+            js_memcpy_s(buffer, rawLength, this->compressedData + start, length);
+            return true;
+        }
+        return DecompressBlock(this->compressedData + start, length, buffer, rawLength);
+    }
+
+    bool SharedSource::Matches(LPCUTF8 source, size_t byteLength, int hashCode) const
+    {
+        if (this->hashCode != hashCode || this->byteLength != byteLength)
+        {
+            return false;
+        }
+
+        if (!IsCompressed())
+        {
+            return memcmp(this->source, source, byteLength) == 0;
+        }
+
+        if (this->expansion != nullptr)
+        {
+            return memcmp(this->expansion, source, byteLength) == 0;
+        }
+
+        // Compare a chunk at a time rather than decompressing the whole source
+        utf8char_t * buffer = HeapNewNoThrowArray(utf8char_t, ChunkSize);
+        if (buffer == nullptr)
+        {
+            return false;
+        }
+
+        bool matches = true;
+        for (uint chunk = 0; matches && chunk < this->chunkCount; chunk++)
+        {
+            matches = DecompressChunk(chunk, buffer) &&
+                memcmp(buffer, source + (size_t)chunk * ChunkSize, GetChunkByteLength(chunk)) == 0;
+        }
+        HeapDeleteArray(ChunkSize, buffer);
+        return matches;
+    }
+
+    // -------- SharedSourceStore ------------//
+    CriticalSection SharedSourceStore::cs;
+    SharedSource * SharedSourceStore::buckets[SharedSourceStore::BucketCount];
+
+    SharedSource * SharedSourceStore::Acquire(LPCUTF8 source, size_t byteLength, bool compress)
+    {
+        Assert(byteLength < MAXUINT32);
+        int hashCode = JsUtil::CharacterBuffer<utf8char_t>::StaticGetHashCode(source, (charcount_t)byteLength);
+        uint bucket = (uint)hashCode % BucketCount;
+
+        {
+            AutoCriticalSection autocs(&cs);
+            for (SharedSource * entry = buckets[bucket]; entry != nullptr; entry = entry->next)
+            {
+                if (entry->Matches(source, byteLength, hashCode))
+                {
+                    entry->refCount++;
+                    return entry;
+                }
+            }
+        }
+
+        // Build the entry outside the lock; compressing a large source takes a while
+        SharedSource * entry = HeapNew(SharedSource, hashCode, byteLength);
+        if (!compress || byteLength < MinCompressedByteLength || !entry->Compress(source))
+        {
+            entry->source = HeapNewNoThrowArray(utf8char_t, byteLength + 1);
+            if (entry->source == nullptr)
+            {
+                entry->refCount = 0;
+                HeapDelete(entry);
+                Js::Throw::OutOfMemory();
+            }
+            js_memcpy_s(entry->source, byteLength, source, byteLength);
+            entry->source[byteLength] = 0;
+        }
+
+        AutoCriticalSection autocs(&cs);
+
+        // Another thread may have published the same source in the meantime
+        for (SharedSource * existing = buckets[bucket]; existing != nullptr; existing = existing->next)
+        {
+            if (existing->Matches(source, byteLength, hashCode))
+            {
+                existing->refCount++;
+                entry->refCount = 0;
+                HeapDelete(entry);
+                return existing;
+            }
+        }
+
+        entry->next = buckets[bucket];
+        buckets[bucket] = entry;
+        return entry;
+    }
+
+    SharedSource * SharedSourceStore::AddRef(SharedSource * sharedSource)
+    {
+        AutoCriticalSection autocs(&cs);
+        Assert(sharedSource->refCount != 0);
+        sharedSource->refCount++;
+        return sharedSource;
+    }
+
+    void SharedSourceStore::Release(SharedSource * sharedSource)
+    {
+        {
+            AutoCriticalSection autocs(&cs);
+            Assert(sharedSource->refCount != 0);
+            if (--sharedSource->refCount != 0)
+            {
+                return;
+            }
+
+            SharedSource ** link = &buckets[(uint)sharedSource->hashCode % BucketCount];
+            while (*link != sharedSource)
+            {
+                link = &(*link)->next;
+            }
+            *link = sharedSource->next;
+        }
+
+        HeapDelete(sharedSource);
+    }
+
+    LPCUTF8 SharedSourceStore::AddExpansionRef(SharedSource * sharedSource)
+    {
+        Assert(sharedSource->IsCompressed());
+
+        AutoCriticalSection autocs(&cs);
+        if (sharedSource->expansion == nullptr)
+        {
+            Assert(sharedSource->expansionRefCount == 0);
+            size_t byteLength = sharedSource->byteLength;
+            utf8char_t * expansion = HeapNewArray(utf8char_t, byteLength + 1);
+            for (uint chunk = 0; chunk < sharedSource->chunkCount; chunk++)
+            {
+                if (!sharedSource->DecompressChunk(chunk, expansion + (size_t)chunk * SharedSource::ChunkSize))
+                {
+                    // We produced this data ourselves, so this is memory corruption
+                    HeapDeleteArray(byteLength + 1, expansion);
+                    Js::Throw::FatalInternalError();
+                }
+            }
+            expansion[byteLength] = 0;
+            sharedSource->expansion = expansion;
+        }
+        sharedSource->expansionRefCount++;
+        return sharedSource->expansion;
+    }
+
+    void SharedSourceStore::ReleaseExpansion(SharedSource * sharedSource)
+    {
+        utf8char_t * expansion;
+        {
+            AutoCriticalSection autocs(&cs);
+            Assert(sharedSource->expansionRefCount != 0);
+            if (--sharedSource->expansionRefCount != 0)
+            {
+                return;
+            }
+            expansion = sharedSource->expansion;
+            sharedSource->expansion = nullptr;
+        }
+
+        HeapDeleteArray(sharedSource->byteLength + 1, expansion);
+    }
+
+    // -------- SharedSourceHolder ------------//
+    SharedSourceHolder * SharedSourceHolder::New(ScriptContext * scriptContext, LPCUTF8 source, size_t byteLength, bool compress)
+    {
+        // Allocate the holder first so that the reference never leaks if the allocation throws
+        SharedSourceHolder * holder = RecyclerNewFinalized(scriptContext->GetRecycler(), SharedSourceHolder, nullptr);
+        holder->sharedSource = SharedSourceStore::Acquire(source, byteLength, compress);
+        return holder;
+    }
+
+    LPCUTF8 SharedSourceHolder::GetSource(const char16* reasonString)
+    {
+        Assert(this->sharedSource != nullptr);
+        if (!this->sharedSource->IsCompressed())
+        {
+            return this->sharedSource->GetUncompressedSource();
+        }
+
+        this->usedSinceTrim = true;
+        if (this->expandedSource == nullptr)
+        {
+            this->expandedSource = SharedSourceStore::AddExpansionRef(this->sharedSource);
+        }
+        return this->expandedSource;
+    }
+
+    ISourceHolder* SharedSourceHolder::Clone(ScriptContext* scriptContext)
+    {
+        SharedSourceHolder * holder = RecyclerNewFinalized(scriptContext->GetRecycler(), SharedSourceHolder, nullptr);
+        holder->sharedSource = SharedSourceStore::AddRef(this->sharedSource);
+        return holder;
+    }
+
+    void SharedSourceHolder::Trim()
+    {
+        if (this->expandedSource == nullptr)
+        {
+            return;
+        }
+
+        if (this->usedSinceTrim)
+        {
+            this->usedSinceTrim = false;
+            return;
+        }
+
+        this->expandedSource = nullptr;
+        SharedSourceStore::ReleaseExpansion(this->sharedSource);
+    }
+
+    void SharedSourceHolder::Finalize(bool isShutdown)
+    {
+        if (this->sharedSource == nullptr)
+        {
+            return;
+        }
+
+        if (this->expandedSource != nullptr)
+        {
+            this->expandedSource = nullptr;
+            SharedSourceStore::ReleaseExpansion(this->sharedSource);
+        }
+        SharedSourceStore::Release(this->sharedSource);
+        this->sharedSource = nullptr;
+    }
+}
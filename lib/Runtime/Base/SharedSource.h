@@ -0,0 +1,134 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Js
+{
+    // Process-wide copy of a script's utf8 source.
+    //
+    // Runtimes created with JsRuntimeAttributeShareScriptSource keep their script source here instead of in
+    // their own recycler, so every script context, in every runtime, that loads the same text refers to the
+    // same entry. Entries are reference counted and immutable once published.
+    //
+    // Large sources can be kept compressed, in independently compressed chunks (LZ4 block format). The text
+    // is then only decompressed when something needs it (deferred parsing, Function.prototype.toString,
+    // the debugger), into a single copy shared by all the holders that currently use it.
+    class SharedSource
+    {
+        friend class SharedSourceStore;
+
+    public:
+        // Only SharedSourceStore creates and deletes entries
+        SharedSource(int hashCode, size_t byteLength);
+        ~SharedSource();
+
+        size_t GetByteLength() const { return this->byteLength; }
+        int GetHashCode() const { return this->hashCode; }
+        bool IsCompressed() const { return this->source == nullptr; }
+        size_t GetCompressedLength() const { return this->compressedLength; }
+
+        LPCUTF8 GetUncompressedSource() const
+        {
+            Assert(!IsCompressed());
+            return this->source;
+        }
+
+    private:
+        static const size_t ChunkSize = 64 * 1024;
+
+        bool Matches(LPCUTF8 source, size_t byteLength, int hashCode) const;
+        bool Compress(LPCUTF8 source);
+        bool DecompressChunk(uint chunk, utf8char_t * buffer) const;
+        size_t GetChunkByteLength(uint chunk) const;
+
+        int hashCode;
+        size_t byteLength;
+        uint refCount;
+
+        // Null terminated copy of the source, or nullptr when compressed
+        utf8char_t * source;
+
+        // Chunk i is compressedData[chunkEnds[i - 1], chunkEnds[i]); a chunk that did not shrink is stored as is
+        byte * compressedData;
+        size_t compressedLength;
+        uint32 * chunkEnds;
+        uint chunkCount;
+
+        // Decompressed text of a compressed source, alive while expansionRefCount != 0
+        utf8char_t * expansion;
+        uint expansionRefCount;
+
+        SharedSource * next;
+    };
+
+    class SharedSourceStore
+    {
+    public:
+        // Finds or adds the entry for the given text and takes a reference to it
+        static SharedSource * Acquire(LPCUTF8 source, size_t byteLength, bool compress);
+        static SharedSource * AddRef(SharedSource * sharedSource);
+        static void Release(SharedSource * sharedSource);
+
+        // Decompressed text of a compressed entry; each AddExpansionRef must be matched by a ReleaseExpansion
+        static LPCUTF8 AddExpansionRef(SharedSource * sharedSource);
+        static void ReleaseExpansion(SharedSource * sharedSource);
+
+    private:
+        // Smaller sources are cheaper to keep than to decompress on each use
+        static const size_t MinCompressedByteLength = 16 * 1024;
+        static const uint BucketCount = 64;
+
+        static CriticalSection cs;
+        static SharedSource * buckets[BucketCount];
+    };
+
+    class SharedSourceHolder sealed : public ISourceHolder
+    {
+    private:
+        SharedSource * sharedSource;
+        LPCUTF8 expandedSource;
+        bool usedSinceTrim;
+
+        SharedSourceHolder(SharedSource * sharedSource)
+            : sharedSource(sharedSource),
+            expandedSource(nullptr),
+            usedSinceTrim(false)
+        {
+        }
+
+    public:
+        static SharedSourceHolder * New(ScriptContext * scriptContext, LPCUTF8 source, size_t byteLength, bool compress);
+
+        virtual LPCUTF8 GetSource(const char16* reasonString) override;
+        virtual size_t GetByteLength(const char16* reasonString) override { return this->sharedSource->GetByteLength(); }
+        virtual ISourceHolder* Clone(ScriptContext* scriptContext) override;
+
+        virtual bool Equals(ISourceHolder* other) override
+        {
+            const char16* reason = _u("Equal Comparison");
+            return this == other ||
+                (this->GetByteLength(reason) == other->GetByteLength(reason)
+                    && (this->GetSource(reason) == other->GetSource(reason)
+                        || memcmp(this->GetSource(reason), other->GetSource(reason), this->GetByteLength(reason)) == 0));
+        }
+
+        virtual int GetHashCode() override { return this->sharedSource->GetHashCode(); }
+        virtual bool IsEmpty() override { return false; }
+        virtual bool IsDeferrable() override { return true; }
+
+        // Lets go of the decompressed text if nothing asked for it since the previous trim
+        virtual void Trim() override;
+
+        virtual void Finalize(bool isShutdown) override;
+
+        virtual void Dispose(bool isShutdown) override
+        {
+        }
+
+        virtual void Mark(Recycler * recycler) override
+        {
+        }
+    };
+}
@@ -25,6 +25,9 @@ namespace Js
         virtual int GetHashCode() = 0;
         virtual bool IsEmpty() = 0;
         virtual bool IsDeferrable() = 0;
+
+        // Drops whatever the holder can rebuild on demand. Only called while nothing is using the source.
+        virtual void Trim() { }
     };
 
     class SimpleSourceHolder sealed : public ISourceHolder
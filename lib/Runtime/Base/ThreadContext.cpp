@@ -108,6 +108,7 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     noScriptScope(false),
     heapEnum(nullptr),
     threadContextFlags(ThreadContextFlagNoFlag),
+    regexBacktrackLimit(0),
     JsUtil::DoublyLinkedListElement<ThreadContext>(),
     allocationPolicyManager(allocationPolicyManager),
     threadService(threadServiceCallback),
@@ -122,9 +123,7 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     recycler(nullptr),
     hasCollectionCallBack(false),
     callDispose(true),
-#if ENABLE_NATIVE_CODEGEN
     jobProcessor(nullptr),
-#endif
     interruptPoller(nullptr),
     expirableCollectModeGcCount(-1),
     expirableObjectList(nullptr),
@@ -182,6 +181,9 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     telemetryBlock(&localTelemetryBlock),
     configuration(enableExperimentalFeatures),
     jsrtRuntime(nullptr),
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+    interpreterOpcodeProfile(nullptr),
+#endif
     rootPendingClose(nullptr),
     wellKnownHostTypeHTMLAllCollectionTypeId(Js::TypeIds_Undefined),
     isProfilingUserCode(true),
@@ -364,6 +366,14 @@ ThreadContext::~ThreadContext()
         interruptPoller = nullptr;
     }
 
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+    if (interpreterOpcodeProfile)
+    {
+        HeapDelete(interpreterOpcodeProfile);
+        interpreterOpcodeProfile = nullptr;
+    }
+#endif
+
 #if DBG
     // ThreadContext dtor may be running on a different thread.
     // Recycler may call finalizer that free temp Arenas, which will free pages back to
@@ -448,20 +458,20 @@ ThreadContext::~ThreadContext()
         HeapDelete(recycler);
     }
 
-#if ENABLE_NATIVE_CODEGEN
     if(jobProcessor)
     {
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
         if(this->bgJit)
         {
             HeapDelete(static_cast<JsUtil::BackgroundJobProcessor *>(jobProcessor));
         }
         else
+#endif
         {
             HeapDelete(static_cast<JsUtil::ForegroundJobProcessor *>(jobProcessor));
         }
         jobProcessor = nullptr;
     }
-#endif
 
     // Do not require all GC callbacks to be revoked, because Trident may not revoke if there
     // is a leak, and we don't want the leak to be masked by an assert
@@ -526,6 +536,18 @@ ThreadContext::SetJSRTRuntime(void* runtime)
 #endif
 }
 
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+Js::InterpreterOpcodeProfile *
+ThreadContext::EnsureInterpreterOpcodeProfile()
+{
+    if (interpreterOpcodeProfile == nullptr)
+    {
+        interpreterOpcodeProfile = HeapNewNoThrow(Js::InterpreterOpcodeProfile);
+    }
+    return interpreterOpcodeProfile;
+}
+#endif
+
 void ThreadContext::CloseForJSRT()
 {
     // This is used for JSRT APIs only.
@@ -1258,29 +1280,31 @@ ThreadContext::ForceCleanPropertyMap()
     // No-op now that we no longer use weak refs
 }
 
-#if ENABLE_NATIVE_CODEGEN
 JsUtil::JobProcessor *
 ThreadContext::GetJobProcessor()
 {
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
     if(bgJit && isOptimizedForManyInstances)
     {
         return ThreadBoundThreadContextManager::GetSharedJobProcessor();
     }
+#endif
 
     if (!jobProcessor)
     {
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
         if(bgJit && !isOptimizedForManyInstances)
         {
             jobProcessor = HeapNew(JsUtil::BackgroundJobProcessor, GetAllocationPolicyManager(), &threadService, false /*disableParallelThreads*/);
         }
         else
+#endif
         {
             jobProcessor = HeapNew(JsUtil::ForegroundJobProcessor);
         }
     }
     return jobProcessor;
 }
-#endif
 
 void
 ThreadContext::RegisterCodeGenRecyclableData(Js::CodeGenRecyclableData *const codeGenRecyclableData)
@@ -2418,6 +2442,32 @@ ThreadContext::PostCollectionCallBack()
     }
 }
 
+void
+ThreadContext::TrimSharedSource()
+{
+    Assert(!this->IsScriptActive());
+
+    // Debug mode keeps raw pointers to the source of every script of the context
+    for (Js::ScriptContext *scriptContext = scriptContextList; scriptContext; scriptContext = scriptContext->next)
+    {
+        if (scriptContext->IsScriptContextInDebugMode())
+        {
+            return;
+        }
+    }
+
+    for (Js::ScriptContext *scriptContext = scriptContextList; scriptContext; scriptContext = scriptContext->next)
+    {
+        if (!scriptContext->IsClosed())
+        {
+            scriptContext->MapScript([](Js::Utf8SourceInfo * sourceInfo)
+            {
+                sourceInfo->GetSourceHolder()->Trim();
+            });
+        }
+    }
+}
+
 #ifdef FAULT_INJECTION
 void
 ThreadContext::DisposeScriptContextByFaultInjectionCallBack()
@@ -39,6 +39,9 @@ enum ThreadContextFlags
     ThreadContextFlagCanDisableExecution           = 0x00000001,
     ThreadContextFlagEvalDisabled                  = 0x00000002,
     ThreadContextFlagNoJIT                         = 0x00000004,
+    ThreadContextFlagShareSource                   = 0x00000008,
+    ThreadContextFlagCompressSource                = 0x00000010,
+    ThreadContextFlagShareRegex                    = 0x00000020,
 };
 
 const int LS_MAX_STACK_SIZE_KB = 300;
@@ -622,6 +625,8 @@ private:
     static ThreadContext * globalListLast;
 
     ThreadContextFlags threadContextFlags;
+    // Backtracking steps a single regex match may take, or 0 for no limit
+    uint regexBacktrackLimit;
     DWORD currentThreadId;
     mutable PBYTE stackLimitForCurrentThread;
     StackProber * stackProber;
@@ -679,8 +684,9 @@ private:
 #endif
 #endif
 
-#if ENABLE_NATIVE_CODEGEN
+    // Shared by the native code generator and the background parser
     JsUtil::JobProcessor *jobProcessor;
+#if ENABLE_NATIVE_CODEGEN
     Js::Var * bailOutRegisterSaveSpace;
     CodeGenNumberThreadAllocator * codeGenNumberThreadAllocator;
     PreReservedVirtualAllocWrapper preReservedVirtualAllocator;
@@ -742,6 +748,10 @@ private:
 
     void* jsrtRuntime;
 
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+    Js::InterpreterOpcodeProfile * interpreterOpcodeProfile;
+#endif
+
     bool hasUnhandledException;
     bool hasCatchHandler;
     DisableImplicitFlags disableImplicitFlags;
@@ -958,6 +968,28 @@ public:
         return this->TestThreadContextFlag(ThreadContextFlagNoJIT);
     }
 
+    // Script source goes to the process-wide SharedSourceStore
+    bool ShareSource() const
+    {
+        return this->TestThreadContextFlag(ThreadContextFlagShareSource);
+    }
+
+    bool CompressSource() const
+    {
+        return this->TestThreadContextFlag(ThreadContextFlagCompressSource);
+    }
+
+    void TrimSharedSource();
+
+    // Regexes are compiled into the process-wide UnifiedRegex::ProgramCache
+    bool ShareRegex() const
+    {
+        return this->TestThreadContextFlag(ThreadContextFlagShareRegex);
+    }
+
+    uint GetRegexBacktrackLimit() const { return this->regexBacktrackLimit; }
+    void SetRegexBacktrackLimit(uint limit) { this->regexBacktrackLimit = limit; }
+
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     Js::Var GetMemoryStat(Js::ScriptContext* scriptContext);
     void SetAutoProxyName(LPCWSTR objectName);
@@ -1048,12 +1080,10 @@ public:
 
     void ShutdownThreads()
     {
-#if ENABLE_NATIVE_CODEGEN
         if (jobProcessor)
         {
             jobProcessor->Close();
         }
-#endif
 #if ENABLE_CONCURRENT_GC
         if (this->recycler != nullptr)
         {
@@ -1192,9 +1222,9 @@ public:
     Js::ScriptEntryExitRecord * GetScriptEntryExit() const { return entryExitRecord; }
     void RegisterCodeGenRecyclableData(Js::CodeGenRecyclableData *const codeGenRecyclableData);
     void UnregisterCodeGenRecyclableData(Js::CodeGenRecyclableData *const codeGenRecyclableData);
+    JsUtil::JobProcessor *GetJobProcessor();
 #if ENABLE_NATIVE_CODEGEN
     BOOL IsNativeAddress(void * pCodeAddr);
-    JsUtil::JobProcessor *GetJobProcessor();
     Js::Var * GetBailOutRegisterSaveSpace() const { return bailOutRegisterSaveSpace; }
     CodeGenNumberThreadAllocator * GetCodeGenNumberThreadAllocator() const
     {
@@ -1611,7 +1641,7 @@ public:
 
     }
 
-#if ENABLE_NATIVE_CODEGEN
+    // Also decides whether background parsing gets threads of its own
     bool IsBgJitEnabled() const { return bgJit; }
 
     void EnableBgJit(const bool enableBgJit)
@@ -1619,11 +1649,15 @@ public:
         Assert(!jobProcessor || enableBgJit == bgJit);
         bgJit = enableBgJit;
     }
-#endif
 
     void* GetJSRTRuntime() const { return jsrtRuntime; }
     void SetJSRTRuntime(void* runtime);
 
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+    Js::InterpreterOpcodeProfile * GetInterpreterOpcodeProfile() const { return interpreterOpcodeProfile; }
+    Js::InterpreterOpcodeProfile * EnsureInterpreterOpcodeProfile();
+#endif
+
     bool CanBeFalsy(Js::TypeId typeId);
 private:
     BOOL ExecuteRecyclerCollectionFunctionCommon(Recycler * recycler, CollectionFunction function, CollectionFlags flags);
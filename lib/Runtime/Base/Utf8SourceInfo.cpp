@@ -183,6 +183,13 @@ namespace Js
     Utf8SourceInfo*
     Utf8SourceInfo::New(ScriptContext* scriptContext, LPCUTF8 utf8String, int32 length, size_t numBytes, SRCINFO const* srcInfo, bool isLibraryCode)
     {
+        ThreadContext * threadContext = scriptContext->GetThreadContext();
+        if (threadContext->ShareSource() && !isLibraryCode)
+        {
+            ISourceHolder* sourceHolder = SharedSourceHolder::New(scriptContext, utf8String, numBytes, threadContext->CompressSource());
+            return NewWithHolder(scriptContext, sourceHolder, length, srcInfo, isLibraryCode);
+        }
+
         utf8char_t * newUtf8String = RecyclerNewArrayLeaf(scriptContext->GetRecycler(), utf8char_t, numBytes + 1);
         js_memcpy_s(newUtf8String, numBytes + 1, utf8String, numBytes + 1);
         return NewWithNoCopy(scriptContext, newUtf8String, length, numBytes, srcInfo, isLibraryCode);
@@ -233,35 +240,45 @@ namespace Js
         return newSourceInfo;
     }
 
-    HRESULT Utf8SourceInfo::EnsureLineOffsetCacheNoThrow()
+    HRESULT Utf8SourceInfo::EnsureLineOffsetCacheNoThrow(charcount_t charPosition)
     {
         HRESULT hr = S_OK;
         // This is a double check, otherwise we would have to have a private function, and add an assert.
         // Basically the outer check is for try/catch, inner check (inside EnsureLineOffsetCache) is for that method as its public.
-        if (this->m_lineOffsetCache == nullptr)
+        if (this->m_lineOffsetCache == nullptr || !this->m_lineOffsetCache->HasCharacterOffset(charPosition))
         {
             BEGIN_TRANSLATE_EXCEPTION_AND_ERROROBJECT_TO_HRESULT_NESTED
             {
-                this->EnsureLineOffsetCache();
+                this->EnsureLineOffsetCache(charPosition);
             }
             END_TRANSLATE_EXCEPTION_AND_ERROROBJECT_TO_HRESULT_NOASSERT(hr);
         }
         return hr;
     }
 
-    void Utf8SourceInfo::EnsureLineOffsetCache()
+    void Utf8SourceInfo::EnsureLineOffsetCache(charcount_t charPosition)
     {
         if (this->m_lineOffsetCache == nullptr)
         {
             LPCUTF8 sourceStart = this->GetSource(_u("Utf8SourceInfo::AllocateLineOffsetCache"));
-            LPCUTF8 sourceEnd = sourceStart + this->GetCbLength(_u("Utf8SourceInfo::AllocateLineOffsetCache"));
 
             LPCUTF8 sourceAfterBOM = sourceStart;
             charcount_t startChar = FunctionBody::SkipByteOrderMark(sourceAfterBOM /* byref */);
-            int64 byteStartOffset = (sourceAfterBOM - sourceStart);
+            Assert((sourceAfterBOM - sourceStart) < MAXUINT32);
+            charcount_t byteStartOffset = (charcount_t)(sourceAfterBOM - sourceStart);
 
             Recycler* recycler = this->m_scriptContext->GetRecycler();
-            this->m_lineOffsetCache = RecyclerNew(recycler, JsUtil::LineOffsetCache<Recycler>, recycler, sourceAfterBOM, sourceEnd, startChar, (int)byteStartOffset);
+            this->m_lineOffsetCache = RecyclerNew(recycler, JsUtil::LineOffsetCache<Recycler>, recycler, startChar, byteStartOffset);
+        }
+
+        // Only scan as far as the position asked for, so the first lookup near the top of a large script
+        // doesn't pay for the whole source.
+        if (!this->m_lineOffsetCache->HasCharacterOffset(charPosition))
+        {
+            LPCUTF8 sourceStart = this->GetSource(_u("Utf8SourceInfo::AllocateLineOffsetCache"));
+            LPCUTF8 sourceEnd = sourceStart + this->GetCbLength(_u("Utf8SourceInfo::AllocateLineOffsetCache"));
+
+            this->m_lineOffsetCache->EnsureCharacterOffset(sourceStart, sourceEnd, charPosition);
         }
     }
 
@@ -285,12 +302,13 @@ namespace Js
 
     void Utf8SourceInfo::GetLineInfoForCharPosition(charcount_t charPosition, charcount_t *outLineNumber, charcount_t *outColumn, charcount_t *outLineByteOffset, bool allowSlowLookup)
     {
-        AssertMsg(this->m_lineOffsetCache != nullptr || allowSlowLookup, "LineOffsetCache wasn't created, EnsureLineOffsetCache should have been called.");
+        AssertMsg((this->m_lineOffsetCache != nullptr && this->m_lineOffsetCache->HasCharacterOffset(charPosition)) || allowSlowLookup,
+            "LineOffsetCache wasn't built up to the position, EnsureLineOffsetCache should have been called.");
         AssertMsg(outLineNumber != nullptr && outColumn != nullptr && outLineByteOffset != nullptr, "Expected out parameter's can't be a nullptr.");
 
         charcount_t lineCharOffset = 0;
         int line = 0;
-        if (this->m_lineOffsetCache == nullptr)
+        if (this->m_lineOffsetCache == nullptr || !this->m_lineOffsetCache->HasCharacterOffset(charPosition))
         {
             LPCUTF8 sourceStart = this->GetSource(_u("Utf8SourceInfo::AllocateLineOffsetCache"));
             LPCUTF8 sourceEnd = sourceStart + this->GetCbLength(_u("Utf8SourceInfo::AllocateLineOffsetCache"));
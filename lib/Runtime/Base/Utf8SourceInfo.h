@@ -282,8 +282,9 @@ namespace Js
             return this->m_scriptContext;
         }
 
-        void EnsureLineOffsetCache();
-        HRESULT EnsureLineOffsetCacheNoThrow();
+        // Builds the line table up to the given character position, or for the whole source by default
+        void EnsureLineOffsetCache(charcount_t charPosition = UINT32_MAX);
+        HRESULT EnsureLineOffsetCacheNoThrow(charcount_t charPosition = UINT32_MAX);
         void DeleteLineOffsetCache()
         {
             this->m_lineOffsetCache = nullptr;
@@ -4,6 +4,6 @@
 //-------------------------------------------------------------------------------------------------------
 // NOTE: If there is a merge conflict the correct fix is to make a new GUID.
 
-// {E76273A1-48D2-4895-81B0-2CE284147DC5}
+// {5DAB3D18-1994-45AE-A747-9006D071B6DB}
 const GUID byteCodeCacheReleaseFileVersion =
-{ 0xe76273a1, 0x48d2, 0x4895,{ 0x81, 0xb0, 0x2c, 0xe2, 0x84, 0x14, 0x7d, 0xc5 } };
+{ 0x5dab3d18, 0x1994, 0x45ae,{ 0xa7, 0x47, 0x90, 0x06, 0xd0, 0x71, 0xb6, 0xdb } };
@@ -2028,6 +2028,9 @@ HRESULT GenerateByteCode(__in ParseNode *pnode, __in uint32 grfscr, __in Js::Scr
     {
         // Main code.
         ByteCodeGenerator::Generate(pnode, grfscr, &byteCodeGenerator, ppRootFunc, sourceIndex, forceNoNative, parser, functionRef);
+
+        // Let JsIdle parse the functions that were deferred ahead of their first call
+        scriptContext->AddIdleParseCandidates(*ppRootFunc);
     }
     END_TRANSLATE_EXCEPTION_TO_HRESULT(hr);
 
@@ -120,13 +120,21 @@ namespace Js
 
     OpCode ByteCodeReader::ReadOp(LayoutSize& layoutSize)
     {
-        OpCode op = ReadOp(m_currentLocation, layoutSize);
+        OpCode op = UnfuseOp(ReadOp(m_currentLocation, layoutSize));
 #if ENABLE_NATIVE_CODEGEN
         Assert(!OpCodeAttr::BackEndOnly(op));
 #endif
         return op;
     }
 
+    // Superinstructions are an interpreter dispatch detail: the fused opcode has the layout of the
+    // first instruction of the pair and the second instruction is still in the stream, so every other
+    // reader (JIT, dumper, serializer) can treat it as the original first instruction.
+    OpCode ByteCodeReader::UnfuseOp(OpCode op)
+    {
+        return op == OpCode::Ld_A_Ld_A ? OpCode::Ld_A : op;
+    }
+
     OpCodeAsmJs ByteCodeReader::ReadAsmJsOp(LayoutSize& layoutSize)
     {
         OpCode op = ReadOp(m_currentLocation, layoutSize);
@@ -142,12 +150,12 @@ namespace Js
     OpCode ByteCodeReader::PeekOp(LayoutSize& layoutSize) const
     {
         const byte * ip = m_currentLocation;
-        return ReadOp(ip, layoutSize);
+        return UnfuseOp(ReadOp(ip, layoutSize));
     }
 
     OpCode ByteCodeReader::PeekOp(const byte * ip, LayoutSize& layoutSize)
     {
-        return ReadOp(ip, layoutSize);
+        return UnfuseOp(ReadOp(ip, layoutSize));
     }
 
     OpCode ByteCodeReader::ReadByteOp(const byte*& ip)
@@ -47,6 +47,7 @@ namespace Js
 
         static OpCode ReadByteOp(const byte*& ip);
         static OpCode PeekByteOp(const byte * ip);
+        static OpCode UnfuseOp(OpCode op);
 
         // Declare reading functions
 #define LAYOUT_TYPE(layout) \
@@ -4344,6 +4344,52 @@ HRESULT ByteCodeSerializer::DeserializeFromBufferInternal(ScriptContext * script
     return hr;
 }
 
+HRESULT ByteCodeSerializer::ValidateBuffer(ScriptContext * scriptContext, byte * buffer, DWORD bufferBytes)
+{
+    // Check the magic and size before handing the buffer to the reader, which asserts on a bad magic and trusts the offsets
+    if (bufferBytes < 2 * sizeof(int) || *(int*)buffer != magicConstant || (DWORD)*(int*)(buffer + sizeof(int)) != bufferBytes)
+    {
+        return ByteCodeSerializer::InvalidByteCode;
+    }
+
+    ByteCodeBufferReader reader(scriptContext, buffer, /* isLibraryCode */ false, TotalNumberOfBuiltInProperties);
+    return reader.ReadHeader();
+}
+
+void ByteCodeSerializer::GetFileVersion(byte * fileVersionScheme, DWORD * v1, DWORD * v2, DWORD * v3, DWORD * v4)
+{
+    // Same choice as ByteCodeBufferReader::ReadHeader makes for non-library code
+    *fileVersionScheme = CurrentFileVersionScheme;
+#if ENABLE_DEBUG_CONFIG_OPTIONS
+    if (Js::Configuration::Global.flags.ForceSerializedBytecodeVersionSchema)
+    {
+        *fileVersionScheme = (byte)Js::Configuration::Global.flags.ForceSerializedBytecodeVersionSchema;
+    }
+#endif
+
+    if (*fileVersionScheme != ReleaseVersioningScheme)
+    {
+        Js::VerifyOkCatastrophic(AutoSystemInfo::GetJscriptFileVersion(v1, v2, v3, v4));
+    }
+    else
+    {
+        auto guidDWORDs = (DWORD*)(&byteCodeCacheReleaseFileVersion);
+        *v1 = guidDWORDs[0];
+        *v2 = guidDWORDs[1];
+        *v3 = guidDWORDs[2];
+        *v4 = guidDWORDs[3];
+    }
+#if ENABLE_DEBUG_CONFIG_OPTIONS
+    if (Js::Configuration::Global.flags.ForceSerializedBytecodeMajorVersion)
+    {
+        *v1 = Js::Configuration::Global.flags.ForceSerializedBytecodeMajorVersion;
+        *v2 = 0;
+        *v3 = 0;
+        *v4 = 0;
+    }
+#endif
+}
+
 void ByteCodeSerializer::ReadSourceInfo(const DeferDeserializeFunctionInfo* deferredFunction, int& lineNumber, int& columnNumber, bool& m_isEval, bool& m_isDynamicFunction)
 {
     ByteCodeCache* cache = deferredFunction->m_cache;
@@ -160,6 +160,12 @@ namespace Js
         static HRESULT DeserializeFromBuffer(ScriptContext * scriptContext, uint32 scriptFlags, LPCUTF8 utf8Source, SRCINFO const * srcInfo, byte * buffer, NativeModule *nativeModule, FunctionBody** function, uint sourceIndex = Js::Constants::InvalidSourceIndex);
         static HRESULT DeserializeFromBuffer(ScriptContext * scriptContext, uint32 scriptFlags, ISourceHolder* sourceHolder, SRCINFO const * srcInfo, byte * buffer, NativeModule *nativeModule, FunctionBody** function, uint sourceIndex = Js::Constants::InvalidSourceIndex);
 
+        // Check that a buffer was serialized by a compatible engine and is bufferBytes long, without deserializing anything from it
+        static HRESULT ValidateBuffer(ScriptContext * scriptContext, byte * buffer, DWORD bufferBytes);
+
+        // The version scheme and the four version parts this engine writes into (and requires of) non-library byte code
+        static void GetFileVersion(byte * fileVersionScheme, DWORD * v1, DWORD * v2, DWORD * v3, DWORD * v4);
+
         static FunctionBody* DeserializeFunction(ScriptContext* scriptContext, DeferDeserializeFunctionInfo* deferredFunction);
 
         // This lib doesn't directly depend on the generated interfaces. Ensure the same codes with a C_ASSERT
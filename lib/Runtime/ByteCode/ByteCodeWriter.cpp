@@ -12,6 +12,8 @@ namespace Js
         m_byteCodeCount = 0;
         m_byteCodeWithoutLDACount = 0;
         m_byteCodeInLoopCount = 0;
+        m_fuseOpcodes = false;
+        m_fusableLdAOffset = UINT_MAX;
         m_functionWrite = nullptr;
         m_pMatchingNode = nullptr;
         m_matchingNodeRefCount = 0;
@@ -75,6 +77,11 @@ namespace Js
         m_doInterruptProbe = functionWrite->GetScriptContext()->GetThreadContext()->DoInterruptProbe(functionWrite);
         m_hasLoop = hasLoop;
         m_isInDebugMode = byteCodeGenerator->IsInDebugMode();
+
+        // Superinstructions change which instruction starts at a given offset as far as the interpreter
+        // is concerned, so keep them out of byte code that the debugger may step through.
+        m_fuseOpcodes = CONFIG_FLAG(FuseByteCode) && !m_isInDebugMode;
+        m_fusableLdAOffset = UINT_MAX;
     }
 
     template <typename T>
@@ -183,6 +190,14 @@ namespace Js
             *pnBackPatch += rootObjectStoreInlineCacheStart;
         });
 
+        // Rewrite the first instruction of each fused pair in place; the second one is left as is.
+        fusedOpOffsets.Map([=](size_t offset)
+        {
+            Assert(offset < byteCount - sizeof(OpLayoutReg2_Small));
+            Assert((OpCode)byteBuffer[offset] == OpCode::Ld_A && (OpCode)byteBuffer[offset + sizeof(byte) + sizeof(OpLayoutReg2_Small)] == OpCode::Ld_A);
+            byteBuffer[offset] = (byte)OpCode::Ld_A_Ld_A;
+        });
+
         //
         // Store the final trimmed byte-code on the function.
         //
@@ -274,6 +289,8 @@ namespace Js
         rootObjectLoadInlineCacheOffsets.Clear(m_labelOffsets->GetAllocator());
         rootObjectStoreInlineCacheOffsets.Clear(m_labelOffsets->GetAllocator());
         rootObjectLoadMethodInlineCacheOffsets.Clear(m_labelOffsets->GetAllocator());
+        fusedOpOffsets.Clear(m_labelOffsets->GetAllocator());
+        m_fusableLdAOffset = UINT_MAX;
         callRegToLdFldCacheIndexMap->ResetNoDelete();
         m_pMatchingNode = nullptr;
         m_matchingNodeRefCount = 0;
@@ -383,12 +400,31 @@ namespace Js
         OpLayoutT_Reg2<SizePolicy> layout;
         if (SizePolicy::Assign(layout.R0, R0) && SizePolicy::Assign(layout.R1, R1))
         {
-            m_byteCodeData.EncodeT<SizePolicy::LayoutEnum>(op, &layout, sizeof(layout), this);
+            uint offset = m_byteCodeData.EncodeT<SizePolicy::LayoutEnum>(op, &layout, sizeof(layout), this);
+            if (SizePolicy::LayoutEnum == SmallLayout && op == OpCode::Ld_A && m_fuseOpcodes)
+            {
+                FuseLdA(offset);
+            }
             return true;
         }
         return false;
     }
 
+    void ByteCodeWriter::FuseLdA(uint offset)
+    {
+        // Pair this move with the previous one only if nothing was written in between (this also catches
+        // branch islands) and that move is not already part of a pair.
+        if (m_fusableLdAOffset != UINT_MAX && m_fusableLdAOffset + sizeof(byte) + sizeof(OpLayoutReg2_Small) == offset)
+        {
+            fusedOpOffsets.Prepend(m_labelOffsets->GetAllocator(), m_fusableLdAOffset);
+            m_fusableLdAOffset = UINT_MAX;
+        }
+        else
+        {
+            m_fusableLdAOffset = offset;
+        }
+    }
+
     void ByteCodeWriter::Reg2(OpCode op, RegSlot R0, RegSlot R1)
     {
         CheckOpen();
@@ -146,6 +146,7 @@ namespace Js
         SListBase<size_t>  rootObjectLoadInlineCacheOffsets;                // load inline cache offsets
         SListBase<size_t>  rootObjectStoreInlineCacheOffsets;               // load inline cache offsets
         SListBase<size_t>  rootObjectLoadMethodInlineCacheOffsets;
+        SListBase<size_t>  fusedOpOffsets;                                  // small Ld_A offsets to rewrite as Ld_A_Ld_A superinstructions
 
         FunctionBody* m_functionWrite;  // Function being written
         Data m_byteCodeData;            // Accumulated byte-code
@@ -174,6 +175,8 @@ namespace Js
         bool m_doJitLoopBodies;
         bool m_hasLoop;
         bool m_isInDebugMode;
+        bool m_fuseOpcodes;
+        uint m_fusableLdAOffset;        // Offset of the preceding small Ld_A if it can start a superinstruction, UINT_MAX otherwise
         bool m_doInterruptProbe;
     public:
         struct CacheIdUnit {
@@ -301,6 +304,7 @@ namespace Js
 
         template <typename SizePolicy> bool TryWriteReg1(OpCode op, RegSlot R0);
         template <typename SizePolicy> bool TryWriteReg2(OpCode op, RegSlot R0, RegSlot R1);
+        void FuseLdA(uint offset);
         template <typename SizePolicy> bool TryWriteReg2WithICIndex(OpCode op, RegSlot R0, RegSlot R1, uint32 inlineCacheIndex, bool isRootLoad);
         template <typename SizePolicy> bool TryWriteReg3(OpCode op, RegSlot R0, RegSlot R1, RegSlot R2);
         template <typename SizePolicy> bool TryWriteReg3C(OpCode op, RegSlot R0, RegSlot R1, RegSlot R2, CacheId cacheId);
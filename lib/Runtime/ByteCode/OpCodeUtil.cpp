@@ -183,8 +183,8 @@ namespace Js
     CompileAssert(((int)Js::OpCode::CallIExtendedFlags - (int)Js::OpCode::CallI) == ((int)Js::OpCode::ProfiledReturnTypeCallIExtendedFlags - (int)Js::OpCode::ProfiledReturnTypeCallI));
     CompileAssert(((int)Js::OpCode::CallIExtendedFlags - (int)Js::OpCode::CallI) == ((int)Js::OpCode::ProfiledCallIExtendedFlagsWithICIndex - (int)Js::OpCode::ProfiledCallIWithICIndex));
 
-    // Only include the opcode name on debug and test build
-#if DBG_DUMP || ENABLE_DEBUG_CONFIG_OPTIONS
+    // Only include the opcode name on debug and test build, and with the interpreter opcode profiler
+#if DBG_DUMP || ENABLE_DEBUG_CONFIG_OPTIONS || ENABLE_INTERPRETER_OPCODE_PROFILE
 
     char16 const * const OpCodeUtil::OpCodeNames[] =
     {
@@ -36,7 +36,7 @@ public:
 
     static OpLayoutType GetOpCodeLayout(OpCode op);
 private:
-#if DBG_DUMP || ENABLE_DEBUG_CONFIG_OPTIONS
+#if DBG_DUMP || ENABLE_DEBUG_CONFIG_OPTIONS || ENABLE_INTERPRETER_OPCODE_PROFILE
     static char16 const * const OpCodeNames[(int)Js::OpCode::MaxByteSizedOpcodes + 1];
     static char16 const * const ExtendedOpCodeNames[];
     static char16 const * const BackendOpCodeNames[];
@@ -133,6 +133,7 @@ EXDEF2_WMS(A1toA1Mem,               NewWithObject,              JavascriptOperat
   DEF2_WMS(FALLTHROUGH,             BeginSwitch,                /* Common case with Ld_A */)
   DEF2_WMS(FALLTHROUGH,             InitConst,                  /* Common case with Ld_A */)
   DEF2_WMS(A1toA1_ALLOW_STACK,      Ld_A,                       OP_Ld_A)
+  DEF2_WMS(A1toA1x2_ALLOW_STACK,    Ld_A_Ld_A,                  OP_Ld_A)
   DEF2_WMS(INNERtoA1,               LdInnerScope,               OP_Ld_A)
   DEF2_WMS(XXtoA1,                  LdLocalObj,                 OP_LdLocalObj)
 EXDEF2_WMS(A1toA1_ALLOW_STACK,      UnwrapWithObj,              JavascriptOperators::OP_UnwrapWithObj)
@@ -351,7 +352,7 @@ EXDEF3_WMS(CUSTOM,                  LdLocalElemUndef,           OP_LdLocalElemen
   DEF3    (CUSTOM,                  NewScObject_A,              OP_NewScObject_A, Auxiliary)
   DEF3    (CUSTOM,                  NewScObjectLiteral,         OP_NewScObjectLiteral, Auxiliary)
   DEF3    (CUSTOM_L_R0,             LdPropIds,                  OP_LdPropIds, Auxiliary)
-  DEF3    (CUSTOM,                  InitCachedFuncs,            OP_InitCachedFuncs, AuxNoReg)
+EXDEF3    (CUSTOM,                  InitCachedFuncs,            OP_InitCachedFuncs, AuxNoReg)
   DEF2_WMS(LOCALI1toA1,             GetCachedFunc,              OP_GetCachedFunc)
   DEF2_WMS(EnvU1toXX,               InvalCachedScope,           JavascriptOperators::OP_InvalidateCachedScope)
   DEF2    (EMPTY,                   CommitScope,                OP_CommitScope)
@@ -25,6 +25,15 @@
 #define INTERPRETERPROFILE 0
 #define PROFILEDOP(prof, unprof) unprof
 #endif
+// The threaded loop goes from the end of one handler straight to the next handler, so it is only used
+// when nothing else has to run between two opcodes (no debugger stepping, no opcode telemetry).
+#if defined(INTERPRETER_THREADED_DISPATCH) && !defined(INTERPRETER_ASMJS) && !DEBUGGING_LOOP && !defined(ENABLE_BASIC_TELEMETRY)
+#define THREADED_LOOP 1
+#define LOOP_CASE(name) case INTERPRETER_OPCODE::name: OpHandler_##name:
+#else
+#define THREADED_LOOP 0
+#define LOOP_CASE(name) case INTERPRETER_OPCODE::name:
+#endif
 
 //two layers of macros are necessary to get arguments to the invocation of the top level macro expanded.
 #define CONCAT_TOKENS_AGAIN(loopName, fnSuffix) loopName ## fnSuffix
@@ -178,6 +187,57 @@ Var Js::InterpreterStackFrame::INTERPRETERLOOPNAME()
     // For checked builds this does mean we are incrementing 2 different counters to
     // track the ip.
     const byte* ip = m_reader.GetIP();
+
+#if THREADED_LOOP
+    // Handler address for each single byte opcode. Label addresses can only be taken in this function, so the
+    // table is filled on the first call rather than statically. Every thread stores the same values, so racing
+    // initializations are harmless.
+    static void* threadedDispatchTable[(int)OpCode::MaxByteSizedOpcodes + 1];
+    static bool threadedDispatchTableReady = false;
+    if (!threadedDispatchTableReady)
+    {
+        for (int i = 0; i <= (int)OpCode::MaxByteSizedOpcodes; i++)
+        {
+            threadedDispatchTable[i] = &&OpHandler_Invalid;
+        }
+
+#define SET_HANDLER(op) threadedDispatchTable[(int)OpCode::op] = &&OpHandler_##op;
+        SET_HANDLER(Ret)
+        SET_HANDLER(Yield)
+        SET_HANDLER(Leave)
+        SET_HANDLER(LeaveNull)
+        SET_HANDLER(ExtendedOpcodePrefix)
+        SET_HANDLER(MediumLayoutPrefix)
+        SET_HANDLER(ExtendedMediumLayoutPrefix)
+        SET_HANDLER(LargeLayoutPrefix)
+        SET_HANDLER(ExtendedLargeLayoutPrefix)
+        SET_HANDLER(EndOfBlock)
+        SET_HANDLER(Break)
+#define DEF2(x, op, func) SET_HANDLER(op)
+#define DEF3(x, op, func, y) SET_HANDLER(op)
+#define DEF2_WMS(x, op, func) SET_HANDLER(op)
+#define DEF3_WMS(x, op, func, y) SET_HANDLER(op)
+#define DEF4_WMS(x, op, func, y, t) SET_HANDLER(op)
+#include "InterpreterHandler.inl"
+#undef SET_HANDLER
+
+        MemoryBarrier();
+        threadedDispatchTableReady = true;
+    }
+
+    // Handlers end by reading the next opcode and jumping to its handler: one indirect jump per handler,
+    // each predicted on its own, instead of the single shared jump of the switch.
+#undef PROCESS_OPCODE_CASE
+#undef PROCESS_OPCODE_DONE
+#define PROCESS_OPCODE_CASE(name) \
+    case OpCode::name: OpHandler_##name:
+#define PROCESS_OPCODE_DONE() \
+    { \
+        op = ReadByteOp<OpCode>(ip); \
+        goto *threadedDispatchTable[(int)op]; \
+    }
+#endif
+
     while (true)
     {
         INTERPRETER_OPCODE op = ReadByteOp<INTERPRETER_OPCODE>(ip);
@@ -266,10 +326,13 @@ Var Js::InterpreterStackFrame::INTERPRETERLOOPNAME()
             }
         }
 SWAP_BP_FOR_OPCODE:
+#endif
+#if THREADED_LOOP
+        goto *threadedDispatchTable[(int)op];
 #endif
         switch (op)
         {
-        case INTERPRETER_OPCODE::Ret:
+        LOOP_CASE(Ret)
             {
                 //
                 // Return "Reg: 0" as the return-value.
@@ -285,7 +348,7 @@ SWAP_BP_FOR_OPCODE:
                 return GetReg((RegSlot)0);
             }
 
-        case INTERPRETER_OPCODE::Yield:
+        LOOP_CASE(Yield)
             {
                 m_reader.Reg2_Small(ip);
                 return GetReg(GetFunctionBody()->GetYieldRegister());
@@ -299,20 +362,20 @@ SWAP_BP_FOR_OPCODE:
 
 #include "InterpreterHandler.inl"
 
-            case INTERPRETER_OPCODE::Leave:
+            LOOP_CASE(Leave)
                 // Return the continuation address to the helper.
                 // This tells the helper that control left the scope without completing the try/handler,
                 // which is particularly significant when executing a finally.
                 m_reader.Empty(ip);
                 return (Var)this->m_reader.GetCurrentOffset();
-            case INTERPRETER_OPCODE::LeaveNull:
+            LOOP_CASE(LeaveNull)
                 // Return to the helper without specifying a continuation address,
                 // indicating that the handler completed without jumping, so exception processing
                 // should continue.
                 m_reader.Empty(ip);
                 return nullptr;
 
-            case INTERPRETER_OPCODE::ExtendedOpcodePrefix:
+            LOOP_CASE(ExtendedOpcodePrefix)
             {
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, ExtendedOpCodePrefix)(ip);
 
@@ -325,7 +388,7 @@ SWAP_BP_FOR_OPCODE:
 #endif
                 break;
             }
-            case INTERPRETER_OPCODE::MediumLayoutPrefix:
+            LOOP_CASE(MediumLayoutPrefix)
             {
                 Var yieldValue = nullptr;
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, MediumLayoutPrefix)(ip, yieldValue);
@@ -344,7 +407,7 @@ SWAP_BP_FOR_OPCODE:
 #endif
                 break;
             }
-            case INTERPRETER_OPCODE::ExtendedMediumLayoutPrefix:
+            LOOP_CASE(ExtendedMediumLayoutPrefix)
             {
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, ExtendedMediumLayoutPrefix)(ip);
 
@@ -357,7 +420,7 @@ SWAP_BP_FOR_OPCODE:
 #endif
                 break;
             }
-            case INTERPRETER_OPCODE::LargeLayoutPrefix:
+            LOOP_CASE(LargeLayoutPrefix)
             {
                 Var yieldValue = nullptr;
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, LargeLayoutPrefix)(ip, yieldValue);
@@ -376,7 +439,7 @@ SWAP_BP_FOR_OPCODE:
 #endif
                 break;
             }
-            case INTERPRETER_OPCODE::ExtendedLargeLayoutPrefix:
+            LOOP_CASE(ExtendedLargeLayoutPrefix)
             {
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, ExtendedLargeLayoutPrefix)(ip);
 
@@ -390,7 +453,7 @@ SWAP_BP_FOR_OPCODE:
                 break;
             }
 
-            case INTERPRETER_OPCODE::EndOfBlock:
+            LOOP_CASE(EndOfBlock)
             {
                 // Note that at this time though ip was advanced by 'OpCode op = ReadByteOp<INTERPRETER_OPCODE>(ip)',
                 // we haven't advanced m_reader.m_currentLocation yet, thus m_reader.m_currentLocation still points to EndOfBLock,
@@ -415,7 +478,7 @@ SWAP_BP_FOR_OPCODE:
 #endif
             }
 
-            case INTERPRETER_OPCODE::Break:
+            LOOP_CASE(Break)
             {
 #if DEBUGGING_LOOP
                 // The reader has already advanced the IP:
@@ -495,17 +558,31 @@ SWAP_BP_FOR_OPCODE:
                 break;
             }
             default:
+#if THREADED_LOOP
+            OpHandler_Invalid:
+#endif
                 // Help the C++ optimizer by declaring that the cases we
                 // have above are sufficient
                 AssertMsg(false, "dispatch to bad opcode");
                 __assume(false);
         }
     }
+
+#if THREADED_LOOP
+#undef PROCESS_OPCODE_CASE
+#undef PROCESS_OPCODE_DONE
+#define PROCESS_OPCODE_CASE(name) \
+    case OpCode::name:
+#define PROCESS_OPCODE_DONE() \
+    break
+#endif
 }
 #if defined (DBG)
 // Restore optimizations to what's specified by the /O switch.
 #pragma optimize("", on)
 #endif
+#undef THREADED_LOOP
+#undef LOOP_CASE
 #undef DEBUGGING_LOOP
 #undef INTERPRETERPROFILE
 #undef PROFILEDOP
@@ -0,0 +1,183 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeLanguagePch.h"
+
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+namespace Js
+{
+    InterpreterOpcodeProfile::InterpreterOpcodeProfile() :
+        opcodeCounts(nullptr),
+        sampledCounts(nullptr),
+        sampledCycles(nullptr),
+        pairCounts(nullptr),
+        entries(nullptr),
+        otherFunctionsEntry(nullptr),
+        entryCount(0),
+        timingSampleInterval(0),
+        timingSampleCountdown(0),
+        enabled(false)
+    {
+    }
+
+    InterpreterOpcodeProfile::~InterpreterOpcodeProfile()
+    {
+        FreeCounters();
+
+        InterpreterOpcodeProfileEntry * entry = this->entries;
+        while (entry != nullptr)
+        {
+            InterpreterOpcodeProfileEntry * next = entry->next;
+            if (entry->functionName != nullptr)
+            {
+                HeapDeleteArray(wcslen(entry->functionName) + 1, entry->functionName);
+            }
+            HeapDelete(entry);
+            entry = next;
+        }
+        this->entries = nullptr;
+        this->otherFunctionsEntry = nullptr;
+        this->entryCount = 0;
+    }
+
+    void InterpreterOpcodeProfile::FreeCounters()
+    {
+        if (this->opcodeCounts != nullptr)
+        {
+            HeapDeleteArray(OpcodeCount, this->opcodeCounts);
+            this->opcodeCounts = nullptr;
+        }
+        if (this->sampledCounts != nullptr)
+        {
+            HeapDeleteArray(OpcodeCount, this->sampledCounts);
+            this->sampledCounts = nullptr;
+        }
+        if (this->sampledCycles != nullptr)
+        {
+            HeapDeleteArray(OpcodeCount, this->sampledCycles);
+            this->sampledCycles = nullptr;
+        }
+        FreePairCounts();
+    }
+
+    void InterpreterOpcodeProfile::FreePairCounts()
+    {
+        if (this->pairCounts != nullptr)
+        {
+            HeapDeleteArray(OpcodeCount * OpcodeCount, this->pairCounts);
+            this->pairCounts = nullptr;
+        }
+    }
+
+    bool InterpreterOpcodeProfile::Start(bool countPairs, uint timingSampleInterval)
+    {
+        this->enabled = false;
+
+        if (this->opcodeCounts == nullptr)
+        {
+            this->opcodeCounts = HeapNewNoThrowArrayZ(uint64, OpcodeCount);
+            this->sampledCounts = HeapNewNoThrowArrayZ(uint64, OpcodeCount);
+            this->sampledCycles = HeapNewNoThrowArrayZ(uint64, OpcodeCount);
+            if (this->opcodeCounts == nullptr || this->sampledCounts == nullptr || this->sampledCycles == nullptr)
+            {
+                FreeCounters();
+                return false;
+            }
+        }
+        else
+        {
+            memset(this->opcodeCounts, 0, OpcodeCount * sizeof(uint64));
+            memset(this->sampledCounts, 0, OpcodeCount * sizeof(uint64));
+            memset(this->sampledCycles, 0, OpcodeCount * sizeof(uint64));
+        }
+
+        // The pair table is the bulk of the profile (OpcodeCount squared counters), so only keep it while asked for
+        if (!countPairs)
+        {
+            FreePairCounts();
+        }
+        else if (this->pairCounts == nullptr)
+        {
+            this->pairCounts = HeapNewNoThrowArrayZ(uint64, OpcodeCount * OpcodeCount);
+            if (this->pairCounts == nullptr)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            memset(this->pairCounts, 0, OpcodeCount * OpcodeCount * sizeof(uint64));
+        }
+
+        // Function bodies keep pointing at their entries, so reset them in place rather than freeing them
+        for (InterpreterOpcodeProfileEntry * entry = this->entries; entry != nullptr; entry = entry->next)
+        {
+            entry->count = 0;
+            entry->sampledCount = 0;
+            entry->sampledCycles = 0;
+        }
+
+        this->timingSampleInterval = timingSampleInterval;
+        this->timingSampleCountdown = timingSampleInterval;
+        this->enabled = true;
+        return true;
+    }
+
+    InterpreterOpcodeProfileEntry * InterpreterOpcodeProfile::EnsureEntry(FunctionBody * functionBody)
+    {
+        InterpreterOpcodeProfileEntry * entry = functionBody->interpreterOpcodeProfileEntry;
+        if (entry != nullptr)
+        {
+            return entry;
+        }
+
+        // Called on every interpreted call while profiling, so never throw: a function we can't
+        // allocate an entry for simply goes unprofiled.
+        if (this->entryCount < MaxFunctionEntries)
+        {
+            entry = AddEntry(functionBody->GetExternalDisplayName(), functionBody->GetLineNumber(), functionBody->GetColumnNumber());
+            if (entry != nullptr)
+            {
+                this->entryCount++;
+            }
+        }
+        else
+        {
+            if (this->otherFunctionsEntry == nullptr)
+            {
+                this->otherFunctionsEntry = AddEntry(_u("(other)"), 0, 0);
+            }
+            entry = this->otherFunctionsEntry;
+        }
+
+        functionBody->interpreterOpcodeProfileEntry = entry;
+        return entry;
+    }
+
+    InterpreterOpcodeProfileEntry * InterpreterOpcodeProfile::AddEntry(const char16 * functionName, ULONG line, ULONG column)
+    {
+        InterpreterOpcodeProfileEntry * entry = HeapNewNoThrowStructZ(InterpreterOpcodeProfileEntry);
+        if (entry == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (functionName != nullptr)
+        {
+            size_t length = wcslen(functionName);
+            entry->functionName = HeapNewNoThrowArray(char16, length + 1);
+            if (entry->functionName != nullptr)
+            {
+                js_wmemcpy_s(entry->functionName, length + 1, functionName, length + 1);
+            }
+        }
+        entry->line = line;
+        entry->column = column;
+
+        entry->next = this->entries;
+        this->entries = entry;
+        return entry;
+    }
+}
+#endif
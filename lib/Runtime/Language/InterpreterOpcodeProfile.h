@@ -0,0 +1,167 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+namespace Js
+{
+    // Opcode counts for one function. Entries belong to the InterpreterOpcodeProfile and are kept until the
+    // thread context goes away, so results stay readable after the function body itself has been collected.
+    // Function bodies point at their entry, so entries are never freed earlier; their number is capped instead.
+    struct InterpreterOpcodeProfileEntry
+    {
+        char16 * functionName;
+        ULONG line;
+        ULONG column;
+        uint64 count;
+        uint64 sampledCount;
+        uint64 sampledCycles;
+        InterpreterOpcodeProfileEntry * next;
+    };
+
+    // Per-thread interpreter profile: execution counts per opcode, optionally per adjacent opcode pair (within
+    // one frame), and per function, plus an optional timestamp sample of every Nth handler. Only compiled in with
+    // ENABLE_INTERPRETER_OPCODE_PROFILE (build.sh --interpreter-profile) and driven by JsDiagStartInterpreterProfile.
+    class InterpreterOpcodeProfile
+    {
+    public:
+        static const uint OpcodeCount = (uint)OpCode::ByteCodeLast;
+        static const uint NoOpcode = OpcodeCount;
+
+        // Functions beyond this many share one "(other)" entry, which bounds the memory a long profile can use
+        static const uint MaxFunctionEntries = 4096;
+
+        InterpreterOpcodeProfile();
+        ~InterpreterOpcodeProfile();
+
+        // Clears previous results and starts counting. The OpcodeCount x OpcodeCount pair table is only allocated
+        // with countPairs. A non-zero timingSampleInterval also times one in every timingSampleInterval handlers;
+        // the time runs until the next opcode of the same frame, so it includes callees.
+        bool Start(bool countPairs, uint timingSampleInterval);
+        void Stop() { this->enabled = false; }
+        bool IsEnabled() const { return this->enabled; }
+        uint GetTimingSampleInterval() const { return this->timingSampleInterval; }
+
+        InterpreterOpcodeProfileEntry * EnsureEntry(FunctionBody * functionBody);
+
+        void Record(InterpreterOpcodeProfileEntry * entry, uint previousOp, uint op)
+        {
+            Assert(op < OpcodeCount);
+            this->opcodeCounts[op]++;
+            if (previousOp != NoOpcode && this->pairCounts != nullptr)
+            {
+                Assert(previousOp < OpcodeCount);
+                this->pairCounts[previousOp * OpcodeCount + op]++;
+            }
+            entry->count++;
+        }
+
+        bool ShouldSampleTime()
+        {
+            if (this->timingSampleInterval == 0 || --this->timingSampleCountdown != 0)
+            {
+                return false;
+            }
+            this->timingSampleCountdown = this->timingSampleInterval;
+            return true;
+        }
+
+        void RecordTime(InterpreterOpcodeProfileEntry * entry, uint op, uint64 cycles)
+        {
+            Assert(op < OpcodeCount);
+            this->sampledCounts[op]++;
+            this->sampledCycles[op] += cycles;
+            entry->sampledCount++;
+            entry->sampledCycles += cycles;
+        }
+
+        static uint64 GetTimestamp()
+        {
+#if defined(_M_IX86) || defined(_M_X64)
+#ifdef _MSC_VER
+            return __rdtsc();
+#else
+            return __builtin_ia32_rdtsc();
+#endif
+#else
+            LARGE_INTEGER timestamp;
+            QueryPerformanceCounter(&timestamp);
+            return timestamp.QuadPart;
+#endif
+        }
+
+        // fn(OpCode op, uint64 count, uint64 sampledCount, uint64 sampledCycles) for each executed opcode
+        template <class Fn>
+        void MapOpcodes(Fn fn) const
+        {
+            if (this->opcodeCounts == nullptr)
+            {
+                return;
+            }
+            for (uint op = 0; op < OpcodeCount; op++)
+            {
+                if (this->opcodeCounts[op] != 0)
+                {
+                    fn((OpCode)op, this->opcodeCounts[op], this->sampledCounts[op], this->sampledCycles[op]);
+                }
+            }
+        }
+
+        // fn(OpCode first, OpCode second, uint64 count) for each opcode pair seen
+        template <class Fn>
+        void MapPairs(Fn fn) const
+        {
+            if (this->pairCounts == nullptr)
+            {
+                return;
+            }
+            for (uint first = 0; first < OpcodeCount; first++)
+            {
+                if (this->opcodeCounts[first] == 0)
+                {
+                    continue;
+                }
+                const uint64 * row = &this->pairCounts[first * OpcodeCount];
+                for (uint second = 0; second < OpcodeCount; second++)
+                {
+                    if (row[second] != 0)
+                    {
+                        fn((OpCode)first, (OpCode)second, row[second]);
+                    }
+                }
+            }
+        }
+
+        // fn(const InterpreterOpcodeProfileEntry * entry) for each function that executed since Start
+        template <class Fn>
+        void MapFunctions(Fn fn) const
+        {
+            for (const InterpreterOpcodeProfileEntry * entry = this->entries; entry != nullptr; entry = entry->next)
+            {
+                if (entry->count != 0)
+                {
+                    fn(entry);
+                }
+            }
+        }
+
+    private:
+        void FreeCounters();
+        void FreePairCounts();
+        InterpreterOpcodeProfileEntry * AddEntry(const char16 * functionName, ULONG line, ULONG column);
+
+        uint64 * opcodeCounts;
+        uint64 * sampledCounts;
+        uint64 * sampledCycles;
+        uint64 * pairCounts;        // OpcodeCount x OpcodeCount, indexed [first][second]; null unless pairs are counted
+        InterpreterOpcodeProfileEntry * entries;
+        InterpreterOpcodeProfileEntry * otherFunctionsEntry;
+        uint entryCount;
+        uint timingSampleInterval;
+        uint timingSampleCountdown;
+        bool enabled;
+    };
+}
+#endif
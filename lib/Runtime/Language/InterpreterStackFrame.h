@@ -129,6 +129,14 @@ namespace Js
 #if DBG || DBG_DUMP
         void * DEBUG_currentByteOffset;
 #endif
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+        InterpreterOpcodeProfile * opcodeProfile;       // Thread's opcode profile, null when this frame isn't profiled
+        InterpreterOpcodeProfileEntry * opcodeProfileEntry;
+        uint opcodeProfilePreviousOp;                   // Full opcode last executed in this frame
+        uint opcodeProfileExtendedBase;                 // 0x100 after an extended opcode prefix
+        uint opcodeProfileSampledOp;                    // Opcode being timed, or InterpreterOpcodeProfile::NoOpcode
+        uint64 opcodeProfileSampleStart;
+#endif
 
         // Asm.js stack pointer
         int* m_localIntSlots;
@@ -306,6 +314,12 @@ namespace Js
 #endif
                            );
 
+#if ENABLE_INTERPRETER_OPCODE_PROFILE
+        void InitializeOpcodeProfile();
+        void RecordOpcodeProfile(OpCode op);
+        void EndOpcodeProfileSample();
+#endif
+
         void* __cdecl operator new(size_t byteSize, void* previousAllocation) throw();
         void __cdecl operator delete(void* allocationToFree, void* previousAllocation) throw();
 
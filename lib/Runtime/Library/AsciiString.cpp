@@ -0,0 +1,85 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeLibraryPch.h"
+
+namespace Js
+{
+#ifndef IsJsDiag
+    AsciiString::AsciiString(const char * asciiBuffer, charcount_t length, ScriptContext * scriptContext) :
+        JavascriptString(scriptContext->GetLibrary()->GetStringTypeStatic(), length, nullptr),
+        asciiBuffer(asciiBuffer)
+    {
+    }
+
+    JavascriptString* AsciiString::New(__in_ecount(length) const char * content, charcount_t length, ScriptContext * scriptContext)
+    {
+        if (length == 0)
+        {
+            return scriptContext->GetLibrary()->GetEmptyString();
+        }
+
+        if (length == 1)
+        {
+            Assert((unsigned char)content[0] < 0x80);
+            return scriptContext->GetLibrary()->GetCharStringCache().GetStringForCharA(content[0]);
+        }
+
+        if (!IsValidCharCount(length))
+        {
+            Js::Throw::OutOfMemory();
+        }
+
+        Recycler* recycler = scriptContext->GetRecycler();
+        char * buffer = RecyclerNewArrayLeaf(recycler, char, length);
+        js_memcpy_s(buffer, length, content, length);
+        return RecyclerNew(recycler, AsciiString, buffer, length, scriptContext);
+    }
+
+    const char16* AsciiString::GetSz()
+    {
+        Assert(!this->IsFinalized());
+        Assert(this->asciiBuffer != nullptr);
+
+        charcount_t length = this->GetLength();
+        char16* buffer = RecyclerNewArrayLeaf(this->GetRecycler(), char16, length + /*terminating null*/1);
+        Widen(buffer, this->asciiBuffer, length);
+        buffer[length] = _u('\0');
+
+        this->SetBuffer(buffer);
+        this->asciiBuffer = nullptr; // Let the bytes go
+        VirtualTableInfo<LiteralString>::SetVirtualTable(this); // This will ensure GetSz does not get invoked again.
+        return buffer;
+    }
+
+    void AsciiString::CopyVirtual(
+        _Out_writes_(m_charLength) char16 *const buffer,
+        StringCopyInfoStack &nestedStringTreeCopyInfos,
+        const byte recursionDepth)
+    {
+        // Widen straight into the destination (e.g. a concatenation) without flattening this string
+        Assert(buffer);
+        Assert(!this->IsFinalized());
+        Widen(buffer, this->asciiBuffer, this->GetLength());
+    }
+
+    void AsciiString::Widen(__out_ecount(length) char16 * buffer, __in_ecount(length) const char * ascii, charcount_t length)
+    {
+        for (charcount_t i = 0; i < length; i++)
+        {
+            Assert((unsigned char)ascii[i] < 0x80);
+            buffer[i] = (char16)ascii[i];
+        }
+    }
+
+    size_t AsciiString::GetAllocatedByteCount() const
+    {
+        if (this->asciiBuffer != nullptr)
+        {
+            return this->GetLength();
+        }
+        return __super::GetAllocatedByteCount();
+    }
+#endif
+}
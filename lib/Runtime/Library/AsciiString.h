@@ -0,0 +1,34 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Js
+{
+    // A string that still holds the 7-bit ASCII bytes it was created from, e.g. a string value from a
+    // UTF-8 JSON payload. The bytes are only widened to char16 the first time the flat contents are
+    // needed, at which point the string turns into a LiteralString. Strings that only go back to the
+    // host as UTF-8 are never widened at all.
+    class AsciiString sealed : public JavascriptString
+    {
+        AsciiString(const char * asciiBuffer, charcount_t length, ScriptContext * scriptContext);
+
+    protected:
+        DEFINE_VTABLE_CTOR(AsciiString, JavascriptString);
+        DECLARE_CONCRETE_STRING_CLASS;
+
+    public:
+        static JavascriptString* New(__in_ecount(length) const char * content, charcount_t length, ScriptContext * scriptContext);
+        virtual const char16* GetSz() override;
+        virtual void CopyVirtual(_Out_writes_(m_charLength) char16 *const buffer, StringCopyInfoStack &nestedStringTreeCopyInfos, const byte recursionDepth) override;
+        virtual size_t GetAllocatedByteCount() const override;
+
+        const char * GetAsciiBuffer() const { return asciiBuffer; }
+
+    private:
+        static void Widen(__out_ecount(length) char16 * buffer, __in_ecount(length) const char * ascii, charcount_t length);
+
+        const char * asciiBuffer;
+    };
+}
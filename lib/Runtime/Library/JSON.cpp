@@ -60,12 +60,12 @@ namespace JSON
     Js::Var Parse(Js::JavascriptString* input, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext)
     {
         // alignment required because of the union in JSONParser::m_token
-        __declspec (align(8)) JSONParser parser(scriptContext, reviver);
+        __declspec (align(8)) JSONParser<char16> parser(scriptContext, reviver);
         Js::Var result = NULL;
 
         TryFinally([&]()
         {
-            result = parser.Parse(input);
+            result = parser.Parse(input->GetSz(), input->GetLength());
 
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
             if (CONFIG_FLAG(ForceGCAfterJSONParse))
@@ -94,6 +94,24 @@ namespace JSON
         return result;
     }
 
+    Js::Var ParseUtf8(LPCUTF8 input, uint length, Js::ScriptContext* scriptContext)
+    {
+        // alignment required because of the union in JSONParser::m_token
+        __declspec (align(8)) JSONParser<utf8char_t> parser(scriptContext, nullptr);
+        Js::Var result = NULL;
+
+        TryFinally([&]()
+        {
+            result = parser.Parse(input, length);
+        },
+        [&](bool/*hasException*/)
+        {
+            parser.Finalizer();
+        });
+
+        return result;
+    }
+
     inline bool IsValidReplacerType(Js::TypeId typeId)
     {
         switch(typeId)
@@ -152,6 +170,148 @@ namespace JSON
         return Anew(tempAlloc, BVSparse<ArenaAllocator>, tempAlloc);
     }
 
+    // Growable char16 output of JSON.stringify. The buffer is recycler memory that becomes the buffer of
+    // the result string, so the text is not copied again once it is complete.
+    class StringifyStringWriter
+    {
+    public:
+        StringifyStringWriter(Js::ScriptContext* scriptContext)
+            : scriptContext(scriptContext), buffer(nullptr), length(0), capacity(0)
+        {
+        }
+
+        void Append(char16 ch)
+        {
+            if (length == capacity)
+            {
+                Grow(1);
+            }
+            buffer[length++] = ch;
+        }
+
+        void Append(const char16* chars, charcount_t count)
+        {
+            if (count > capacity - length)
+            {
+                Grow(count);
+            }
+            js_wmemcpy_s(buffer + length, capacity - length, chars, count);
+            length += count;
+        }
+
+        Js::JavascriptString* ToString()
+        {
+            if (length == 0)
+            {
+                return scriptContext->GetLibrary()->GetEmptyString();
+            }
+
+            // capacity doesn't count the slot reserved for the terminating null
+            buffer[length] = _u('\0');
+            return Js::JavascriptString::NewWithBuffer(buffer, length, scriptContext);
+        }
+
+    private:
+        void Grow(charcount_t count)
+        {
+            const charcount_t initialCapacity = 256;
+            charcount_t requiredCapacity = UInt32Math::Add(length, count);
+            if (requiredCapacity > Js::JavascriptString::MaxCharLength)
+            {
+                Js::Throw::OutOfMemory();
+            }
+
+            charcount_t newCapacity = max(max(requiredCapacity, initialCapacity), min(capacity * 2, Js::JavascriptString::MaxCharLength));
+            char16* newBuffer = RecyclerNewArrayLeaf(scriptContext->GetRecycler(), char16, newCapacity + 1);
+            if (length != 0)
+            {
+                js_wmemcpy_s(newBuffer, newCapacity, buffer, length);
+            }
+            buffer = newBuffer;
+            capacity = newCapacity;
+        }
+
+        Js::ScriptContext* scriptContext;
+        char16* buffer;
+        charcount_t length;
+        charcount_t capacity;
+    };
+
+    // Growable UTF-8 output for hosts. The text is transcoded as it is appended, and the buffer is handed
+    // over to the host, which frees it with JsStringFree (so it comes from malloc).
+    class StringifyUtf8Writer
+    {
+    public:
+        StringifyUtf8Writer() : buffer(nullptr), length(0), capacity(0)
+        {
+        }
+
+        ~StringifyUtf8Writer()
+        {
+            free(buffer);
+        }
+
+        void Append(char16 ch)
+        {
+            if (ch < 0x80 && length < capacity)
+            {
+                buffer[length++] = (utf8char_t)ch;
+                return;
+            }
+            Append(&ch, 1);
+        }
+
+        void Append(const char16* chars, charcount_t count)
+        {
+            // Each char16 encodes to at most 3 bytes
+            size_t maxBytes = (size_t)count * 3;
+            if (maxBytes > capacity - length)
+            {
+                Grow(maxBytes);
+            }
+            length += utf8::EncodeInto(buffer + length, chars, count);
+        }
+
+        char* Detach(size_t* outLength)
+        {
+            if (length == capacity)
+            {
+                Grow(1);
+            }
+            buffer[length] = 0;
+
+            char* result = reinterpret_cast<char*>(buffer);
+            *outLength = length;
+            buffer = nullptr;
+            length = capacity = 0;
+            return result;
+        }
+
+    private:
+        void Grow(size_t count)
+        {
+            const size_t initialCapacity = 1024;
+            if (count > SIZE_MAX / 2 - length)
+            {
+                Js::Throw::OutOfMemory();
+            }
+
+            size_t newCapacity = max(max(length + count, initialCapacity), capacity * 2);
+            // keep a byte for the terminating null
+            utf8char_t* newBuffer = static_cast<utf8char_t*>(realloc(buffer, newCapacity + 1));
+            if (newBuffer == nullptr)
+            {
+                Js::Throw::OutOfMemory();
+            }
+            buffer = newBuffer;
+            capacity = newCapacity;
+        }
+
+        utf8char_t* buffer;
+        size_t length;
+        size_t capacity;
+    };
+
     Js::Var Stringify(Js::RecyclableObject* function, Js::CallInfo callInfo, ...)
     {
         PROBE_STACK(function->GetScriptContext(), Js::Constants::MinStackDefault);
@@ -320,13 +480,17 @@ namespace JSON
         {
             stringifySession.CompleteInit(space, tempAlloc);
 
-            Js::DynamicObject* wrapper = scriptContext->GetLibrary()->CreateObject();
-            JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(wrapper));
-            Js::PropertyRecord const * propertyRecord;
-            scriptContext->GetOrAddPropertyRecord(_u(""), 0, &propertyRecord);
-            Js::PropertyId propertyId = propertyRecord->GetPropertyId();
-            Js::JavascriptOperators::InitProperty(wrapper, propertyId, value);
-            result = stringifySession.Str(scriptContext->GetLibrary()->GetEmptyString(), propertyId, wrapper);
+            Js::Var rootValue = stringifySession.GetSerializableRootValue(value);
+            if (rootValue == nullptr)
+            {
+                result = library->GetUndefined();
+            }
+            else
+            {
+                StringifyStringWriter writer(scriptContext);
+                stringifySession.WriteValue(writer, rootValue);
+                result = writer.ToString();
+            }
         }
         END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
 
@@ -334,6 +498,29 @@ namespace JSON
         return result;
     }
 
+    char* StringifyUtf8(Js::Var value, Js::ScriptContext* scriptContext, size_t* length)
+    {
+        char* result = nullptr;
+        *length = 0;
+
+        StringifySession stringifySession(scriptContext);
+        BEGIN_TEMP_ALLOCATOR(tempAlloc, scriptContext, _u("JSON"))
+        {
+            stringifySession.CompleteInit(scriptContext->GetLibrary()->GetNull(), tempAlloc);
+
+            Js::Var rootValue = stringifySession.GetSerializableRootValue(value);
+            if (rootValue != nullptr)
+            {
+                StringifyUtf8Writer writer;
+                stringifySession.WriteValue(writer, rootValue);
+                result = writer.Detach(length);
+            }
+        }
+        END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
+
+        return result;
+    }
+
     // -------- StringifySession implementation ------------//
 
     void StringifySession::CompleteInit(Js::Var space, ArenaAllocator* tempAlloc)
@@ -388,7 +575,19 @@ namespace JSON
         objectStack = Anew(tempAlloc, JSONStack, tempAlloc, scriptContext);
     }
 
-    Js::Var StringifySession::Str(uint32 index, Js::Var holder)
+    Js::Var StringifySession::GetSerializableRootValue(Js::Var value)
+    {
+        // The value is serialized as the "" property of a wrapper object
+        Js::DynamicObject* wrapper = scriptContext->GetLibrary()->CreateObject();
+        JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(wrapper));
+        Js::PropertyRecord const * propertyRecord;
+        scriptContext->GetOrAddPropertyRecord(_u(""), 0, &propertyRecord);
+        Js::PropertyId propertyId = propertyRecord->GetPropertyId();
+        Js::JavascriptOperators::InitProperty(wrapper, propertyId, value);
+        return GetSerializableValue(scriptContext->GetLibrary()->GetEmptyString(), propertyId, wrapper);
+    }
+
+    Js::Var StringifySession::GetSerializableValue(uint32 index, Js::Var holder)
     {
         Js::Var value;
         Js::RecyclableObject *undefined = scriptContext->GetLibrary()->GetUndefined();
@@ -397,7 +596,7 @@ namespace JSON
         {
             if (Js::JavascriptOperators::IsUndefinedObject(value = Js::JavascriptArray::FromVar(holder)->DirectGetItem(index), undefined))
             {
-                return value;
+                return nullptr;
             }
         }
         else
@@ -406,19 +605,19 @@ namespace JSON
             Js::RecyclableObject *arr = RecyclableObject::FromVar(holder);
             if (!Js::JavascriptOperators::GetItem(arr, index, &value, scriptContext))
             {
-                return undefined;
+                return nullptr;
             }
             if (Js::JavascriptOperators::IsUndefinedObject(value, undefined))
             {
-                return value;
+                return nullptr;
             }
         }
 
-        Js::JavascriptString *key = scriptContext->GetIntegerString(index);
-        return StrHelper(key, value, holder);
+        // The key string is only needed by toJSON and the replacer function, it is created on demand
+        return GetSerializableValueHelper(nullptr, index, value, holder);
     }
 
-    Js::Var StringifySession::Str(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder)
+    Js::Var StringifySession::GetSerializableValue(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder)
     {
         Js::Var value;
         // We should look only into object's own properties here. When an object is serialized, only the own properties are considered,
@@ -429,19 +628,18 @@ namespace JSON
 
         if(!Js::JavascriptOperators::GetProperty(Js::RecyclableObject::FromVar(holder),keyId, &value, scriptContext))
         {
-            return scriptContext->GetLibrary()->GetUndefined();
+            return nullptr;
         }
-        return StrHelper(key, value, holder);
+        return GetSerializableValueHelper(key, Js::JavascriptArray::InvalidIndex, value, holder);
     }
 
-    Js::Var StringifySession::StrHelper(Js::JavascriptString* key, Js::Var value, Js::Var holder)
+    Js::Var StringifySession::GetSerializableValueHelper(Js::JavascriptString* key, uint32 index, Js::Var value, Js::Var holder)
     {
         PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
         AssertMsg(Js::RecyclableObject::Is(holder), "The holder argument in a JSON::Str function must be an object");
 
         Js::Var values[3];
         Js::Arguments args(0, values);
-        Js::Var undefined = scriptContext->GetLibrary()->GetUndefined();
 
         //check and apply 'toJSON' filter
         if (Js::JavascriptOperators::IsJsNativeObject(value) || (Js::JavascriptOperators::IsObject(value)))
@@ -450,6 +648,10 @@ namespace JSON
             if (Js::JavascriptOperators::GetProperty(Js::RecyclableObject::FromVar(value), Js::PropertyIds::toJSON, &tojson, scriptContext) &&
                 Js::JavascriptConversion::IsCallable(tojson))
             {
+                if (key == nullptr)
+                {
+                    key = scriptContext->GetIntegerString(index);
+                }
                 args.Info.Count = 2;
                 args.Values[0] = value;
                 args.Values[1] = key;
@@ -462,6 +664,10 @@ namespace JSON
         //check and apply the user defined replacer filter
         if (ReplacerFunction == replacerType)
         {
+            if (key == nullptr)
+            {
+                key = scriptContext->GetIntegerString(index);
+            }
             args.Info.Count = 3;
             args.Values[0] = holder;
             args.Values[1] = key;
@@ -490,112 +696,165 @@ namespace JSON
         {
         case Js::TypeIds_Undefined:
         case Js::TypeIds_Symbol:
-            return undefined;
+            return nullptr;
+
+        case Js::TypeIds_Null:
+        case Js::TypeIds_Integer:
+        case Js::TypeIds_Boolean:
+        case Js::TypeIds_Int64Number:
+        case Js::TypeIds_UInt64Number:
+        case Js::TypeIds_Number:
+        case Js::TypeIds_String:
+            return value;
 
+        default:
+            if (Js::JavascriptOperators::IsJsNativeObject(value))
+            {
+                return Js::JavascriptConversion::IsCallable(value) ? nullptr : value;
+            }
+            //every object which is not a native object gets stringified as an object
+            return Js::JavascriptOperators::IsObject(value) ? value : nullptr;
+        }
+    }
+
+    template <class TWriter>
+    void StringifySession::WriteValue(TWriter& writer, Js::Var value)
+    {
+        switch (Js::JavascriptOperators::GetTypeId(value))
+        {
         case Js::TypeIds_Null:
-            return scriptContext->GetLibrary()->GetNullDisplayString();
+            writer.Append(_u("null"), 4);
+            break;
 
         case Js::TypeIds_Integer:
-            return scriptContext->GetIntegerString(value);
+            {
+                char16 buffer[20];
+                Js::TaggedInt::ToBuffer(value, buffer, _countof(buffer));
+                writer.Append(buffer, (charcount_t)wcslen(buffer));
+                break;
+            }
 
         case Js::TypeIds_Boolean:
-            return (Js::JavascriptBoolean::FromVar(value)->GetValue()) ? scriptContext->GetLibrary()->GetTrueDisplayString() : scriptContext->GetLibrary()->GetFalseDisplayString();
+            if (Js::JavascriptBoolean::FromVar(value)->GetValue())
+            {
+                writer.Append(_u("true"), 4);
+            }
+            else
+            {
+                writer.Append(_u("false"), 5);
+            }
+            break;
 
         case Js::TypeIds_Int64Number:
             if (Js::NumberUtilities::IsFinite(static_cast<double>(Js::JavascriptInt64Number::FromVar(value)->GetValue())))
             {
-                return Js::JavascriptConversion::ToString(value, scriptContext);
+                WriteString(writer, Js::JavascriptConversion::ToString(value, scriptContext));
             }
             else
             {
-                return scriptContext->GetLibrary()->GetNullDisplayString();
+                writer.Append(_u("null"), 4);
             }
+            break;
 
         case Js::TypeIds_UInt64Number:
             if (Js::NumberUtilities::IsFinite(static_cast<double>(Js::JavascriptUInt64Number::FromVar(value)->GetValue())))
             {
-                return Js::JavascriptConversion::ToString(value, scriptContext);
+                WriteString(writer, Js::JavascriptConversion::ToString(value, scriptContext));
             }
             else
             {
-                return scriptContext->GetLibrary()->GetNullDisplayString();
+                writer.Append(_u("null"), 4);
             }
+            break;
 
         case Js::TypeIds_Number:
-            if (Js::NumberUtilities::IsFinite(Js::JavascriptNumber::GetValue(value)))
-            {
-                return Js::JavascriptConversion::ToString(value, scriptContext);
-            }
-            else
             {
-                return scriptContext->GetLibrary()->GetNullDisplayString();
+                double dbl = Js::JavascriptNumber::GetValue(value);
+                if (!Js::NumberUtilities::IsFinite(dbl))
+                {
+                    writer.Append(_u("null"), 4);
+                }
+                else if (dbl == 0)
+                {
+                    // -0 is serialized as 0
+                    writer.Append(_u('0'));
+                }
+                else
+                {
+                    char16 buffer[256];
+                    if (!Js::NumberUtilities::FNonZeroFiniteDblToStr(dbl, buffer, _countof(buffer)))
+                    {
+                        Js::JavascriptError::ThrowOutOfMemoryError(scriptContext);
+                    }
+                    writer.Append(buffer, (charcount_t)wcslen(buffer));
+                }
+                break;
             }
 
         case Js::TypeIds_String:
-            return Quote(Js::JavascriptString::FromVar(value));
+            {
+                Js::JavascriptString* string = Js::JavascriptString::FromVar(value);
+                Js::JSONString::WriteEscaped(writer, string->GetString(), string->GetLength());
+                break;
+            }
 
         default:
-            Js::Var ret = undefined;
-            if(Js::JavascriptOperators::IsJsNativeObject(value))
+            if (Js::JavascriptOperators::IsJsNativeObject(value))
             {
-                if (!Js::JavascriptConversion::IsCallable(value))
+                Assert(!Js::JavascriptConversion::IsCallable(value));
+                if (objectStack->Has(value))
                 {
-                    if (objectStack->Has(value))
-                    {
-                        Js::JavascriptError::ThrowTypeError(scriptContext, JSERR_JSONSerializeCircular);
-                    }
-                    objectStack->Push(value);
+                    Js::JavascriptError::ThrowTypeError(scriptContext, JSERR_JSONSerializeCircular);
+                }
+                objectStack->Push(value);
 
-                    if(Js::JavascriptOperators::IsArray(value))
-                    {
-                        ret = StringifyArray(value);
-                    }
-                    else
-                    {
-                        ret = StringifyObject(value);
-                    }
-                    objectStack->Pop();
+                if (Js::JavascriptOperators::IsArray(value))
+                {
+                    WriteArray(writer, value);
                 }
+                else
+                {
+                    WriteObject(writer, value);
+                }
+                objectStack->Pop();
             }
-            else if (Js::JavascriptOperators::IsObject(value)) //every object which is not a native object gets stringified here
+            else
             {
+                Assert(Js::JavascriptOperators::IsObject(value));
                 if (objectStack->Has(value, false))
                 {
                     Js::JavascriptError::ThrowTypeError(scriptContext, JSERR_JSONSerializeCircular);
                 }
                 objectStack->Push(value, false);
-                ret = StringifyObject(value);
+                WriteObject(writer, value);
                 objectStack->Pop(false);
             }
-            return ret;
+            break;
         }
     }
 
-    Js::Var StringifySession::StringifyObject(Js::Var value)
+    template <class TWriter>
+    void StringifySession::WriteObject(TWriter& writer, Js::Var value)
     {
         Js::JavascriptString* propertyName;
         Js::PropertyId id;
         Js::PropertyRecord const * propRecord;
 
         bool isFirstMember = true;
-        bool isEmpty = true;
 
         uint stepBackIndent = this->indent++;
-        Js::JavascriptString* memberSeparator = NULL;       // comma  or comma+linefeed+indent
-        Js::JavascriptString* indentString = NULL;          // gap*indent
         Js::RecyclableObject* object = Js::RecyclableObject::FromVar(value);
-        Js::JavascriptString* result = NULL;
+
+        writer.Append(_u('{'));
 
         if(ReplacerArray == this->replacerType)
         {
-            result = Js::ConcatStringBuilder::New(this->scriptContext, this->replacer.propertyList.length); // Reserve initial slots for properties.
-
             for (uint k = 0; k < this->replacer.propertyList.length;  k++)
             {
                 propertyName = replacer.propertyList.propertyNames[k].propName;
                 id = replacer.propertyList.propertyNames[k].propRecord->GetPropertyId();
 
-                StringifyMemberObject(propertyName, id, value, (Js::ConcatStringBuilder*)result, indentString, memberSeparator, isFirstMember,  isEmpty);
+                WriteMember(writer, propertyName, id, value, isFirstMember);
             }
         }
         else
@@ -607,7 +866,6 @@ namespace JSON
 
                 // filter enumerable keys
                 uint32 resultLength = proxyResult->GetLength();
-                result = Js::ConcatStringBuilder::New(this->scriptContext, resultLength);    // Reserve initial slots for properties.
                 Var element;
                 for (uint32 i = 0; i < resultLength; i++)
                 {
@@ -623,29 +881,19 @@ namespace JSON
                     {
                         if (propertyDescriptor.IsEnumerable())
                         {
-                            StringifyMemberObject(propertyName, id, value, (Js::ConcatStringBuilder*)result, indentString, memberSeparator, isFirstMember, isEmpty);
+                            WriteMember(writer, propertyName, id, value, isFirstMember);
                         }
                     }
                 }
             }
             else
             {
-                uint32 precisePropertyCount = 0;
                 Js::Var enumeratorVar;
                 if (object->GetEnumerator(FALSE, &enumeratorVar, scriptContext, true, false))
                 {
                     Js::JavascriptEnumerator* enumerator = static_cast<Js::JavascriptEnumerator*>(enumeratorVar);
                     Js::RecyclableObject *undefined = scriptContext->GetLibrary()->GetUndefined();
 
-                    bool isPrecise;
-                    uint32 propertyCount = GetPropertyCount(object, enumerator, &isPrecise);
-                    if (isPrecise)
-                    {
-                        precisePropertyCount = propertyCount;
-                    }
-
-                    result = Js::ConcatStringBuilder::New(this->scriptContext, propertyCount);    // Reserve initial slots for properties.
-
                     if (ReplacerFunction != replacerType)
                     {
                         Js::Var propertyNameVar;
@@ -661,7 +909,7 @@ namespace JSON
                                     scriptContext->GetOrAddPropertyRecord(propertyName->GetString(), propertyName->GetLength(), &propRecord);
                                     id = propRecord->GetPropertyId();
                                 }
-                                StringifyMemberObject(propertyName, id, value, (Js::ConcatStringBuilder*)result, indentString, memberSeparator, isFirstMember, isEmpty);
+                                WriteMember(writer, propertyName, id, value, isFirstMember);
                             }
                         }
                     }
@@ -670,10 +918,7 @@ namespace JSON
                         Js::Var* nameTable = nullptr;
                         // ES5 requires that the new properties introduced by the replacer to not be stringified
                         // Get the actual count first.
-                        if (precisePropertyCount == 0)  // Check if it was updated in earlier step.
-                        {
-                            precisePropertyCount = this->GetPropertyCount(object, enumerator);
-                        }
+                        uint32 precisePropertyCount = this->GetPropertyCount(object, enumerator);
 
                         // pick the property names before walking the object
                         DECLARE_TEMP_GUEST_ALLOCATOR(nameTableAlloc);
@@ -714,7 +959,7 @@ namespace JSON
                                 propertyName = Js::JavascriptString::FromVar(nameTable[k]);
                                 scriptContext->GetOrAddPropertyRecord(propertyName->GetString(), propertyName->GetLength(), &propRecord);
                                 id = propRecord->GetPropertyId();
-                                StringifyMemberObject(propertyName, id, value, (Js::ConcatStringBuilder*)result, indentString, memberSeparator, isFirstMember, isEmpty);
+                                WriteMember(writer, propertyName, id, value, isFirstMember);
                             }
                         }
                         RELEASE_TEMP_GUEST_ALLOCATOR(nameTableAlloc, scriptContext);
@@ -722,58 +967,20 @@ namespace JSON
                 }
             }
         }
-        Assert(isEmpty || result);
 
-        if(isEmpty)
+        if(!isFirstMember && this->gap)
         {
-            result = scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("{}"));
-        }
-        else
-        {
-            if(this->gap)
-            {
-                if(!indentString)
-                {
-                    indentString = GetIndentString(this->indent);
-                }
-                // Note: it's better to use strings with length = 1 as the are cached/new instances are not created every time.
-                Js::ConcatStringN<7>* retVal = Js::ConcatStringN<7>::New(this->scriptContext);
-                retVal->SetItem(0, scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("{")));
-                retVal->SetItem(1, scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("\n")));
-                retVal->SetItem(2, indentString);
-                retVal->SetItem(3, result);
-                retVal->SetItem(4, scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("\n")));
-                retVal->SetItem(5, GetIndentString(stepBackIndent));
-                retVal->SetItem(6, scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("}")));
-                result = retVal;
-            }
-            else
-            {
-                result = Js::ConcatStringWrapping<_u('{'), _u('}')>::New(result);
-            }
+            WriteNewLineAndIndent(writer, stepBackIndent);
         }
+        writer.Append(_u('}'));
 
         this->indent = stepBackIndent;
-        return result;
-    }
-
-    Js::JavascriptString* StringifySession::GetArrayElementString(uint32 index, Js::Var arrayVar)
-    {
-        Js::RecyclableObject *undefined = scriptContext->GetLibrary()->GetUndefined();
-
-        Js::Var arrayElement = Str(index, arrayVar);
-        if (Js::JavascriptOperators::IsUndefinedObject(arrayElement, undefined))
-        {
-            return scriptContext->GetLibrary()->GetNullDisplayString();
-        }
-        return Js::JavascriptString::FromVar(arrayElement);
     }
 
-    Js::Var StringifySession::StringifyArray(Js::Var value)
+    template <class TWriter>
+    void StringifySession::WriteArray(TWriter& writer, Js::Var value)
     {
         uint stepBackIndent = this->indent++;
-        Js::JavascriptString* memberSeparator = NULL;       // comma  or comma+linefeed+indent
-        Js::JavascriptString* indentString = NULL;          // gap*indent
 
         uint32 length;
 
@@ -789,133 +996,87 @@ namespace JSON
             Assert(Js::JavascriptConversion::ToLength(Js::JavascriptOperators::OP_GetLength(value, scriptContext), scriptContext) == length);
         }
 
-        Js::JavascriptString* result;
-        if (length == 0)
-        {
-            result = scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("[]"));
-        }
-        else
+        writer.Append(_u('['));
+        for (uint32 k = 0; k < length; k++)
         {
-            if (length == 1)
+            if (k != 0)
             {
-                result = GetArrayElementString(0, value);
+                writer.Append(_u(','));
             }
-            else
+            if (this->gap)
             {
-                Assert(length > 1);
-                if (!indentString)
-                {
-                    indentString = GetIndentString(this->indent);
-                    memberSeparator = GetMemberSeparator(indentString);
-                }
-                bool isFirstMember = true;
-
-                // Total node count: number of array elements (N = length) + indents [including member separators] (N = length - 1).
-                result = Js::ConcatStringBuilder::New(this->scriptContext, length * 2 - 1);
-                for (uint32 k = 0; k < length; k++)
-                {
-                    if (!isFirstMember)
-                    {
-                        ((Js::ConcatStringBuilder*)result)->Append(memberSeparator);
-                    }
-                    Js::JavascriptString* arrayElementString = GetArrayElementString(k, value);
-                    ((Js::ConcatStringBuilder*)result)->Append(arrayElementString);
-                    isFirstMember = false;
-                }
+                WriteNewLineAndIndent(writer, this->indent);
             }
 
-            if (this->gap)
+            Js::Var element = GetSerializableValue(k, value);
+            if (element == nullptr)
             {
-                if (!indentString)
-                {
-                    indentString = GetIndentString(this->indent);
-                }
-                Js::ConcatStringN<6>* retVal = Js::ConcatStringN<6>::New(this->scriptContext);
-                retVal->SetItem(0, scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("[\n")));
-                retVal->SetItem(1, indentString);
-                retVal->SetItem(2, result);
-                retVal->SetItem(3, scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("\n")));
-                retVal->SetItem(4, GetIndentString(stepBackIndent));
-                retVal->SetItem(5, scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u("]")));
-                result = retVal;
+                writer.Append(_u("null"), 4);
             }
             else
             {
-                result = Js::ConcatStringWrapping<_u('['), _u(']')>::New(result);
+                WriteValue(writer, element);
             }
         }
+        if (length != 0 && this->gap)
+        {
+            WriteNewLineAndIndent(writer, stepBackIndent);
+        }
+        writer.Append(_u(']'));
 
         this->indent = stepBackIndent;
-        return result;
     }
 
-    Js::JavascriptString* StringifySession::GetPropertySeparator()
+    template <class TWriter>
+    void StringifySession::WriteNewLineAndIndent(TWriter& writer, uint count)
     {
-        if(!propertySeparator)
+        Assert(this->gap);
+        writer.Append(_u('\n'));
+
+        const char16* gapString = this->gap->GetString();
+        charcount_t gapLength = this->gap->GetLength();
+        for (uint i = 0; i < count; i++)
         {
-            if(this->gap)
-            {
-                propertySeparator = scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u(": "));
-            }
-            else
-            {
-                propertySeparator = scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u(":"));
-            }
+            writer.Append(gapString, gapLength);
         }
-        return propertySeparator;
     }
 
-    Js::JavascriptString* StringifySession::GetIndentString(uint count)
+    template <class TWriter>
+    void StringifySession::WriteString(TWriter& writer, Js::JavascriptString* value)
     {
-        // Note: this potentially can be improved by using a special ConcatString which has gap and count fields.
-        //       Although this does not seem to be a critical path (using gap should not be often).
-        Js::JavascriptString* res = scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u(""));
-        if(this->gap)
-        {
-            for (uint i = 0 ; i < count; i++)
-            {
-                res = Js::JavascriptString::Concat(res, this->gap);
-            }
-        }
-        return res;
+        writer.Append(value->GetString(), value->GetLength());
     }
 
-    Js::JavascriptString* StringifySession::GetMemberSeparator(Js::JavascriptString* indentString)
+    template <class TWriter>
+    void StringifySession::WriteMember(TWriter& writer, Js::JavascriptString* propertyName, Js::PropertyId id, Js::Var holder, bool &isFirstMember)
     {
-        if(this->gap)
+        Js::Var value = GetSerializableValue(propertyName, id, holder);
+        if (value == nullptr)
         {
-            return Js::JavascriptString::Concat(scriptContext->GetLibrary()->CreateStringFromCppLiteral(_u(",\n")), indentString);
+            return;
         }
-        else
+
+        if (!isFirstMember)
         {
-            return scriptContext->GetLibrary()->GetCommaDisplayString();
+            writer.Append(_u(','));
         }
-    }
-
-    void StringifySession::StringifyMemberObject( Js::JavascriptString* propertyName, Js::PropertyId id, Js::Var value, Js::ConcatStringBuilder* result, Js::JavascriptString* &indentString, Js::JavascriptString* &memberSeparator, bool &isFirstMember, bool &isEmpty )
-    {
-        Js::Var propertyObjectString = Str(propertyName, id, value);
-        if(!Js::JavascriptOperators::IsUndefinedObject(propertyObjectString, scriptContext))
+        if (this->gap)
         {
-            int slotIndex = 0;
-            Js::ConcatStringN<4>* tempResult = Js::ConcatStringN<4>::New(this->scriptContext);   // We may use 3 or 4 slots.
-            if(!isFirstMember)
-            {
-                if(!indentString)
-                {
-                    indentString = GetIndentString(this->indent);
-                    memberSeparator = GetMemberSeparator(indentString);
-                }
-                tempResult->SetItem(slotIndex++, memberSeparator);
-            }
-            tempResult->SetItem(slotIndex++, Quote(propertyName));
-            tempResult->SetItem(slotIndex++, this->GetPropertySeparator());
-            tempResult->SetItem(slotIndex++, Js::JavascriptString::FromVar(propertyObjectString));
+            WriteNewLineAndIndent(writer, this->indent);
+        }
 
-            result->Append(tempResult);
-            isFirstMember = false;
-            isEmpty = false;
+        Js::JSONString::WriteEscaped(writer, propertyName->GetString(), propertyName->GetLength());
+        if (this->gap)
+        {
+            writer.Append(_u(": "), 2);
+        }
+        else
+        {
+            writer.Append(_u(':'));
         }
+
+        WriteValue(writer, value);
+        isFirstMember = false;
     }
 
     // Returns precise property count for given object and enumerator, does not count properties that are undefined.
@@ -934,40 +1095,4 @@ namespace JSON
         }
         return count;
     }
-
-    // Returns property count (including array items) for given object and enumerator.
-    // When object has objectArray, we do slow path return actual/precise count, in this case *pPrecise will receive true.
-    // Otherwise we optimize for speed and try to guess the count, in this case *pPrecise will receive false.
-    // Parameters:
-    // - object: the object to get the number of properties for.
-    // - enumerator: the enumerator to enumerate the object.
-    // - [out] pIsPrecise: receives a boolean indicating whether the value returned is precise or just guessed.
-    inline uint32 StringifySession::GetPropertyCount(Js::RecyclableObject* object, Js::JavascriptEnumerator* enumerator, bool* pIsPrecise)
-    {
-        Assert(pIsPrecise);
-        *pIsPrecise = false;
-
-        uint32 count = object->GetPropertyCount();
-        if (Js::DynamicObject::Is(object) && Js::DynamicObject::FromVar(object)->HasObjectArray())
-        {
-            // Can't use array->GetLength() as this can be sparse array for which we stringify only real/set properties.
-            // Do one walk through the elements.
-            // This would account for prototype property as well.
-            count = this->GetPropertyCount(object, enumerator);
-            *pIsPrecise = true;
-        }
-        if (!*pIsPrecise && count > sizeof(Js::JavascriptString*) * 8)
-        {
-            // For large # of elements just one more for potential prototype wouldn't matter.
-            ++count;
-        }
-
-        return count;
-    }
-
-    inline Js::JavascriptString* StringifySession::Quote(Js::JavascriptString* value)
-    {
-        // By default, optimize for scenario when we don't need to change the inside of the string. That's majority of cases.
-        return Js::JSONString::Escape<Js::EscapingOperation_NotEscape>(value);
-    }
 } // namespace JSON
@@ -7,7 +7,7 @@
 namespace JSON
 {
     class JSONStack;
-    class JSONParser;
+    template <typename CharType> class JSONParser;
 
     class EntryInfo
     {
@@ -19,6 +19,16 @@ namespace JSON
     Js::Var Stringify(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
     Js::Var Parse(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
 
+    // Parse UTF-8 encoded JSON text without widening it to UTF-16 first (no reviver).
+    Js::Var ParseUtf8(LPCUTF8 input, uint length, Js::ScriptContext* scriptContext);
+
+    // Serialize value as JSON.stringify(value) would, into a malloc'ed UTF-8 buffer the caller frees.
+    // Returns nullptr when the value has no JSON text (undefined, functions and symbols).
+    char* StringifyUtf8(Js::Var value, Js::ScriptContext* scriptContext, size_t* length);
+
+    // Serializes values for JSON.stringify. The JSON text is written as it is produced to a writer,
+    // which provides Append(char16) and Append(const char16*, charcount_t), instead of being
+    // assembled from intermediate strings.
     class StringifySession
     {
     public:
@@ -38,15 +48,12 @@ namespace JSON
             :   scriptContext(sc),
                 replacerType(ReplacerNone),
                 gap(NULL),
-                indent(0),
-                propertySeparator(NULL)
+                indent(0)
         {
             replacer.propertyList.propertyNames = NULL;
             replacer.propertyList.length = 0;
         };
 
-        Js::Var Stringify(){};
-
         // Init operation is split in three functions
         void InitReplacer(Js::RecyclableObject* f)
         {
@@ -61,24 +68,31 @@ namespace JSON
         }
         void CompleteInit(Js::Var space, ArenaAllocator* alloc);
 
-        Js::Var Str(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder);
-        Js::Var Str(uint32 index, Js::Var holder);
+        // The value to serialize for the top level value, or nullptr if it has no JSON text
+        Js::Var GetSerializableRootValue(Js::Var value);
 
-    private:
-        Js::JavascriptString* Quote(Js::JavascriptString* value);
-
-        Js::Var StringifyObject(Js::Var value);
+        template <class TWriter>
+        void WriteValue(TWriter& writer, Js::Var value);
 
-        Js::Var StringifyArray(Js::Var value);
-        Js::JavascriptString* GetArrayElementString(uint32 index, Js::Var arrayVar);
-        Js::JavascriptString* GetPropertySeparator();
-        Js::JavascriptString* GetIndentString(uint count);
-        Js::JavascriptString* GetMemberSeparator(Js::JavascriptString* indentString);
-        void StringifyMemberObject( Js::JavascriptString* propertyName, Js::PropertyId id, Js::Var value, Js::ConcatStringBuilder* result,
-            Js::JavascriptString* &indentString, Js::JavascriptString* &memberSeparator, bool &isFirstMember, bool &isEmpty );
+    private:
+        // The value to serialize for a property once toJSON and the replacer function are applied, or
+        // nullptr if the property is skipped (undefined, functions and symbols).
+        Js::Var GetSerializableValue(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder);
+        Js::Var GetSerializableValue(uint32 index, Js::Var holder);
+        Js::Var GetSerializableValueHelper(Js::JavascriptString* key, uint32 index, Js::Var value, Js::Var holder);
+
+        template <class TWriter>
+        void WriteObject(TWriter& writer, Js::Var value);
+        template <class TWriter>
+        void WriteArray(TWriter& writer, Js::Var value);
+        template <class TWriter>
+        void WriteMember(TWriter& writer, Js::JavascriptString* propertyName, Js::PropertyId id, Js::Var holder, bool &isFirstMember);
+        template <class TWriter>
+        void WriteNewLineAndIndent(TWriter& writer, uint count);
+        template <class TWriter>
+        void WriteString(TWriter& writer, Js::JavascriptString* value);
 
         uint32 GetPropertyCount(Js::RecyclableObject* object, Js::JavascriptEnumerator* enumerator);
-        uint32 GetPropertyCount(Js::RecyclableObject* object, Js::JavascriptEnumerator* enumerator, bool* isPrecise);
 
         JSONStack *objectStack;
 
@@ -98,7 +112,5 @@ namespace JSON
 
         Js::JavascriptString* gap;
         uint indent;
-        Js::JavascriptString* propertySeparator;     // colon or colon+space
-        Js::Var StringifySession::StrHelper(Js::JavascriptString* key, Js::Var value, Js::Var holder);
     };
 } // namespace JSON
@@ -11,7 +11,8 @@ using namespace Js;
 namespace JSON
 {
     // -------- Parser implementation ------------//
-    void JSONParser::Finalizer()
+    template <typename CharType>
+    void JSONParser<CharType>::Finalizer()
     {
         m_scanner.Finalizer();
         if(arenaAllocatorObject)
@@ -20,7 +21,8 @@ namespace JSON
         }
     }
 
-    Js::Var JSONParser::Parse(LPCWSTR str, int length)
+    template <typename CharType>
+    Js::Var JSONParser<CharType>::Parse(const CharType* str, int length)
     {
         if (length > MIN_CACHE_LENGTH)
         {
@@ -40,12 +42,8 @@ namespace JSON
         return ret;
     }
 
-    Js::Var JSONParser::Parse(Js::JavascriptString* input)
-    {
-        return Parse(input->GetSz(), input->GetLength());
-    }
-
-    Js::Var JSONParser::Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index)
+    template <typename CharType>
+    Js::Var JSONParser<CharType>::Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index)
     {
         AssertMsg(reviver, "JSON post parse walk with null reviver");
         Js::Var value;
@@ -184,7 +182,8 @@ namespace JSON
         return value;
     }
 
-    Js::Var JSONParser::ParseObject()
+    template <typename CharType>
+    Js::Var JSONParser<CharType>::ParseObject()
     {
         PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
 
@@ -200,9 +199,18 @@ namespace JSON
 
         case tkStrCon:
             {
-                // will auto-null-terminate the string (as length=len+1)
                 uint len = m_scanner.GetCurrentStringLen();
-                retVal = Js::JavascriptString::NewCopyBuffer(m_scanner.GetCurrentString(), len, scriptContext);
+                const CharType* asciiStr = m_scanner.GetCurrentAsciiString();
+                if (asciiStr != nullptr)
+                {
+                    // Plain ASCII from UTF-8 input: keep the bytes, they are widened only if needed
+                    retVal = Js::AsciiString::New(reinterpret_cast<const char*>(asciiStr), len, scriptContext);
+                }
+                else
+                {
+                    // will auto-null-terminate the string (as length=len+1)
+                    retVal = Js::JavascriptString::NewCopyBuffer(m_scanner.GetCurrentString(), len, scriptContext);
+                }
                 Scan();
                 return retVal;
             }
@@ -278,18 +286,37 @@ namespace JSON
                     if(!typeCacheList)
                     {
                         typeCacheList = Anew(this->arenaAllocator, JsonTypeCacheList, this->arenaAllocator, 8);
+                        pendingMembers = Anew(this->arenaAllocator, JsonPendingMemberList, this->arenaAllocator);
                     }
                 }
 
-                // first, create the object
-                Js::DynamicObject* object = scriptContext->GetLibrary()->CreateObject();
-                JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(object));
+                // While the members follow a cached layout the object is not created yet. Their values are kept in
+                // pendingMembers and the object is allocated directly with the type reached so far once the layout
+                // is complete or diverges from the cache, instead of transitioning its type once per member.
+                Js::DynamicObject* object = nullptr;
+                DynamicType* pendingType = nullptr;
+                int firstPendingMember = 0;
+                bool deferObjectCreation = IsCaching();
 #if ENABLE_DEBUG_CONFIG_OPTIONS
-                if (Js::Configuration::Global.flags.IsEnabled(Js::autoProxyFlag))
+                deferObjectCreation = deferObjectCreation && !Js::Configuration::Global.flags.IsEnabled(Js::autoProxyFlag);
+#endif
+                if(deferObjectCreation)
                 {
-                    object = DynamicObject::FromVar(JavascriptProxy::AutoProxyWrapper(object));
+                    pendingType = scriptContext->GetLibrary()->GetObjectLiteralType(0);
+                    firstPendingMember = pendingMembers->Count();
                 }
+                else
+                {
+                    // first, create the object
+                    object = scriptContext->GetLibrary()->CreateObject();
+                    JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(object));
+#if ENABLE_DEBUG_CONFIG_OPTIONS
+                    if (Js::Configuration::Global.flags.IsEnabled(Js::autoProxyFlag))
+                    {
+                        object = DynamicObject::FromVar(JavascriptProxy::AutoProxyWrapper(object));
+                    }
 #endif
+                }
 
                 //next token after '{'
                 Scan();
@@ -298,7 +325,7 @@ namespace JSON
                 if(tkRCurly == m_token.tk)
                 {
                     Scan();
-                    return object;
+                    return object != nullptr ? object : CreateObjectWithPendingMembers(pendingType, firstPendingMember);
                 }
                 JsonTypeCache* previousCache = nullptr;
                 JsonTypeCache* currentCache = nullptr;
@@ -318,9 +345,9 @@ namespace JSON
                     WCHAR* currentStr = m_scanner.GetCurrentString();
                     uint currentStrLength = m_scanner.GetCurrentStringLen();
 
-                    DynamicType* typeWithoutProperty = object->GetDynamicType();
                     if(IsCaching())
                     {
+                        DynamicType* typeWithoutProperty = object != nullptr ? object->GetDynamicType() : pendingType;
                         if(!previousCache)
                         {
                             // This is the first property in the list - see if we have an existing cache for it.
@@ -343,12 +370,23 @@ namespace JSON
                             previousCache = currentCache;
                             currentCache = currentCache->next;
 
-                            // fast path for type transition and property set
-                            object->EnsureSlots(typeWithoutProperty->GetTypeHandler()->GetSlotCapacity(),
-                                typeWithProperty->GetTypeHandler()->GetSlotCapacity(), scriptContext, typeWithProperty->GetTypeHandler());
-                            object->ReplaceType(typeWithProperty);
-                            Js::Var value = ParseObject();
-                            object->SetSlot(SetSlotArguments(propertyId, propertyIndex, value));
+                            if(object == nullptr)
+                            {
+                                // Nested objects push and pop their own pending members, so ours stay contiguous
+                                Js::Var value = ParseObject();
+                                JsonPendingMember member = { propertyId, propertyIndex, value };
+                                pendingMembers->Add(member);
+                                pendingType = typeWithProperty;
+                            }
+                            else
+                            {
+                                // fast path for type transition and property set
+                                object->EnsureSlots(typeWithoutProperty->GetTypeHandler()->GetSlotCapacity(),
+                                    typeWithProperty->GetTypeHandler()->GetSlotCapacity(), scriptContext, typeWithProperty->GetTypeHandler());
+                                object->ReplaceType(typeWithProperty);
+                                Js::Var value = ParseObject();
+                                object->SetSlot(SetSlotArguments(propertyId, propertyIndex, value));
+                            }
 
                             // if the next token is not a comma consider the list of members done.
                             if (tkComma != m_token.tk)
@@ -358,7 +396,14 @@ namespace JSON
                         }
                     }
 
+                    if(object == nullptr)
+                    {
+                        // The layout diverges from the cache, create the object with the members parsed so far
+                        object = CreateObjectWithPendingMembers(pendingType, firstPendingMember);
+                    }
+
                     // slow path
+                    DynamicType* typeWithoutProperty = object->GetDynamicType();
                     Js::PropertyRecord const * propertyRecord;
                     scriptContext->GetOrAddPropertyRecord(currentStr, currentStrLength, &propertyRecord);
 
@@ -403,6 +448,12 @@ namespace JSON
                     Scan();
                 }
 
+                if(object == nullptr)
+                {
+                    // Every member followed the cached layout
+                    object = CreateObjectWithPendingMembers(pendingType, firstPendingMember);
+                }
+
                 // check  and consume the ending '}"
                 CheckCurrentToken(tkRCurly, JSERR_JsonNoRcurly);
                 return object;
@@ -412,4 +463,24 @@ namespace JSON
             m_scanner.ThrowSyntaxError(JSERR_JsonSyntax);
         }
     }
+
+    template <typename CharType>
+    Js::DynamicObject* JSONParser<CharType>::CreateObjectWithPendingMembers(Js::DynamicType* type, int firstPendingMember)
+    {
+        Assert(IsCaching() && pendingMembers != nullptr);
+
+        Js::DynamicObject* object = Js::DynamicObject::New(scriptContext->GetRecycler(), type);
+        JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(object));
+
+        // The type already has all the pending properties, only the slots are left to fill
+        while (pendingMembers->Count() > firstPendingMember)
+        {
+            JsonPendingMember member = pendingMembers->RemoveAtEnd();
+            object->SetSlot(SetSlotArguments(member.propertyId, member.propertyIndex, member.value));
+        }
+        return object;
+    }
+
+    template class JSONParser<char16>;
+    template class JSONParser<utf8char_t>;
 } // namespace JSON
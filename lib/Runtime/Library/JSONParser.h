@@ -46,16 +46,17 @@ namespace JSON
     };
 
 
+    // CharType is the encoding of the JSON text, see JSONScanner.
+    template <typename CharType>
     class JSONParser
     {
     public:
         JSONParser(Js::ScriptContext* sc, Js::RecyclableObject* rv) : scriptContext(sc),
-            reviver(rv),  arenaAllocatorObject(nullptr), arenaAllocator(nullptr), typeCacheList(nullptr)
+            reviver(rv),  arenaAllocatorObject(nullptr), arenaAllocator(nullptr), typeCacheList(nullptr), pendingMembers(nullptr)
         {
         };
 
-        Js::Var Parse(LPCWSTR str, int length);
-        Js::Var Parse(Js::JavascriptString* input);
+        Js::Var Parse(const CharType* str, int length);
         Js::Var Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index = Js::JavascriptArray::InvalidIndex);
         void Finalizer();
 
@@ -66,6 +67,7 @@ namespace JSON
         }
 
         Js::Var ParseObject();
+        Js::DynamicObject* CreateObjectWithPendingMembers(Js::DynamicType* type, int firstPendingMember);
 
         void CheckCurrentToken(int tk, int wErr)
         {
@@ -80,13 +82,24 @@ namespace JSON
         }
 
         Token m_token;
-        JSONScanner m_scanner;
+        JSONScanner<CharType> m_scanner;
         Js::ScriptContext* scriptContext;
         Js::RecyclableObject* reviver;
         Js::TempGuestArenaAllocatorObject* arenaAllocatorObject;
         ArenaAllocator* arenaAllocator;
         typedef JsUtil::BaseDictionary<const Js::PropertyRecord *, JsonTypeCache*, ArenaAllocator, PowerOf2SizePolicy, Js::PropertyRecordStringHashComparer>  JsonTypeCacheList;
         JsonTypeCacheList* typeCacheList;
+
+        // Members of the objects whose creation is deferred while they follow a cached layout. Lives in the
+        // guest arena, so the values are reported to the recycler.
+        struct JsonPendingMember
+        {
+            Js::PropertyId propertyId;
+            Js::PropertyIndex propertyIndex;
+            Js::Var value;
+        };
+        typedef JsUtil::List<JsonPendingMember, ArenaAllocator> JsonPendingMemberList;
+        JsonPendingMemberList* pendingMembers;
         static const int MIN_CACHE_LENGTH = 50; // Use Json type cache only if the JSON string is larger than this constant.
     };
 } // namespace JSON
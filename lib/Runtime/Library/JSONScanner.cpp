@@ -9,14 +9,198 @@ using namespace Js;
 
 namespace JSON
 {
+#if defined(_M_IX86) || defined(_M_X64)
+#define JSON_SCANNER_SSE2
+#endif
+
+    // -------- Bulk character classification ------------//
+    // Most of the scan time goes to string bodies and whitespace. These helpers skip a run of characters
+    // that need no attention, 16 char16 or 32 UTF-8 bytes at a time when SSE2 is available, and return
+    // the first character that does need attention (or end).
+#ifdef JSON_SCANNER_SSE2
+    static inline bool CanUseSSE2()
+    {
+#if defined(_M_IX86)
+        return AutoSystemInfo::Data.SSE2Available() != FALSE;
+#else
+        return true;
+#endif
+    }
+
+    static inline uint FirstSetBit(uint mask)
+    {
+        Assert(mask != 0);
+        DWORD index;
+        _BitScanForward(&index, mask);
+        return index;
+    }
+
+    // One byte lane per character: 0xFF where the char16 is '"', '\\' or <= 0x1F
+    static inline __m128i StringSpecialChars(__m128i chars)
+    {
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16('"')), _mm_cmpeq_epi16(chars, _mm_set1_epi16('\\')));
+        // unsigned chars <= 0x1F saturate to 0
+        return _mm_or_si128(special, _mm_cmpeq_epi16(_mm_subs_epu16(chars, _mm_set1_epi16(0x1F)), _mm_setzero_si128()));
+    }
+
+    static inline __m128i WhitespaceChars(__m128i chars)
+    {
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16(' ')), _mm_cmpeq_epi16(chars, _mm_set1_epi16('\n')));
+        return _mm_or_si128(ws, _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16('\r')), _mm_cmpeq_epi16(chars, _mm_set1_epi16('\t'))));
+    }
+
+    static inline __m128i WhitespaceBytes(__m128i bytes)
+    {
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+        return _mm_or_si128(ws, _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'))));
+    }
+
+    // Bit i set for each of the 16 char16 at p matched by classify
+    template <__m128i (*classify)(__m128i)>
+    static inline uint ClassifyChars(const char16* p)
+    {
+        __m128i lo = classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        __m128i hi = classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8)));
+        // 0/-1 lanes survive the signed saturation, leaving one byte per character
+        return (uint)_mm_movemask_epi8(_mm_packs_epi16(lo, hi));
+    }
+
+    // Bit i set for each of the 32 bytes at p matched by classify
+    template <__m128i (*classify)(__m128i)>
+    static inline uint ClassifyBytes(const utf8char_t* p)
+    {
+        uint lo = (uint)_mm_movemask_epi8(classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+        uint hi = (uint)_mm_movemask_epi8(classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16))));
+        return lo | (hi << 16);
+    }
+
+    static inline __m128i QuoteOrBackslashBytes(__m128i bytes)
+    {
+        return _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')));
+    }
+
+    // 0xFF where the byte is '"', '\\', <= 0x1F or not ASCII
+    static inline __m128i StringSpecialBytes(__m128i bytes)
+    {
+        __m128i special = _mm_or_si128(QuoteOrBackslashBytes(bytes), _mm_cmpeq_epi8(_mm_subs_epu8(bytes, _mm_set1_epi8(0x1F)), _mm_setzero_si128()));
+        return _mm_or_si128(special, _mm_cmplt_epi8(bytes, _mm_setzero_si128()));
+    }
+#endif
+
+    template <typename CharType>
+    static inline bool IsJSONWhitespace(CharType ch)
+    {
+        return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+    }
+
+    template <typename CharType>
+    static const CharType* SkipWhitespace(const CharType* current, const CharType* end)
+    {
+#ifdef JSON_SCANNER_SSE2
+        if (CanUseSSE2())
+        {
+            const int blockLength = 32 / sizeof(CharType);
+            while (end - current >= blockLength)
+            {
+                uint nonWhitespace = sizeof(CharType) == sizeof(char16) ?
+                    (~ClassifyChars<WhitespaceChars>(reinterpret_cast<const char16*>(current)) & 0xFFFF) :
+                    ~ClassifyBytes<WhitespaceBytes>(reinterpret_cast<const utf8char_t*>(current));
+                if (nonWhitespace != 0)
+                {
+                    return current + FirstSetBit(nonWhitespace);
+                }
+                current += blockLength;
+            }
+        }
+#endif
+        while (current < end && IsJSONWhitespace(*current))
+        {
+            current++;
+        }
+        return current;
+    }
+
+    // Skips the characters a JSON string takes as is, stopping at '"', '\\' or a control character
+    static const char16* SkipPlainStringChars(const char16* current, const char16* end)
+    {
+#ifdef JSON_SCANNER_SSE2
+        if (CanUseSSE2())
+        {
+            while (end - current >= 16)
+            {
+                uint special = ClassifyChars<StringSpecialChars>(current);
+                if (special != 0)
+                {
+                    return current + FirstSetBit(special);
+                }
+                current += 16;
+            }
+        }
+#endif
+        while (current < end && *current != '"' && *current != '\\' && *current > 0x1F)
+        {
+            current++;
+        }
+        return current;
+    }
+
+    // Same as above for UTF-8 input, but also stops at non-ASCII bytes, which need decoding
+    static const utf8char_t* SkipPlainStringChars(const utf8char_t* current, const utf8char_t* end)
+    {
+#ifdef JSON_SCANNER_SSE2
+        if (CanUseSSE2())
+        {
+            while (end - current >= 32)
+            {
+                uint special = ClassifyBytes<StringSpecialBytes>(current);
+                if (special != 0)
+                {
+                    return current + FirstSetBit(special);
+                }
+                current += 32;
+            }
+        }
+#endif
+        while (current < end && *current != '"' && *current != '\\' && *current > 0x1F && *current < 0x80)
+        {
+            current++;
+        }
+        return current;
+    }
+
+    static const utf8char_t* FindQuoteOrBackslash(const utf8char_t* current, const utf8char_t* end)
+    {
+#ifdef JSON_SCANNER_SSE2
+        if (CanUseSSE2())
+        {
+            while (end - current >= 32)
+            {
+                uint found = ClassifyBytes<QuoteOrBackslashBytes>(current);
+                if (found != 0)
+                {
+                    return current + FirstSetBit(found);
+                }
+                current += 32;
+            }
+        }
+#endif
+        while (current < end && *current != '"' && *current != '\\')
+        {
+            current++;
+        }
+        return current;
+    }
+
     // -------- Scanner implementation ------------//
-    JSONScanner::JSONScanner()
+    template <typename CharType>
+    JSONScanner<CharType>::JSONScanner()
         : inputText(0), inputLen(0), pToken(0), stringBuffer(0), allocator(0), allocatorObject(0),
-        currentRangeCharacterPairList(0), stringBufferLength(0), currentIndex(0)
+        currentRangeCharacterPairList(0), stringBufferLength(0), currentIndex(0), currentAsciiString(0)
     {
     }
 
-    void JSONScanner::Finalizer()
+    template <typename CharType>
+    void JSONScanner<CharType>::Finalizer()
     {
         // All dynamic memory allocated by this object is on the arena - either the one this object owns or by the
         // one shared with JSON parser - here we will deallocate ours. The others will be deallocated when JSONParser
@@ -28,7 +212,8 @@ namespace JSON
         }
     }
 
-    void JSONScanner::Init(const char16* input, uint len, Token* pOutToken, Js::ScriptContext* sc, const char16* current, ArenaAllocator* allocator)
+    template <typename CharType>
+    void JSONScanner<CharType>::Init(const CharType* input, uint len, Token* pOutToken, Js::ScriptContext* sc, const CharType* current, ArenaAllocator* allocator)
     {
         // Note that allocator could be nullptr from JSONParser, if we could not reuse an allocator, keep our own
         inputText = input;
@@ -39,7 +224,8 @@ namespace JSON
         this->allocator = allocator;
     }
 
-    tokens JSONScanner::Scan()
+    template <typename CharType>
+    tokens JSONScanner<CharType>::Scan()
     {
         pTokenString = currentChar;
 
@@ -56,7 +242,8 @@ namespace JSON
             case '\r':
             case '\n':
             case ' ':
-                //WS - keep looping
+                //WS - skip the rest of the run and keep looping
+                currentChar = SkipWhitespace(currentChar, inputText + inputLen);
                 break;
 
             case '"':
@@ -79,15 +266,18 @@ namespace JSON
 
                     // we use StrToDbl() here for compat with the rest of the engine. StrToDbl() accept a larger syntax.
                     // Verify first the JSON grammar.
-                    const char16* saveCurrentChar = currentChar;
+                    const CharType* saveCurrentChar = currentChar;
                     if(!IsJSONNumber())
                     {
                        ThrowSyntaxError(JSERR_JsonBadNumber);
                     }
                     currentChar = saveCurrentChar;
                     double val;
-                    const char16* end;
-                    val = Js::NumberUtilities::StrToDbl(currentChar, &end, scriptContext);
+                    const CharType* end;
+                    if (!TryConvertInteger(&val, &end))
+                    {
+                        val = ConvertNumber(&end);
+                    }
                     if(currentChar == end)
                     {
                        ThrowSyntaxError(JSERR_JsonBadNumber);
@@ -156,7 +346,8 @@ namespace JSON
         return (pToken->tk = tkEOF);
     }
 
-    bool JSONScanner::IsJSONNumber()
+    template <typename CharType>
+    bool JSONScanner<CharType>::IsJSONNumber()
     {
         bool firstDigitIsAZero = false;
         if (PeekNextChar() == '0')
@@ -193,7 +384,7 @@ namespace JSON
                     // at least one digit after '.'
                     if(currentChar < inputText + inputLen)
                     {
-                        char16 nch = ReadNextChar();
+                        CharType nch = ReadNextChar();
                         if('0' <= nch && nch <= '9')
                         {
                             return true;
@@ -220,7 +411,126 @@ namespace JSON
         return true;
     }
 
-    tokens JSONScanner::ScanString()
+    // Most numbers in JSON documents are small integers. Up to 15 digits they are exactly representable
+    // as a double, so they don't need to go through StrToDbl.
+    template <typename CharType>
+    bool JSONScanner<CharType>::TryConvertInteger(double* value, const CharType** end)
+    {
+        const uint maxExactDigits = 15;
+        const CharType* inputEnd = inputText + inputLen;
+        const CharType* p = currentChar;
+        uint64 intValue = 0;
+        while (p < inputEnd && '0' <= *p && *p <= '9')
+        {
+            if (uint(p - currentChar) == maxExactDigits)
+            {
+                return false;
+            }
+            intValue = intValue * 10 + (*p - '0');
+            p++;
+        }
+
+        if (p == currentChar || (p < inputEnd && (*p == '.' || *p == 'e' || *p == 'E')))
+        {
+            return false;
+        }
+
+        *value = (double)intValue;
+        *end = p;
+        return true;
+    }
+
+    template <typename CharType>
+    char16 JSONScanner<CharType>::ScanEscapeSequence()
+    {
+        //JSON escape sequence in a string \", \/, \\, \b, \f, \n, \r, \t, unicode seq
+        // unlikely V5.8 regular chars are not escaped, i.e '\g'' in a string is illegal not 'g'
+        if (currentChar >= inputText + inputLen )
+        {
+           ThrowSyntaxError(JSERR_JsonNoStrEnd);
+        }
+
+        int tempHex;
+        char16 ch = ReadNextChar();
+        switch (ch)
+        {
+        case 0:
+            currentChar--;
+           ThrowSyntaxError(JSERR_JsonNoStrEnd);
+
+        case '"':
+        case '/':
+        case '\\':
+            //keep ch
+            break;
+
+        case 'b':
+            ch = 0x08;
+            break;
+
+        case 'f':
+            ch = 0x0C;
+            break;
+
+        case 'n':
+            ch = 0x0A;
+            break;
+
+        case 'r':
+            ch = 0x0D;
+            break;
+
+        case 't':
+            ch = 0x09;
+            break;
+
+        case 'u':
+            {
+                int chcode;
+                // 4 hex digits
+                if (currentChar + 3 >= inputText + inputLen)
+                {
+                    //no room left for 4 hex chars
+                   ThrowSyntaxError(JSERR_JsonNoStrEnd);
+
+                }
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode = tempHex * 0x1000;
+
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode += tempHex * 0x0100;
+
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode += tempHex * 0x0010;
+
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode += tempHex;
+                AssertMsg(chcode == (chcode & 0xFFFF), "Bad unicode code");
+                ch = (char16)chcode;
+            }
+            break;
+
+        default:
+            // Any other '\o' is an error in JSON
+           ThrowSyntaxError(JSERR_JsonIllegalChar);
+        }
+        return ch;
+    }
+
+    template <>
+    tokens JSONScanner<char16>::ScanString()
     {
         char16 ch;
 
@@ -231,10 +541,19 @@ namespace JSON
         LPCWSTR bulkStart = currentChar;
         uint bulkLength = 0;
 
-        while (currentChar < inputText + inputLen)
+        const char16* inputEnd = inputText + inputLen;
+        while (currentChar < inputEnd)
         {
+            // Characters that are taken as is only extend the current bulk
+            const char16* plainEnd = SkipPlainStringChars(currentChar, inputEnd);
+            bulkLength += (uint)(plainEnd - currentChar);
+            currentChar = plainEnd;
+            if (currentChar == inputEnd)
+            {
+                break;
+            }
+
             ch = ReadNextChar();
-            int tempHex;
 
             if (ch == '"')
             {
@@ -247,95 +566,10 @@ namespace JSON
                 //JSON doesn't accept \u0000 - \u001f range, LS(\u2028) and PS(\u2029) are ok
                ThrowSyntaxError(JSERR_JsonIllegalChar);
             }
-            else if ( 0 == ch )
-            {
-                currentChar--;
-               ThrowSyntaxError(JSERR_JsonNoStrEnd);
-            }
-            else if ('\\' == ch)
+            else
             {
-                //JSON escape sequence in a string \", \/, \\, \b, \f, \n, \r, \t, unicode seq
-                // unlikely V5.8 regular chars are not escaped, i.e '\g'' in a string is illegal not 'g'
-                if (currentChar >= inputText + inputLen )
-                {
-                   ThrowSyntaxError(JSERR_JsonNoStrEnd);
-                }
-
-                ch = ReadNextChar();
-                switch (ch)
-                {
-                case 0:
-                    currentChar--;
-                   ThrowSyntaxError(JSERR_JsonNoStrEnd);
-
-                case '"':
-                case '/':
-                case '\\':
-                    //keep ch
-                    break;
-
-                case 'b':
-                    ch = 0x08;
-                    break;
-
-                case 'f':
-                    ch = 0x0C;
-                    break;
-
-                case 'n':
-                    ch = 0x0A;
-                    break;
-
-                case 'r':
-                    ch = 0x0D;
-                    break;
-
-                case 't':
-                    ch = 0x09;
-                    break;
-
-                case 'u':
-                    {
-                        int chcode;
-                        // 4 hex digits
-                        if (currentChar + 3 >= inputText + inputLen)
-                        {
-                            //no room left for 4 hex chars
-                           ThrowSyntaxError(JSERR_JsonNoStrEnd);
-
-                        }
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode = tempHex * 0x1000;
-
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode += tempHex * 0x0100;
-
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode += tempHex * 0x0010;
-
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode += tempHex;
-                        AssertMsg(chcode == (chcode & 0xFFFF), "Bad unicode code");
-                        ch = (char16)chcode;
-                    }
-                    break;
-
-                default:
-                    // Any other '\o' is an error in JSON
-                   ThrowSyntaxError(JSERR_JsonIllegalChar);
-                }
+                Assert(ch == '\\');
+                ch = ScanEscapeSequence();
 
                 // flush
                 this->GetCurrentRangeCharacterPairList()->Add(RangeCharacterPair((uint)(bulkStart - inputText), bulkLength, ch));
@@ -357,11 +591,6 @@ namespace JSON
                 bulkStart = currentChar;
                 bulkLength = 0;
             }
-            else
-            {
-                // continue
-                bulkLength++;
-            }
         }
 
         if (!endFound)
@@ -404,26 +633,168 @@ namespace JSON
         return (pToken->tk = tkStrCon);
     }
 
-    void JSONScanner::BuildUnescapedString(bool shouldSkipLastCharacter)
+    // UTF-8 input is never mapped directly. Plain ASCII strings are left in the input for the
+    // parser to create the string value from the bytes, and are only widened if they are needed
+    // as char16 (e.g. for a property name). Other strings are decoded into the string buffer,
+    // resolving escape sequences along the way.
+    template <>
+    tokens JSONScanner<utf8char_t>::ScanString()
     {
-        AssertMsg(this->allocator != nullptr, "We must have built the allocator");
-        AssertMsg(this->currentRangeCharacterPairList != nullptr, "We must have built the currentRangeCharacterPairList");
-        AssertMsg(this->currentRangeCharacterPairList->Count() > 0, "We need to build the current string only because we have escaped characters");
+        const utf8char_t* inputEnd = inputText + inputLen;
+        this->currentAsciiString = nullptr;
 
-        // Step 1: Ensure the buffer has sufficient space
-        int requiredSize = this->GetCurrentStringLen();
-        if (requiredSize > this->stringBufferLength)
+        // Find the closing '"' first. Every char16 of the decoded string takes at least one byte
+        // of input, so the byte length bounds the size of the buffer we need.
+        const utf8char_t* stringEnd = FindQuoteOrBackslash(currentChar, inputEnd);
+        while (stringEnd < inputEnd && *stringEnd != '"')
         {
-            if (this->stringBuffer)
+            // skip the escaped byte, it can't end the string
+            stringEnd = FindQuoteOrBackslash(min(stringEnd + 2, inputEnd), inputEnd);
+        }
+
+        if (stringEnd >= inputEnd)
+        {
+            // no ending '"' found
+            currentChar = inputEnd;
+            ThrowSyntaxError(JSERR_JsonNoStrEnd);
+        }
+
+        const utf8char_t* plainEnd = SkipPlainStringChars(currentChar, stringEnd);
+        if (plainEnd == stringEnd)
+        {
+            this->currentAsciiString = currentChar;
+            this->currentIndex = uint(stringEnd - currentChar);
+            this->currentString = nullptr;
+
+            // skip the closing '"'
+            currentChar = stringEnd + 1;
+
+            OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("ScanString(): plain ASCII string of length %u\n"), GetCurrentStringLen());
+
+            return (pToken->tk = tkStrCon);
+        }
+
+        // Allocate at least one char so that empty strings still have a buffer
+        uint maxLength = max(uint(stringEnd - currentChar), 1u);
+        this->EnsureStringBuffer(maxLength);
+
+        char16* buffer = this->stringBuffer;
+        uint length = 0;
+
+        // Widen the leading plain ASCII characters we have already skipped over
+        while (currentChar < plainEnd)
+        {
+            buffer[length++] = (char16)*currentChar++;
+        }
+
+        utf8::DecodeOptions options = utf8::doDefault;
+        while (currentChar < stringEnd)
+        {
+            char16 ch;
+            utf8char_t byte = *currentChar;
+            if (byte < 0x80)
             {
-                AdeleteArray(this->allocator, this->stringBufferLength, this->stringBuffer);
-                this->stringBuffer = nullptr;
+                if (byte > 0x1F && byte != '\\')
+                {
+                    // Widen the whole run of plain ASCII characters
+                    const utf8char_t* plainEnd = SkipPlainStringChars(currentChar, stringEnd);
+                    Assert(plainEnd > currentChar && length + (plainEnd - currentChar) <= maxLength);
+                    while (currentChar < plainEnd)
+                    {
+                        buffer[length++] = (char16)*currentChar++;
+                    }
+                    continue;
+                }
+
+                currentChar++;
+                if (byte <= 0x1F)
+                {
+                    //JSON doesn't accept \u0000 - \u001f range, LS(\u2028) and PS(\u2029) are ok
+                    ThrowSyntaxError(JSERR_JsonIllegalChar);
+                }
+                Assert(byte == '\\');
+                ch = ScanEscapeSequence();
+            }
+            else
+            {
+                // Code points outside the BMP decode into a surrogate pair in two steps
+                ch = utf8::Decode(currentChar, stringEnd, options);
+                if ((options & utf8::doSecondSurrogatePair) != 0)
+                {
+                    Assert(length < maxLength);
+                    buffer[length++] = ch;
+                    ch = utf8::Decode(currentChar, stringEnd, options);
+                }
             }
 
-            this->stringBuffer = AnewArray(this->allocator, char16, requiredSize);
-            this->stringBufferLength = requiredSize;
+            Assert(length < maxLength);
+            buffer[length++] = ch;
         }
 
+        // skip the closing '"'
+        Assert(currentChar == stringEnd);
+        currentChar++;
+
+        this->currentIndex = length;
+        this->currentString = buffer;
+
+        OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("ScanString(): decoded UTF-8 string as '%.*s'\n"),
+            GetCurrentStringLen(), GetCurrentString());
+
+        return (pToken->tk = tkStrCon);
+    }
+
+    template <>
+    double JSONScanner<char16>::ConvertNumber(const char16** end)
+    {
+        return Js::NumberUtilities::StrToDbl(currentChar, end, scriptContext);
+    }
+
+    template <>
+    double JSONScanner<utf8char_t>::ConvertNumber(const utf8char_t** end)
+    {
+        // The host buffer doesn't have to be null terminated and StrToDbl reads until the first character
+        // that can't be part of a number, so convert from a terminated copy of the number text.
+        const utf8char_t* inputEnd = inputText + inputLen;
+        const utf8char_t* numberEnd = currentChar;
+        while (numberEnd < inputEnd &&
+            (('0' <= *numberEnd && *numberEnd <= '9') || *numberEnd == '.' || *numberEnd == 'e' || *numberEnd == 'E' || *numberEnd == '+' || *numberEnd == '-'))
+        {
+            numberEnd++;
+        }
+
+        size_t numberLength = numberEnd - currentChar;
+        utf8char_t localBuffer[64];
+        utf8char_t* buffer = localBuffer;
+        if (numberLength >= _countof(localBuffer))
+        {
+            buffer = AnewArray(this->GetAllocator(), utf8char_t, numberLength + 1);
+        }
+        js_memcpy_s(buffer, numberLength, currentChar, numberLength);
+        buffer[numberLength] = 0;
+
+        const utf8char_t* bufferEnd;
+        double value = Js::NumberUtilities::StrToDbl<utf8char_t>(buffer, &bufferEnd, scriptContext);
+        *end = currentChar + (bufferEnd - buffer);
+
+        if (buffer != localBuffer)
+        {
+            AdeleteArray(this->GetAllocator(), numberLength + 1, buffer);
+        }
+        return value;
+    }
+
+    template <>
+    void JSONScanner<char16>::BuildUnescapedString(bool shouldSkipLastCharacter)
+    {
+        AssertMsg(this->allocator != nullptr, "We must have built the allocator");
+        AssertMsg(this->currentRangeCharacterPairList != nullptr, "We must have built the currentRangeCharacterPairList");
+        AssertMsg(this->currentRangeCharacterPairList->Count() > 0, "We need to build the current string only because we have escaped characters");
+
+        // Step 1: Ensure the buffer has sufficient space
+        int requiredSize = this->GetCurrentStringLen();
+        this->EnsureStringBuffer(requiredSize);
+
         // Step 2: Copy the data to the buffer
         int totalCopied = 0;
         char16* begin_copy = this->stringBuffer;
@@ -455,19 +826,63 @@ namespace JSON
         OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("BuildUnescapedString(): unescaped string as '%.*s'\n"), GetCurrentStringLen(), this->stringBuffer);
     }
 
-    JSONScanner::RangeCharacterPairList* JSONScanner::GetCurrentRangeCharacterPairList(void)
+    template <typename CharType>
+    void JSONScanner<CharType>::WidenCurrentAsciiString()
     {
-        if (this->currentRangeCharacterPairList == nullptr)
+        Assert(this->currentAsciiString != nullptr);
+
+        // Allocate at least one char so that empty strings still have a buffer
+        uint length = this->currentIndex;
+        this->EnsureStringBuffer(max(length, 1u));
+        for (uint i = 0; i < length; i++)
+        {
+            this->stringBuffer[i] = (char16)this->currentAsciiString[i];
+        }
+
+        this->currentString = this->stringBuffer;
+        this->currentAsciiString = nullptr;
+    }
+
+    template <typename CharType>
+    void JSONScanner<CharType>::EnsureStringBuffer(int requiredSize)
+    {
+        if (requiredSize > this->stringBufferLength)
         {
-            if (this->allocator == nullptr)
+            ArenaAllocator* allocator = this->GetAllocator();
+            if (this->stringBuffer)
             {
-                this->allocatorObject = this->scriptContext->GetTemporaryGuestAllocator(_u("JSONScanner"));
-                this->allocator = this->allocatorObject->GetAllocator();
+                AdeleteArray(allocator, this->stringBufferLength, this->stringBuffer);
+                this->stringBuffer = nullptr;
             }
 
-            this->currentRangeCharacterPairList = Anew(this->allocator, RangeCharacterPairList, this->allocator, 4);
+            this->stringBuffer = AnewArray(allocator, char16, requiredSize);
+            this->stringBufferLength = requiredSize;
+        }
+    }
+
+    template <typename CharType>
+    ArenaAllocator* JSONScanner<CharType>::GetAllocator()
+    {
+        if (this->allocator == nullptr)
+        {
+            this->allocatorObject = this->scriptContext->GetTemporaryGuestAllocator(_u("JSONScanner"));
+            this->allocator = this->allocatorObject->GetAllocator();
+        }
+        return this->allocator;
+    }
+
+    template <typename CharType>
+    typename JSONScanner<CharType>::RangeCharacterPairList* JSONScanner<CharType>::GetCurrentRangeCharacterPairList(void)
+    {
+        if (this->currentRangeCharacterPairList == nullptr)
+        {
+            ArenaAllocator* allocator = this->GetAllocator();
+            this->currentRangeCharacterPairList = Anew(allocator, RangeCharacterPairList, allocator, 4);
         }
 
         return this->currentRangeCharacterPairList;
     }
+
+    template class JSONScanner<char16>;
+    template class JSONScanner<utf8char_t>;
 } // namespace JSON
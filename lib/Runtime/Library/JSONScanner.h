@@ -6,22 +6,36 @@
 
 namespace JSON
 {
-    class JSONParser;
+    template <typename CharType> class JSONParser;
 
     // Small scanner for exclusive JSON purpose. The general
     // JScript scanner is not appropriate here because of the JSON restricted lexical grammar
     // token enums and structures are shared although the token semantics is slightly different.
+    // CharType is the encoding of the input text: char16 for JavascriptString input, or utf8char_t
+    // for UTF-8 input coming straight from the host. Scanned strings are always produced as char16;
+    // with UTF-8 input only the string tokens are decoded, the rest of the text is never widened.
+    template <typename CharType>
     class JSONScanner
     {
     public:
         JSONScanner();
         tokens Scan();
-        void Init(const char16* input, uint len, Token* pOutToken,
-            ::Js::ScriptContext* sc, const char16* current, ArenaAllocator* allocator);
+        void Init(const CharType* input, uint len, Token* pOutToken,
+            ::Js::ScriptContext* sc, const CharType* current, ArenaAllocator* allocator);
 
         void Finalizer();
-        char16* GetCurrentString() { return currentString; } 
+        char16* GetCurrentString()
+        {
+            if (currentAsciiString != nullptr)
+            {
+                WidenCurrentAsciiString();
+            }
+            return currentString;
+        }
         uint GetCurrentStringLen() { return currentIndex; }
+        // With UTF-8 input, the bytes of the current string if it is plain ASCII and hasn't been widened yet
+        const CharType* GetCurrentAsciiString() { return currentAsciiString; }
+        // Position in CharType units (bytes for UTF-8 input)
         uint GetScanPosition() { return uint(currentChar - inputText); }
 
         void __declspec(noreturn) ThrowSyntaxError(int wErr)
@@ -49,36 +63,43 @@ namespace JSON
 
         Js::TempGuestArenaAllocatorObject* allocatorObject;
         ArenaAllocator* allocator;
+        ArenaAllocator* GetAllocator();
         void BuildUnescapedString(bool shouldSkipLastCharacter);
+        void WidenCurrentAsciiString();
+        void EnsureStringBuffer(int requiredSize);
 
         RangeCharacterPairList* GetCurrentRangeCharacterPairList(void);
 
-        inline char16 ReadNextChar(void)
+        inline CharType ReadNextChar(void)
         {
             return *currentChar++;
         }
 
-        inline char16 PeekNextChar(void)
+        inline CharType PeekNextChar(void)
         {
             return *currentChar;
         }
 
         tokens ScanString();
+        char16 ScanEscapeSequence();
         bool IsJSONNumber();
+        bool TryConvertInteger(double* value, const CharType** end);
+        double ConvertNumber(const CharType** end);
 
-        const char16* inputText;
+        const CharType* inputText;
         uint    inputLen;
-        const char16* currentChar;
-        const char16* pTokenString;
+        const CharType* currentChar;
+        const CharType* pTokenString;
 
         Token*   pToken;
         ::Js::ScriptContext* scriptContext;
 
         uint     currentIndex;
         char16* currentString;
+        const CharType* currentAsciiString;
         __field_ecount(stringBufferLength) char16* stringBuffer;
         int      stringBufferLength;
 
-        friend class JSONParser;
+        friend class JSONParser<CharType>;
     };
 } // namespace JSON
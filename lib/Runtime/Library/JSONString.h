@@ -173,6 +173,47 @@ namespace Js
             return result;
         }
 
+        // Writes the quoted, escaped value straight to a writer providing Append(char16) and
+        // Append(const char16*, charcount_t). Used by the streaming JSON.stringify path.
+        template <class TWriter>
+        static void WriteEscaped(TWriter& writer, const char16* szValue, charcount_t len)
+        {
+            static const char16 hexDigits[] = _u("0123456789abcdef");
+
+            writer.Append(_u('\"'));
+            const char16* endSz = szValue + len;
+            const char16* lastFlushSz = szValue;
+            for (const char16* current = szValue; current < endSz; current++)
+            {
+                char16 wch = *current;
+                if (wch < _countof(escapeMap) && escapeMap[wch] != _u('\0'))
+                {
+                    writer.Append(lastFlushSz, (charcount_t)(current - lastFlushSz));
+                    lastFlushSz = current + 1;
+
+                    char16 specialChar = escapeMap[wch];
+                    if (specialChar == _u('u'))
+                    {
+                        // only control characters are escaped as \u00XX
+                        Assert(wch < 0x20);
+                        char16 escape[] = { _u('\\'), _u('u'), _u('0'), _u('0'), hexDigits[wch >> 4], hexDigits[wch & 0xF] };
+                        writer.Append(escape, _countof(escape));
+                    }
+                    else
+                    {
+                        char16 escape[] = { _u('\\'), specialChar };
+                        writer.Append(escape, _countof(escape));
+                    }
+                }
+            }
+
+            if (lastFlushSz < endSz)
+            {
+                writer.Append(lastFlushSz, (charcount_t)(endSz - lastFlushSz));
+            }
+            writer.Append(_u('\"'));
+        }
+
         static WCHAR* EscapeNonEmptyString(ArenaAllocator* allocator, const char16* szValue)
         {
             WCHAR* result = nullptr;
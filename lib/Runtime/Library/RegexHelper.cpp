@@ -155,7 +155,6 @@ namespace Js
 #ifdef PROFILE_EXEC
         scriptContext->ProfileBegin(Js::RegexCompilePhase);
 #endif
-        ArenaAllocator* rtAllocator = scriptContext->RegexAllocator();
 #if ENABLE_REGEX_CONFIG_OPTIONS
         UnifiedRegex::DebugWriter *dw = 0;
         if (REGEX_CONFIG_FLAG(RegexDebug))
@@ -186,6 +185,23 @@ namespace Js
             return pattern;
         }
 
+        // Runtimes which share compiled regexes only parse and compile a pattern once per process. On a miss, the program
+        // is compiled into a new cache entry and published once its pattern exists.
+        UnifiedRegex::ProgramCache::AutoCompile cacheCompile(scriptContext);
+        if (cacheCompile.IsSharing() && GetFlags(scriptContext, pszOpts, cszOpts, flags))
+        {
+            UnifiedRegex::Program* cachedProgram = cacheCompile.Lookup(psz, csz, flags);
+            if (cachedProgram != nullptr)
+            {
+                UnifiedRegex::RegexPattern* pattern = cacheCompile.NewPattern(cachedProgram, isLiteralSource);
+#ifdef PROFILE_EXEC
+                scriptContext->ProfileEnd(Js::RegexCompilePhase);
+#endif
+                return pattern;
+            }
+            flags = UnifiedRegex::NoRegexFlags;
+        }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
         if (REGEX_CONFIG_FLAG(RegexProfile))
             scriptContext->GetRegexStatsDatabase()->BeginProfile();
@@ -218,10 +234,10 @@ namespace Js
         }
 
         const auto recycler = scriptContext->GetRecycler();
-        UnifiedRegex::Program* program = UnifiedRegex::Program::New(recycler, flags);
+        UnifiedRegex::Program* program = cacheCompile.NewProgram(flags);
         parser.CaptureSourceAndGroups(recycler, program, psz, csz);
 
-        UnifiedRegex::RegexPattern* pattern = UnifiedRegex::RegexPattern::New(scriptContext, program, isLiteralSource);
+        UnifiedRegex::RegexPattern* pattern = cacheCompile.NewPattern(program, isLiteralSource);
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
         if (REGEX_CONFIG_FLAG(RegexProfile))
@@ -243,7 +259,7 @@ namespace Js
         UnifiedRegex::Compiler::Compile
             ( scriptContext
             , ctAllocator
-            , rtAllocator
+            , cacheCompile.GetRuntimeAllocator()
             , standardChars
             , program
             , root
@@ -254,6 +270,7 @@ namespace Js
             , stats
 #endif
             );
+        cacheCompile.Publish();
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
         if (REGEX_CONFIG_FLAG(RegexProfile))
@@ -364,6 +364,7 @@ enum tagDEBUG_EVENT_INFO_TYPE
 #endif
 
 #include "Base/SourceHolder.h"
+#include "Base/SharedSource.h"
 #include "Base/Utf8SourceInfo.h"
 #include "Base/PropertyRecord.h"
 #ifdef ENABLE_GLOBALIZATION
@@ -408,6 +409,7 @@ enum tagDEBUG_EVENT_INFO_TYPE
 #include "Debug/SourceContextInfo.h"
 #include "Language/InlineCache.h"
 #include "Language/InlineCachePointerArray.h"
+#include "Language/InterpreterOpcodeProfile.h"
 #include "Base/FunctionInfo.h"
 #include "Base/FunctionBody.h"
 #include "Language/JavascriptExceptionContext.h"
@@ -489,6 +491,7 @@ enum tagDEBUG_EVENT_INFO_TYPE
 #include "Library/ConcatString.h"
 #include "Library/CompoundString.h"
 #include "Library/PropertyString.h"
+#include "Library/AsciiString.h"
 
 #include "Library/JavascriptTypedNumber.h"
 #include "Library/SparseArraySegment.h"
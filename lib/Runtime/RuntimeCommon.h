@@ -196,7 +196,7 @@ namespace Js
 
 namespace JSON
 {
-    class JSONParser;
+    template <typename CharType> class JSONParser;
 }
 
 //
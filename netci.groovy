@@ -113,7 +113,7 @@ def CreateBuildTasks = { machine, configTag, buildExtra, testExtra, runCodeAnaly
     }
 }
 
-def CreateLinuxBuildTasks = { machine, configTag, linuxBranch, nonDefaultTaskSetup ->
+def CreateLinuxBuildTasks = { machine, configTag, linuxBranch, buildExtra, nonDefaultTaskSetup ->
     [true, false].each { isPR ->
         ['debug', 'test', 'release'].each { buildType ->
             [true, false].each { staticBuild ->
@@ -130,6 +130,7 @@ def CreateLinuxBuildTasks = { machine, configTag, linuxBranch, nonDefaultTaskSet
                 def buildFlag = buildType == "release" ? "" : (buildType == "debug" ? "--debug" : "--test-build")
                 def staticFlag = staticBuild ? "--static" : ""
                 def buildScript = "bash ./build.sh ${staticFlag} -j=`nproc` ${buildFlag} --cxx=/usr/bin/clang++-3.8 --cc=/usr/bin/clang-3.8"
+                buildScript += buildExtra ? " ${buildExtra}" : ''
                 def testScript = "bash test/runtests.sh"
 
                 def newJob = job(jobName) {
@@ -258,14 +259,21 @@ if (branch.startsWith('linux') || branch.startsWith('master')) {
     def osString = 'Ubuntu16.04'
 
     // PR and CI checks
-    CreateLinuxBuildTasks(osString, "ubuntu", branch, null)
+    CreateLinuxBuildTasks(osString, "ubuntu", branch, null, null)
 
     // daily builds - explicit branch names only
     if (branch in ['linux', 'master']) {
-        CreateLinuxBuildTasks(osString, "daily_ubuntu", branch,
+        CreateLinuxBuildTasks(osString, "daily_ubuntu", branch, null,
             /* nonDefaultTaskSetup */ { newJob, isPR, config ->
                 DailyBuildTaskSetup(newJob, isPR,
                     "Ubuntu ${config}",
                     'linux\\s+tests')})
+
+        // The interpreter and regex matcher loops as MSVC builds them, with a switch rather than computed gotos
+        CreateLinuxBuildTasks(osString, "daily_ubuntu_switch_dispatch", branch, '--switch-dispatch',
+            /* nonDefaultTaskSetup */ { newJob, isPR, config ->
+                DailyBuildTaskSetup(newJob, isPR,
+                    "Ubuntu ${config}",
+                    '(linux|switch)\\s+tests')})
     }
 }
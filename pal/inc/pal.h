@@ -3560,6 +3560,8 @@ SetErrorMode(
 #define MEM_WRITE_WATCH                 0x200000
 #define MEM_RESERVE_EXECUTABLE          0x40000000 // reserve memory using executable memory allocator
 
+#define WRITE_WATCH_FLAG_RESET          0x01
+
 PALIMPORT
 HANDLE
 PALAPI
@@ -32,6 +32,7 @@ Abstract:
 #include "pal/init.h"
 #include "pal/process.h"
 #include "pal/debug.h"
+#include "pal/virtual.h"
 
 #include <signal.h>
 #include <errno.h>
@@ -271,6 +272,13 @@ static void sigsegv_handler(int code, siginfo_t *siginfo, void *context)
 {
     if (PALIsInitialized())
     {
+        // First write to a clean page of a MEM_WRITE_WATCH region: the page
+        // has been recorded as written and made writable, retry the write.
+        if (VIRTUALHandleWriteWatchFault((UINT_PTR)siginfo->si_addr))
+        {
+            return;
+        }
+
         EXCEPTION_RECORD record;
         EXCEPTION_POINTERS pointers;
         native_context_t *ucontext;
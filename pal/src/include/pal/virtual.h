@@ -46,6 +46,10 @@ typedef struct _CMI {
     BYTE * pDirtyPages;         /* Pages that need to be cleared if re-committed */
 #endif // MMAP_DOESNOT_ALLOW_REMAP
 
+    BYTE * pWriteWatchState;    /* Pages written since the last write watch reset. */
+                                /* NULL if the region was not reserved with MEM_WRITE_WATCH. */
+    struct _CMI * pNextWriteWatch; /* Link to the next write watched region. */
+
 }CMI, * PCMI;
 
 enum VIRTUAL_CONSTANTS
@@ -102,6 +106,19 @@ Function :
 --*/
 BOOL VIRTUALOwnedRegion( IN UINT_PTR address );
 
+/*++
+Function :
+    VIRTUALHandleWriteWatchFault
+
+    Called from the SIGSEGV handler. Records the first write to a clean
+    page of a MEM_WRITE_WATCH region and makes the page writable again.
+
+    Returns TRUE if the fault was a write watch fault and execution can
+    resume, FALSE otherwise. Does not take virtual_critsec, so it can run
+    while any thread (including the faulting one) owns it.
+--*/
+BOOL VIRTUALHandleWriteWatchFault( IN UINT_PTR address );
+
 
 #ifdef __cplusplus
 }
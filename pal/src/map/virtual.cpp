@@ -36,6 +36,7 @@ Abstract:
 #include <string.h>
 #include <unistd.h>
 #include <limits.h>
+#include <sched.h>
 
 #if HAVE_VM_ALLOCATE
 #include <mach/vm_map.h>
@@ -59,6 +60,51 @@ typedef struct FREE_BLOCK {
 // The first node in our list of allocated blocks.
 static PCMI pVirtualMemory;
 
+// Write watch (MEM_WRITE_WATCH) is emulated with page protection: clean pages
+// of a write watched region that are committed as writable are kept read-only,
+// and the first write to such a page is recorded by the SIGSEGV handler (see
+// VIRTUALHandleWriteWatchFault). Platforms using Mach exceptions don't route
+// access violations through our signal handler, so the emulation is not
+// available there.
+//
+// The fault handler can't take virtual_critsec: the faulting thread may be
+// blocked on it behind a thread that is waiting for the faulting thread.
+// Instead, the write watched regions are kept on their own list, and the
+// list, the written page bitmaps and the protection of clean pages are only
+// changed under writeWatchLock. That lock is a spin lock that is never held
+// while touching memory that may be write watched, so the handler can always
+// acquire it.
+//
+// Every run of write protected pages splits its mapping, and the kernel
+// caps the number of mappings per process (vm.max_map_count). A write in
+// the middle of a protected run splits it again, so a large heap written
+// sparsely would run out of mappings, and mprotect would fail inside the
+// fault handler. The number of protected runs is therefore kept under
+// VIRTUAL_WRITE_WATCH_MAX_PROTECTED_RUNS: past that budget, or if mprotect
+// fails, whole runs are left writable and reported as written, so that
+// the caller rescans them instead.
+//
+// Writes made by the kernel (e.g. read(2) into a clean write watched page)
+// don't raise SIGSEGV; the system call fails with EFAULT instead. Callers
+// must not pass write watched memory to system calls, which the recycler
+// never does with its heap pages.
+#if !HAVE_MACH_EXCEPTIONS
+#define VIRTUAL_WRITE_WATCH_SUPPORTED 1
+#else
+#define VIRTUAL_WRITE_WATCH_SUPPORTED 0
+#endif
+
+// The first node in our list of write watched blocks.
+static PCMI pWriteWatchMemory;
+static LONG writeWatchLock;
+
+// Each protected run costs up to two mappings; this keeps write watch well
+// under the default vm.max_map_count of 65530.
+#define VIRTUAL_WRITE_WATCH_MAX_PROTECTED_RUNS 16384
+
+// The number of runs of write protected pages in all write watched regions.
+static SIZE_T writeWatchProtectedRuns;
+
 #if MMAP_IGNORES_HINT
 // The first node in our list of freed blocks.
 static FREE_BLOCK *pFreeMemory PAL_GLOBAL;
@@ -526,6 +572,217 @@ static BOOL VIRTUALSetDirtyPages( UINT nStatus, SIZE_T nStartingBit,
 }
 #endif // MMAP_DOESNOT_ALLOW_REMAP
 
+/****
+ *
+ * VIRTUALAcquireWriteWatchLock, VIRTUALReleaseWriteWatchLock
+ *
+ *  Guard the write watch state shared with the SIGSEGV handler.
+ *  Nothing done under the lock may fault on a write watched page.
+ *
+ */
+static void VIRTUALAcquireWriteWatchLock()
+{
+    while ( InterlockedCompareExchange( &writeWatchLock, 1, 0 ) != 0 )
+    {
+        sched_yield();
+    }
+}
+
+static void VIRTUALReleaseWriteWatchLock()
+{
+    InterlockedExchange( &writeWatchLock, 0 );
+}
+
+/****
+ *
+ * VIRTUALIsPageWritten
+ *
+ *  SIZE_T nBitToRetrieve - Which page to check.
+ *
+ *  Returns TRUE if the page of a write watched region was written since
+ *  the last write watch reset, FALSE otherwise.
+ *
+ */
+static BOOL VIRTUALIsPageWritten( SIZE_T nBitToRetrieve, CONST PCMI pInformation )
+{
+    SIZE_T nByteOffset = nBitToRetrieve / CHAR_BIT;
+    UINT byteMask = 1 << ( nBitToRetrieve % CHAR_BIT );
+
+    return ( pInformation->pWriteWatchState[ nByteOffset ] & byteMask ) != 0;
+}
+
+/****
+ *
+ * VIRTUALIsWritableProtection
+ *
+ *  Returns TRUE for the protection states that write watch tracks.
+ *
+ */
+static BOOL VIRTUALIsWritableProtection( BYTE protectionState )
+{
+    return protectionState == VIRTUAL_READWRITE ||
+           protectionState == VIRTUAL_EXECUTE_READWRITE;
+}
+
+/****
+ *
+ * VIRTUALIsPageWriteProtected
+ *
+ *  SIZE_T nPage - The page to check; may be past either end of the region.
+ *
+ *  Returns TRUE if the page is committed, writable and clean, which are
+ *  the pages that write watch keeps read-only.
+ *  NOTE: Safe to call from the fault handler.
+ *
+ */
+static BOOL VIRTUALIsPageWriteProtected( SIZE_T nPage, CONST PCMI pInformation )
+{
+    return nPage < pInformation->memSize / VIRTUAL_PAGE_SIZE &&
+           VIRTUALIsPageCommitted( nPage, pInformation ) &&
+           VIRTUALIsWritableProtection( pInformation->pProtectionState[ nPage ] ) &&
+           !VIRTUALIsPageWritten( nPage, pInformation );
+}
+
+/****
+ *
+ * VIRTUALCountProtectedRuns
+ *
+ *  IN SIZE_T nStartingPage - The first page of the range.
+ *  IN SIZE_T nNumberOfPages - The number of pages in the range.
+ *  IN PCMI pInformation - The write watched region.
+ *
+ *  Returns the number of runs of write protected pages that overlap the
+ *  range or the pages on either side of it. Counting these before and
+ *  after the range changes gives the change in the region's runs.
+ *  NOTE: Safe to call from the fault handler.
+ *
+ */
+static SIZE_T VIRTUALCountProtectedRuns( SIZE_T nStartingPage,
+                                         SIZE_T nNumberOfPages, CONST PCMI pInformation )
+{
+    SIZE_T first = nStartingPage != 0 ? nStartingPage - 1 : 0;
+    SIZE_T last = nStartingPage + nNumberOfPages;
+    SIZE_T index;
+    SIZE_T runs = 0;
+    BOOL previousProtected = FALSE;
+
+    for ( index = first; index <= last; index++ )
+    {
+        BOOL isProtected = VIRTUALIsPageWriteProtected( index, pInformation );
+        if ( isProtected && !previousProtected )
+        {
+            runs++;
+        }
+        previousProtected = isProtected;
+    }
+
+    return runs;
+}
+
+/****
+ *
+ * VIRTUALUntrackProtectedRuns, VIRTUALTrackProtectedRuns
+ *
+ *  Bracket a change to the commit, protection or written state of a range
+ *  of a write watched region, so that writeWatchProtectedRuns follows it.
+ *  Does nothing for regions that are not write watched.
+ *  NOTE: The caller must own the write watch lock.
+ *
+ */
+static void VIRTUALUntrackProtectedRuns( SIZE_T nStartingPage,
+                                         SIZE_T nNumberOfPages, CONST PCMI pInformation )
+{
+    if ( pInformation->pWriteWatchState != NULL )
+    {
+        writeWatchProtectedRuns -= VIRTUALCountProtectedRuns( nStartingPage, nNumberOfPages, pInformation );
+    }
+}
+
+static void VIRTUALTrackProtectedRuns( SIZE_T nStartingPage,
+                                       SIZE_T nNumberOfPages, CONST PCMI pInformation )
+{
+    if ( pInformation->pWriteWatchState != NULL )
+    {
+        writeWatchProtectedRuns += VIRTUALCountProtectedRuns( nStartingPage, nNumberOfPages, pInformation );
+    }
+}
+
+/****
+ *
+ * VIRTUALWriteProtectCleanPages
+ *
+ *  IN SIZE_T nStartingPage - The first page to re-arm.
+ *  IN SIZE_T nNumberOfPages - The number of pages to re-arm.
+ *  IN PCMI pInformation - The write watched region.
+ *
+ *  Committed, writable pages that were not written since the last reset
+ *  are made read-only so that the next write to them is recorded. Each
+ *  run of such pages takes a single mprotect. Runs that would take write
+ *  watch over its protected run budget, or that mprotect fails on, are
+ *  left writable and marked as written instead.
+ *  Does nothing for regions that are not write watched.
+ *
+ *  NOTE: The caller must own the critical section and the write watch lock,
+ *  and bracket the call with VIRTUALUntrackProtectedRuns and
+ *  VIRTUALTrackProtectedRuns.
+ */
+static void VIRTUALWriteProtectCleanPages( SIZE_T nStartingPage,
+                                           SIZE_T nNumberOfPages, CONST PCMI pInformation )
+{
+    SIZE_T index;
+    SIZE_T runStart = 0;
+    SIZE_T runLength = 0;
+    SIZE_T runsAdded = 0;
+    BYTE runProtection = 0;
+
+    if ( pInformation->pWriteWatchState == NULL )
+    {
+        return;
+    }
+
+    /* Find runs of clean pages with the same protection; the extra iteration
+       past the end of the range flushes the last run. */
+    for ( index = nStartingPage; index <= nStartingPage + nNumberOfPages; index++ )
+    {
+        BOOL isClean = index < nStartingPage + nNumberOfPages &&
+            VIRTUALIsPageWriteProtected( index, pInformation );
+
+        if ( isClean && runLength != 0 &&
+             pInformation->pProtectionState[ index ] == runProtection )
+        {
+            runLength++;
+            continue;
+        }
+
+        if ( runLength != 0 )
+        {
+            INT nProtect = ( runProtection == VIRTUAL_EXECUTE_READWRITE ) ?
+                ( PROT_READ | PROT_EXEC ) : PROT_READ;
+
+            if ( writeWatchProtectedRuns + runsAdded >= VIRTUAL_WRITE_WATCH_MAX_PROTECTED_RUNS ||
+                 mprotect( (void *)( pInformation->startBoundary + runStart * VIRTUAL_PAGE_SIZE ),
+                           runLength * VIRTUAL_PAGE_SIZE, nProtect ) != 0 )
+            {
+                WARN( "Leaving %d write watched pages writable (%d protected runs, errno %d)\n",
+                      runLength, writeWatchProtectedRuns + runsAdded, errno );
+                VIRTUALSetPageBits( 1, runStart, runLength, pInformation->pWriteWatchState );
+            }
+            else
+            {
+                runsAdded++;
+            }
+            runLength = 0;
+        }
+
+        if ( isClean )
+        {
+            runStart = index;
+            runLength = 1;
+            runProtection = pInformation->pProtectionState[ index ];
+        }
+    }
+}
+
 
 /****
  *
@@ -599,6 +856,22 @@ static BOOL VIRTUALReleaseMemory( PCMI pMemoryToBeReleased )
         return FALSE;
     }
 
+    if ( pMemoryToBeReleased->pWriteWatchState )
+    {
+        PCMI * ppLink = &pWriteWatchMemory;
+
+        /* Unlink the region before its state goes away, so the fault
+           handler can't find it anymore. */
+        VIRTUALAcquireWriteWatchLock();
+        while ( *ppLink != pMemoryToBeReleased )
+        {
+            ppLink = &( *ppLink )->pNextWriteWatch;
+        }
+        *ppLink = pMemoryToBeReleased->pNextWriteWatch;
+        VIRTUALUntrackProtectedRuns( 0, pMemoryToBeReleased->memSize / VIRTUAL_PAGE_SIZE, pMemoryToBeReleased );
+        VIRTUALReleaseWriteWatchLock();
+    }
+
     if ( pMemoryToBeReleased == pVirtualMemory )
     {
         /* This is either the first entry, or the only entry. */
@@ -639,6 +912,12 @@ static BOOL VIRTUALReleaseMemory( PCMI pMemoryToBeReleased )
     pMemoryToBeReleased->pDirtyPages = NULL;
 #endif // MMAP_DOESNOT_ALLOW_REMAP
 
+    if ( pMemoryToBeReleased->pWriteWatchState )
+    {
+        InternalFree( pMemoryToBeReleased->pWriteWatchState );
+        pMemoryToBeReleased->pWriteWatchState = NULL;
+    }
+
     InternalFree( pMemoryToBeReleased );
     pMemoryToBeReleased = NULL;
 
@@ -822,17 +1101,28 @@ static BOOL VIRTUALStoreAllocationInfo(
 #if MMAP_DOESNOT_ALLOW_REMAP
     pNewEntry->pDirtyPages  = (BYTE*)InternalMalloc( nBufferSize );
 #endif // 
+    pNewEntry->pWriteWatchState = NULL;
+    pNewEntry->pNextWriteWatch = NULL;
+    if ( flAllocationType & MEM_WRITE_WATCH )
+    {
+        pNewEntry->pWriteWatchState = (BYTE*)InternalMalloc( nBufferSize );
+    }
 
     if ( pNewEntry->pAllocState && pNewEntry->pProtectionState 
 #if MMAP_DOESNOT_ALLOW_REMAP
         && pNewEntry->pDirtyPages
 #endif // MMAP_DOESNOT_ALLOW_REMAP
+        && ( !( flAllocationType & MEM_WRITE_WATCH ) || pNewEntry->pWriteWatchState )
       )
     {
         /* Set the intial allocation state, and initial allocation protection. */
 #if MMAP_DOESNOT_ALLOW_REMAP
         memset (pNewEntry->pDirtyPages, 0, nBufferSize);
 #endif // MMAP_DOESNOT_ALLOW_REMAP
+        if ( pNewEntry->pWriteWatchState )
+        {
+            memset( pNewEntry->pWriteWatchState, 0, nBufferSize );
+        }
         VIRTUALSetAllocState( MEM_RESERVE, 0, nBufferSize * CHAR_BIT, pNewEntry );
         memset( pNewEntry->pProtectionState,
             VIRTUALConvertWinFlags( flProtection ),
@@ -848,6 +1138,9 @@ static BOOL VIRTUALStoreAllocationInfo(
         pNewEntry->pDirtyPages = NULL;
 #endif // 
 
+        if (pNewEntry->pWriteWatchState) InternalFree( pNewEntry->pWriteWatchState );
+        pNewEntry->pWriteWatchState = NULL;
+
         if (pNewEntry->pProtectionState) InternalFree( pNewEntry->pProtectionState );
         pNewEntry->pProtectionState = NULL;
         
@@ -895,6 +1188,14 @@ static BOOL VIRTUALStoreAllocationInfo(
         
         pVirtualMemory = pNewEntry ;
     }
+
+    if ( pNewEntry->pWriteWatchState )
+    {
+        VIRTUALAcquireWriteWatchLock();
+        pNewEntry->pNextWriteWatch = pWriteWatchMemory;
+        pWriteWatchMemory = pNewEntry;
+        VIRTUALReleaseWriteWatchLock();
+    }
 done:
     TRACE( "Exiting StoreAllocationInformation. \n" );
     return bRetVal;
@@ -1231,6 +1532,14 @@ static LPVOID VIRTUALCommitMemory(
                 goto error;
             }
             VIRTUALSetAllocState(MEM_COMMIT, runStart, runLength, pInformation);
+            if (pInformation->pWriteWatchState != NULL)
+            {
+                // Report freshly committed pages as written so that they start
+                // out writable instead of taking a fault on their first use.
+                VIRTUALAcquireWriteWatchLock();
+                VIRTUALSetPageBits(1, runStart, runLength, pInformation->pWriteWatchState);
+                VIRTUALReleaseWriteWatchLock();
+            }
 #if MMAP_DOESNOT_ALLOW_REMAP
             VIRTUALSetDirtyPages (0, runStart, runLength, pInformation);
 #endif // MMAP_DOESNOT_ALLOW_REMAP
@@ -1246,14 +1555,23 @@ static LPVOID VIRTUALCommitMemory(
         }
         if (protectionState != vProtect)
         {
-            // Change permissions.
+            // Change permissions. Clean write watched pages must not be
+            // seen writable by the fault handler until they are re-armed.
+            VIRTUALAcquireWriteWatchLock();
+            VIRTUALUntrackProtectedRuns(runStart, runLength, pInformation);
             if (mprotect((void *) StartBoundary, MemSize, nProtect) != -1)
             {
                 memset(pInformation->pProtectionState + runStart,
                        vProtect, runLength);
+
+                VIRTUALWriteProtectCleanPages(runStart, runLength, pInformation);
+                VIRTUALTrackProtectedRuns(runStart, runLength, pInformation);
+                VIRTUALReleaseWriteWatchLock();
             }
             else
             {
+                VIRTUALTrackProtectedRuns(runStart, runLength, pInformation);
+                VIRTUALReleaseWriteWatchLock();
                 ERROR("mprotect() failed! Error(%d)=%s\n",
                       errno, strerror(errno));
                 goto error;
@@ -1613,8 +1931,11 @@ Function:
   VirtualAlloc
 
 Note:
-  MEM_TOP_DOWN, MEM_PHYSICAL, MEM_WRITE_WATCH are not supported.
+  MEM_TOP_DOWN, MEM_PHYSICAL are not supported.
   Unsupported flags are ignored.
+
+  MEM_WRITE_WATCH is emulated with page protection where the PAL
+  handles SIGSEGV (see GetWriteWatch).
   
   Page size on i386 is set to 4k.
 
@@ -1637,17 +1958,23 @@ VirtualAlloc(
 
     pthrCurrent = InternalGetCurrentThread();
 
-    if ( ( flAllocationType & MEM_WRITE_WATCH )  != 0 )
+#if VIRTUAL_WRITE_WATCH_SUPPORTED
+    /* Write watch can only be requested when the region is reserved. */
+    if ( ( flAllocationType & MEM_WRITE_WATCH ) != 0 &&
+         ( flAllocationType & MEM_RESERVE ) == 0 )
+#else  // VIRTUAL_WRITE_WATCH_SUPPORTED
+    if ( ( flAllocationType & MEM_WRITE_WATCH ) != 0 )
+#endif // VIRTUAL_WRITE_WATCH_SUPPORTED
     {
         pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
         goto done;
     }
 
     /* Test for un-supported flags. */
-    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE ) ) != 0 )
+    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE | MEM_WRITE_WATCH ) ) != 0 )
     {
         ASSERT( "flAllocationType can be one, or any combination of MEM_COMMIT, \
-               MEM_RESERVE, MEM_TOP_DOWN, or MEM_RESERVE_EXECUTABLE.\n" );
+               MEM_RESERVE, MEM_TOP_DOWN, MEM_RESERVE_EXECUTABLE, or MEM_WRITE_WATCH.\n" );
         pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
         goto done;
     }
@@ -1831,8 +2158,12 @@ VirtualFree(
             index = (StartBoundary - pUnCommittedMem->startBoundary) / VIRTUAL_PAGE_SIZE;
             
             nNumOfPagesToChange = MemSize / VIRTUAL_PAGE_SIZE;
+            VIRTUALAcquireWriteWatchLock();
+            VIRTUALUntrackProtectedRuns( index, nNumOfPagesToChange, pUnCommittedMem );
             VIRTUALSetAllocState( MEM_RESERVE, index, 
                                   nNumOfPagesToChange, pUnCommittedMem ); 
+            VIRTUALTrackProtectedRuns( index, nNumOfPagesToChange, pUnCommittedMem );
+            VIRTUALReleaseWriteWatchLock();
 #if MMAP_DOESNOT_ALLOW_REMAP
             VIRTUALSetDirtyPages( 1, index, 
                                   nNumOfPagesToChange, pUnCommittedMem ); 
@@ -1989,6 +2320,11 @@ VirtualProtect(
         }
     }
 
+    VIRTUALAcquireWriteWatchLock();
+    if ( pEntry )
+    {
+        VIRTUALUntrackProtectedRuns( OffSet, NumberOfPagesToChange, pEntry );
+    }
     if ( 0 == mprotect( (LPVOID)StartBoundary, MemSize, 
                    W32toUnixAccessControl( flNewProtect ) ) )
     {
@@ -2008,15 +2344,25 @@ VirtualProtect(
             memset( pEntry->pProtectionState + OffSet, 
                     VIRTUALConvertWinFlags( flNewProtect ),
                     NumberOfPagesToChange );
+
+            /* Keep write watch armed on pages that were made writable again. */
+            VIRTUALWriteProtectCleanPages( OffSet, NumberOfPagesToChange, pEntry );
+            VIRTUALTrackProtectedRuns( OffSet, NumberOfPagesToChange, pEntry );
         }
         else
         {
             *lpflOldProtect = PAGE_EXECUTE_READWRITE;
         }
+        VIRTUALReleaseWriteWatchLock();
         bRetVal = TRUE;
     }
     else
     {
+        if ( pEntry )
+        {
+            VIRTUALTrackProtectedRuns( OffSet, NumberOfPagesToChange, pEntry );
+        }
+        VIRTUALReleaseWriteWatchLock();
         ERROR( "%s\n", strerror( errno ) );
         if ( errno == EINVAL )
         {
@@ -2311,11 +2657,68 @@ ExitVirtualQuery:
     return sizeof( *lpBuffer );
 }
 
+/*++
+Function:
+  VIRTUALFindWriteWatchRange
+
+  Locates the write watched region containing [lpBaseAddress, lpBaseAddress + dwRegionSize)
+  and returns the index and count of the pages it covers.
+  NOTE: The caller must own the critical section.
+--*/
+static PCMI VIRTUALFindWriteWatchRange(
+  IN LPVOID lpBaseAddress,
+  IN SIZE_T dwRegionSize,
+  OUT SIZE_T *pnStartingPage,
+  OUT SIZE_T *pnNumberOfPages)
+{
+    UINT_PTR StartBoundary = (UINT_PTR)lpBaseAddress & ~VIRTUAL_PAGE_MASK;
+    UINT_PTR EndBoundary = ((UINT_PTR)lpBaseAddress + dwRegionSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK;
+    PCMI pEntry = VIRTUALFindRegionInformation( StartBoundary );
+
+    if ( pEntry == NULL || pEntry->pWriteWatchState == NULL || dwRegionSize == 0 ||
+         EndBoundary > pEntry->startBoundary + pEntry->memSize )
+    {
+        return NULL;
+    }
+
+    *pnStartingPage = ( StartBoundary - pEntry->startBoundary ) / VIRTUAL_PAGE_SIZE;
+    *pnNumberOfPages = ( EndBoundary - StartBoundary ) / VIRTUAL_PAGE_SIZE;
+    return pEntry;
+}
+
+/*++
+Function:
+  VIRTUALResetWrittenPages
+
+  Clears the written state of a range of pages of a write watched region
+  and write protects the clean ones again.
+  NOTE: The caller must own the critical section.
+--*/
+static void VIRTUALResetWrittenPages(
+  IN SIZE_T nStartingPage,
+  IN SIZE_T nNumberOfPages,
+  IN PCMI pEntry)
+{
+    VIRTUALAcquireWriteWatchLock();
+    VIRTUALUntrackProtectedRuns( nStartingPage, nNumberOfPages, pEntry );
+    VIRTUALSetPageBits( 0, nStartingPage, nNumberOfPages, pEntry->pWriteWatchState );
+    VIRTUALWriteProtectCleanPages( nStartingPage, nNumberOfPages, pEntry );
+    VIRTUALTrackProtectedRuns( nStartingPage, nNumberOfPages, pEntry );
+    VIRTUALReleaseWriteWatchLock();
+}
+
 /*++
 Function:
   GetWriteWatch
 
 See MSDN doc.
+
+  Pages are reported once they were written since the last reset, or
+  committed since then. Pages that write watch could not keep protected
+  are reported too, whether they were written or not (see the note at the
+  top of this file). The range must lie within a single region that was
+  reserved with MEM_WRITE_WATCH. Writes made by system calls are not
+  tracked: they fail with EFAULT on clean pages.
 --*/
 UINT 
 PALAPI 
@@ -2328,11 +2731,87 @@ GetWriteWatch(
   OUT PULONG lpdwGranularity
 )
 {
-    // TODO: implement this method
-    *lpAddresses = NULL;
-    *lpdwCount = 0;
-    // Until it is implemented, return non-zero value as an indicator of failure
-    return 1;
+    UINT uRetVal = 1;
+    PCMI pEntry = NULL;
+    SIZE_T nStartingPage = 0;
+    SIZE_T nNumberOfPages = 0;
+    SIZE_T index;
+    SIZE_T resetRunStart = 0;
+    SIZE_T resetRunLength = 0;
+    ULONG_PTR count = 0;
+    CPalThread * pthrCurrent;
+
+    PERF_ENTRY(GetWriteWatch);
+    ENTRY("GetWriteWatch(dwFlags=%#x, lpBaseAddress=%p, dwRegionSize=%u, "
+          "lpAddresses=%p, lpdwCount=%p, lpdwGranularity=%p)\n",
+          dwFlags, lpBaseAddress, dwRegionSize, lpAddresses, lpdwCount, lpdwGranularity);
+
+    pthrCurrent = InternalGetCurrentThread();
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+
+    if ( ( dwFlags & ~WRITE_WATCH_FLAG_RESET ) != 0 || lpAddresses == NULL ||
+         lpdwCount == NULL || lpdwGranularity == NULL )
+    {
+        ERROR( "Invalid parameter.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        goto ExitGetWriteWatch;
+    }
+
+    pEntry = VIRTUALFindWriteWatchRange( lpBaseAddress, dwRegionSize,
+                                         &nStartingPage, &nNumberOfPages );
+    if ( pEntry == NULL )
+    {
+        ERROR( "The region was not reserved with MEM_WRITE_WATCH.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        goto ExitGetWriteWatch;
+    }
+
+    for ( index = nStartingPage;
+          index < nStartingPage + nNumberOfPages && count < *lpdwCount; index++ )
+    {
+        /* A page being written concurrently may or may not be reported,
+           as with write watch on Windows. */
+        if ( !VIRTUALIsPageWritten( index, pEntry ) )
+        {
+            if ( resetRunLength != 0 )
+            {
+                VIRTUALResetWrittenPages( resetRunStart, resetRunLength, pEntry );
+                resetRunLength = 0;
+            }
+            continue;
+        }
+
+        /* Only the reported pages are reset, so that pages that did not fit
+           in the caller's buffer are reported by the next call. Consecutive
+           reported pages are reset together. */
+        if ( dwFlags & WRITE_WATCH_FLAG_RESET )
+        {
+            if ( resetRunLength == 0 )
+            {
+                resetRunStart = index;
+            }
+            resetRunLength++;
+        }
+
+        /* Outside of the write watch lock: the caller's buffer may itself
+           be write watched. */
+        lpAddresses[ count++ ] = (PVOID)( pEntry->startBoundary + index * VIRTUAL_PAGE_SIZE );
+    }
+
+    if ( resetRunLength != 0 )
+    {
+        VIRTUALResetWrittenPages( resetRunStart, resetRunLength, pEntry );
+    }
+
+    *lpdwCount = count;
+    *lpdwGranularity = VIRTUAL_PAGE_SIZE;
+    uRetVal = 0;
+
+ExitGetWriteWatch:
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    LOGEXIT( "GetWriteWatch returning %u.\n", uRetVal );
+    PERF_EXIT(GetWriteWatch);
+    return uRetVal;
 }
 
 /*++
@@ -2348,9 +2827,154 @@ ResetWriteWatch(
   IN SIZE_T dwRegionSize
 )
 {
-    // TODO: implement this method
-    // Until it is implemented, return non-zero value as an indicator of failure
-    return 1;
+    UINT uRetVal = 1;
+    PCMI pEntry = NULL;
+    SIZE_T nStartingPage = 0;
+    SIZE_T nNumberOfPages = 0;
+    CPalThread * pthrCurrent;
+
+    PERF_ENTRY(ResetWriteWatch);
+    ENTRY("ResetWriteWatch(lpBaseAddress=%p, dwRegionSize=%u)\n",
+          lpBaseAddress, dwRegionSize);
+
+    pthrCurrent = InternalGetCurrentThread();
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+
+    pEntry = VIRTUALFindWriteWatchRange( lpBaseAddress, dwRegionSize,
+                                         &nStartingPage, &nNumberOfPages );
+    if ( pEntry == NULL )
+    {
+        ERROR( "The region was not reserved with MEM_WRITE_WATCH.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        goto ExitResetWriteWatch;
+    }
+
+    VIRTUALResetWrittenPages( nStartingPage, nNumberOfPages, pEntry );
+    uRetVal = 0;
+
+ExitResetWriteWatch:
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    LOGEXIT( "ResetWriteWatch returning %u.\n", uRetVal );
+    PERF_EXIT(ResetWriteWatch);
+    return uRetVal;
+}
+
+/*++
+Function :
+    VIRTUALHandleWriteWatchFault
+
+    See virtual.h.
+
+    Runs in the signal handler, so it only takes the write watch lock and
+    leaves the rest of the PAL alone.
+--*/
+BOOL VIRTUALHandleWriteWatchFault( IN UINT_PTR address )
+{
+#if VIRTUAL_WRITE_WATCH_SUPPORTED
+    BOOL bRetVal = FALSE;
+    PCMI pEntry = NULL;
+    SIZE_T index;
+    SIZE_T runStart;
+    SIZE_T runEnd;
+    SIZE_T page;
+    BYTE protectionState;
+    INT nProtect;
+
+    VIRTUALAcquireWriteWatchLock();
+
+    for ( pEntry = pWriteWatchMemory; pEntry != NULL; pEntry = pEntry->pNextWriteWatch )
+    {
+        if ( address >= pEntry->startBoundary &&
+             address < pEntry->startBoundary + pEntry->memSize )
+        {
+            break;
+        }
+    }
+
+    if ( pEntry == NULL )
+    {
+        goto ExitHandleWriteWatchFault;
+    }
+
+    index = ( address - pEntry->startBoundary ) / VIRTUAL_PAGE_SIZE;
+    protectionState = pEntry->pProtectionState[ index ];
+    nProtect = W32toUnixAccessControl( VIRTUALConvertVirtualFlags( protectionState ) );
+
+    /* Clean writable pages are the only ones we write protect, so any other
+       fault in the region is a genuine access violation. If the page is
+       already marked as written, another thread raced us to it and made it
+       writable before releasing the lock; the write is simply retried. */
+    if ( !VIRTUALIsPageCommitted( index, pEntry ) ||
+         !VIRTUALIsWritableProtection( protectionState ) )
+    {
+        goto ExitHandleWriteWatchFault;
+    }
+
+    if ( VIRTUALIsPageWritten( index, pEntry ) )
+    {
+        bRetVal = TRUE;
+        goto ExitHandleWriteWatchFault;
+    }
+
+    /* Making a page in the middle of a protected run writable splits the
+       run. Within the budget, only the faulting page is made writable. */
+    if ( !( index != 0 && VIRTUALIsPageWriteProtected( index - 1, pEntry ) &&
+         VIRTUALIsPageWriteProtected( index + 1, pEntry ) ) ||
+         writeWatchProtectedRuns < VIRTUAL_WRITE_WATCH_MAX_PROTECTED_RUNS )
+    {
+        runStart = index;
+        runEnd = index + 1;
+        writeWatchProtectedRuns -= VIRTUALCountProtectedRuns( runStart, runEnd - runStart, pEntry );
+        if ( mprotect( (void *)( pEntry->startBoundary + index * VIRTUAL_PAGE_SIZE ),
+                       VIRTUAL_PAGE_SIZE, nProtect ) == 0 )
+        {
+            goto MarkWritten;
+        }
+
+        /* Out of mappings; fall back to the whole run */
+        writeWatchProtectedRuns += VIRTUALCountProtectedRuns( runStart, runEnd - runStart, pEntry );
+    }
+
+    /* Make the whole run writable, which merges mappings instead of splitting
+       them, and report all of it as written. Runs are bounded by pages of a
+       different protection, so the run is a single mapping. */
+    runStart = index;
+    while ( runStart != 0 && VIRTUALIsPageWriteProtected( runStart - 1, pEntry ) &&
+            pEntry->pProtectionState[ runStart - 1 ] == protectionState )
+    {
+        runStart--;
+    }
+    runEnd = index + 1;
+    while ( VIRTUALIsPageWriteProtected( runEnd, pEntry ) &&
+            pEntry->pProtectionState[ runEnd ] == protectionState )
+    {
+        runEnd++;
+    }
+
+    writeWatchProtectedRuns -= VIRTUALCountProtectedRuns( runStart, runEnd - runStart, pEntry );
+    if ( mprotect( (void *)( pEntry->startBoundary + runStart * VIRTUAL_PAGE_SIZE ),
+                   ( runEnd - runStart ) * VIRTUAL_PAGE_SIZE, nProtect ) != 0 )
+    {
+        writeWatchProtectedRuns += VIRTUALCountProtectedRuns( runStart, runEnd - runStart, pEntry );
+        goto ExitHandleWriteWatchFault;
+    }
+
+MarkWritten:
+    /* Only once the pages are writable: a page marked written is never
+       faulted on again. */
+    for ( page = runStart; page < runEnd; page++ )
+    {
+        pEntry->pWriteWatchState[ page / CHAR_BIT ] |= ( 1 << ( page % CHAR_BIT ) );
+    }
+    writeWatchProtectedRuns += VIRTUALCountProtectedRuns( runStart, runEnd - runStart, pEntry );
+    bRetVal = TRUE;
+
+ExitHandleWriteWatchFault:
+    VIRTUALReleaseWriteWatchLock();
+    return bRetVal;
+#else  // VIRTUAL_WRITE_WATCH_SUPPORTED
+    return FALSE;
+#endif // VIRTUAL_WRITE_WATCH_SUPPORTED
 }
 
 /*++
@@ -2902,3 +2902,47 @@ bool IsAddressOnStack(ULONG_PTR address)
 
     return false;
 }
+
+uintptr_t _beginthreadex(
+   void *security,
+   unsigned stack_size,
+   unsigned ( __stdcall *start_address )( void * ),
+   void *arglist,
+   unsigned initflag,
+   unsigned *thrdaddr)
+{
+    // CreateThread takes the same start routine shape here, and already accepts
+    // CREATE_SUSPENDED and ignores STACK_SIZE_PARAM_IS_A_RESERVATION
+    DWORD threadId = 0;
+    HANDLE threadHandle = CreateThread(
+        static_cast<LPSECURITY_ATTRIBUTES>(security),
+        stack_size,
+        reinterpret_cast<LPTHREAD_START_ROUTINE>(start_address),
+        arglist,
+        initflag,
+        &threadId);
+
+    if (threadHandle == NULL)
+    {
+        return 0;
+    }
+
+    if (thrdaddr != NULL)
+    {
+        *thrdaddr = threadId;
+    }
+    return reinterpret_cast<uintptr_t>(threadHandle);
+}
+
+BOOL GetModuleHandleEx(
+  DWORD dwFlags,
+  LPCWSTR lpModuleName,
+  HMODULE *phModule)
+{
+    // Threads use this to pin the engine module while they run. The engine is never
+    // unloaded from under a running thread here, so report no module and let callers
+    // fall back to returning from the thread procedure.
+    *phModule = NULL;
+    SetLastError(ERROR_MOD_NOT_FOUND);
+    return FALSE;
+}
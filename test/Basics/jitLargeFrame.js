@@ -0,0 +1,42 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Jitted functions whose frames are larger than a page, so the prolog probes the stack a page at a time. Every
+// local is live across a call, which keeps it in a stack slot.
+function write(v) { WScript.Echo(v + ""); }
+
+function id(x) { return x; }
+
+function makeLargeFrame(count) {
+    var body = [];
+    for (var i = 0; i < count; i++) {
+        body.push("var v" + i + " = id(n + " + i + ") * 0.5;");
+    }
+    var sum = [];
+    for (var i = 0; i < count; i++) {
+        sum.push("v" + i);
+    }
+    body.push("return " + sum.join(" + ") + ";");
+    return new Function("n", "id", body.join("\n"));
+}
+
+var small = makeLargeFrame(600);       // A few pages of spilled doubles
+var large = makeLargeFrame(3000);      // Several times as many
+
+function callFromDeepStack(f, depth, n) {
+    if (depth > 0) {
+        return callFromDeepStack(f, depth - 1, n);
+    }
+    return f(n, id);
+}
+
+for (var i = 0; i < 20; i++) {
+    var a = small(i, id);
+    var b = large(i, id);
+    var c = callFromDeepStack(large, 200, i);
+    if (i % 5 === 0 || i === 19) {
+        write(i + ": " + a + " " + b + " " + c);
+    }
+}
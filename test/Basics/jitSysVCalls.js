@@ -0,0 +1,59 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Jitted calls with more arguments than the System V argument registers hold: more than 6 integer and more than
+// 8 double arguments, mixed, through script calls and through helpers, with doubles live across the calls.
+function write(v) { WScript.Echo(v + ""); }
+
+function ints(a, b, c, d, e, f, g, h, i, j) {
+    return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * f + 7 * g + 8 * h + 9 * i + 10 * j;
+}
+
+function doubles(a, b, c, d, e, f, g, h, i, j, k) {
+    return a * 1.5 + b * 2.5 + c * 3.5 + d * 4.5 + e * 5.5 + f * 6.5 + g * 7.5 + h * 8.5 + i * 9.5 + j * 10.5 + k * 11.5;
+}
+
+function mixed(a, x, b, y, c, z, d, w, e, v, f, u, g, t, h, s, i, r) {
+    return [a + b + c + d + e + f + g + h + i, x + y + z + w + v + u + t + s + r].join(",");
+}
+
+// Sixteen doubles stay live across each call, more than the xmm registers a call preserves
+function liveAcrossCalls(n) {
+    var d0 = n + 0.5, d1 = n + 1.5, d2 = n + 2.5, d3 = n + 3.5, d4 = n + 4.5, d5 = n + 5.5, d6 = n + 6.5, d7 = n + 7.5;
+    var d8 = n + 8.5, d9 = n + 9.5, d10 = n + 10.5, d11 = n + 11.5, d12 = n + 12.5, d13 = n + 13.5, d14 = n + 14.5, d15 = n + 15.5;
+    var calls = ints(1, 2, 3, 4, 5, 6, 7, 8, 9, n);
+    calls += doubles(d0, d1, d2, d3, d4, d5, d6, d7, d8, d9, d10);
+    calls += Math.pow(d11, 2) + Math.sqrt(d12 * d12);
+    return calls + d0 + d1 + d2 + d3 + d4 + d5 + d6 + d7 + d8 + d9 + d10 + d11 + d12 + d13 + d14 + d15;
+}
+
+// Helpers with many operands: polymorphic property stores, string concatenation, Math with many arguments
+function helpers(o, i) {
+    o["p" + (i % 3)] = i;
+    o.q = i * 0.25;
+    var s = "a" + i + "b" + o.q + "c" + (i % 3);
+    var m = Math.max(i, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5, i * 0.5);
+    var h = Math.hypot(i, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+    return s + " " + m + " " + h.toFixed(6);
+}
+
+function applied() {
+    return ints.apply(null, arguments) + "/" + Reflect.apply(doubles, null, Array.prototype.slice.call(arguments, 0, 11));
+}
+
+var shapes = [{}, { x: 1 }, { y: 2, z: 3 }];
+for (var i = 0; i < 50; i++) {
+    var results = [
+        ints(i, 1, 2, 3, 4, 5, 6, 7, 8, 9),
+        doubles(i * 0.25, 0.5, 1.25, 2.5, 3.75, 5, 6.25, 7.5, 8.75, 10, 11.25),
+        mixed(i, 0.5, 1, 1.5, 2, 2.5, 3, 3.5, 4, 4.5, 5, 5.5, 6, 6.5, 7, 7.5, 8, i * 0.125),
+        liveAcrossCalls(i),
+        helpers(shapes[i % 3], i),
+        applied(i, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10.5)
+    ];
+    if (i % 10 === 0 || i === 49) {
+        write(i + ": " + results.join(" | "));
+    }
+}
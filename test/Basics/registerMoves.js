@@ -0,0 +1,50 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Runs of register moves, the most frequent pair in the interpreter opcode profile, including a branch that
+// lands between two moves. The results must not change with -FuseByteCode, which runs two adjacent moves as
+// one Ld_A_Ld_A superinstruction, nor when the functions are later jitted.
+function rotate(a, b, c) {
+    var t = a;
+    a = b;
+    b = c;
+    c = t;
+    return "" + a + b + c;
+}
+
+function select(flag, a, b) {
+    var x, y;
+    if (flag) {
+        x = a;
+    }
+    y = b;
+    x = y;
+    return x;
+}
+
+function fib(n) {
+    var a = 0, b = 1, t;
+    for (var i = 0; i < n; i++) {
+        t = a;
+        a = b;
+        b = t;
+        b = a + b;
+    }
+    return a;
+}
+
+function objects(o) {
+    var p = o, q = p, r = q;
+    r.count = (r.count | 0) + 1;
+    return p === r ? o.count : -1;
+}
+
+var o = {};
+for (var i = 0; i < 200; i++) {
+    var results = [rotate(1, 2, 3), select(i & 1, "a", "b"), fib(20), objects(o)];
+    if (i < 2 || i == 199) {
+        WScript.Echo(i + ": " + results.join(" "));
+    }
+}
@@ -0,0 +1,80 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Long ASCII runs in whitespace, comments, string literals and identifiers, with the characters that end a
+// run placed at every offset of a 16 unit block. This file itself is scanned as UTF-8; the eval'd sources
+// are scanned as UTF-16.
+
+function write(v) { WScript.Echo(v); }
+
+var pad = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+function check(name, source, expected) {
+    var failures = 0;
+    for (var i = 0; i < 40; i++) {
+        var result;
+        try {
+            result = eval(source(pad.substring(0, i), i));
+        } catch (e) {
+            result = e.name;
+        }
+        if (result !== expected(pad.substring(0, i), i)) {
+            write("FAIL " + name + " " + i + ": " + result);
+            failures++;
+        }
+    }
+    write(name + (failures === 0 ? " passed" : " failed"));
+}
+
+// Whitespace
+check("blanks", function (s, i) { return "1" + Array(i + 2).join(" \t") + "+" + Array(i + 1).join(" ") + "1"; },
+    function () { return 2; });
+
+// Line comments ending in each kind of line break, or at the end of the source
+check("line comment LF", function (s) { return "1 // " + s + " *\n+ 2"; }, function () { return 3; });
+check("line comment CR", function (s) { return "1 // " + s + "\r+ 2"; }, function () { return 3; });
+check("line comment LS", function (s) { return "1 // " + s + "\u2028+ 2"; }, function () { return 3; });
+check("line comment non-ASCII", function (s) { return "1 // " + s + "é中" + s + "\n+ 2"; }, function () { return 3; });
+check("line comment EOF", function (s) { return "1 // " + s; }, function () { return 1; });
+
+// Block comments
+check("block comment", function (s) { return "1 /* " + s + " * / ** " + s + " */ + 2"; }, function () { return 3; });
+check("block comment lines", function (s) { return "1 /* " + s + "\r\n" + s + " é" + s + "\n*/ + 2"; }, function () { return 3; });
+check("block comment unterminated", function (s) { return "1 /* " + s; }, function () { return "SyntaxError"; });
+
+// String literals
+check("double quotes", function (s) { return "\"" + s + "'`$" + s + "\""; }, function (s) { return s + "'`$" + s; });
+check("single quotes", function (s) { return "'" + s + "\"" + s + "'"; }, function (s) { return s + "\"" + s; });
+check("escapes", function (s) { return "'" + s + "\\t\\x41\\u00e9\\\\" + s + "\\\n" + s + "'"; },
+    function (s) { return s + "\tAé\\" + s + s; });
+check("non-ASCII", function (s) { return "'" + s + "é中😀" + s + "'"; },
+    function (s) { return s + "é中😀" + s; });
+check("line break in string", function (s) { return "'" + s + "\n'"; },
+    function () { return "SyntaxError"; });
+
+// Templates, cooked and raw
+check("template", function (s, i) { return "`" + s + "$" + s + "${" + i + "}" + s + "\"'\r\n" + s + "`"; },
+    function (s, i) { return s + "$" + s + i + s + "\"'\n" + s; });
+check("raw template", function (s) { return "String.raw`" + s + "\\n" + s + "${1}$" + s + "`"; },
+    function (s) { return s + "\\n" + s + "1$" + s; });
+
+// Identifiers
+check("identifier", function (s, i) { return "var _$" + s + " = " + i + "; _$" + s; }, function (s, i) { return i; });
+check("identifier escape", function (s, i) { return "var " + s + "_\\u0041" + s + " = " + i + "; " + s + "_A" + s; },
+    function (s, i) { return i; });
+check("identifier non-ASCII", function (s, i) { return "var " + s + "_é" + s + " = " + i + "; " + s + "_é" + s; },
+    function (s, i) { return i; });
+
+// The same shapes written directly in this (UTF-8) file
+var abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789$ = 1;                                   // trailing comment with enough ASCII text to fill several blocks
+var s1 = "a string literal that is long enough to span a couple of sixteen byte blocks é and then 中";
+var s2 = 'a string literal with a non-ASCII character part way through: é, and an escaped quote \' at the end';
+var s3 = `a template that spans several blocks before the substitution ${abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789$} and after`;
+/* A block comment spanning several blocks of ASCII text, with a * and a line break
+   and a non-ASCII character: é, before it ends */
+write(abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789$);
+write(s1.length + " " + s2.length + " " + s3.length);
+write(s2.substring(60));
+write(s3);
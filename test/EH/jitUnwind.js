@@ -0,0 +1,103 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Exceptions thrown from script and from runtime helpers unwind through chains of jitted frames, run the finally
+// blocks on the way and leave the frames they pass through usable.
+function write(v) { WScript.Echo(v + ""); }
+
+var log = [];
+
+function thrower(kind, n) {
+    switch (kind) {
+        case 0: throw new Error("error " + n);
+        case 1: return null.x;                  // TypeError from a helper
+        case 2: return undefinedVariable + n;   // ReferenceError from a helper
+        case 3: throw n;                        // Not an Error object
+        default: return n;
+    }
+}
+
+function middle(kind, n, depth) {
+    var a = n * 1.5, b = n + 0.25, c = "m" + n;
+    try {
+        if (depth > 0) {
+            return middle(kind, n, depth - 1) + 1;
+        }
+        return thrower(kind, n);
+    } finally {
+        if (depth === 2) {
+            log.push("finally " + depth + " " + a + " " + b + " " + c);
+        }
+    }
+}
+
+function outer(kind, n) {
+    try {
+        return "returned " + middle(kind, n, 5);
+    } catch (e) {
+        return "caught " + (e instanceof Error ? e.name : typeof e);
+    }
+}
+
+function rethrow(n) {
+    try {
+        middle(0, n, 3);
+    } catch (e) {
+        throw new RangeError("wrapped " + e.message);
+    }
+}
+
+function nested(n) {
+    var result = [];
+    for (var i = 0; i < 3; i++) {
+        try {
+            try {
+                rethrow(n + i);
+            } finally {
+                result.push("inner finally " + i);
+            }
+        } catch (e) {
+            result.push(e.name + ": " + e.message);
+        }
+    }
+    return result.join(", ");
+}
+
+function recurse(n) {
+    return recurse(n + 1) + 1;
+}
+
+for (var i = 0; i < 40; i++) {
+    var results = [];
+    for (var kind = 0; kind < 5; kind++) {
+        results.push(outer(kind, i));
+    }
+    results.push(nested(i));
+    if (i % 10 === 0 || i === 39) {
+        write(i + ": " + results.join(" | "));
+        write(log.join(" | "));
+    }
+    log.length = 0;
+}
+
+// A stack overflow unwinds through every jitted frame on the stack
+for (var i = 0; i < 3; i++) {
+    try {
+        recurse(0);
+        write("no overflow");
+    } catch (e) {
+        // The error's type and message are host specific
+        write("overflow " + i + ": caught");
+    }
+}
+
+// An exception thrown from a callback unwinds through the runtime's own frames in between
+for (var i = 0; i < 3; i++) {
+    try {
+        [1, 2, 3].map(function (x) { if (x === 2) { thrower(0, x); } return x; });
+    } catch (e) {
+        write("callback " + i + ": " + e.message);
+    }
+}
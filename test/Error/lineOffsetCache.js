@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// The line table of a script is built in chunks, only as far as the positions looked up so far. Throw from
+// functions spread over a script several chunks long, mixing every kind of line terminator with multi-byte
+// characters, first from the end backwards and then from the start, and print the line and column reported.
+function write(v) { WScript.Echo(v + ""); }
+
+var terminators = ["\n", "\r\n", "\r", "\u2028", "\u2029"];
+var functionCount = 60;
+var lines = [];
+for (var i = 0; i < functionCount; i++) {
+    for (var j = 0; j < 300; j++) {
+        lines.push("// filler é 中 😀 " + i + " " + j);
+    }
+    var line = "function g" + i + "() { missing" + i + "(); }";
+    lines.push(line);
+}
+
+var source = "";
+for (var i = 0; i < lines.length; i++) {
+    source += lines[i] + terminators[i % terminators.length];
+}
+write("source spans several chunks: " + (source.length > 4 * 64 * 1024));
+
+function verify(global, name) {
+    function position(i) {
+        var f = global["g" + i];
+        try {
+            f();
+        } catch (e) {
+            var frames = e.stack.split("\n");
+            for (var k = 0; k < frames.length; k++) {
+                if (frames[k].indexOf("at g" + i + " ") !== -1) {
+                    var match = /:(\d+):(\d+)\)?\s*$/.exec(frames[k]);
+                    return match ? match[1] + ":" + match[2] : frames[k];
+                }
+            }
+            return e.stack;
+        }
+        return "no exception";
+    }
+
+    for (var i = functionCount - 1; i >= 0; i -= 7) {
+        write(name + ": g" + i + " at " + position(i));
+    }
+    for (var i = 0; i < functionCount; i += 3) {
+        write(name + ": g" + i + " at " + position(i));
+    }
+}
+
+(0, eval)(source);
+verify(this, "eval");
+verify(WScript.LoadScript(source, "samethread"), "LoadScript");
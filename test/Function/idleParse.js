@@ -0,0 +1,30 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -Idle, so ch calls JsIdle after the script and before the timeout below. Every function is deferred, and
+// the ones not called yet should be parsed by that JsIdle call, in source order with inner functions queued behind.
+function write(v) { WScript.Echo(v + ""); }
+
+function outer() {
+    function inner(x) {
+        return x * 2;
+    }
+    return inner;
+}
+
+function calledFirst() {
+    return "called before idle";
+}
+
+function notCalled(a, b) {
+    return a + b;
+}
+
+write(calledFirst());
+
+WScript.SetTimeout(function later() {
+    write(outer()(21));
+    write(notCalled(1, 2));
+}, 0);
@@ -0,0 +1,13 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -Idle -IdleParseBudget:1. Parsing all of these functions takes far longer than a millisecond, so the single
+// JsIdle call after the script has to stop with functions left in the queue.
+var source = "";
+for (var i = 0; i < 10000; i++) {
+    source += "function f" + i + "(a, b) { var c = a + b; for (var j = 0; j < c; j++) { c += j * " + i + "; } return c; }\n";
+}
+WScript.LoadScript(source);
+WScript.Echo("loaded");
@@ -0,0 +1,75 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -ParallelParseThreshold:1, so every function the main thread reaches is parsed by a background job.
+// Closures, regex literals and references to globals declared later must bind the same way as in a serial parse.
+function write(v) { WScript.Echo(v + ""); }
+
+function counter(start) {
+    var count = start;
+    return function () {
+        return ++count;
+    };
+}
+
+function words(text) {
+    return text.split(/\s+/).filter(function (word) { return /^[a-z]+$/.test(word); });
+}
+
+function usesLaterGlobal() {
+    return laterGlobal * 2;
+}
+
+function shadows(laterGlobal) {
+    var inner = function () { return laterGlobal; };
+    return inner();
+}
+
+function deep(n) {
+    function level1() {
+        function level2() {
+            return n + 2;
+        }
+        return level2() + 1;
+    }
+    return level1();
+}
+
+var expression = function (a, b) {
+    let sum = 0;
+    for (let i = a; i < b; i++) {
+        sum += i;
+    }
+    return sum;
+};
+
+class Point {
+    constructor(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+    norm() {
+        return Math.sqrt(this.x * this.x + this.y * this.y);
+    }
+}
+
+var laterGlobal = 21;
+
+var next = counter(10);
+next();
+write("closure over a parameter: " + next());
+write("regex literals: " + words("alpha 42 beta Gamma delta").join(","));
+write("reference to a later global: " + usesLaterGlobal());
+write("parameter shadowing a global: " + shadows("inner"));
+write("nested functions: " + deep(1));
+write("function expression with block scoped variables: " + expression(0, 5));
+write("class methods: " + new Point(3, 4).norm());
+
+try {
+    eval("function broken() { return 1 + ; }");
+    write("syntax error in a background job: not thrown");
+} catch (e) {
+    write("syntax error in a background job: " + e.name);
+}
@@ -0,0 +1,30 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -ParallelParseThreshold:1 -ForceOOMInBackgroundParse:3, so the third function parsed by a background
+// job runs out of memory. The script it is in fails to compile with an out of memory error rather than binding a
+// function which was never parsed, and the same script compiles once the fault is past. This file has no function
+// literals of its own, so that the failing function is one of those in the evaluated source.
+var source = "";
+for (var i = 0; i < 10; i++) {
+    source += "function f" + i + "(x) { var a = [x, " + i + "]; return a[0] + a[1]; }\n";
+}
+source += "var total = 0;\n";
+for (var i = 0; i < 10; i++) {
+    source += "total += f" + i + "(0);\n";
+}
+source += "total;";
+
+var failures = [];
+var result;
+for (var attempt = 0; attempt < 3 && result === undefined; attempt++) {
+    try {
+        result = (0, eval)(source);
+    } catch (e) {
+        failures.push(e.name + ": " + e.message);
+    }
+}
+WScript.Echo("failures: " + failures.join(", "));
+WScript.Echo("result: " + result);
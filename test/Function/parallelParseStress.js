@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -ParallelParseThreshold:1, so every function is parsed by a background job. Large scripts with many
+// functions, deeply nested functions, and syntax errors inside the functions handed off, which must be reported
+// as in a serial parse: the lexically first error wins, whichever job finds it first.
+function write(v) { WScript.Echo(v + ""); }
+
+function run(source) {
+    try {
+        return (0, eval)(source);
+    } catch (e) {
+        return e.name + ": " + e.message;
+    }
+}
+
+function manyFunctions(count, errors) {
+    var source = [];
+    for (var i = 0; i < count; i++) {
+        var body = "var a = [x, " + i + "]; var s = 'f" + i + "'; " +
+            "return a[0] * 2 + a[1] + (function (y) { return y % 7; })(" + i + ") + (/f\\d+/.test(s) ? 1 : 0);";
+        if (errors && errors[i]) {
+            body = errors[i];
+        }
+        source.push("function f" + i + "(x) { " + body + " }");
+    }
+    source.push("var total = 0;");
+    for (var i = 0; i < count; i++) {
+        source.push("total += f" + i + "(" + (i % 10) + ");");
+    }
+    source.push("total;");
+    return source.join("\n");
+}
+
+function nestedFunctions(depth) {
+    var source = "0";
+    for (var i = depth - 1; i >= 0; i--) {
+        source = "(function g" + i + "() { var v" + i + " = " + i + "; return v" + i + " + " + source + "; })()";
+    }
+    return "function outer() { return " + source + "; }\nouter();";
+}
+
+var large = manyFunctions(2000);
+write("large script, " + large.length + " characters: " + run(large));
+write("large script again: " + run(large));
+write("nested 100 deep: " + run(nestedFunctions(100)));
+
+write("error in one function: " + run(manyFunctions(100, { 50: "return (1;" })));
+write("errors in two functions: " + run(manyFunctions(100, { 10: "return (1;", 90: "return [1;" })));
+write("errors in two functions, reversed: " + run(manyFunctions(100, { 10: "return [1;", 90: "return (1;" })));
+write("error in a nested function: " + run(manyFunctions(100, { 30: "function inner() { return (1; } return inner();" })));
+write("error in every function: " + run(manyFunctions(100, (function () { var all = {}; for (var i = 0; i < 100; i++) { all[i] = i < 1 ? "return (1;" : "return [1;"; } return all; })())));
+write("valid script after the errors: " + run(manyFunctions(100)));
@@ -0,0 +1,36 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -ShareSource -CompressSource: the same large script is loaded into several contexts, which share
+// one compressed copy of its text. Deferred parsing and toString must see the original text in each of them.
+function write(v) { WScript.Echo(v + ""); }
+
+var functionCount = 400;
+var parts = [];
+for (var i = 0; i < functionCount; i++) {
+    parts.push("function f" + i + "(a) { /* é " + i + " 中 */ return a + " + i + " + 'é'.length; }\n");
+}
+parts.push("var sum = 0; for (var i = 0; i < " + functionCount + "; i += 7) { sum += this['f' + i](1); }\n");
+var source = parts.join("");
+write("source is large enough to be compressed: " + (source.length > 16 * 1024));
+
+function verify(global, name) {
+    write(name + ": sum " + global.sum);
+    for (var i = 0; i < functionCount; i += 13) {
+        var text = global["f" + i].toString();
+        write(name + ": f" + i + " keeps its text " + (text === parts[i].substring(0, parts[i].length - 1)) + ", returns " + global["f" + i](2));
+    }
+}
+
+verify(WScript.LoadScript(source, "samethread"), "first context");
+verify(WScript.LoadScript(source, "samethread"), "second context");
+verify(WScript.LoadScript(source), "this context");
+
+// A script differing in a single character must not be mistaken for the first one
+var changed = source.replace("f399(a) { /* é 399", "f399(a) { /* è 399");
+var global = WScript.LoadScript(changed, "samethread");
+write("changed script keeps its own text: " + (global.f399.toString().indexOf("è 399") !== -1));
+verify(WScript.LoadScript(source, "samethread"), "third context");
+
@@ -0,0 +1,58 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// The scanner skips whitespace and plain string characters in blocks; make sure special characters
+// are found at every position of a block, and in the tail after the last full block.
+var passed = true;
+function check(actual, expected, message) {
+    if (actual !== expected) {
+        WScript.Echo("FAILED: " + message + ": expected " + JSON.stringify(expected) + ", got " + JSON.stringify(actual));
+        passed = false;
+    }
+}
+
+function repeat(s, count) {
+    var result = "";
+    for (var i = 0; i < count; i++) {
+        result += s;
+    }
+    return result;
+}
+
+for (var length = 0; length < 70; length++) {
+    var plain = repeat("a", length);
+    check(JSON.parse('"' + plain + '"'), plain, "plain string of length " + length);
+    check(JSON.parse('"' + plain + '\u00e9\u2028x"'), plain + "\u00e9\u2028x", "non-ASCII after " + length);
+    check(JSON.parse(repeat(" ", length) + "[" + repeat("\n\t\r ", length) + "1]")[0], 1, "whitespace run of " + length);
+
+    for (var pos = 0; pos < length; pos++) {
+        var prefix = plain.substring(0, pos);
+        var suffix = plain.substring(pos);
+        check(JSON.parse('"' + prefix + '\\n' + suffix + '"'), prefix + "\n" + suffix, "escape at " + pos + " of " + length);
+        check(JSON.parse('"' + prefix + '\\"' + suffix + '"'), prefix + '"' + suffix, "escaped quote at " + pos + " of " + length);
+
+        try {
+            JSON.parse('"' + prefix + '\u0001' + suffix + '"');
+            check(false, true, "control character at " + pos + " of " + length);
+        } catch (e) {
+            check(e instanceof SyntaxError, true, "control character error at " + pos + " of " + length);
+        }
+    }
+}
+
+// Integers take a fast path up to 15 digits
+var digits = "123456789012345678";
+for (var i = 1; i <= digits.length; i++) {
+    var text = digits.substring(0, i);
+    check(JSON.parse(text), Number(text), "integer " + text);
+    check(JSON.parse(text + ".5"), Number(text + ".5"), "decimal " + text + ".5");
+    check(JSON.parse(text + "e2"), Number(text + "e2"), "exponent " + text + "e2");
+}
+check(JSON.parse("[0,-0,10,-7]").join(), "0,0,10,-7", "small integers");
+check(1 / JSON.parse("-0"), -Infinity, "negative zero");
+
+if (passed) {
+    WScript.Echo("Pass");
+}
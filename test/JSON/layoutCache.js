@@ -0,0 +1,80 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Objects that follow a layout already seen in the same JSON.parse are created directly with the
+// final type. Check that layouts which match, extend, diverge from or nest into each other all
+// produce the right objects.
+function write(v) { WScript.Echo(v); }
+
+function describe(value) {
+    if (value === null || typeof value !== "object") {
+        return JSON.stringify(value);
+    }
+    if (Array.isArray(value)) {
+        return "[" + value.map(describe).join(",") + "]";
+    }
+    return "{" + Object.keys(value).map(function (key) { return key + ":" + describe(value[key]); }).join(",") + "}";
+}
+
+var records = [];
+for (var i = 0; i < 100; i++) {
+    var record = { id: i, name: "item" + i, tags: ["a", "b"], nested: { x: i, y: -i } };
+    if (i % 7 == 3) {
+        record.extra = true;            // longer layout
+    }
+    if (i % 11 == 5) {
+        record = { id: i, other: i };   // diverges after the first key
+    }
+    if (i % 13 == 6) {
+        record = { nested: { x: { id: i, name: "deep" } }, id: i };
+    }
+    if (i % 17 == 8) {
+        record = { id: i, name: "short" };  // prefix of the common layout
+    }
+    if (i % 19 == 9) {
+        record = { 1: "numeric", id: i };
+    }
+    records.push(record);
+}
+
+var text = JSON.stringify(records);
+var parsed = JSON.parse(text);
+write("length: " + parsed.length);
+
+// One record of each layout, then the ones that don't round trip, if any
+[0, 3, 5, 6, 8, 9].forEach(function (i) {
+    write(i + ": " + describe(parsed[i]));
+});
+for (var i = 0; i < records.length; i++) {
+    if (describe(parsed[i]) !== describe(records[i])) {
+        write("mismatch " + i + ": " + describe(parsed[i]));
+    }
+}
+
+// Objects with the same layout share a type but not their values
+parsed[0].name = "changed";
+write("independent values: " + parsed[2].name);
+parsed[2].added = 1;
+write("independent properties: " + parsed[4].added);
+write("key order: " + Object.keys(parsed[4]).join());
+
+// Reviver walks the deferred objects as well
+function sumIds(value) {
+    var total = 0;
+    if (value !== null && typeof value === "object") {
+        Object.keys(value).forEach(function (key) {
+            total += (key === "id" ? value[key] : 0) + sumIds(value[key]);
+        });
+    }
+    return total;
+}
+var sum = 0;
+JSON.parse(text, function (key, value) {
+    if (key === "id") {
+        sum += value;
+    }
+    return value;
+});
+write("reviver: " + sum + " " + sumIds(records));
@@ -0,0 +1,61 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// JSON.stringify writes its output straight into one buffer. Check the pieces that buffer has to get
+// right: escaping, numbers, indentation, skipped members, toJSON, replacers, large outputs and cycles.
+function write(v) { WScript.Echo(v); }
+
+write(JSON.stringify("a\"b\\c\n\t\u0001\u001f"));
+write(JSON.stringify("\ud83d\ude00") === "\"\ud83d\ude00\"");
+write(JSON.stringify("\b\f\r"));
+write(JSON.stringify(""));
+write(JSON.stringify([0, -0, 1.5, -7, 1e21, 1e-7, 2147483648, NaN, Infinity, -Infinity]));
+write(JSON.stringify([true, false, null]));
+write(JSON.stringify([new Number(3), new String("s"), new Boolean(false)]));
+write(JSON.stringify({ a: undefined, b: function () { }, c: Symbol(), d: 1 }));
+write(JSON.stringify({ a: undefined }));
+write(JSON.stringify([undefined, function () { }, Symbol()]));
+write(JSON.stringify(undefined));
+write(JSON.stringify(function () { }));
+write(JSON.stringify({}));
+write(JSON.stringify([]));
+
+var nested = { a: [1, { b: [] }, {}], c: { d: "e" } };
+write(JSON.stringify(nested));
+write(JSON.stringify(nested, null, 2));
+write(JSON.stringify({ a: [1], b: { c: 2 } }, null, "--"));
+write(JSON.stringify({ "k\"ey": 1 }));
+
+var withToJSON = { a: { toJSON: function (key) { return "key:" + key; } }, b: [{ toJSON: function (key) { return key; } }] };
+write(JSON.stringify(withToJSON));
+write(JSON.stringify(new Date(0)));
+
+write(JSON.stringify({ a: 1, b: [2, 3], c: "x" }, function (key, value) {
+    return typeof value === "number" ? value * 10 : value;
+}));
+write(JSON.stringify({ a: 1, b: 2, c: { a: 3, d: 4 } }, ["a", "c"]));
+
+// Outputs that grow the buffer several times
+var big = [];
+var expected = [];
+for (var i = 0; i < 20000; i++) {
+    big.push({ id: i, name: "item" + i });
+    expected.push("{\"id\":" + i + ",\"name\":\"item" + i + "\"}");
+}
+var bigText = JSON.stringify(big);
+write("large array: " + bigText.length + " " + (bigText === "[" + expected.join(",") + "]"));
+var longString = new Array(100001).join("\u00e9\"");
+write("long escaped string: " + JSON.stringify(longString).length);
+
+var cyclic = { a: [] };
+cyclic.a.push(cyclic);
+try {
+    JSON.stringify(cyclic);
+    write("cycle didn't throw");
+} catch (e) {
+    write("cycle: " + e.name);
+}
+// The session must be usable again after a throw
+write(JSON.stringify({ a: [cyclic.a.length] }));
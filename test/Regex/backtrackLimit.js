@@ -0,0 +1,50 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -LimitRegexBacktracking -RegexBacktrackLimit:100000: a match which backtracks catastrophically throws a
+// catchable RangeError, and leaves the regex and the runtime usable.
+function write(v) { WScript.Echo(v + ""); }
+
+function throws(f, message) {
+    try {
+        f();
+    } catch (e) {
+        write(message + ": " + e.name);
+        return;
+    }
+    write(message + ": no error");
+}
+
+var as = Array(31).join("a");
+
+// Multiline anchors and lookaheads keep these on the backtracking matcher
+var nested = /^(a+)+$/m;
+var lookahead = /(x+x+)+(?=y)/;
+var global = /(a|aa)+$/mg;
+
+throws(function () { nested.test(as + "b"); }, "test");
+throws(function () { nested.exec(as + "b"); }, "exec");
+throws(function () { (as + "b").match(nested); }, "match");
+throws(function () { (as + "b").replace(nested, "$1"); }, "replace");
+throws(function () { (as + "b").search(nested); }, "search");
+throws(function () { (as + "b").split(nested); }, "split");
+throws(function () { lookahead.exec(Array(31).join("x")); }, "lookahead");
+
+global.lastIndex = 0;
+throws(function () { global.exec(as + "b"); }, "global exec");
+write("global exec, lastIndex: " + global.lastIndex);
+
+// The same regexes still match inputs which don't need much backtracking
+write("nested, short match: " + JSON.stringify(nested.exec("aaaa")));
+write("nested, short mismatch: " + nested.test("aab"));
+write("lookahead, match: " + JSON.stringify(lookahead.exec("xxxy")));
+write("global, match: " + JSON.stringify("aa\naaa".match(global)));
+write("backreference: " + JSON.stringify(/(\w+)\s\1/.exec("hello hello world")));
+
+// Patterns matched without backtracking are not limited, however long the input
+var long = Array(200001).join("a");
+write("automaton, long input: " + /(a+)+$/.test(long + "b"));
+write("automaton, alternatives: " + /a*b|a*c/.exec(long + "c")[0].length);
+write("global replace: " + long.replace(/a/g, "").length);
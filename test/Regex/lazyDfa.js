@@ -0,0 +1,80 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Patterns which are not deterministic, and have no backreferences or lookarounds, are matched with automata. They
+// must give the same results as the backtracking matcher, in linear time.
+
+// Long strings are shown by their length, and non-ASCII characters escaped
+function write(description, value) {
+    var text = JSON.stringify(value, function (key, v) {
+        return typeof v === "string" && v.length > 32 ? v.length + " characters" : v;
+    });
+    WScript.Echo(description + ": " + String(text).replace(/[^\x20-\x7e]/g, function (c) {
+        return "\\u" + ("000" + c.charCodeAt(0).toString(16)).slice(-4);
+    }));
+}
+
+function exec(re, input, lastIndex) {
+    if (lastIndex !== undefined) {
+        re.lastIndex = lastIndex;
+    }
+    var m = re.exec(input);
+    return m === null ? null : { index: m.index, groups: Array.prototype.slice.call(m), lastIndex: re.lastIndex };
+}
+
+var n = 30000;
+var as = Array(n + 1).join("a");
+var xs = Array(n + 1).join("x");
+
+// Exponential for a backtracking matcher
+write("(a|aa)*b, no match", /(a|aa)*b/.exec(as));
+write("(x+x+)+y, no match", /(x+x+)+y/.test(xs));
+write("(a|aa)*b, match", exec(/(a|aa)*b/, as + "b"));
+
+// Deterministic patterns stay with the backtracking matcher, which skips to candidates with a character scan
+var shortAs = as.substring(0, 3000);
+var shortXs = xs.substring(0, 3000);
+write("a+b, no match", /a+b/.test(shortAs));
+write("[ax]*y, no match", /[ax]*y/.test(shortAs + shortXs));
+
+// Captures
+write("group in a loop", exec(/((a)|b)+/, "ab"));
+write("non-capturing loop", exec(/(?:(a)|b)+/, "ab"));
+write("nested groups", exec(/((a+)(b|c)?)+d/, "aabacd"));
+write("unmatched alternative", exec(/(x)|(a|b)+c/, "zabc"));
+write("bounded loop", exec(/(a|b){2,3}(a*)/, "babaa"));
+
+// Priorities
+write("first alternative", exec(/(a|ab)(c|bcd)(d*)/, "abcd"));
+write("lazy loop", exec(/<(.+?)>/, "<a><b>"));
+write("lazy and greedy", exec(/a+?(b*?)(b*)/, "aabb"));
+write("lazy bounded loop", exec(/(a{1,3}?)(a*)b/, "aaab"));
+
+// Anchors
+write("^ and $", /^(a|b)*c$/.test("ababc"));
+write("^ not at start", /x(^a|b)+/.test("xab"));
+write("$ match", exec(/(a|b)*$/, "xab"));
+write("empty input", exec(/(a|b)*$/, ""));
+
+// Flags
+write("global", "aXbbXaaa".match(/(a|b)+/g));
+write("global lastIndex", exec(/(a|b)+c/g, "abcabbc", 3));
+write("sticky", exec(/(a|ab)(c|bcd)/y, "xabcd", 1));
+write("sticky no match", exec(/(a|b)+c/y, "xabc", 0));
+write("ignore case", exec(/(A|b)+c/i, "zaBaC"));
+write("non-ASCII", exec(/[\u0100-\u0200]+(\u3042|x)*/, "z\u0150\u0151\u3042x"));
+
+// Enough DFA states to overflow the cache
+var seed = 1;
+var random = "";
+for (var i = 0; i < 100000; i++) {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    random += seed & 0x10000 ? "a" : "b";
+}
+var end = random.charAt(random.length - 13) === "a" ? random : random.slice(0, -13) + "a" + random.slice(-12);
+write("cache overflow, match", exec(/(a|b)*a(a|b){12}$/, end));
+write("cache overflow, no match", /(?:a|b)*a(?:a|b){12}c/.test(random));
+write("cache overflow, repeated", /(?:a|b)*a(?:a|b){12}$/.test(end) && /(?:a|b)*a(?:a|b){12}$/.test(end));
+
@@ -0,0 +1,48 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Corner cases of the lazy DFA's priorities and captures: empty alternatives, lazy quantifiers, and groups which are
+// reset on each iteration of their loop. Run with and without -RegexDfa- against the same baseline, so that the
+// automata and the backtracking matcher are held to the same results. Inputs are short enough for either.
+
+// Long strings are shown by their length, and non-ASCII characters escaped
+function write(description, value) {
+    var text = JSON.stringify(value, function (key, v) {
+        return typeof v === "string" && v.length > 32 ? v.length + " characters" : v;
+    });
+    WScript.Echo(description + ": " + String(text).replace(/[^\x20-\x7e]/g, function (c) {
+        return "\\u" + ("000" + c.charCodeAt(0).toString(16)).slice(-4);
+    }));
+}
+
+function exec(re, input, lastIndex) {
+    if (lastIndex !== undefined) {
+        re.lastIndex = lastIndex;
+    }
+    var m = re.exec(input);
+    return m === null ? null : { index: m.index, groups: Array.prototype.slice.call(m), lastIndex: re.lastIndex };
+}
+
+// Empty alternatives
+write("empty alternative in a loop", exec(/(a|)*b/, "aab"));
+write("empty first alternative", exec(/(|a)+b/, "aab"));
+write("empty alternative, no match", exec(/(a||b)*c/, "abab"));
+write("empty alternative before a group", exec(/x(|(a))+y/, "xay"));
+
+// Lazy quantifiers
+write("lazy loop, shortest", exec(/(a|b)*?c/, "abbcbc"));
+write("lazy loop, alternatives", exec(/(a|ab)+?c/, "ababc"));
+write("lazy loop, backtracks", exec(/^(a|b)*?(b+)$/, "abbb"));
+write("lazy bounded loop, alternatives", exec(/(a|aa){2,4}?(a*)$/, "aaaaa"));
+write("lazy loop, empty iterations", exec(/(a|)*?b/, "ab"));
+write("lazy loop, global", "<a><bc><d>".match(/<(a|b|c|d)+?>/g));
+
+// Groups reset on each iteration of their loop
+write("reset in a loop", exec(/(?:(a)|(b))+/, "ab"));
+write("reset nested", exec(/(z)((a+)?(b+)?(c))*/, "zaacbbbcac"));
+write("reset bounded", exec(/(?:(a)|b|(c)){3}/, "acb"));
+write("reset lazy", exec(/(?:(a)|(b))+?c/, "abac"));
+write("reset in both loops", exec(/((a)|(b))*((c)|(d))*e/, "abcde"));
+write("reset sticky", exec(/(?:(a)|(b))+c/y, "xbac", 1));
@@ -0,0 +1,38 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -ShareRegex: each context compiles the same regexes, which share one compiled program. Every context prints
+// the same results, whatever the flags, and keeps its own lastIndex and capture state. Also run without it, against the
+// same baseline, so that sharing is held to the results of contexts which compile their own programs.
+function write(v) { WScript.Echo(v + ""); }
+
+var source = [
+    "var results = [];",
+    "results.push(/(\\d+)-(\\d+)/.exec('call 425-5550100 now'));",
+    "results.push('a1b22c333'.match(/\\d+/g));",
+    "results.push('Hello World'.replace(/o/gi, '0'));",
+    "results.push(new RegExp('^[a-z]+$', 'i').test('MiXeD'));",
+    "results.push(new RegExp('^[a-z]+$').test('MiXeD'));",
+    "results.push(new RegExp('(a|ab)(c|bcd)(d*)').exec('abcd'));",
+    "results.push('x.y.z'.split(new RegExp('\\\\.')));",
+    "var sticky = new RegExp('b', 'y'); sticky.lastIndex = 1;",
+    "results.push(sticky.test('abc'), sticky.lastIndex, sticky.test('abc'), sticky.lastIndex);",
+    "results.push(/\\u{1F600}/u.test('\\u{1F600}'), /^.$/u.test('\\u{1F600}'), /^.$/.test('\\u{1F600}'));",
+    "var global = /o/g; results.push(global.exec('foo').index, global.lastIndex, global.exec('foo').index, global.lastIndex);",
+    "results.push(new RegExp(/q(u)/i).exec('QUIT'), RegExp.$1);",
+    "var errors = 0; for (var i = 0; i < 2; i++) { try { new RegExp('(unclosed'); } catch (e) { errors++; } } results.push(errors);",
+    "try { new RegExp('a', 'gg'); } catch (e) { results.push(e.name); }",
+    "results.push(new RegExp('').exec('abc'), new RegExp('', 'g').source);",
+    "var dynamic = []; for (var i = 0; i < 300; i++) { dynamic.push(new RegExp('^p' + (i % 150) + '$').test('p' + i)); } results.push(dynamic.lastIndexOf(true));",
+    "results;"
+].join("\n");
+
+write("this context: " + JSON.stringify(eval(source)));
+
+for (var i = 0; i < 3; i++) {
+    var global = WScript.LoadScript(source, "samethread");
+    write("context " + i + ": " + JSON.stringify(global.results));
+}
+write("this context again: " + JSON.stringify(eval(source)));
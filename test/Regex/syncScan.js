@@ -0,0 +1,82 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// The instructions which skip to a candidate match, or over a run of characters, look at a block of input at a time.
+// Put the character they stop at at each offset of inputs a few blocks long, with ASCII and non-ASCII fillers, and
+// print where each one stops. The lengths cover the ends of blocks, and a tail of a few characters after a block.
+
+function write(v) { WScript.Echo(v + ""); }
+
+function repeat(s, n) {
+    return Array(n + 1).join(s);
+}
+
+var fillers = ["x", "\u00e9", "\u3042", "\uffff", "\u8000"];
+var lengths = [0, 1, 2, 15, 16, 17, 24, 31, 32, 33, 41, 48, 50];
+
+fillers.forEach(function (filler) {
+    lengths.forEach(function (length) {
+        var plain = repeat(filler, length);
+        write("filler " + escape(filler) + ", length " + length + ", no match: " + [
+            plain.search(/q/),
+            plain.search(/[qr]/),
+            plain.search(/[0-9]/),
+            plain.search(/[^\s\S]/),
+            plain.search(/qr/),
+            plain.search(/quick brown/)
+        ].join(" "));
+
+        var results = {};
+        function record(kind, value) {
+            (results[kind] = results[kind] || []).push(value);
+        }
+
+        for (var i = 0; i < length; i++) {
+            var input = plain.substring(0, i) + "q" + plain.substring(i + 1);
+
+            record("char", input.search(/q/));
+            record("char2", input.search(/[rq]/));
+            record("set", input.search(/[0-9a-q\u0100]/));
+            record("negated set", input.search(filler === "x" ? /[^x\u3042]/ : /[^\u00e9\u3042\uffff\u8000]/));
+            record("consume", input.search(/q$|q/));
+            record("backup", (input + "!").search(/\S?q!?/));
+            record("run", /^[^q]*/.exec(input)[0].length);
+            record("run of char", new RegExp("^" + filler + "*").exec(input)[0].length);
+
+            if (i + 1 < length) {
+                var pair = input.substring(0, i + 1) + "r" + input.substring(i + 2);
+                record("literal", pair.search(/qr/));
+                record("literal, near miss", input.search(/qr/));
+            }
+
+            if (i + 11 <= length) {
+                var sentence = plain.substring(0, i) + "quick brown" + plain.substring(i + 11);
+                record("long literal", sentence.search(/quick brown/));
+                record("long literal, last char differs", sentence.replace(/n/, "m").search(/quick brown/));
+                record("long literal, first char differs", sentence.replace(/q/, "p").search(/quick brown/));
+                record("literal match", /^(?:x|\u00e9|\u3042|\uffff|\u8000)*quick brown/.test(sentence) ? 1 : 0);
+                record("literal mismatch", /^(?:x|\u00e9|\u3042|\uffff|\u8000)*quick brawn/.test(sentence) ? 1 : 0);
+            }
+        }
+
+        for (var kind in results) {
+            write("    " + kind + ": " + results[kind].join(" "));
+        }
+    });
+});
+
+// Global replace and split over a large log
+var lines = [];
+for (var i = 0; i < 2000; i++) {
+    lines.push("2016-01-01 00:00:" + (i % 60) + " [" + (i % 7 === 0 ? "ERROR" : "INFO") + "] request " + i + " served in " + (i % 13) + "ms");
+}
+var log = lines.join("\n");
+write("split lines: " + log.split(/\n/).length);
+write("split words: " + log.split(/ +/).length);
+write("replace errors: " + log.replace(/\[ERROR\]/g, "E").split("E]").length);
+write("count errors: " + log.match(/ERROR/g).length);
+write("count served: " + log.match(/served in \d+ms/g).length);
+write("count digit runs: " + log.match(/[0-9]+/g).length);
+
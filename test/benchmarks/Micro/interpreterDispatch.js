@@ -0,0 +1,87 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Interpreter dispatch micro benchmark. Each kernel is a loop of cheap opcodes (register moves, tagged
+// int arithmetic, compares and branches, inline cached property loads) so that the time is dominated by
+// going from one opcode handler to the next rather than by the handlers themselves.
+//
+// Run it in the interpreter, once against a build with threaded dispatch and once against a build with
+// the switch loop (build.sh --switch-dispatch), and compare the ns per iteration of each kernel:
+//
+//   ch -NoNative interpreterDispatch.js
+//   perl perftest.pl -dir:Micro -interpreted -binary:<path to ch>
+
+if (typeof (WScript) === "undefined") {
+    var WScript = {
+        Echo: print
+    }
+}
+
+var iterations = 2000000;
+
+function arithmetic(n) {
+    var a = 0, b = 1, c = 2;
+    for (var i = 0; i < n; i++) {
+        a = a + b;
+        b = c - a;
+        c = a ^ b;
+        a = a & 0xffff;
+    }
+    return a + b + c;
+}
+
+function moves(n) {
+    var a = 1, b = 2, c = 3, d = 4, t;
+    for (var i = 0; i < n; i++) {
+        t = a; a = b; b = c; c = d; d = t;
+    }
+    return a + b + c + d;
+}
+
+function branches(n) {
+    var even = 0, odd = 0;
+    for (var i = 0; i < n; i++) {
+        if ((i & 1) === 0) {
+            even++;
+        } else if (i > 0) {
+            odd++;
+        }
+    }
+    return even - odd;
+}
+
+function properties(n) {
+    var o = { x: 1, y: 2, z: 3 };
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum = (sum + o.x + o.y + o.z) & 0xffff;
+        o.x = o.y;
+        o.y = o.z;
+        o.z = sum & 7;
+    }
+    return sum;
+}
+
+function run(name, kernel, expected) {
+    kernel(1000); // warm up the inline caches and the profile data
+
+    var start = new Date();
+    var result = kernel(iterations);
+    var elapsed = new Date() - start;
+
+    if (result !== expected) {
+        throw "ERROR: " + name + ": expected " + expected + " but got " + result;
+    }
+    WScript.Echo(name + ": " + (elapsed * 1000000 / iterations).toFixed(2) + " ns/iteration");
+    return elapsed;
+}
+
+var total = 0;
+total += run("arithmetic", arithmetic, 65528);
+total += run("moves", moves, 10);
+total += run("branches", branches, 0);
+total += run("properties", properties, 3465);
+
+WScript.Echo("### TIME:", total, "ms");
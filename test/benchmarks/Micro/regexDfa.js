@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Regex automata micro benchmark. Each kernel searches a long log for the few lines of interest, so that the time is
+// dominated by skipping over the input between matches. The "deterministic" kernels always run on the backtracking
+// matcher; the "nondeterministic" ones run on the lazy DFA unless it is turned off.
+//
+// Compare the ms per kernel with the DFA and with only the backtracking matcher:
+//
+//   ch regexDfa.js
+//   ch -RegexDfa- regexDfa.js
+//   perl perftest.pl -dir:Micro -binary:<path to ch>
+
+if (typeof (WScript) === "undefined") {
+    var WScript = {
+        Echo: print
+    }
+}
+
+var iterations = 20;
+
+var levels = ["INFO", "INFO", "DEBUG", "INFO", "WARN", "INFO", "DEBUG", "INFO"];
+var lines = [];
+for (var i = 0; i < 20000; i++) {
+    var level = i % 997 === 0 ? "ERROR" : levels[i & 7];
+    lines.push("2017-03-" + (10 + i % 20) + "T12:" + (10 + i % 50) + ":" + (10 + i % 49) + "Z [worker-" + (i % 16) + "] " +
+        level + " request id=" + (100000 + i) + " path=/api/v1/items/" + (i % 500) + " status=" + (i % 331 === 0 ? 503 : 200) +
+        " took " + (i % 97) + "ms");
+}
+var log = lines.join("\n");
+
+function count(re) {
+    return function () {
+        re.lastIndex = 0;
+        var found = 0;
+        while (re.exec(log) !== null) {
+            found++;
+        }
+        return found;
+    };
+}
+
+function run(name, kernel, expected) {
+    kernel();
+
+    var start = new Date();
+    for (var i = 0; i < iterations; i++) {
+        var result = kernel();
+        if (result !== expected) {
+            throw "ERROR: " + name + ": expected " + expected + " but got " + result;
+        }
+    }
+    var elapsed = new Date() - start;
+
+    WScript.Echo(name + ": " + (elapsed / iterations).toFixed(2) + " ms/iteration");
+    return elapsed;
+}
+
+var total = 0;
+total += run("deterministic, level", count(/ ERROR request id=(\d+)/g), 21);
+total += run("deterministic, status", count(/status=5\d\d took (\d+)ms/g), 61);
+total += run("nondeterministic, worker", count(/\[(.*)\] ERROR (.*) took/g), 21);
+total += run("nondeterministic, path", count(/path=(\S+|\/api\/v1\/items\/\d+) status=503/g), 61);
+
+WScript.Echo("### TIME:", total, "ms");
@@ -0,0 +1,98 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Regex matcher dispatch micro benchmark. Each kernel runs anchored patterns, of the kind used by validators and
+// routers, against short inputs, so that the time is dominated by going from one matcher instruction to the next
+// rather than by scanning the input.
+//
+// Compare the ns per iteration of each kernel on a build with threaded dispatch and on one with the switch loop
+// (build.sh --switch-dispatch):
+//
+//   ch regexDispatch.js
+//   perl perftest.pl -dir:Micro -binary:<path to ch>
+
+if (typeof (WScript) === "undefined") {
+    var WScript = {
+        Echo: print
+    }
+}
+
+var iterations = 500000;
+
+var routes = [
+    /^\/users\/(\d+)$/,
+    /^\/users\/(\d+)\/posts\/([a-z0-9-]+)$/,
+    /^\/static\/(?:css|js|img)\/[\w.-]+$/
+];
+var paths = ["/users/1234", "/users/42/posts/hello-world", "/static/js/app.min.js", "/about"];
+
+function route(n) {
+    var matched = 0;
+    for (var i = 0; i < n; i++) {
+        var path = paths[i & 3];
+        for (var r = 0; r < routes.length; r++) {
+            if (routes[r].test(path)) {
+                matched++;
+                break;
+            }
+        }
+    }
+    return matched;
+}
+
+var validators = [
+    /^\d{3}-\d{3}-\d{4}$/,
+    /^[A-Z]{2}\d{2}(?: ?[A-Z0-9]{4}){3}$/,
+    /^#?(?:[0-9a-f]{3}){1,2}$/i
+];
+var values = ["425-555-0100", "GB82 WEST 1234 5698", "#c0ffee", "not valid"];
+
+function validate(n) {
+    var valid = 0;
+    for (var i = 0; i < n; i++) {
+        var value = values[i & 3];
+        for (var v = 0; v < validators.length; v++) {
+            if (validators[v].test(value)) {
+                valid++;
+            }
+        }
+    }
+    return valid;
+}
+
+var keyValue = /^\s*([\w.]+)\s*=\s*"?([^"]*)"?\s*$/;
+var lines = ["name = \"chakra\"", "  version=1.2.3  ", "# comment", "path.root = \"/usr/lib\""];
+
+function parse(n) {
+    var length = 0;
+    for (var i = 0; i < n; i++) {
+        var m = keyValue.exec(lines[i & 3]);
+        if (m !== null) {
+            length += m[2].length;
+        }
+    }
+    return length;
+}
+
+function run(name, kernel, expected) {
+    kernel(1000);
+
+    var start = new Date();
+    var result = kernel(iterations);
+    var elapsed = new Date() - start;
+
+    if (result !== expected) {
+        throw "ERROR: " + name + ": expected " + expected + " but got " + result;
+    }
+    WScript.Echo(name + ": " + (elapsed * 1000000 / iterations).toFixed(2) + " ns/iteration");
+    return elapsed;
+}
+
+var total = 0;
+total += run("route", route, iterations / 4 * 3);
+total += run("validate", validate, iterations / 4 * 3);
+total += run("parse", parse, iterations / 4 * 21);
+
+WScript.Echo("### TIME:", total, "ms");
@@ -0,0 +1,109 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Scanner throughput micro benchmark, in MB of source per second.
+//
+// Two generated corpora stand in for real-world bundles: a minified one (short identifiers, long string
+// literals, a license header and a source map comment) and a pretty printed one (indentation, doc comments,
+// long descriptive identifiers). Each is wrapped in a function that is never called, so the time goes to
+// scanning and parsing the text rather than running it. Sources are compiled both as UTF-8
+// (WScript.LoadScript, when running under ch) and as UTF-16 (new Function).
+//
+//   ch scannerThroughput.js
+//   perl perftest.pl -dir:Micro -binary:<path to ch>
+
+if (typeof (WScript) === "undefined") {
+    var WScript = {
+        Echo: print
+    }
+}
+
+var corpusLength = 2 * 1024 * 1024;
+var iterations = 10;
+
+function minifiedCorpus(length) {
+    var parts = [
+        "/*! bundle v1.0.0 | (c) contributors | license: MIT. Permission is hereby granted, free of charge, to any person obtaining a copy of this software */\n"
+    ];
+    var size = parts[0].length;
+    for (var i = 0; size < length; i++) {
+        var chunk =
+            "function a" + i + "(e,t,n){var r=e.length,o=t||{};for(var i=0;i<r;i++){o[e[i].id]=e[i]}" +
+            "if(!n)throw new Error(\"Invalid argument supplied to a" + i + ": expected a non-empty collection of records with ids\");" +
+            "return o.url=\"https://cdn.example.com/assets/images/icons/a" + i + "-large.png?v=1.0.0&format=webp\",o}" +
+            "var b" + i + "='Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor " + i + "'," +
+            "c" + i + "=`template ${b" + i + "} with a substitution and a long plain tail of text`;";
+        parts.push(chunk);
+        size += chunk.length;
+    }
+    parts.push("\n//# sourceMappingURL=data:application/json;base64,eyJ2ZXJzaW9uIjozLCJzb3VyY2VzIjpbImJ1bmRsZS5qcyJdfQ==\n");
+    return parts.join("");
+}
+
+function prettyCorpus(length) {
+    var parts = [];
+    var size = 0;
+    for (var i = 0; size < length; i++) {
+        var chunk =
+            "\n" +
+            "    /**\n" +
+            "     * Collects the records of the given collection into a dictionary keyed by id, and attaches\n" +
+            "     * the location of the icon that goes with them.\n" +
+            "     */\n" +
+            "    function collectRecordsById" + i + "(recordCollection, existingDictionary, shouldValidate) {\n" +
+            "        var recordCount = recordCollection.length;\n" +
+            "        var resultDictionary = existingDictionary || {};\n" +
+            "        for (var recordIndex = 0; recordIndex < recordCount; recordIndex++) {\n" +
+            "            // later records replace earlier ones with the same id\n" +
+            "            resultDictionary[recordCollection[recordIndex].id] = recordCollection[recordIndex];\n" +
+            "        }\n" +
+            "        if (!shouldValidate) {\n" +
+            "            throw new Error(\"Invalid argument supplied to collectRecordsById\");\n" +
+            "        }\n" +
+            "        return resultDictionary;\n" +
+            "    }\n";
+        parts.push(chunk);
+        size += chunk.length;
+    }
+    return parts.join("");
+}
+
+function measure(name, source, compile) {
+    compile(source, -1); // warm up
+
+    var start = new Date();
+    for (var i = 0; i < iterations; i++) {
+        compile(source, i);
+    }
+    var elapsed = new Date() - start;
+
+    var megabytes = source.length * iterations / (1024 * 1024);
+    WScript.Echo(name + ": " + (megabytes * 1000 / Math.max(elapsed, 1)).toFixed(1) + " MB/s");
+    return elapsed;
+}
+
+// The trailing comment keeps each source distinct so that no compile is served from a cache
+function compileUtf16(source, i) {
+    new Function(source + "\n//" + i);
+}
+
+function compileUtf8(source, i) {
+    WScript.LoadScript("(function () {" + source + "\n});//" + i, "samethread");
+}
+
+var corpora = [
+    { name: "minified", source: minifiedCorpus(corpusLength) },
+    { name: "pretty", source: prettyCorpus(corpusLength) }
+];
+
+var total = 0;
+for (var i = 0; i < corpora.length; i++) {
+    if (WScript.LoadScript) {
+        total += measure(corpora[i].name + " utf8", corpora[i].source, compileUtf8);
+    }
+    total += measure(corpora[i].name + " utf16", corpora[i].source, compileUtf16);
+}
+
+WScript.Echo("### TIME:", total, "ms");
@@ -55,6 +55,8 @@ parser.add_argument('--timeout', type=int, default=60,
 parser.add_argument('-l', '--logfile', metavar='logfile', help='file to log results to', default=None)
 parser.add_argument('--x86', action='store_true', help='use x86 build')
 parser.add_argument('--x64', action='store_true', help='use x64 build')
+parser.add_argument('--jit', action='store_true',
+                    help='ch was built with the JIT (build.sh --jit)')
 args = parser.parse_args()
 
 
@@ -109,7 +111,8 @@ not_tags.add('exclude_nightly' if args.nightly else 'nightly')
 if sys.platform != 'win32':
     not_tags.add('exclude_xplat')
     not_tags.add('Intl')
-    not_tags.add('require_backend')
+    if not args.jit:
+        not_tags.add('require_backend')
     not_tags.add('require_debugger')
 not_compile_flags = set(['-simdjs']) \
     if sys.platform != 'win32' else None